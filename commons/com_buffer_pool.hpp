@@ -0,0 +1,198 @@
+/**
+ * @file com_buffer_pool.hpp
+ * @author your name (you@domain.com)
+ * @brief Fixed-size pool of cache-aligned buffers with refcounted handles
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef COM_BUFFER_POOL_HPP
+#define COM_BUFFER_POOL_HPP
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <atomic>
+#include <utility>
+
+#include "com_types.hpp"
+
+#ifndef BUFFER_POOL_ALIGNMENT
+#define BUFFER_POOL_ALIGNMENT                                                 64
+#endif
+
+/**
+ * @brief Bookkeeping for one buffer of a pool
+ */
+typedef struct
+{
+  std::atomic<uint32_t> refs;  /*!< Zero while the buffer is free */
+  uint32_t size;               /*!< Bytes in use */
+  uint32_t capacity;           /*!< Bytes available */
+  uint8_t *data;
+}PoolBlock_t;
+
+/**
+ * @brief Refcounted handle to a buffer taken from a BufferPool
+ *
+ * @note The buffer goes back to its pool when the last handle is destroyed.
+ *       Drivers keep a reference while an asynchronous request is in flight,
+ *       so the application can drop its handle right after submitting.
+ */
+class PoolBuffer
+{
+public:
+  PoolBuffer() : m_block(nullptr) {}
+
+  explicit PoolBuffer(PoolBlock_t *block) : m_block(block) {}
+
+  PoolBuffer(const PoolBuffer &other) : m_block(other.m_block)
+  {
+    if(m_block != nullptr) { m_block->refs.fetch_add(1, std::memory_order_relaxed);}
+  }
+
+  PoolBuffer(PoolBuffer &&other) noexcept : m_block(std::exchange(other.m_block, nullptr)) {}
+
+  ~PoolBuffer() { release(m_block);}
+
+  PoolBuffer &operator=(const PoolBuffer &other)
+  {
+    if(other.m_block != nullptr) { other.m_block->refs.fetch_add(1, std::memory_order_relaxed);}
+    release(m_block);
+    m_block = other.m_block;
+    return *this;
+  }
+
+  PoolBuffer &operator=(PoolBuffer &&other) noexcept
+  {
+    if(this != &other)
+    {
+      release(m_block);
+      m_block = std::exchange(other.m_block, nullptr);
+    }
+    return *this;
+  }
+
+  bool valid() const { return m_block != nullptr;}
+
+  uint8_t *data() const { return m_block != nullptr ? m_block->data : nullptr;}
+
+  uint32_t size() const { return m_block != nullptr ? m_block->size : 0;}
+
+  uint32_t capacity() const { return m_block != nullptr ? m_block->capacity : 0;}
+
+  /**
+   * @brief Change the number of bytes in use
+   * @param size New size, clamped to the capacity
+   */
+  void resize(uint32_t size)
+  {
+    if(m_block == nullptr) { return;}
+    m_block->size = size < m_block->capacity ? size : m_block->capacity;
+  }
+
+  Buffer_t span() const { return Buffer_t(data(), size());}
+
+  /**
+   * @brief Take a reference to carry the buffer through a request queue
+   * @return void* Opaque pointer to give back to release(), nullptr if not valid
+   */
+  void *retain() const
+  {
+    if(m_block == nullptr) { return nullptr;}
+    m_block->refs.fetch_add(1, std::memory_order_relaxed);
+    return m_block;
+  }
+
+  /**
+   * @brief Drop a reference taken with retain(), nullptr is ignored
+   * @param block Pointer returned by retain()
+   */
+  static void release(void *block)
+  {
+    if(block == nullptr) { return;}
+    static_cast<PoolBlock_t *>(block)->refs.fetch_sub(1, std::memory_order_release);
+  }
+
+private:
+  PoolBlock_t *m_block;
+};
+
+/**
+ * @brief Fixed-size pool of buffers, each aligned on a cache line
+ *
+ * @note No memory is allocated after construction. acquire() is lock free and
+ *       can be called from any thread.
+ *
+ * @tparam BUFFER_SIZE Capacity of each buffer in bytes
+ * @tparam BUFFER_COUNT Number of buffers in the pool
+ */
+template<uint32_t BUFFER_SIZE, uint32_t BUFFER_COUNT>
+class BufferPool
+{
+public:
+  BufferPool()
+  {
+    m_cursor = 0;
+    for(uint32_t i = 0; i < BUFFER_COUNT; i++)
+    {
+      m_blocks[i].refs = 0;
+      m_blocks[i].size = 0;
+      m_blocks[i].capacity = BUFFER_SIZE;
+      m_blocks[i].data = &m_storage[i * STRIDE];
+    }
+  }
+
+  BufferPool(const BufferPool &) = delete;
+  BufferPool &operator=(const BufferPool &) = delete;
+
+  /**
+   * @brief Take a free buffer from the pool
+   * @param size Number of bytes in use, clamped to BUFFER_SIZE
+   * @return PoolBuffer Not valid if the pool is exhausted
+   */
+  PoolBuffer acquire(uint32_t size = BUFFER_SIZE)
+  {
+    uint32_t start = m_cursor.fetch_add(1, std::memory_order_relaxed);
+    uint32_t expected;
+
+    for(uint32_t i = 0; i < BUFFER_COUNT; i++)
+    {
+      PoolBlock_t *block = &m_blocks[(start + i) % BUFFER_COUNT];
+      expected = 0;
+      if(block->refs.load(std::memory_order_relaxed) == 0 &&
+         block->refs.compare_exchange_strong(expected, 1, std::memory_order_acquire))
+      {
+        block->size = size < BUFFER_SIZE ? size : BUFFER_SIZE;
+        return PoolBuffer(block);
+      }
+    }
+    return PoolBuffer();
+  }
+
+  /**
+   * @brief Get the number of buffers not in use
+   * @return uint32_t
+   */
+  uint32_t getFreeCount()
+  {
+    uint32_t count = 0;
+    for(uint32_t i = 0; i < BUFFER_COUNT; i++)
+    {
+      if(m_blocks[i].refs.load(std::memory_order_relaxed) == 0) { count++;}
+    }
+    return count;
+  }
+
+private:
+  // Buffers never share a cache line
+  static constexpr uint32_t STRIDE = (BUFFER_SIZE + BUFFER_POOL_ALIGNMENT - 1) / BUFFER_POOL_ALIGNMENT * BUFFER_POOL_ALIGNMENT;
+
+  alignas(BUFFER_POOL_ALIGNMENT) uint8_t m_storage[STRIDE * BUFFER_COUNT];
+  PoolBlock_t m_blocks[BUFFER_COUNT];
+  std::atomic<uint32_t> m_cursor;
+};
+
+#endif /* COM_BUFFER_POOL_HPP */
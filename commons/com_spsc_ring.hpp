@@ -0,0 +1,78 @@
+/**
+ * @file com_spsc_ring.hpp
+ * @author your name (you@domain.com)
+ * @brief Lock-free ring buffer for one producer and one consumer
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef COM_SPSC_RING_HPP
+#define COM_SPSC_RING_HPP
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <atomic>
+
+#ifndef SPSC_RING_ALIGNMENT
+#define SPSC_RING_ALIGNMENT                                                   64
+#endif
+
+/**
+ * @brief Fixed-size ring buffer, one thread pushes and another pops without
+ *        locks
+ *
+ * @note The indexes run freely and wrap with SIZE, so SIZE must be a power
+ *       of two and all SIZE slots are usable. Each index lives in its own
+ *       cache line so that the two threads do not share one.
+ *
+ * @tparam T Type of the items, copied in and out
+ * @tparam SIZE Number of items, a power of two
+ */
+template <typename T, uint32_t SIZE>
+class SpscRing
+{
+  static_assert(SIZE > 0 && (SIZE & (SIZE - 1)) == 0, "SpscRing size must be a power of two");
+
+public:
+  SpscRing() : m_head(0), m_tail(0) {}
+
+  // Called by the producer only, false when the ring is full
+  bool push(const T &item)
+  {
+    uint32_t head = m_head.load(std::memory_order_relaxed);
+
+    if(head - m_tail.load(std::memory_order_acquire) >= SIZE) { return false;}
+    m_items[head & (SIZE - 1)] = item;
+    m_head.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Called by the consumer only, false when the ring is empty
+  bool pop(T &item)
+  {
+    uint32_t tail = m_tail.load(std::memory_order_relaxed);
+
+    if(tail == m_head.load(std::memory_order_acquire)) { return false;}
+    item = m_items[tail & (SIZE - 1)];
+    m_tail.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Number of items, exact only when called by one of the two threads
+  uint32_t getSize()
+  {
+    return m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_acquire);
+  }
+
+  uint32_t getCapacity() { return SIZE;}
+
+private:
+  alignas(SPSC_RING_ALIGNMENT) std::atomic<uint32_t> m_head;
+  alignas(SPSC_RING_ALIGNMENT) std::atomic<uint32_t> m_tail;
+  alignas(SPSC_RING_ALIGNMENT) T m_items[SIZE];
+};
+
+#endif /* COM_SPSC_RING_HPP */
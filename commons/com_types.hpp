@@ -34,6 +34,10 @@ typedef struct
   uint8_t *tx_buffer;
   uint32_t tx_size;
   uint32_t timeout;
+  uint32_t id;
+  void *completion;
+  void *pool_buffer;
+  uint64_t timestamp;
 } DataBundle_t;
 
 #endif /* COM_TYPES_HPP */
\ No newline at end of file
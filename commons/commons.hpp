@@ -14,6 +14,7 @@
 
 #include "com_status.hpp"
 #include "com_types.hpp"
+#include "com_buffer_pool.hpp"
 
 
 #endif /* COMMONS_HPP_ */
@@ -0,0 +1,375 @@
+/**
+ * @file benchmark_harness.cpp
+ * @author your name (you@domain.com)
+ * @brief Minimal harness to time driver operations and report them as JSON
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "benchmark_harness.hpp"
+
+#include <pty.h>
+#include <poll.h>
+#include <unistd.h>
+#include <termios.h>
+#include <string.h>
+#include <stdlib.h>
+#include <chrono>
+#include <algorithm>
+
+// Time the echo or drain peer waits for data before checking for termination
+constexpr int BENCHMARK_PEER_POLL_MS = 50;
+
+/**
+ * @brief Constructor
+ * @param iteration_count Number of operations the benchmark should perform
+ */
+BenchmarkRun::BenchmarkRun(uint32_t iteration_count)
+{
+  iterations = iteration_count;
+  bytes = 0;
+  dropped = 0;
+  error = nullptr;
+  m_start_ns = 0;
+  m_elapsed_ns = 0;
+  m_samples.reserve(iteration_count);
+}
+
+/**
+ * @brief Start the timed section
+ */
+void BenchmarkRun::start()
+{
+  m_start_ns = BenchmarkHarness::getTimeNs();
+}
+
+/**
+ * @brief End the timed section
+ */
+void BenchmarkRun::stop()
+{
+  m_elapsed_ns = BenchmarkHarness::getTimeNs() - m_start_ns;
+}
+
+/**
+ * @brief End the timed section at an earlier time, for benchmarks that wait
+ *        for stragglers after the measured work
+ * @param end_ns End time, from BenchmarkHarness::getTimeNs()
+ */
+void BenchmarkRun::stopAt(uint64_t end_ns)
+{
+  m_elapsed_ns = end_ns - m_start_ns;
+}
+
+/**
+ * @brief Record the latency of a single operation
+ * @param duration_ns Duration in nanoseconds
+ */
+void BenchmarkRun::addSample(uint64_t duration_ns)
+{
+  m_samples.push_back(duration_ns);
+}
+
+/**
+ * @brief Mark the run as failed
+ * @param message What went wrong
+ * @return false, so that benchmarks can write return run.fail("...")
+ */
+bool BenchmarkRun::fail(const char *message)
+{
+  error = message;
+  return false;
+}
+
+/**
+ * @brief Get the duration of the timed section
+ * @return uint64_t
+ */
+uint64_t BenchmarkRun::getElapsedNs() const
+{
+  return m_elapsed_ns;
+}
+
+/**
+ * @brief Get the latencies recorded so far
+ * @return const std::vector<uint64_t>&
+ */
+const std::vector<uint64_t> &BenchmarkRun::getSamples() const
+{
+  return m_samples;
+}
+
+/**
+ * @brief Constructor
+ */
+BenchmarkHarness::BenchmarkHarness()
+{
+}
+
+/**
+ * @brief Register a benchmark
+ * @param name Name of the benchmark
+ * @param function Function performing the benchmark
+ * @param iterations Default number of operations
+ */
+void BenchmarkHarness::add(const char *name, BenchmarkFunction_t function, uint32_t iterations)
+{
+  m_benchmarks.push_back({name, function, iterations});
+}
+
+/**
+ * @brief Run the benchmarks selected on the command line
+ *
+ * @note Accepted options: --list, --filter <text>, --iterations <n> and
+ *       --output <file>. Results are printed as JSON lines.
+ * @param argc Number of arguments
+ * @param argv Arguments
+ * @return int Zero when every selected benchmark succeeded
+ */
+int BenchmarkHarness::run(int argc, char **argv)
+{
+  const char *filter = nullptr;
+  const char *output = nullptr;
+  uint32_t iterations = 0;
+  bool list_only = false;
+  int failures = 0;
+  FILE *file = stdout;
+
+  for(int i = 1; i < argc; i++)
+  {
+    if(strcmp(argv[i], "--list") == 0)
+    {
+      list_only = true;
+    }else if(strcmp(argv[i], "--filter") == 0 && i + 1 < argc)
+    {
+      filter = argv[++i];
+    }else if(strcmp(argv[i], "--iterations") == 0 && i + 1 < argc)
+    {
+      iterations = strtoul(argv[++i], nullptr, 10);
+    }else if(strcmp(argv[i], "--output") == 0 && i + 1 < argc)
+    {
+      output = argv[++i];
+    }else
+    {
+      fprintf(stderr, "usage: %s [--list] [--filter text] [--iterations n] [--output file]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  if(output != nullptr)
+  {
+    file = fopen(output, "w");
+    if(file == nullptr)
+    {
+      fprintf(stderr, "Failed to open %s\n", output);
+      return 2;
+    }
+  }
+
+  for(const Benchmark_t &benchmark : m_benchmarks)
+  {
+    if(filter != nullptr && strstr(benchmark.name, filter) == nullptr) { continue;}
+    if(list_only)
+    {
+      fprintf(file, "%s\n", benchmark.name);
+      continue;
+    }
+
+    BenchmarkRun run(iterations > 0 ? iterations : benchmark.iterations);
+    bool success = benchmark.function(run);
+    if(!success) { failures++;}
+    report(file, benchmark, run, success);
+    fflush(file);
+  }
+
+  if(file != stdout) { fclose(file);}
+  return failures == 0 ? 0 : 1;
+}
+
+/**
+ * @brief Get a monotonic timestamp
+ * @return uint64_t Time in nanoseconds
+ */
+uint64_t BenchmarkHarness::getTimeNs()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief Print the result of a run as a JSON object on a single line
+ * @param file Output file
+ * @param benchmark The benchmark
+ * @param run Its run
+ * @param success True if the run succeeded
+ */
+void BenchmarkHarness::report(FILE *file, const Benchmark_t &benchmark, const BenchmarkRun &run, bool success)
+{
+  std::vector<uint64_t> samples = run.getSamples();
+  uint64_t elapsed_ns = run.getElapsedNs();
+  double seconds = elapsed_ns / 1e9;
+
+  fprintf(file, "{\"name\":\"%s\",\"status\":\"%s\"", benchmark.name, success ? "ok" : "failed");
+  if(!success)
+  {
+    fprintf(file, ",\"error\":\"%s\"}\n", run.error != nullptr ? run.error : "unknown");
+    return;
+  }
+
+  fprintf(file, ",\"iterations\":%u,\"bytes\":%llu,\"dropped\":%llu,\"elapsed_ns\":%llu", run.iterations,
+    (unsigned long long) run.bytes, (unsigned long long) run.dropped, (unsigned long long) elapsed_ns);
+  if(seconds > 0)
+  {
+    fprintf(file, ",\"ops_per_s\":%.1f,\"mib_per_s\":%.3f", run.iterations / seconds,
+      run.bytes / seconds / (1024.0 * 1024.0));
+  }
+  if(!samples.empty())
+  {
+    std::sort(samples.begin(), samples.end());
+    auto percentile = [&samples](double p) -> unsigned long long
+    {
+      size_t index = (size_t) (p / 100.0 * (samples.size() - 1) + 0.5);
+      return samples[index];
+    };
+    fprintf(file, ",\"latency_ns\":{\"min\":%llu,\"p50\":%llu,\"p90\":%llu,\"p99\":%llu,\"max\":%llu}",
+      percentile(0), percentile(50), percentile(90), percentile(99), percentile(100));
+  }
+  fprintf(file, "}\n");
+}
+
+/**
+ * @brief Constructor
+ */
+PtyPair::PtyPair()
+{
+  m_master = -1;
+  m_slave = -1;
+  m_name[0] = '\0';
+  m_peer = nullptr;
+  m_terminate = true;
+  m_drained = 0;
+}
+
+/**
+ * @brief Destructor
+ */
+PtyPair::~PtyPair()
+{
+  close();
+}
+
+/**
+ * @brief Create the pseudo-terminal, both ends in raw mode
+ * @return true on success
+ */
+bool PtyPair::open()
+{
+  struct termios termios_structure;
+
+  close();
+  if(openpty(&m_master, &m_slave, m_name, nullptr, nullptr) < 0) { return false;}
+
+  // The slave stays open so that the master never sees a hang up between
+  // two drivers using the line
+  tcgetattr(m_slave, &termios_structure);
+  cfmakeraw(&termios_structure);
+  tcsetattr(m_slave, TCSANOW, &termios_structure);
+  return true;
+}
+
+/**
+ * @brief Stop the peer and close both ends
+ */
+void PtyPair::close()
+{
+  stopPeer();
+  if(m_master >= 0) { ::close(m_master);}
+  if(m_slave >= 0) { ::close(m_slave);}
+  m_master = -1;
+  m_slave = -1;
+}
+
+/**
+ * @brief Send back everything the driver writes
+ * @return true if the peer is running
+ */
+bool PtyPair::startEcho()
+{
+  stopPeer();
+  m_terminate = false;
+  m_peer = new std::thread(&PtyPair::runPeer, this, true);
+  return m_peer != nullptr;
+}
+
+/**
+ * @brief Discard and count everything the driver writes
+ * @return true if the peer is running
+ */
+bool PtyPair::startDrain()
+{
+  stopPeer();
+  m_drained = 0;
+  m_terminate = false;
+  m_peer = new std::thread(&PtyPair::runPeer, this, false);
+  return m_peer != nullptr;
+}
+
+/**
+ * @brief Stop the echo or drain peer
+ */
+void PtyPair::stopPeer()
+{
+  if(m_peer == nullptr) { return;}
+  m_terminate = true;
+  m_peer->join();
+  delete m_peer;
+  m_peer = nullptr;
+}
+
+/**
+ * @brief Block until the drain peer has received a number of bytes
+ * @param byte_count Number of bytes expected since startDrain() or resetDrained()
+ * @param timeout_ms Time to wait in milliseconds
+ * @return true if every byte arrived in time
+ */
+bool PtyPair::waitDrained(uint64_t byte_count, uint32_t timeout_ms)
+{
+  uint64_t deadline = BenchmarkHarness::getTimeNs() + (uint64_t) timeout_ms * 1000000;
+
+  while(m_drained.load(std::memory_order_acquire) < byte_count)
+  {
+    if(BenchmarkHarness::getTimeNs() > deadline) { return false;}
+    std::this_thread::yield();
+  }
+  return true;
+}
+
+/**
+ * @brief Remote end of the line
+ * @param echo True to send data back, false to discard it
+ */
+void PtyPair::runPeer(bool echo)
+{
+  struct pollfd fds[1] = {{m_master, POLLIN, 0}};
+  uint8_t buffer[4096];
+  ssize_t byte_count, bytes_written, result;
+
+  while(!m_terminate)
+  {
+    if(poll(fds, 1, BENCHMARK_PEER_POLL_MS) <= 0) { continue;}
+    byte_count = read(m_master, buffer, sizeof(buffer));
+    if(byte_count <= 0) { continue;}
+    if(echo)
+    {
+      for(bytes_written = 0; bytes_written < byte_count; bytes_written += result)
+      {
+        result = write(m_master, buffer + bytes_written, byte_count - bytes_written);
+        if(result < 0) { break;}
+      }
+    }
+    m_drained.fetch_add(byte_count, std::memory_order_release);
+  }
+}
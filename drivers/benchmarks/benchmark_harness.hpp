@@ -0,0 +1,131 @@
+/**
+ * @file benchmark_harness.hpp
+ * @author your name (you@domain.com)
+ * @brief Minimal harness to time driver operations and report them as JSON
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef DRIVERS_BENCHMARKS_BENCHMARK_HARNESS_HPP
+#define DRIVERS_BENCHMARKS_BENCHMARK_HARNESS_HPP
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <functional>
+
+#include "drivers.hpp"
+
+/**
+ * @brief State of a single benchmark run, filled in by the benchmark
+ */
+class BenchmarkRun
+{
+public:
+  uint32_t iterations;  /*!< Number of operations requested by the harness */
+  uint64_t bytes;       /*!< Payload moved during the timed section */
+  uint64_t dropped;     /*!< Events lost during the timed section */
+  const char *error;    /*!< Set to a message when the run failed */
+
+  BenchmarkRun(uint32_t iteration_count);
+
+  void start();
+  void stop();
+  void stopAt(uint64_t end_ns);
+  void addSample(uint64_t duration_ns);
+  bool fail(const char *message);
+
+  uint64_t getElapsedNs() const;
+  const std::vector<uint64_t> &getSamples() const;
+
+private:
+  uint64_t m_start_ns;
+  uint64_t m_elapsed_ns;
+  std::vector<uint64_t> m_samples;
+};
+
+using BenchmarkFunction_t = std::function<bool(BenchmarkRun &run)>;
+
+/**
+ * @brief A named benchmark, names are paths such as uart/sync/roundtrip/8
+ */
+typedef struct
+{
+  const char *name;
+  BenchmarkFunction_t function;
+  uint32_t iterations;  /*!< Default number of operations */
+}Benchmark_t;
+
+/**
+ * @brief Runs registered benchmarks and prints one JSON object per line
+ */
+class BenchmarkHarness
+{
+public:
+  BenchmarkHarness();
+
+  void add(const char *name, BenchmarkFunction_t function, uint32_t iterations);
+
+  int run(int argc, char **argv);
+
+  static uint64_t getTimeNs();
+
+private:
+  std::vector<Benchmark_t> m_benchmarks;
+
+  void report(FILE *file, const Benchmark_t &benchmark, const BenchmarkRun &run, bool success);
+};
+
+/**
+ * @brief Pseudo-terminal pair standing in for a serial line
+ *
+ * @note Drivers open the slave side by name, the benchmark plays the remote
+ *       end on the master side.
+ */
+class PtyPair
+{
+public:
+  PtyPair();
+
+  ~PtyPair();
+
+  bool open();
+
+  void close();
+
+  const char *getName() const { return m_name;}
+  int getMaster() const { return m_master;}
+  int getSlave() const { return m_slave;}
+
+  bool startEcho();
+
+  bool startDrain();
+
+  void stopPeer();
+
+  bool waitDrained(uint64_t byte_count, uint32_t timeout_ms);
+
+  void resetDrained() { m_drained = 0;}
+
+private:
+  int m_master;
+  int m_slave;
+  char m_name[64];
+  std::thread *m_peer;
+  std::atomic<bool> m_terminate;
+  std::atomic<uint64_t> m_drained;
+
+  void runPeer(bool echo);
+};
+
+void registerUartBenchmarks(BenchmarkHarness &harness);
+void registerDioBenchmarks(BenchmarkHarness &harness);
+void registerBusBenchmarks(BenchmarkHarness &harness);
+
+#endif /* DRIVERS_BENCHMARKS_BENCHMARK_HARNESS_HPP */
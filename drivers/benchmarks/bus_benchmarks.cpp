@@ -0,0 +1,180 @@
+/**
+ * @file bus_benchmarks.cpp
+ * @author your name (you@domain.com)
+ * @brief Sampling jitter of sensors on a shared bus, with the acquisition
+ *        scheduler and with one thread per sensor
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "benchmark_harness.hpp"
+
+#include <memory>
+
+// Sensors sampled at once, spread over the periods below
+constexpr uint32_t BENCHMARK_SENSOR_COUNT = 30;
+// Periods from 4 kHz down to 10 Hz
+constexpr uint32_t BENCHMARK_PERIODS_US[] = {250, 500, 1000, 2000, 5000, 10000, 100000};
+// Longest a run lasts, whatever the number of samples collected
+constexpr uint64_t BENCHMARK_ACQUISITION_TIMEOUT_NS = 10000000000;
+
+/**
+ * @brief Emulated bus with one register device per sensor
+ */
+class SensorBusFixture
+{
+public:
+  SensorBusFixture()
+  {
+    for(uint32_t i = 0; i < BENCHMARK_SENSOR_COUNT; i++)
+    {
+      m_devices.emplace_back(new VirtualIicRegisterDevice(16));
+      m_devices.back()->setRegister(0, (uint8_t) i);
+      m_bus.attach(getAddress(i) >> 1, *m_devices.back());
+    }
+  }
+
+  VirtualIicBus &getBus() { return m_bus;}
+
+  static uint16_t getAddress(uint32_t sensor) { return (uint16_t) ((0x10 + sensor) << 1);}
+
+  static uint32_t getPeriodUs(uint32_t sensor)
+  {
+    return BENCHMARK_PERIODS_US[sensor % (sizeof(BENCHMARK_PERIODS_US) / sizeof(BENCHMARK_PERIODS_US[0]))];
+  }
+
+private:
+  VirtualIicBus m_bus;
+  std::vector<std::unique_ptr<VirtualIicRegisterDevice>> m_devices;
+};
+
+/**
+ * @brief Sample every sensor with AcquisitionScheduler, the delay between
+ *        due and start of each sample is timed
+ * @param run The run, each iteration is a sample
+ * @return true on success
+ */
+static bool acquisitionJitter(BenchmarkRun &run)
+{
+  SensorBusFixture fixture;
+  LinuxIicBus bus(fixture.getBus());
+  AcquisitionScheduler acquisition;
+  AcquisitionSample_t sample;
+  AcquisitionStats_t stats;
+  uint64_t collected = 0, deadline;
+  uint8_t reg = 0;
+  uint16_t sensor_id;
+
+  if(!bus.open().success) { return run.fail("Failed to open the bus");}
+  for(uint32_t i = 0; i < BENCHMARK_SENSOR_COUNT; i++)
+  {
+    // Emulated sensors always acknowledge
+    BusDevice sensor(bus, SensorBusFixture::getAddress(i));
+    sensor.setMergeable(true);
+    if(!acquisition.addSensor(sensor, &reg, 1, 1, SensorBusFixture::getPeriodUs(i), sensor_id).success)
+    {
+      return run.fail("Failed to add a sensor");
+    }
+  }
+
+  run.start();
+  if(!acquisition.start().success) { return run.fail("Failed to start the acquisition");}
+  deadline = BenchmarkHarness::getTimeNs() + BENCHMARK_ACQUISITION_TIMEOUT_NS;
+  while(collected < run.iterations && BenchmarkHarness::getTimeNs() < deadline)
+  {
+    for(uint16_t i = 0; i < BENCHMARK_SENSOR_COUNT; i++)
+    {
+      while(collected < run.iterations && acquisition.getSample(i, sample))
+      {
+        run.addSample(sample.start_ns - sample.due_ns);
+        collected++;
+      }
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  acquisition.stop();
+  run.stop();
+
+  for(uint16_t i = 0; i < BENCHMARK_SENSOR_COUNT; i++)
+  {
+    (void) acquisition.getStats(i, stats);
+    run.dropped += stats.misses + stats.overruns;
+  }
+  if(collected == 0) { return run.fail("No sample was taken");}
+  run.iterations = (uint32_t) collected;
+  return true;
+}
+
+/**
+ * @brief Sample every sensor from a thread of its own sleeping until each
+ *        sample is due, as applications do without the scheduler
+ * @param run The run, each iteration is a sample
+ * @return true on success
+ */
+static bool threadedJitter(BenchmarkRun &run)
+{
+  SensorBusFixture fixture;
+  std::vector<std::thread> threads;
+  std::vector<std::vector<uint64_t>> jitters(BENCHMARK_SENSOR_COUNT);
+  std::atomic<uint64_t> collected(0), missed(0);
+  std::atomic<bool> terminate(false);
+  uint64_t origin, deadline;
+
+  run.start();
+  origin = BenchmarkHarness::getTimeNs() + 1000000;
+  for(uint32_t i = 0; i < BENCHMARK_SENSOR_COUNT; i++)
+  {
+    threads.emplace_back([&, i]()
+    {
+      IIC iic(fixture.getBus(), SensorBusFixture::getAddress(i));
+      uint64_t period_ns = (uint64_t) SensorBusFixture::getPeriodUs(i) * 1000;
+      uint64_t due = origin, start;
+      uint8_t reg = 0, value;
+
+      (void) iic.configure(nullptr, 0);
+      while(!terminate.load(std::memory_order_relaxed))
+      {
+        std::this_thread::sleep_until(std::chrono::steady_clock::time_point(std::chrono::nanoseconds(due)));
+        start = BenchmarkHarness::getTimeNs();
+        if(iic.write(&reg, 1).success && iic.read(&value, 1).success)
+        {
+          jitters[i].push_back(start - due);
+          if(collected.fetch_add(1, std::memory_order_relaxed) + 1 >= run.iterations) { terminate = true;}
+        }
+        due += period_ns;
+        while(due + period_ns <= BenchmarkHarness::getTimeNs()) { due += period_ns; missed++;}
+      }
+    });
+  }
+
+  deadline = BenchmarkHarness::getTimeNs() + BENCHMARK_ACQUISITION_TIMEOUT_NS;
+  while(!terminate.load() && BenchmarkHarness::getTimeNs() < deadline)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  terminate = true;
+  for(std::thread &thread : threads) { thread.join();}
+  run.stop();
+
+  for(const std::vector<uint64_t> &samples : jitters)
+  {
+    for(uint64_t jitter : samples) { run.addSample(jitter);}
+  }
+  run.dropped = missed.load();
+  if(collected == 0) { return run.fail("No sample was taken");}
+  run.iterations = (uint32_t) collected.load();
+  return true;
+}
+
+/**
+ * @brief Register the shared bus benchmarks
+ * @param harness The harness
+ */
+void registerBusBenchmarks(BenchmarkHarness &harness)
+{
+  harness.add("bus/acquisition_jitter", acquisitionJitter, 20000);
+  harness.add("bus/threaded_jitter", threadedJitter, 20000);
+}
@@ -0,0 +1,365 @@
+/**
+ * @file dio_benchmarks.cpp
+ * @author your name (you@domain.com)
+ * @brief Digital line benchmarks on a gpio-sim chip, or on an in-process
+ *        line when the module is not available
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "benchmark_harness.hpp"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+// Device created through configfs, needs the gpio-sim module and root
+#define GPIO_SIM_DEVICE      "/sys/kernel/config/gpio-sim/driver_benchmarks"
+#define GPIO_SIM_BANK        GPIO_SIM_DEVICE "/bank0"
+
+// Time to wait for a single edge to be reported before the run fails
+constexpr uint64_t BENCHMARK_EDGE_TIMEOUT_NS = 1000000000;
+// Time without new callbacks after which a burst is considered delivered
+constexpr uint64_t BENCHMARK_EDGE_SETTLE_NS = 100000000;
+
+/**
+ * @brief Shared between a benchmark and the DIO callback
+ */
+typedef struct
+{
+  std::atomic<uint64_t> received;
+  std::atomic<uint64_t> last_callback_ns;
+}EdgeCounter_t;
+
+/**
+ * @brief A line the benchmarks own, and a way to drive it from the outside
+ */
+class DioFixture
+{
+public:
+  DioFixture();
+  ~DioFixture();
+
+  bool open();
+
+  DIO &getDio() { return *m_dio;}
+
+  bool setLevel(bool level);
+
+private:
+  VirtualDioLine m_line;
+  DIO *m_dio;
+  char m_pull_path[256];
+  bool m_is_sim;
+
+  bool openGpioSim();
+  void closeGpioSim();
+};
+
+/**
+ * @brief Write a short string to a configfs or sysfs attribute
+ * @param path The attribute
+ * @param text The value
+ * @return true on success
+ */
+static bool writeAttribute(const char *path, const char *text)
+{
+  int fd = ::open(path, O_WRONLY);
+  bool success;
+
+  if(fd < 0) { return false;}
+  success = write(fd, text, strlen(text)) == (ssize_t) strlen(text);
+  close(fd);
+  return success;
+}
+
+/**
+ * @brief Read a configfs or sysfs attribute, the trailing newline is removed
+ * @param path The attribute
+ * @param text Buffer to store the value
+ * @param size Size of the buffer
+ * @return true on success
+ */
+static bool readAttribute(const char *path, char *text, size_t size)
+{
+  int fd = ::open(path, O_RDONLY);
+  ssize_t length;
+
+  if(fd < 0) { return false;}
+  length = read(fd, text, size - 1);
+  close(fd);
+  if(length <= 0) { return false;}
+  text[length] = '\0';
+  if(text[length - 1] == '\n') { text[length - 1] = '\0';}
+  return true;
+}
+
+/**
+ * @brief Constructor
+ */
+DioFixture::DioFixture()
+{
+  m_dio = nullptr;
+  m_pull_path[0] = '\0';
+  m_is_sim = false;
+}
+
+/**
+ * @brief Destructor, the driver goes before the line it uses
+ */
+DioFixture::~DioFixture()
+{
+  delete m_dio;
+  if(m_is_sim) { closeGpioSim();}
+}
+
+/**
+ * @brief Create the line, gpio-sim is preferred so that the kernel path is
+ *        measured
+ * @return true on success
+ */
+bool DioFixture::open()
+{
+  static bool is_reported = false;
+
+  m_is_sim = openGpioSim();
+  if(!m_is_sim) { m_dio = new DIO(m_line);}
+  if(!is_reported)
+  {
+    fprintf(stderr, "gpio benchmarks run on %s\n", m_is_sim ? "gpio-sim" : "an in-process line, gpio-sim is not available");
+    is_reported = true;
+  }
+  return m_dio != nullptr;
+}
+
+/**
+ * @brief Drive the line from the outside, through its pull on gpio-sim
+ * @param level The new level
+ * @return true on success
+ */
+bool DioFixture::setLevel(bool level)
+{
+  if(m_is_sim) { return writeAttribute(m_pull_path, level ? "pull-up" : "pull-down");}
+  m_line.setLevel(level);
+  return true;
+}
+
+/**
+ * @brief Create a one line gpio-sim chip
+ * @return true on success
+ */
+bool DioFixture::openGpioSim()
+{
+  char chip_name[64], device_name[64];
+
+  if(mkdir(GPIO_SIM_DEVICE, 0755) < 0 && errno != EEXIST) { return false;}
+  if((mkdir(GPIO_SIM_BANK, 0755) < 0 && errno != EEXIST) ||
+     !writeAttribute(GPIO_SIM_BANK "/num_lines", "1") ||
+     !writeAttribute(GPIO_SIM_DEVICE "/live", "1") ||
+     !readAttribute(GPIO_SIM_BANK "/chip_name", chip_name, sizeof(chip_name)) ||
+     !readAttribute(GPIO_SIM_DEVICE "/dev_name", device_name, sizeof(device_name)) ||
+     strncmp(chip_name, "gpiochip", 8) != 0)
+  {
+    closeGpioSim();
+    return false;
+  }
+
+  snprintf(m_pull_path, sizeof(m_pull_path), "/sys/devices/platform/%s/%s/sim_gpio0/pull", device_name, chip_name);
+  m_dio = new DIO(0, (uint32_t) atoi(chip_name + 8));
+  return true;
+}
+
+/**
+ * @brief Remove the gpio-sim chip
+ */
+void DioFixture::closeGpioSim()
+{
+  (void) writeAttribute(GPIO_SIM_DEVICE "/live", "0");
+  (void) rmdir(GPIO_SIM_BANK);
+  (void) rmdir(GPIO_SIM_DEVICE);
+}
+
+/**
+ * @brief Configure the line
+ * @param dio The driver
+ * @param is_output True for an output
+ * @return true on success
+ */
+static bool configureDio(DIO &dio, bool is_output)
+{
+  const DriverSettings_t config_list[]
+  {
+    ADD_PARAMETER(DIO_LINE_DIRECTION, is_output ? DIO_DIRECTION_OUTPUT : DIO_DIRECTION_INPUT),
+    ADD_PARAMETER(DIO_LINE_INITIAL_VALUE, DIO_STATE_LOW)
+  };
+  return dio.configure(config_list, sizeof(config_list)/sizeof(config_list[0])).success;
+}
+
+/**
+ * @brief Time read(), write() or toggle()
+ * @param run The run
+ * @param operation 0 to read, 1 to write, 2 to toggle
+ * @return true on success
+ */
+static bool lineAccess(BenchmarkRun &run, int operation)
+{
+  DioFixture fixture;
+  uint64_t start;
+  Status_t status;
+  bool state = false;
+
+  if(!fixture.open()) { return run.fail("Failed to create the line");}
+  DIO &dio = fixture.getDio();
+  if(!configureDio(dio, operation != 0)) { return run.fail("Failed to configure the line");}
+
+  run.start();
+  for(uint32_t i = 0; i < run.iterations; i++)
+  {
+    start = BenchmarkHarness::getTimeNs();
+    switch(operation)
+    {
+      case 0:
+        status = dio.read(state);
+        break;
+      case 1:
+        status = dio.write((i & 1) != 0);
+        break;
+      default:
+        status = dio.toggle();
+        break;
+    }
+    run.addSample(BenchmarkHarness::getTimeNs() - start);
+    if(!status.success) { return run.fail("Line access failed");}
+  }
+  run.stop();
+
+  return true;
+}
+
+/**
+ * @brief Callback counting edges
+ */
+static Status_t countEdge(Status_t status, DriverEventsList_t edge, Buffer_t buffer, void *arg)
+{
+  EdgeCounter_t *counter = (EdgeCounter_t *) arg;
+
+  (void) status;
+  (void) edge;
+  (void) buffer;
+  counter->last_callback_ns.store(BenchmarkHarness::getTimeNs(), std::memory_order_relaxed);
+  counter->received.fetch_add(1, std::memory_order_release);
+  return STATUS_DRV_SUCCESS;
+}
+
+/**
+ * @brief Prepare an input line reporting both edges to countEdge()
+ * @param run The run
+ * @param fixture The line
+ * @param counter The callback's counter
+ * @return true on success
+ */
+static bool setUpEdges(BenchmarkRun &run, DioFixture &fixture, EdgeCounter_t &counter)
+{
+  counter.received = 0;
+  counter.last_callback_ns = 0;
+  if(!fixture.open()) { return run.fail("Failed to create the line");}
+  if(!fixture.setLevel(false)) { return run.fail("Failed to drive the line");}
+  if(!configureDio(fixture.getDio(), false)) { return run.fail("Failed to configure the line");}
+  if(!fixture.getDio().setCallback(EVENT_EDGE_BOTH, countEdge, &counter).success ||
+     !fixture.getDio().enableCallback(true, EVENT_EDGE_BOTH).success)
+  {
+    return run.fail("Failed to enable edge callbacks");
+  }
+  return true;
+}
+
+/**
+ * @brief Drive one edge at a time and time it until its callback runs, the
+ *        rate reached this way is sustained without losing edges
+ * @param run The run, each iteration is an edge
+ * @return true on success
+ */
+static bool edgeToCallback(BenchmarkRun &run)
+{
+  DioFixture fixture;
+  EdgeCounter_t counter;
+  uint64_t start;
+
+  if(!setUpEdges(run, fixture, counter)) { return false;}
+
+  run.start();
+  for(uint32_t i = 0; i < run.iterations; i++)
+  {
+    start = BenchmarkHarness::getTimeNs();
+    if(!fixture.setLevel((i & 1) == 0)) { return run.fail("Failed to drive the line");}
+    while(counter.received.load(std::memory_order_acquire) <= i)
+    {
+      if(BenchmarkHarness::getTimeNs() - start > BENCHMARK_EDGE_TIMEOUT_NS) { return run.fail("Edge was not reported");}
+    }
+    run.addSample(counter.last_callback_ns.load(std::memory_order_relaxed) - start);
+  }
+  run.stop();
+
+  (void) fixture.getDio().enableCallback(false);
+  return true;
+}
+
+/**
+ * @brief Drive edges back to back without waiting for callbacks, the rate
+ *        is of the edges delivered and the edges lost are counted
+ * @param run The run, each iteration is an edge
+ * @return true on success
+ */
+static bool edgeBurst(BenchmarkRun &run)
+{
+  DioFixture fixture;
+  EdgeCounter_t counter;
+  uint64_t received, last_change;
+
+  if(!setUpEdges(run, fixture, counter)) { return false;}
+
+  run.start();
+  for(uint32_t i = 0; i < run.iterations; i++)
+  {
+    if(!fixture.setLevel((i & 1) == 0)) { return run.fail("Failed to drive the line");}
+  }
+  // Wait until the callbacks stop coming
+  received = counter.received.load(std::memory_order_acquire);
+  last_change = BenchmarkHarness::getTimeNs();
+  while(received < run.iterations && BenchmarkHarness::getTimeNs() - last_change < BENCHMARK_EDGE_SETTLE_NS)
+  {
+    std::this_thread::yield();
+    if(counter.received.load(std::memory_order_acquire) != received)
+    {
+      received = counter.received.load(std::memory_order_acquire);
+      last_change = BenchmarkHarness::getTimeNs();
+    }
+  }
+  // Only the time until the last delivered edge counts towards the rate
+  run.stopAt(counter.last_callback_ns.load(std::memory_order_relaxed));
+
+  (void) fixture.getDio().enableCallback(false);
+  if(received == 0) { return run.fail("No edge was reported");}
+  run.dropped = run.iterations - received;
+  run.iterations = (uint32_t) received;
+  return true;
+}
+
+/**
+ * @brief Register the digital line benchmarks
+ * @param harness The harness
+ */
+void registerDioBenchmarks(BenchmarkHarness &harness)
+{
+  harness.add("gpio/read", [](BenchmarkRun &run) { return lineAccess(run, 0);}, 100000);
+  harness.add("gpio/write", [](BenchmarkRun &run) { return lineAccess(run, 1);}, 100000);
+  harness.add("gpio/toggle", [](BenchmarkRun &run) { return lineAccess(run, 2);}, 100000);
+  harness.add("gpio/edge_to_callback", edgeToCallback, 5000);
+  harness.add("gpio/edge_burst", edgeBurst, 10000);
+}
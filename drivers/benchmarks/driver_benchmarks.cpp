@@ -0,0 +1,27 @@
+/**
+ * @file driver_benchmarks.cpp
+ * @author your name (you@domain.com)
+ * @brief Throughput and latency benchmarks for the linux drivers, no
+ *        hardware needed
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "benchmark_harness.hpp"
+
+/**
+ * @brief Run the benchmarks, results are printed as JSON lines
+ */
+int main(int argc, char **argv)
+{
+  BenchmarkHarness harness;
+
+  registerUartBenchmarks(harness);
+  registerDioBenchmarks(harness);
+  registerBusBenchmarks(harness);
+
+  return harness.run(argc, argv);
+}
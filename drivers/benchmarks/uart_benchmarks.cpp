@@ -0,0 +1,568 @@
+/**
+ * @file uart_benchmarks.cpp
+ * @author your name (you@domain.com)
+ * @brief Serial line benchmarks over a pseudo-terminal loopback
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "benchmark_harness.hpp"
+
+#include <unistd.h>
+#include <string.h>
+#include <stdlib.h>
+#include <deque>
+#include <string>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+
+#include "linux/utils/linux_io.hpp"
+#include "telemetry/telemetry.hpp"
+
+// Time any single operation may take before the run is declared failed
+constexpr uint32_t BENCHMARK_TIMEOUT_MS = 1000;
+// Timeout given to reads, some strategies only return once the line has been
+// idle for that long so it bounds their latency
+constexpr uint32_t BENCHMARK_READ_TIMEOUT_MS = 10;
+// Size of each write on bulk benchmarks
+constexpr Size_t BENCHMARK_CHUNK_SIZE = 4096;
+
+using ReadStrategy_t = int (*)(int fd, uint8_t *buffer, size_t cnt, uint32_t timeout_ms);
+
+/**
+ * @brief Sample streamed by the telemetry benchmarks
+ */
+typedef struct
+{
+  uint32_t tick;
+  int16_t accel[3];
+  int16_t gyro[3];
+  float temperature;
+  uint16_t status;
+}ImuSample_t;
+
+using ImuSchema = TelemetrySchema<&ImuSample_t::tick, &ImuSample_t::accel, &ImuSample_t::gyro,
+                                  &ImuSample_t::temperature, &ImuSample_t::status>;
+
+/**
+ * @brief Ways of sending telemetry
+ */
+typedef enum
+{
+  TELEMETRY_STAGING,    /*!< Packed by hand into a staging buffer, then written */
+  TELEMETRY_FULL,       /*!< TelemetryEncoder into pool buffers, every field */
+  TELEMETRY_DELTA,      /*!< TelemetryEncoder into pool buffers, changed fields */
+}TelemetryMode_t;
+
+/**
+ * @brief Configure a driver on a pseudo-terminal
+ * @tparam DRIVER UART or LinuxSerialFile
+ * @param driver The driver
+ * @param is_async True to use the worker threads
+ * @param is_pipelined True to return from writes before the data is sent
+ * @return true on success
+ */
+template <typename DRIVER>
+static bool configureDriver(DRIVER &driver, bool is_async, bool is_pipelined)
+{
+  const DriverSettings_t config_list[]
+  {
+    ADD_PARAMETER(COMM_PARAM_BAUD, 115200),
+    ADD_PARAMETER(COMM_WORK_ASYNC, is_async),
+    ADD_PARAMETER(COMM_WORK_PIPELINED, is_pipelined)
+  };
+  return driver.configure(config_list, sizeof(config_list)/sizeof(config_list[0])).success;
+}
+
+/**
+ * @brief Read until a number of bytes arrived, drivers may return less
+ * @tparam DRIVER UART or LinuxSerialFile
+ * @param driver The driver, in synchronous mode
+ * @param data Buffer to store the data
+ * @param byte_count Number of bytes expected
+ * @return true if every byte arrived in time
+ */
+template <typename DRIVER>
+static bool readAll(DRIVER &driver, uint8_t *data, Size_t byte_count)
+{
+  Size_t bytes_read = 0;
+
+  while(bytes_read < byte_count)
+  {
+    if(!driver.read(data + bytes_read, byte_count - bytes_read, BENCHMARK_READ_TIMEOUT_MS).success) { return false;}
+    bytes_read += driver.getBytesRead();
+  }
+  return true;
+}
+
+/**
+ * @brief Write and read back messages through an echoing peer, one at a time
+ * @tparam DRIVER UART or LinuxSerialFile
+ * @param run The run
+ * @param message_size Number of bytes per message
+ * @param is_async True to go through the worker threads
+ * @return true on success
+ */
+template <typename DRIVER>
+static bool roundTrip(BenchmarkRun &run, Size_t message_size, bool is_async)
+{
+  std::vector<uint8_t> tx_data(message_size), rx_data(message_size);
+  uint64_t start;
+  PtyPair pty;
+
+  if(!pty.open() || !pty.startEcho()) { return run.fail("Failed to set up the pseudo-terminal");}
+  DRIVER driver(pty.getName());
+  if(!configureDriver(driver, is_async, false)) { return run.fail("Failed to configure the driver");}
+  for(Size_t i = 0; i < message_size; i++) { tx_data[i] = (uint8_t) i;}
+
+  run.start();
+  for(uint32_t i = 0; i < run.iterations; i++)
+  {
+    start = BenchmarkHarness::getTimeNs();
+    if(is_async)
+    {
+      // Queue the read first so that the reception worker is already waiting
+      DriverToken read_token = driver.readAsync(rx_data.data(), message_size, BENCHMARK_TIMEOUT_MS);
+      DriverToken write_token = driver.writeAsync(tx_data.data(), message_size, BENCHMARK_TIMEOUT_MS);
+      if(!write_token.wait(BENCHMARK_TIMEOUT_MS).success) { return run.fail("Write failed");}
+      if(!read_token.wait(BENCHMARK_TIMEOUT_MS).success) { return run.fail("Read failed");}
+      if(read_token.getResult().bytes != message_size) { return run.fail("Short read");}
+    }else
+    {
+      if(!driver.write(tx_data.data(), message_size, BENCHMARK_TIMEOUT_MS).success) { return run.fail("Write failed");}
+      if(!readAll(driver, rx_data.data(), message_size)) { return run.fail("Read failed");}
+    }
+    run.addSample(BenchmarkHarness::getTimeNs() - start);
+    run.bytes += message_size;
+  }
+  run.stop();
+
+  if(memcmp(tx_data.data(), rx_data.data(), message_size) != 0) { return run.fail("Data mismatch");}
+  return true;
+}
+
+/**
+ * @brief Stream chunks to a draining peer as fast as the driver accepts them
+ * @tparam DRIVER UART or LinuxSerialFile
+ * @param run The run, each iteration is a chunk
+ * @param is_async True to queue writes on the worker thread
+ * @param is_pipelined True to return from writes before the data is sent
+ * @return true on success
+ */
+template <typename DRIVER>
+static bool bulkWrite(BenchmarkRun &run, bool is_async, bool is_pipelined)
+{
+  std::vector<uint8_t> tx_data(BENCHMARK_CHUNK_SIZE, 0x55);
+  std::deque<DriverToken> in_flight;
+  uint32_t queued = 0;
+  uint64_t start;
+  Status_t status;
+  PtyPair pty;
+
+  if(!pty.open() || !pty.startDrain()) { return run.fail("Failed to set up the pseudo-terminal");}
+  DRIVER driver(pty.getName());
+  if(!configureDriver(driver, is_async, is_pipelined)) { return run.fail("Failed to configure the driver");}
+
+  run.start();
+  while(queued < run.iterations)
+  {
+    start = BenchmarkHarness::getTimeNs();
+    if(!is_async)
+    {
+      if(!driver.write(tx_data.data(), BENCHMARK_CHUNK_SIZE, BENCHMARK_TIMEOUT_MS).success) { return run.fail("Write failed");}
+    }else
+    {
+      DriverToken token = driver.writeAsync(tx_data.data(), BENCHMARK_CHUNK_SIZE, BENCHMARK_TIMEOUT_MS);
+      status = token.ready() ? token.wait(0) : STATUS_DRV_SUCCESS;
+      if(status.code == STATUS_DRV_ERR_BUSY.code && !in_flight.empty())
+      {
+        // The queue is full, wait for the oldest write and try again
+        if(!in_flight.front().wait(BENCHMARK_TIMEOUT_MS).success) { return run.fail("Write failed");}
+        in_flight.pop_front();
+        continue;
+      }
+      if(!status.success) { return run.fail("Write failed");}
+      in_flight.push_back(token);
+    }
+    run.addSample(BenchmarkHarness::getTimeNs() - start);
+    queued++;
+  }
+  for(DriverToken &token : in_flight)
+  {
+    if(!token.wait(BENCHMARK_TIMEOUT_MS).success) { return run.fail("Write failed");}
+  }
+  run.bytes = (uint64_t) run.iterations * BENCHMARK_CHUNK_SIZE;
+  if(!pty.waitDrained(run.bytes, BENCHMARK_TIMEOUT_MS)) { return run.fail("Data did not reach the peer");}
+  run.stop();
+
+  return true;
+}
+
+/**
+ * @brief Write a message on every port of a gateway and wait for every echo,
+ *        through one multiplexer thread or the worker threads of each UART
+ * @param run The run
+ * @param port_count Number of ports
+ * @param use_mux True to serve the ports with a SerialMux
+ * @return true on success
+ */
+static bool multiPortRoundTrip(BenchmarkRun &run, uint8_t port_count, bool use_mux)
+{
+  constexpr Size_t message_size = 64;
+  std::vector<uint8_t> tx_data(message_size, 0xA5);
+  std::vector<std::vector<uint8_t>> rx_data(port_count, std::vector<uint8_t>(message_size));
+  std::vector<std::unique_ptr<PtyPair>> ptys;
+  std::vector<std::unique_ptr<UART>> uarts;
+  std::vector<DriverToken> tokens;
+  std::mutex mutex;
+  std::condition_variable condition;
+  uint64_t bytes_received = 0, start;
+  uint8_t id;
+  SerialMux mux;
+
+  // Bytes are counted as they come, the echo is checked by the UART runs
+  DriverCallback_t count_bytes = [&](Status_t status, DriverEventsList_t event, const Buffer_t data, void *user_arg) -> Status_t
+  {
+    (void) status; (void) event; (void) user_arg;
+    std::lock_guard<std::mutex> lock(mutex);
+    bytes_received += data.size();
+    condition.notify_one();
+    return STATUS_DRV_SUCCESS;
+  };
+
+  for(uint8_t i = 0; i < port_count; i++)
+  {
+    ptys.push_back(std::make_unique<PtyPair>());
+    if(!ptys[i]->open() || !ptys[i]->startEcho()) { return run.fail("Failed to set up the pseudo-terminals");}
+    uarts.push_back(std::make_unique<UART>(ptys[i]->getName()));
+    if(!configureDriver(*uarts[i], !use_mux, false)) { return run.fail("Failed to configure the driver");}
+    if(use_mux && !mux.addPort(*uarts[i], id, count_bytes).success) { return run.fail("Failed to add the port");}
+  }
+  if(use_mux && !mux.open().success) { return run.fail("Failed to open the multiplexer");}
+
+  run.start();
+  for(uint32_t i = 0; i < run.iterations; i++)
+  {
+    start = BenchmarkHarness::getTimeNs();
+    tokens.clear();
+    for(uint8_t port = 0; port < port_count; port++)
+    {
+      if(use_mux)
+      {
+        tokens.push_back(mux.write(port, tx_data.data(), message_size));
+      }else
+      {
+        tokens.push_back(uarts[port]->readAsync(rx_data[port].data(), message_size, BENCHMARK_TIMEOUT_MS));
+        tokens.push_back(uarts[port]->writeAsync(tx_data.data(), message_size, BENCHMARK_TIMEOUT_MS));
+      }
+    }
+    for(DriverToken &token : tokens)
+    {
+      if(!token.wait(BENCHMARK_TIMEOUT_MS).success) { return run.fail("Transfer failed");}
+    }
+    if(use_mux)
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      if(!condition.wait_for(lock, std::chrono::milliseconds(BENCHMARK_TIMEOUT_MS),
+        [&] { return bytes_received >= (uint64_t) (i + 1) * port_count * message_size;})) { return run.fail("Echo missing");}
+    }
+    run.addSample(BenchmarkHarness::getTimeNs() - start);
+    run.bytes += port_count * message_size;
+  }
+  run.stop();
+
+  mux.close();
+  for(uint8_t port = 0; !use_mux && port < port_count; port++)
+  {
+    if(memcmp(tx_data.data(), rx_data[port].data(), message_size) != 0) { return run.fail("Data mismatch");}
+  }
+  return true;
+}
+
+/**
+ * @brief Write and read back messages on a real port with its TX wired to its
+ *        RX, e.g. a USB adapter with a loopback plug
+ * @param run The run
+ * @param device Path to the port
+ * @param latency_timer_ms Value of COMM_PARAM_LOW_LATENCY, 16 is the default of FTDI chips
+ * @param low_latency Value of COMM_USE_LOW_LATENCY, must be 0 for a timer other than 1 ms
+ * @return true on success
+ */
+static bool loopbackRoundTrip(BenchmarkRun &run, const char *device, uint32_t latency_timer_ms, bool low_latency)
+{
+  uint8_t tx_data = 0x5A, rx_data = 0;
+  uint64_t start;
+  UART driver(device);
+  const DriverSettings_t config_list[]
+  {
+    ADD_PARAMETER(COMM_PARAM_BAUD, 115200),
+    ADD_PARAMETER(COMM_USE_LOW_LATENCY, low_latency),
+    ADD_PARAMETER(COMM_PARAM_LOW_LATENCY, latency_timer_ms)
+  };
+
+  if(!driver.configure(config_list, sizeof(config_list)/sizeof(config_list[0])).success) { return run.fail("Failed to configure the driver");}
+  // Results taken with another timer than the name says would be compared
+  if(driver.getLatencyTimerMs() != (int) latency_timer_ms) { return run.fail("The adapter did not keep the latency timer, writing it may need root");}
+  if(driver.getLowLatency() != (low_latency ? 1 : 0)) { return run.fail("The port did not take ASYNC_LOW_LATENCY");}
+  (void) driver.flush();
+
+  run.start();
+  for(uint32_t i = 0; i < run.iterations; i++)
+  {
+    start = BenchmarkHarness::getTimeNs();
+    if(!driver.write(&tx_data, 1, BENCHMARK_TIMEOUT_MS).success) { return run.fail("Write failed");}
+    if(!driver.read(&rx_data, 1, BENCHMARK_TIMEOUT_MS).success || driver.getBytesRead() != 1) { return run.fail("Read failed");}
+    run.addSample(BenchmarkHarness::getTimeNs() - start);
+    run.bytes++;
+  }
+  run.stop();
+
+  if(rx_data != tx_data) { return run.fail("Data mismatch");}
+  return true;
+}
+
+/**
+ * @brief Read bursts of NMEA sentences, by lines or a byte at a time
+ * @param run The run, each iteration is a burst of sentences
+ * @param by_line True to use readLine(), false for one read() per byte
+ * @return true on success
+ */
+static bool readSentences(BenchmarkRun &run, bool by_line)
+{
+  constexpr uint32_t sentence_count = 10;
+  const char sentence[] = "$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*47\r\n";
+  std::string burst;
+  Buffer_t line;
+  uint8_t byte;
+  uint32_t lines;
+  uint64_t start;
+  PtyPair pty;
+
+  for(uint32_t i = 0; i < sentence_count; i++) { burst += sentence;}
+  if(!pty.open()) { return run.fail("Failed to set up the pseudo-terminal");}
+  LinuxSerialFile driver(pty.getName());
+  if(!configureDriver(driver, false, false)) { return run.fail("Failed to configure the driver");}
+
+  run.start();
+  for(uint32_t i = 0; i < run.iterations; i++)
+  {
+    start = BenchmarkHarness::getTimeNs();
+    if(write(pty.getMaster(), burst.data(), burst.size()) != (ssize_t) burst.size()) { return run.fail("Write failed");}
+    for(lines = 0; lines < sentence_count;)
+    {
+      if(by_line)
+      {
+        if(!driver.readLine(line, BENCHMARK_TIMEOUT_MS).success || line.size() != sizeof(sentence) - 3) { return run.fail("Read failed");}
+        lines++;
+      }else
+      {
+        if(!driver.read(&byte, 1, BENCHMARK_TIMEOUT_MS).success) { return run.fail("Read failed");}
+        if(byte == '\n') { lines++;}
+      }
+    }
+    run.addSample(BenchmarkHarness::getTimeNs() - start);
+    run.bytes += burst.size();
+  }
+  run.stop();
+
+  return true;
+}
+
+/**
+ * @brief Log bursts of lines to a draining peer, written by the caller or
+ *        queued on an AsyncLogger, a control cycle apart
+ * @param run The run, each iteration is a burst
+ * @param use_logger True to queue the lines on an AsyncLogger
+ * @return true on success
+ */
+static bool logLines(BenchmarkRun &run, bool use_logger)
+{
+  constexpr uint32_t burst_size = 32;
+  constexpr uint32_t cycle_us = 1000;
+  const char format[] = "cycle %u took %.3f ms, state %s, error 0x%08x\r\n";
+  AsyncLoggerStats_t stats;
+  char line[128];
+  uint64_t start;
+  int size;
+  PtyPair pty;
+
+  if(!pty.open() || !pty.startDrain()) { return run.fail("Failed to set up the pseudo-terminal");}
+  LinuxSerialFile driver(pty.getName());
+  if(!configureDriver(driver, false, false)) { return run.fail("Failed to configure the driver");}
+  AsyncLogger logger(driver);
+  if(use_logger && !logger.open().success) { return run.fail("Failed to open the logger");}
+
+  run.start();
+  for(uint32_t i = 0; i < run.iterations; i++)
+  {
+    start = BenchmarkHarness::getTimeNs();
+    for(uint32_t j = 0; j < burst_size; j++)
+    {
+      if(use_logger)
+      {
+        (void) logger.log(LOG_LEVEL_INFO, format, i, 0.125 * j, "running", j);
+      }else
+      {
+        size = snprintf(line, sizeof(line), format, i, 0.125 * j, "running", j);
+        if(!driver.write((uint8_t *) line, size, BENCHMARK_TIMEOUT_MS).success) { return run.fail("Write failed");}
+        run.bytes += size;
+      }
+    }
+    run.addSample(BenchmarkHarness::getTimeNs() - start);
+    usleep(cycle_us);
+  }
+  if(use_logger)
+  {
+    logger.flush();
+    logger.getStats(stats);
+    run.bytes = stats.bytes;
+    run.dropped = stats.dropped;
+  }
+  if(!pty.waitDrained(run.bytes, BENCHMARK_TIMEOUT_MS)) { return run.fail("Data did not reach the peer");}
+  run.stop();
+
+  return true;
+}
+
+/**
+ * @brief Stream IMU samples to a draining peer
+ * @param run The run, each iteration is a sample
+ * @param mode How samples are serialized
+ * @return true on success
+ */
+static bool telemetryStream(BenchmarkRun &run, TelemetryMode_t mode)
+{
+  BufferPool<ImuSchema::FRAME_SIZE_MAX, 4> pool;
+  TelemetryEncoder<ImuSchema> encoder(1);
+  ImuSample_t sample = {0, {12, -40, 980}, {0, 3, -1}, 36.5f, 0x0001};
+  uint8_t staging[TELEMETRY_HEADER_SIZE + ImuSchema::PAYLOAD_SIZE], *cursor;
+  uint64_t start;
+  PtyPair pty;
+
+  if(!pty.open() || !pty.startDrain()) { return run.fail("Failed to set up the pseudo-terminal");}
+  UART driver(pty.getName());
+  if(!configureDriver(driver, false, false)) { return run.fail("Failed to configure the driver");}
+  if(mode == TELEMETRY_DELTA) { encoder.setDelta(50);}
+
+  run.start();
+  for(uint32_t i = 0; i < run.iterations; i++)
+  {
+    // A sensor at rest: noise on the low bits, a slow temperature drift
+    sample.tick++;
+    sample.accel[i % 3] += (i & 4) ? 1 : -1;
+    sample.gyro[(i + 1) % 3] += (i & 8) ? 1 : -1;
+    if(i % 64 == 0) { sample.temperature += 0.0625f;}
+
+    start = BenchmarkHarness::getTimeNs();
+    if(mode == TELEMETRY_STAGING)
+    {
+      cursor = staging;
+      *cursor++ = 1;
+      *cursor++ = 0;
+      memcpy(cursor, &i, 2);
+      cursor += 2;
+      memcpy(cursor, &sample.tick, 4);
+      cursor += 4;
+      memcpy(cursor, sample.accel, 6);
+      cursor += 6;
+      memcpy(cursor, sample.gyro, 6);
+      cursor += 6;
+      memcpy(cursor, &sample.temperature, 4);
+      cursor += 4;
+      memcpy(cursor, &sample.status, 2);
+      cursor += 2;
+      if(!driver.write(staging, cursor - staging, BENCHMARK_TIMEOUT_MS).success) { return run.fail("Write failed");}
+      run.bytes += cursor - staging;
+    }else
+    {
+      if(!encoder.send(driver, pool, sample, BENCHMARK_TIMEOUT_MS).wait(BENCHMARK_TIMEOUT_MS).success) { return run.fail("Write failed");}
+    }
+    run.addSample(BenchmarkHarness::getTimeNs() - start);
+  }
+  if(mode != TELEMETRY_STAGING) { run.bytes = encoder.getStats().bytes;}
+  if(!pty.waitDrained(run.bytes, BENCHMARK_TIMEOUT_MS)) { return run.fail("Data did not reach the peer");}
+  run.stop();
+
+  return true;
+}
+
+/**
+ * @brief Time one of the read strategies of linux_io on raw file descriptors
+ * @param run The run
+ * @param strategy The read function
+ * @param message_size Number of bytes per message
+ * @return true on success
+ */
+static bool readStrategy(BenchmarkRun &run, ReadStrategy_t strategy, Size_t message_size)
+{
+  std::vector<uint8_t> tx_data(message_size, 0xAA), rx_data(message_size);
+  int bytes_read, result;
+  uint64_t start;
+  PtyPair pty;
+
+  if(!pty.open()) { return run.fail("Failed to set up the pseudo-terminal");}
+
+  run.start();
+  for(uint32_t i = 0; i < run.iterations; i++)
+  {
+    start = BenchmarkHarness::getTimeNs();
+    if(write(pty.getMaster(), tx_data.data(), message_size) != (ssize_t) message_size) { return run.fail("Write failed");}
+    for(bytes_read = 0; bytes_read < (int) message_size; bytes_read += result)
+    {
+      result = strategy(pty.getSlave(), rx_data.data() + bytes_read, message_size - bytes_read, BENCHMARK_READ_TIMEOUT_MS);
+      if(result <= 0) { return run.fail("Read failed");}
+    }
+    run.addSample(BenchmarkHarness::getTimeNs() - start);
+    run.bytes += message_size;
+  }
+  run.stop();
+
+  return true;
+}
+
+/**
+ * @brief Register the serial line benchmarks
+ * @param harness The harness
+ */
+void registerUartBenchmarks(BenchmarkHarness &harness)
+{
+  harness.add("uart/sync/roundtrip/1", [](BenchmarkRun &run) { return roundTrip<UART>(run, 1, false);}, 200);
+  harness.add("uart/sync/roundtrip/64", [](BenchmarkRun &run) { return roundTrip<UART>(run, 64, false);}, 200);
+  harness.add("uart/async/roundtrip/1", [](BenchmarkRun &run) { return roundTrip<UART>(run, 1, true);}, 2000);
+  harness.add("uart/async/roundtrip/64", [](BenchmarkRun &run) { return roundTrip<UART>(run, 64, true);}, 2000);
+  harness.add("uart/sync/bulk/4096", [](BenchmarkRun &run) { return bulkWrite<UART>(run, false, false);}, 1000);
+  harness.add("uart/async/bulk/4096", [](BenchmarkRun &run) { return bulkWrite<UART>(run, true, false);}, 1000);
+  harness.add("uart/pipelined/bulk/4096", [](BenchmarkRun &run) { return bulkWrite<UART>(run, true, true);}, 1000);
+
+  harness.add("uart/async/roundtrip/16x64", [](BenchmarkRun &run) { return multiPortRoundTrip(run, 16, false);}, 500);
+  harness.add("serial_mux/roundtrip/16x64", [](BenchmarkRun &run) { return multiPortRoundTrip(run, 16, true);}, 500);
+
+  harness.add("serial/sync/roundtrip/1", [](BenchmarkRun &run) { return roundTrip<LinuxSerialFile>(run, 1, false);}, 2000);
+  harness.add("serial/sync/roundtrip/64", [](BenchmarkRun &run) { return roundTrip<LinuxSerialFile>(run, 64, false);}, 2000);
+  harness.add("serial/async/roundtrip/64", [](BenchmarkRun &run) { return roundTrip<LinuxSerialFile>(run, 64, true);}, 2000);
+  harness.add("serial/sync/bulk/4096", [](BenchmarkRun &run) { return bulkWrite<LinuxSerialFile>(run, false, false);}, 1000);
+  harness.add("serial/async/bulk/4096", [](BenchmarkRun &run) { return bulkWrite<LinuxSerialFile>(run, true, false);}, 1000);
+  harness.add("serial/readline/nmea", [](BenchmarkRun &run) { return readSentences(run, true);}, 2000);
+  harness.add("serial/read_bytewise/nmea", [](BenchmarkRun &run) { return readSentences(run, false);}, 200);
+  harness.add("serial/sync/log_burst/32", [](BenchmarkRun &run) { return logLines(run, false);}, 200);
+  harness.add("logger/async/log_burst/32", [](BenchmarkRun &run) { return logLines(run, true);}, 200);
+  harness.add("uart/telemetry/staging/imu", [](BenchmarkRun &run) { return telemetryStream(run, TELEMETRY_STAGING);}, 2000);
+  harness.add("uart/telemetry/full/imu", [](BenchmarkRun &run) { return telemetryStream(run, TELEMETRY_FULL);}, 2000);
+  harness.add("uart/telemetry/delta/imu", [](BenchmarkRun &run) { return telemetryStream(run, TELEMETRY_DELTA);}, 2000);
+
+  harness.add("read_strategy/poll_first_byte/64", [](BenchmarkRun &run) { return readStrategy(run, readOnTimeoutSyscall, 64);}, 2000);
+  harness.add("read_strategy/sleep_until_count/64", [](BenchmarkRun &run) { return readStrategy(run, readOnTimeoutSyscall2, 64);}, 200);
+  harness.add("read_strategy/poll_with_timeout/64", [](BenchmarkRun &run) { return readStrategy(run, readOnTimeoutSyscall3, 64);}, 200);
+
+  // Needs hardware, BENCHMARK_UART_LOOPBACK names a port with TX wired to RX
+  const char *loopback = getenv("BENCHMARK_UART_LOOPBACK");
+  if(loopback != nullptr)
+  {
+    harness.add("uart/loopback/latency_16ms/roundtrip/1", [loopback](BenchmarkRun &run) { return loopbackRoundTrip(run, loopback, 16, false);}, 200);
+    harness.add("uart/loopback/latency_1ms/roundtrip/1", [loopback](BenchmarkRun &run) { return loopbackRoundTrip(run, loopback, 1, true);}, 200);
+  }
+}
@@ -33,6 +33,12 @@ const DriverSettings_t g_uart_config_list[]
 };
 uint8_t g_uart_config_list_size = sizeof(g_uart_config_list)/sizeof(g_uart_config_list[0]);
 
+/**
+ * @brief Buffers handed to the uart port, the driver keeps them alive until
+ *        the asynchronous write is done
+ */
+BufferPool<32, 4> g_buffer_pool;
+
 
 /**
  * @brief Example code that prints a Hello World message on a uart port
@@ -41,7 +47,8 @@ AP_MAIN()
 {
   UART my_serial(handle);
   SPT my_timer(SOFTWARE_TIMER_SECONDS);
-  uint8_t message[] = "Hello world!!!\r\n";
+  const char text[] = "Hello world!!!\r\n";
+  PoolBuffer message;
   Status_t status;
 
   status = my_serial.configure(g_uart_config_list, g_uart_config_list_size);
@@ -53,8 +60,15 @@ AP_MAIN()
 
   while(true)
   {
+    message = g_buffer_pool.acquire(strlen(text));
+    if(!message.valid())
+    {
+      errorHandler(STATUS_DRV_ERR_BUSY);
+      return STATUS_DRV_ERR_BUSY.code; // Should not get here
+    }
+    memcpy(message.data(), text, message.size());
     status = my_serial.write(message);
-    // status = my_serial.write(message, strlen((char *)message)); // Another write format
+    // status = my_serial.write(message.data(), message.size()); // Another write format
     if(!status.success)
     {
       errorHandler(status);
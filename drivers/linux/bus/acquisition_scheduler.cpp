@@ -0,0 +1,261 @@
+/**
+ * @file acquisition_scheduler.cpp
+ * @author your name (you@domain.com)
+ * @brief Periodic sampling of devices on shared buses
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "linux/bus/acquisition_scheduler.hpp"
+
+#include <string.h>
+#include <chrono>
+#include <thread>
+
+/**
+ * @brief A sensor and the transaction it keeps scheduled, only the bus
+ *        worker touches the schedule once started
+ */
+struct AcquisitionSensor
+{
+  AcquisitionSensor(AcquisitionScheduler &scheduler, const BusDevice &bus_device) : owner(scheduler), device(bus_device) {}
+
+  AcquisitionScheduler &owner;
+  BusDevice device;
+  BusSegment_t segments[2];
+  uint8_t segment_count;
+  uint8_t command[ACQUISITION_MAX_COMMAND_SIZE];
+  uint8_t rx_data[ACQUISITION_MAX_SAMPLE_SIZE];
+  uint16_t sample_size;
+  uint64_t period_ns;
+  uint64_t phase_ns;
+  uint64_t due_ns;
+  uint32_t sequence;
+  SpscRing<AcquisitionSample_t, ACQUISITION_RING_SIZE> ring;
+  std::atomic<uint64_t> samples;
+  std::atomic<uint64_t> overruns;
+  std::atomic<uint64_t> misses;
+  std::atomic<uint64_t> errors;
+  std::atomic<uint64_t> jitter_max_ns;
+  std::atomic<uint64_t> jitter_sum_ns;
+};
+
+/**
+ * @brief Constructor
+ */
+AcquisitionScheduler::AcquisitionScheduler()
+{
+  m_running = false;
+  m_in_flight = 0;
+}
+
+/**
+ * @brief Destructor, stops sampling
+ */
+AcquisitionScheduler::~AcquisitionScheduler()
+{
+  stop();
+  for(AcquisitionSensor_t *sensor : m_sensors) { delete sensor;}
+}
+
+/**
+ * @brief Add a sensor, call before start()
+ * @param device The device, its bus must be open before start()
+ * @param command Bytes written before each sample, copied, may be nullptr
+ *        if command_size is 0
+ * @param command_size Number of bytes of the command
+ * @param sample_size Number of bytes read for each sample
+ * @param period_us Time between two samples in microseconds
+ * @param sensor_id Storage for the id of the sensor
+ * @param phase_us Offset of the samples from the common origin, spreads
+ *        sensors with related periods over time
+ * @return Status_t
+ */
+Status_t AcquisitionScheduler::addSensor(const BusDevice &device, const uint8_t *command, uint8_t command_size, uint16_t sample_size,
+                                         uint32_t period_us, uint16_t &sensor_id, uint32_t phase_us)
+{
+  AcquisitionSensor_t *sensor;
+
+  if(m_running) { return STATUS_DRV_ERR_BUSY;}
+  if(command == nullptr && command_size != 0) { return STATUS_DRV_NULL_POINTER;}
+  if(command_size > ACQUISITION_MAX_COMMAND_SIZE || sample_size == 0 || sample_size > ACQUISITION_MAX_SAMPLE_SIZE)
+  {
+    return STATUS_DRV_ERR_PARAM_SIZE;
+  }
+  if(period_us == 0 || m_sensors.size() >= UINT16_MAX) { return STATUS_DRV_ERR_PARAM;}
+
+  sensor = new AcquisitionSensor_t(*this, device);
+  if(command_size != 0) { memcpy(sensor->command, command, command_size);}
+  sensor->segment_count = 0;
+  if(command_size != 0) { sensor->segments[sensor->segment_count++] = {sensor->command, nullptr, command_size};}
+  sensor->segments[sensor->segment_count++] = {nullptr, sensor->rx_data, sample_size};
+  sensor->sample_size = sample_size;
+  sensor->period_ns = (uint64_t) period_us * 1000;
+  sensor->phase_ns = (uint64_t) phase_us * 1000;
+  sensor->due_ns = 0;
+  sensor->sequence = 0;
+  sensor->samples = 0;
+  sensor->overruns = 0;
+  sensor->misses = 0;
+  sensor->errors = 0;
+  sensor->jitter_max_ns = 0;
+  sensor->jitter_sum_ns = 0;
+
+  sensor_id = (uint16_t) m_sensors.size();
+  m_sensors.push_back(sensor);
+  return STATUS_DRV_SUCCESS;
+}
+
+/**
+ * @brief Start sampling, every sensor is due for the first time at the same
+ *        origin plus its phase
+ * @return Status_t
+ */
+Status_t AcquisitionScheduler::start()
+{
+  uint64_t origin;
+  Status_t status;
+
+  if(m_running) { return STATUS_DRV_ERR_BUSY;}
+  if(m_sensors.empty()) { return STATUS_DRV_NOT_CONFIGURED;}
+
+  m_running = true;
+  origin = LinuxBus::getTimeNs() + ACQUISITION_START_DELAY_NS;
+  for(AcquisitionSensor_t *sensor : m_sensors)
+  {
+    // scheduleNext() adds a period
+    sensor->due_ns = origin + sensor->phase_ns - sensor->period_ns;
+    sensor->sequence = UINT32_MAX;
+    m_in_flight++;
+    status = scheduleNext(*sensor);
+    if(!status.success)
+    {
+      m_in_flight--;
+      stop();
+      return status;
+    }
+  }
+  return STATUS_DRV_SUCCESS;
+}
+
+/**
+ * @brief Stop sampling, returns once no transaction is left on the buses,
+ *        samples already stored can still be read
+ */
+void AcquisitionScheduler::stop()
+{
+  m_running = false;
+  // A completion running now may schedule once more, cancel until none is left
+  while(m_in_flight.load() > 0)
+  {
+    for(AcquisitionSensor_t *sensor : m_sensors) { (void) sensor->device.getBus().cancel(sensor);}
+    if(m_in_flight.load() > 0) { std::this_thread::sleep_for(std::chrono::microseconds(100));}
+  }
+}
+
+/**
+ * @brief Take the oldest sample of a sensor
+ * @param sensor_id Id given by addSensor()
+ * @param sample Storage for the sample
+ * @return true if there was one
+ */
+bool AcquisitionScheduler::getSample(uint16_t sensor_id, AcquisitionSample_t &sample)
+{
+  if(sensor_id >= m_sensors.size()) { return false;}
+  return m_sensors[sensor_id]->ring.pop(sample);
+}
+
+/**
+ * @brief Get the counters of a sensor
+ * @param sensor_id Id given by addSensor()
+ * @param stats Storage for the counters
+ * @return Status_t
+ */
+Status_t AcquisitionScheduler::getStats(uint16_t sensor_id, AcquisitionStats_t &stats)
+{
+  AcquisitionSensor_t *sensor;
+
+  if(sensor_id >= m_sensors.size()) { return STATUS_DRV_ERR_PARAM;}
+  sensor = m_sensors[sensor_id];
+  stats.samples = sensor->samples.load(std::memory_order_relaxed);
+  stats.overruns = sensor->overruns.load(std::memory_order_relaxed);
+  stats.misses = sensor->misses.load(std::memory_order_relaxed);
+  stats.errors = sensor->errors.load(std::memory_order_relaxed);
+  stats.jitter_max_ns = sensor->jitter_max_ns.load(std::memory_order_relaxed);
+  stats.jitter_sum_ns = sensor->jitter_sum_ns.load(std::memory_order_relaxed);
+  return STATUS_DRV_SUCCESS;
+}
+
+/**
+ * @brief Schedule the next sample of a sensor, periods already over are
+ *        skipped and counted as misses
+ * @param sensor The sensor
+ * @return Status_t
+ */
+Status_t AcquisitionScheduler::scheduleNext(AcquisitionSensor_t &sensor)
+{
+  uint64_t now = LinuxBus::getTimeNs();
+  uint64_t skipped;
+
+  sensor.due_ns += sensor.period_ns;
+  sensor.sequence++;
+  if(sensor.due_ns + sensor.period_ns <= now)
+  {
+    skipped = (now - sensor.due_ns) / sensor.period_ns;
+    sensor.due_ns += skipped * sensor.period_ns;
+    sensor.sequence += (uint32_t) skipped;
+    sensor.misses.fetch_add(skipped, std::memory_order_relaxed);
+  }
+  // Late past the next due time, the sample is dropped rather than delay it
+  return sensor.device.getBus().schedule(sensor.device, sensor.segments, sensor.segment_count, sensor.due_ns,
+                                         sensor.due_ns + sensor.period_ns - 1, completeSample, &sensor);
+}
+
+/**
+ * @brief Called on the bus worker when a sample completes, stores it and
+ *        schedules the next one
+ * @param status Status of the transaction
+ * @param start_ns Time it started
+ * @param user_arg The sensor
+ */
+void AcquisitionScheduler::completeSample(Status_t status, uint64_t start_ns, void *user_arg)
+{
+  AcquisitionSensor_t &sensor = *static_cast<AcquisitionSensor_t *>(user_arg);
+  AcquisitionScheduler &owner = sensor.owner;
+  AcquisitionSample_t sample;
+  uint64_t jitter;
+
+  if(status.success)
+  {
+    sample.due_ns = sensor.due_ns;
+    sample.start_ns = start_ns;
+    sample.end_ns = LinuxBus::getTimeNs();
+    sample.sequence = sensor.sequence;
+    sample.size = sensor.sample_size;
+    memcpy(sample.data, sensor.rx_data, sensor.sample_size);
+    sensor.samples.fetch_add(1, std::memory_order_relaxed);
+    if(!sensor.ring.push(sample)) { sensor.overruns.fetch_add(1, std::memory_order_relaxed);}
+    jitter = start_ns > sensor.due_ns ? start_ns - sensor.due_ns : 0;
+    sensor.jitter_sum_ns.fetch_add(jitter, std::memory_order_relaxed);
+    if(jitter > sensor.jitter_max_ns.load(std::memory_order_relaxed))
+    {
+      sensor.jitter_max_ns.store(jitter, std::memory_order_relaxed);
+    }
+  }else if(status.code == ERR_TIMEOUT)
+  {
+    sensor.misses.fetch_add(1, std::memory_order_relaxed);
+  }else if(owner.m_running)
+  {
+    sensor.errors.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  if(owner.m_running)
+  {
+    if(owner.scheduleNext(sensor).success) { return;}
+    sensor.errors.fetch_add(1, std::memory_order_relaxed);
+  }
+  owner.m_in_flight--;
+}
@@ -0,0 +1,129 @@
+/**
+ * @file acquisition_scheduler.hpp
+ * @author your name (you@domain.com)
+ * @brief Periodic sampling of devices on shared buses
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef DRIVERS_LINUX_BUS_ACQUISITION_SCHEDULER_HPP
+#define DRIVERS_LINUX_BUS_ACQUISITION_SCHEDULER_HPP
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <atomic>
+#include <vector>
+
+#include "commons.hpp"
+#include "com_spsc_ring.hpp"
+#include "linux/bus/linux_bus.hpp"
+#if __has_include("setup.hpp")
+#include "setup.hpp"
+#endif
+
+// Bytes of the command sent before each sample, e.g. a register address
+#ifndef ACQUISITION_MAX_COMMAND_SIZE
+#define ACQUISITION_MAX_COMMAND_SIZE                                           4
+#endif
+
+// Bytes of a sample
+#ifndef ACQUISITION_MAX_SAMPLE_SIZE
+#define ACQUISITION_MAX_SAMPLE_SIZE                                           32
+#endif
+
+// Samples buffered per sensor, a power of two
+#ifndef ACQUISITION_RING_SIZE
+#define ACQUISITION_RING_SIZE                                                256
+#endif
+
+// Time between start() and the first samples, so that every sensor is
+// scheduled before the first one is due
+#ifndef ACQUISITION_START_DELAY_NS
+#define ACQUISITION_START_DELAY_NS                                       1000000
+#endif
+
+/**
+ * @brief A sample and when it was taken, times on the LinuxBus::getTimeNs()
+ *        clock
+ */
+typedef struct
+{
+  uint64_t due_ns;        /*!< Time the sample was scheduled for */
+  uint64_t start_ns;      /*!< Time the transaction started */
+  uint64_t end_ns;        /*!< Time the transaction completed */
+  uint32_t sequence;      /*!< Index of the period, a gap means samples were lost */
+  uint16_t size;
+  uint8_t data[ACQUISITION_MAX_SAMPLE_SIZE];
+}AcquisitionSample_t;
+
+/**
+ * @brief Counters of a sensor
+ */
+typedef struct
+{
+  uint64_t samples;       /*!< Samples taken */
+  uint64_t overruns;      /*!< Samples taken but lost because nobody emptied the ring */
+  uint64_t misses;        /*!< Periods skipped because the bus was late */
+  uint64_t errors;        /*!< Transactions that failed */
+  uint64_t jitter_max_ns; /*!< Largest delay between due and start */
+  uint64_t jitter_sum_ns; /*!< Sum of the delays, divide by samples for the mean */
+}AcquisitionStats_t;
+
+typedef struct AcquisitionSensor AcquisitionSensor_t;
+
+/**
+ * @brief Samples devices at fixed rates on the workers of their buses
+ *
+ * @note No thread is added, each sensor keeps one transaction scheduled on
+ *       its bus, released at the time the sample is due and dropped if it
+ *       cannot start before the next one is due. The bus completes it on
+ *       its worker, which stores the sample and schedules the next one.
+ *       Due times are multiples of the period from a common origin, so
+ *       they do not drift. Samples are read back from a lock-free ring per
+ *       sensor, getSample() must be called from a single thread per sensor.
+ *
+ * @code
+ * LinuxIicBus bus("/dev/i2c-1");
+ * bus.open();
+ * AcquisitionScheduler acquisition;
+ * uint8_t reg = 0x3B;
+ * uint16_t imu;
+ * acquisition.addSensor(BusDevice(bus, 0x68 << 1), &reg, 1, 6, 250, imu);  // 4 kHz
+ * acquisition.start();
+ * AcquisitionSample_t sample;
+ * while(acquisition.getSample(imu, sample)) { ... }
+ * @endcode
+ */
+class AcquisitionScheduler
+{
+public:
+  AcquisitionScheduler();
+  ~AcquisitionScheduler();
+
+  Status_t addSensor(const BusDevice &device, const uint8_t *command, uint8_t command_size, uint16_t sample_size,
+                     uint32_t period_us, uint16_t &sensor_id, uint32_t phase_us = 0);
+
+  Status_t start();
+
+  void stop();
+
+  bool isRunning() { return m_running.load(std::memory_order_relaxed);}
+
+  bool getSample(uint16_t sensor_id, AcquisitionSample_t &sample);
+
+  Status_t getStats(uint16_t sensor_id, AcquisitionStats_t &stats);
+
+private:
+  std::vector<AcquisitionSensor_t *> m_sensors;
+  std::atomic<bool> m_running;
+  std::atomic<uint32_t> m_in_flight;
+
+  Status_t scheduleNext(AcquisitionSensor_t &sensor);
+
+  static void completeSample(Status_t status, uint64_t start_ns, void *user_arg);
+};
+
+#endif /* DRIVERS_LINUX_BUS_ACQUISITION_SCHEDULER_HPP */
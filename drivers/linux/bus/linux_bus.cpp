@@ -0,0 +1,906 @@
+/**
+ * @file linux_bus.cpp
+ * @author your name (you@domain.com)
+ * @brief Shared IIC and SPI buses, one file and one worker per bus
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "linux/bus/linux_bus.hpp"
+
+#include <algorithm>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/prctl.h>
+#include <sys/ioctl.h>
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+#include <linux/spi/spidev.h>
+
+#include "driver_base/driver_trace.hpp"
+
+/**
+ * @brief Order of the queue, true when a is less urgent than b
+ * @param a A transaction
+ * @param b Another transaction
+ * @return bool
+ */
+static bool isLessUrgent(const BusTransaction_t &a, const BusTransaction_t &b)
+{
+  if(a.priority != b.priority) { return a.priority < b.priority;}
+  if(a.deadline_ns != b.deadline_ns) { return a.deadline_ns > b.deadline_ns;}
+  return a.sequence > b.sequence;
+}
+
+/**
+ * @brief Get the number of bytes moved by a transaction
+ * @param transaction The transaction
+ * @return Size_t
+ */
+static Size_t getByteCount(const BusTransaction_t &transaction)
+{
+  Size_t byte_count = 0;
+
+  for(uint8_t i = 0; i < transaction.segment_count; i++) { byte_count += transaction.segments[i].size;}
+  return byte_count;
+}
+
+/**
+ * @brief Order of the scheduled transactions, true when a is released
+ *        after b
+ * @param a A transaction
+ * @param b Another transaction
+ * @return bool
+ */
+static bool isReleasedLater(const BusTransaction_t &a, const BusTransaction_t &b)
+{
+  if(a.release_ns != b.release_ns) { return a.release_ns > b.release_ns;}
+  return a.sequence > b.sequence;
+}
+
+/**
+ * @brief Constructor
+ * @param path Path of the bus, e.g. "/dev/i2c-1"
+ * @param name Name of the worker thread
+ */
+LinuxBus::LinuxBus(const char *path, const char *name)
+{
+  m_path = path;
+  m_name = name;
+  m_attributes = {THREAD_POLICY_DEFAULT, 0, 0};
+  m_use_default_attributes = true;
+  m_linux_handle = -1;
+  m_max_segments = 1;
+  m_max_bytes = UINT32_MAX;
+  m_thread = nullptr;
+  m_terminate = false;
+  m_sequence = 0;
+  m_queue.reserve(LINUX_BUS_QUEUE_SIZE);
+  m_scheduled.reserve(LINUX_BUS_QUEUE_SIZE);
+  memset(&m_stats, 0, sizeof(m_stats));
+}
+
+/**
+ * @brief Destructor, transactions still queued fail
+ *
+ * @note The final classes close the bus in their own destructor, the worker
+ *       calls execute() and must be stopped while they still exist.
+ */
+LinuxBus::~LinuxBus()
+{
+  close();
+}
+
+/**
+ * @brief Open the bus and start its worker
+ * @return Status_t
+ */
+Status_t LinuxBus::open()
+{
+  Status_t status;
+
+  if(m_thread != nullptr) { return STATUS_DRV_SUCCESS;}
+  status = setUp();
+  if(!status.success) { return status;}
+  m_terminate = false;
+  m_thread = new std::thread(&LinuxBus::workerThread, this);
+  if(m_use_default_attributes) { m_attributes = LinuxThreadAttributes::getDefaults();}
+  status = LinuxThreadAttributes::apply(*m_thread, m_attributes);
+  if(!status.success)
+  {
+    close();
+    return status;
+  }
+  return STATUS_DRV_SUCCESS;
+}
+
+/**
+ * @brief Set the scheduling of the worker, must be called before open(),
+ *        LinuxThreadAttributes::getDefaults() is used otherwise
+ * @param attributes Policy, priority and CPU affinity
+ */
+void LinuxBus::setThreadAttributes(const LinuxThreadAttributes_t &attributes)
+{
+  m_attributes = attributes;
+  m_use_default_attributes = false;
+}
+
+/**
+ * @brief Stop the worker and close the bus, queued transactions fail
+ */
+void LinuxBus::close()
+{
+  std::vector<BusTransaction_t> pending;
+  Status_t status;
+
+  if(m_thread != nullptr)
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_terminate = true;
+    }
+    m_condition.notify_one();
+    m_thread->join();
+    delete m_thread;
+    m_thread = nullptr;
+  }
+
+  // Taken after the worker stopped, its last completions may have queued more
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    pending.swap(m_queue);
+    pending.insert(pending.end(), m_scheduled.begin(), m_scheduled.end());
+    m_scheduled.clear();
+    m_queue.reserve(LINUX_BUS_QUEUE_SIZE);
+  }
+  SET_STATUS(status, false, SRC_DRIVER, ERR_FAILED, (char *)"The bus was closed.\r\n");
+  for(const BusTransaction_t &transaction : pending) { finish(transaction, status, getTimeNs());}
+  tearDown();
+}
+
+/**
+ * @brief Close the files of the bus, called once the worker stopped
+ */
+void LinuxBus::tearDown()
+{
+  if(m_linux_handle >= 0) { (void) ::close(m_linux_handle);}
+  m_linux_handle = -1;
+}
+
+/**
+ * @brief Tell if a device address exists on the bus
+ * @param address The address
+ * @return Status_t
+ */
+Status_t LinuxBus::checkAddress(uint16_t address)
+{
+  (void) address;
+  return STATUS_DRV_SUCCESS;
+}
+
+/**
+ * @brief Tell if the bus can send two transactions in one submission, the
+ *        merge-safe and failure checks aside
+ * @param first First transaction of the submission
+ * @param other Transaction to add to it
+ * @return bool
+ */
+bool LinuxBus::isCompatible(const BusTransaction_t &first, const BusTransaction_t &other)
+{
+  (void) first;
+  (void) other;
+  return true;
+}
+
+/**
+ * @brief Queue a transaction
+ * @param device The device, gives the address, clock and priority
+ * @param segments The segments, copied, their buffers must stay valid until
+ *        the transaction completes
+ * @param count Number of segments, up to LINUX_BUS_MAX_SEGMENTS
+ * @param deadline_ns Latest start on the getTimeNs() clock, 0 for none
+ * @return DriverToken completed with the transaction
+ */
+DriverToken LinuxBus::submit(const BusDevice &device, const BusSegment_t *segments, uint8_t count, uint64_t deadline_ns)
+{
+  BusTransaction_t transaction;
+  DriverToken token;
+  Status_t status;
+
+  if(segments == nullptr) { return DriverToken(STATUS_DRV_NULL_POINTER);}
+  if(count == 0 || count > LINUX_BUS_MAX_SEGMENTS) { return DriverToken(STATUS_DRV_ERR_PARAM_SIZE);}
+
+  memcpy(transaction.segments, segments, count * sizeof(BusSegment_t));
+  transaction.segment_count = count;
+  transaction.priority = device.getPriority();
+  transaction.address = device.getAddress();
+  transaction.speed_hz = device.getSpeed();
+  transaction.is_mergeable = device.isMergeable();
+  transaction.release_ns = 0;
+  transaction.deadline_ns = deadline_ns == 0 ? UINT64_MAX : deadline_ns;
+  transaction.function = nullptr;
+  transaction.user_arg = nullptr;
+
+  token = DriverToken::create(EVENT_READ_WRITE, Buffer_t());
+  if(!token.valid()) { return token;}
+  transaction.completion = token.attach();
+
+  status = enqueue(transaction);
+  if(!status.success)
+  {
+    DriverToken::complete(transaction.completion, {0, status, 0, EVENT_READ_WRITE});
+  }
+  return token;
+}
+
+/**
+ * @brief Queue a transaction to start at a given time, its outcome goes to
+ *        a function called on the worker instead of a token
+ * @param device The device, gives the address, clock and priority
+ * @param segments The segments, copied, their buffers must stay valid until
+ *        the transaction completes
+ * @param count Number of segments, up to LINUX_BUS_MAX_SEGMENTS
+ * @param release_ns Earliest start on the getTimeNs() clock, 0 for now
+ * @param deadline_ns Latest start on the getTimeNs() clock, 0 for none
+ * @param function Called once the transaction completes or is dropped
+ * @param user_arg Argument for the function
+ * @return Status_t
+ */
+Status_t LinuxBus::schedule(const BusDevice &device, const BusSegment_t *segments, uint8_t count, uint64_t release_ns,
+                            uint64_t deadline_ns, BusCompletion_t function, void *user_arg)
+{
+  BusTransaction_t transaction;
+
+  if(segments == nullptr || function == nullptr) { return STATUS_DRV_NULL_POINTER;}
+  if(count == 0 || count > LINUX_BUS_MAX_SEGMENTS) { return STATUS_DRV_ERR_PARAM_SIZE;}
+
+  memcpy(transaction.segments, segments, count * sizeof(BusSegment_t));
+  transaction.segment_count = count;
+  transaction.priority = device.getPriority();
+  transaction.address = device.getAddress();
+  transaction.speed_hz = device.getSpeed();
+  transaction.is_mergeable = device.isMergeable();
+  transaction.release_ns = release_ns;
+  transaction.deadline_ns = deadline_ns == 0 ? UINT64_MAX : deadline_ns;
+  transaction.completion = nullptr;
+  transaction.function = function;
+  transaction.user_arg = user_arg;
+  return enqueue(transaction);
+}
+
+/**
+ * @brief Drop the scheduled transactions that did not start yet, their
+ *        functions are called with an error
+ * @param user_arg Argument the transactions were scheduled with
+ * @return uint32_t Number of transactions dropped
+ */
+uint32_t LinuxBus::cancel(void *user_arg)
+{
+  std::vector<BusTransaction_t> cancelled;
+  Status_t status;
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for(std::vector<BusTransaction_t> *queue : {&m_queue, &m_scheduled})
+    {
+      auto last = std::partition(queue->begin(), queue->end(), [user_arg](const BusTransaction_t &transaction)
+      {
+        return transaction.function == nullptr || transaction.user_arg != user_arg;
+      });
+      cancelled.insert(cancelled.end(), last, queue->end());
+      queue->erase(last, queue->end());
+    }
+    std::make_heap(m_queue.begin(), m_queue.end(), isLessUrgent);
+    std::make_heap(m_scheduled.begin(), m_scheduled.end(), isReleasedLater);
+  }
+
+  SET_STATUS(status, false, SRC_DRIVER, ERR_FAILED, (char *)"The transaction was cancelled.\r\n");
+  for(const BusTransaction_t &transaction : cancelled) { finish(transaction, status, getTimeNs());}
+  return (uint32_t) cancelled.size();
+}
+
+/**
+ * @brief Get the activity of the bus
+ * @return BusStats_t
+ */
+BusStats_t LinuxBus::getStats()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_stats;
+}
+
+/**
+ * @brief Get the value of the clock used for releases and deadlines
+ * @return uint64_t Time in nanoseconds
+ */
+uint64_t LinuxBus::getTimeNs()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief Put a transaction in the queue it belongs to
+ * @param transaction The transaction, its sequence is set here
+ * @return Status_t
+ */
+Status_t LinuxBus::enqueue(BusTransaction_t &transaction)
+{
+  size_t queued;
+  std::thread::id worker;
+  Status_t status;
+
+  status = checkAddress(transaction.address);
+  if(!status.success) { return status;}
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if(m_thread == nullptr || m_terminate) { return STATUS_DRV_NOT_CONFIGURED;}
+    // close() may delete the thread as soon as the lock is released
+    worker = m_thread->get_id();
+    if(m_queue.size() + m_scheduled.size() >= LINUX_BUS_QUEUE_SIZE) { return STATUS_DRV_ERR_BUSY;}
+    transaction.sequence = m_sequence++;
+    if(transaction.release_ns > getTimeNs())
+    {
+      m_scheduled.push_back(transaction);
+      std::push_heap(m_scheduled.begin(), m_scheduled.end(), isReleasedLater);
+    }else
+    {
+      m_queue.push_back(transaction);
+      std::push_heap(m_queue.begin(), m_queue.end(), isLessUrgent);
+    }
+    queued = m_queue.size() + m_scheduled.size();
+    if(queued > m_stats.max_queued) { m_stats.max_queued = (uint32_t) queued;}
+  }
+  // The worker calling schedule() from a completion does not need waking
+  if(worker != std::this_thread::get_id()) { m_condition.notify_one();}
+  return STATUS_DRV_SUCCESS;
+}
+
+/**
+ * @brief Move the scheduled transactions that are due to the queue, and
+ *        wait for the next one when the queue is empty
+ * @param locker Holds the lock, released while waiting
+ * @return true when the queue has something to run
+ */
+bool LinuxBus::releaseScheduled(std::unique_lock<std::mutex> &locker)
+{
+  uint64_t now = getTimeNs();
+  uint64_t release;
+
+  while(!m_scheduled.empty() && m_scheduled.front().release_ns <= now)
+  {
+    std::pop_heap(m_scheduled.begin(), m_scheduled.end(), isReleasedLater);
+    m_queue.push_back(m_scheduled.back());
+    std::push_heap(m_queue.begin(), m_queue.end(), isLessUrgent);
+    m_scheduled.pop_back();
+  }
+  if(!m_queue.empty()) { return true;}
+
+  if(m_scheduled.empty())
+  {
+    m_condition.wait(locker);
+    return false;
+  }
+  release = m_scheduled.front().release_ns;
+  if(release - now > LINUX_BUS_SPIN_NS)
+  {
+    m_condition.wait_until(locker, std::chrono::steady_clock::time_point(std::chrono::nanoseconds(release - LINUX_BUS_SPIN_NS)));
+    return false;
+  }
+  // Close enough, the wake up latency of a sleep would be the jitter
+  locker.unlock();
+  while(getTimeNs() < release) {}
+  locker.lock();
+  return false;
+}
+
+/**
+ * @brief Tell if a transaction may join a submission, called with the lock
+ *        held
+ * @param first First transaction of the submission
+ * @param other Transaction to add to it
+ * @return bool
+ */
+bool LinuxBus::canMerge(const BusTransaction_t &first, const BusTransaction_t &other)
+{
+  auto has_failed = [this](uint16_t address)
+  {
+    return std::find(m_failed_addresses.begin(), m_failed_addresses.end(), address) != m_failed_addresses.end();
+  };
+
+  // The kernel aborts a whole submission on the first NACK
+  if(!first.is_mergeable || !other.is_mergeable) { return false;}
+  if(has_failed(first.address) || has_failed(other.address)) { return false;}
+  return isCompatible(first, other);
+}
+
+/**
+ * @brief Remember the devices whose last transaction failed, called with
+ *        the lock held
+ * @param batch The transactions of a submission
+ * @param status Status of the submission
+ */
+void LinuxBus::trackFailures(const std::vector<BusTransaction_t> &batch, Status_t status)
+{
+  for(const BusTransaction_t &transaction : batch)
+  {
+    auto found = std::find(m_failed_addresses.begin(), m_failed_addresses.end(), transaction.address);
+    if(!status.success && found == m_failed_addresses.end())
+    {
+      m_failed_addresses.push_back(transaction.address);
+    }else if(status.success && found != m_failed_addresses.end())
+    {
+      m_failed_addresses.erase(found);
+    }
+  }
+}
+
+/**
+ * @brief Thread running the queued transactions, the ones of merge-safe
+ *        devices queued while the bus was busy go out in one submission
+ */
+void LinuxBus::workerThread(void)
+{
+  std::unique_lock<std::mutex> locker(m_mutex);
+  std::vector<BusTransaction_t> batch, expired;
+  uint32_t segment_count, byte_count;
+  Status_t status, timed_out = STATUS_DRV_ERR_TIMEOUT;
+  uint64_t now;
+
+  LinuxThreadAttributes::setUp(m_name);
+  // Wake up when asked to, the default slack of 50 us would be jitter
+  (void) prctl(PR_SET_TIMERSLACK, 1UL);
+  batch.reserve(m_max_segments);
+  while(true)
+  {
+    if(m_terminate) { break;}
+    if(!releaseScheduled(locker)) { continue;}
+
+    // Most urgent first, for as long as the submission has room
+    now = getTimeNs();
+    segment_count = 0;
+    byte_count = 0;
+    while(!m_queue.empty())
+    {
+      const BusTransaction_t &top = m_queue.front();
+      if(top.deadline_ns >= now &&
+         !batch.empty() &&
+         (segment_count + top.segment_count > m_max_segments || byte_count + getByteCount(top) > m_max_bytes ||
+          !canMerge(batch.front(), top)))
+      {
+        break;
+      }
+      std::pop_heap(m_queue.begin(), m_queue.end(), isLessUrgent);
+      if(m_queue.back().deadline_ns < now)
+      {
+        expired.push_back(m_queue.back());
+      }else
+      {
+        batch.push_back(m_queue.back());
+        segment_count += batch.back().segment_count;
+        byte_count += getByteCount(batch.back());
+      }
+      m_queue.pop_back();
+    }
+    m_stats.deadline_misses += expired.size();
+    locker.unlock();
+
+    for(const BusTransaction_t &transaction : expired) { finish(transaction, timed_out, now);}
+    expired.clear();
+
+    if(!batch.empty())
+    {
+      DRIVER_TRACE_SCOPE("bus", "execute");
+      status = execute(batch.data(), (uint16_t) batch.size());
+      locker.lock();
+      m_stats.submissions++;
+      if(batch.size() > 1) { m_stats.merged += batch.size();}
+      // A failed merged submission does not tell which device failed, all
+      // of them are kept apart until they succeed alone
+      trackFailures(batch, status);
+      locker.unlock();
+
+      // A failed submission is not replayed, part of it may have reached the
+      // devices and writes or reads with side effects must not run twice
+      for(const BusTransaction_t &transaction : batch) { finish(transaction, status, now);}
+      batch.clear();
+    }
+    locker.lock();
+  }
+}
+
+/**
+ * @brief Report the outcome of a transaction
+ * @param transaction The transaction
+ * @param status Its status
+ * @param start_ns Time it started or was dropped
+ */
+void LinuxBus::finish(const BusTransaction_t &transaction, Status_t status, uint64_t start_ns)
+{
+  DriverRequest_t request = {(uint32_t) transaction.sequence, status, status.success ? getByteCount(transaction) : 0, EVENT_READ_WRITE};
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stats.transactions++;
+    if(!status.success) { m_stats.failures++;}
+  }
+  if(transaction.function != nullptr)
+  {
+    transaction.function(status, start_ns, transaction.user_arg);
+  }else
+  {
+    DriverToken::complete(transaction.completion, request);
+  }
+}
+
+/**
+ * @brief Constructor
+ * @param path Path of the bus, e.g. "/dev/i2c-1"
+ */
+LinuxIicBus::LinuxIicBus(const char *path) : LinuxBus(path, "iic_bus")
+{
+  m_backend = nullptr;
+  m_max_segments = LINUX_IIC_BUS_MAX_MESSAGES;
+}
+
+/**
+ * @brief Constructor, transactions go to an emulated bus
+ * @param backend The emulated bus, must outlive this object
+ */
+LinuxIicBus::LinuxIicBus(VirtualIicBackend &backend) : LinuxIicBus((const char *) nullptr)
+{
+  m_backend = &backend;
+}
+
+/**
+ * @brief Destructor, stops the worker before this part of the object goes
+ */
+LinuxIicBus::~LinuxIicBus()
+{
+  close();
+}
+
+/**
+ * @brief Open the bus
+ * @return Status_t
+ */
+Status_t LinuxIicBus::setUp()
+{
+  Status_t status;
+
+  if(m_backend != nullptr) { return STATUS_DRV_SUCCESS;}
+  if(m_path == nullptr) { return STATUS_DRV_NULL_POINTER;}
+  if((m_linux_handle = ::open(m_path, O_RDWR)) < 0)
+  {
+    SET_STATUS(status, false, SRC_DRIVER, ERR_FAILED, (char *)"Failed to open the file.\r\n");
+    return status;
+  }
+  return STATUS_DRV_SUCCESS;
+}
+
+/**
+ * @brief Send transactions in one I2C_RDWR, each segment is a message
+ * @param batch The transactions
+ * @param count Number of transactions
+ * @return Status_t
+ */
+Status_t LinuxIicBus::execute(const BusTransaction_t *batch, uint16_t count)
+{
+  struct i2c_msg messages[LINUX_IIC_BUS_MAX_MESSAGES];
+  struct i2c_rdwr_ioctl_data data;
+  Status_t status = STATUS_DRV_SUCCESS;
+  uint32_t message_count = 0;
+
+  for(uint16_t i = 0; i < count; i++)
+  {
+    for(uint8_t j = 0; j < batch[i].segment_count; j++)
+    {
+      const BusSegment_t &segment = batch[i].segments[j];
+      if(m_backend != nullptr)
+      {
+        if(segment.rx_data != nullptr)
+        {
+          status = m_backend->read(batch[i].address >> 1, segment.rx_data, segment.size);
+        }else
+        {
+          status = m_backend->write(batch[i].address >> 1, segment.tx_data, segment.size);
+        }
+        if(!status.success) { return status;}
+        continue;
+      }
+      messages[message_count].addr = batch[i].address >> 1;
+      messages[message_count].flags = segment.rx_data != nullptr ? I2C_M_RD : 0;
+      messages[message_count].len = segment.size;
+      messages[message_count].buf = segment.rx_data != nullptr ? segment.rx_data : segment.tx_data;
+      message_count++;
+    }
+  }
+  if(m_backend != nullptr) { return status;}
+
+  data.msgs = messages;
+  data.nmsgs = message_count;
+  if(ioctl(m_linux_handle, I2C_RDWR, &data) < 0)
+  {
+    SET_STATUS(status, false, SRC_DRIVER, ERR_FAILED, (char *)"The iic transaction was not acknowledged.\r\n");
+  }
+  return status;
+}
+
+/**
+ * @brief Constructor
+ * @param path Path of the spidev file of chip select 0, e.g. "/dev/spidev0.0"
+ * @param mode SPI mode from 0 to 3, shared by the devices
+ * @param speed_hz Clock of the devices that do not set one
+ */
+LinuxSpiBus::LinuxSpiBus(const char *path, uint8_t mode, uint32_t speed_hz) : LinuxBus(path, "spi_bus")
+{
+  m_backend = nullptr;
+  m_mode = mode;
+  m_speed = speed_hz;
+  m_max_segments = LINUX_SPI_BUS_MAX_MESSAGES;
+  m_max_bytes = LINUX_SPI_BUS_MAX_BYTES;
+  m_chip_selects.push_back({0, path, -1});
+}
+
+/**
+ * @brief Constructor, transactions go to an emulated device
+ * @param backend The emulated device, must outlive this object
+ * @param mode SPI mode from 0 to 3
+ * @param speed_hz Clock of the devices that do not set one
+ */
+LinuxSpiBus::LinuxSpiBus(VirtualSpiBackend &backend, uint8_t mode, uint32_t speed_hz) :
+LinuxSpiBus((const char *) nullptr, mode, speed_hz)
+{
+  m_backend = &backend;
+}
+
+/**
+ * @brief Destructor, stops the worker before this part of the object goes
+ */
+LinuxSpiBus::~LinuxSpiBus()
+{
+  close();
+}
+
+/**
+ * @brief Add a chip select, must be called before open()
+ * @param chip_select Address the devices on it are given
+ * @param path Path of its spidev file, e.g. "/dev/spidev0.1"
+ * @return Status_t
+ */
+Status_t LinuxSpiBus::addChipSelect(uint16_t chip_select, const char *path)
+{
+  if(path == nullptr) { return STATUS_DRV_NULL_POINTER;}
+  if(isOpen()) { return STATUS_DRV_ERR_BUSY;}
+  if(m_backend != nullptr || findChipSelect(chip_select) != nullptr) { return STATUS_DRV_ERR_PARAM;}
+  m_chip_selects.push_back({chip_select, path, -1});
+  return STATUS_DRV_SUCCESS;
+}
+
+/**
+ * @brief Find a chip select
+ * @param chip_select Its address
+ * @return LinuxSpiChipSelect_t* nullptr if the bus does not have it
+ */
+LinuxSpiChipSelect_t *LinuxSpiBus::findChipSelect(uint16_t chip_select)
+{
+  for(LinuxSpiChipSelect_t &entry : m_chip_selects)
+  {
+    if(entry.chip_select == chip_select) { return &entry;}
+  }
+  return nullptr;
+}
+
+/**
+ * @brief Open the spidev file of each chip select and set the mode
+ * @return Status_t
+ */
+Status_t LinuxSpiBus::setUp()
+{
+  Status_t status;
+  uint8_t bits = 8;
+
+  if(m_backend != nullptr) { return m_backend->configure(m_speed, m_mode);}
+  for(LinuxSpiChipSelect_t &entry : m_chip_selects)
+  {
+    if(entry.path == nullptr)
+    {
+      tearDown();
+      return STATUS_DRV_NULL_POINTER;
+    }
+    if((entry.handle = ::open(entry.path, O_RDWR)) < 0)
+    {
+      tearDown();
+      SET_STATUS(status, false, SRC_DRIVER, ERR_FAILED, (char *)"Failed to open the file.\r\n");
+      return status;
+    }
+    if(ioctl(entry.handle, SPI_IOC_WR_MODE, &m_mode) < 0 ||
+       ioctl(entry.handle, SPI_IOC_WR_BITS_PER_WORD, &bits) < 0 ||
+       ioctl(entry.handle, SPI_IOC_WR_MAX_SPEED_HZ, &m_speed) < 0)
+    {
+      tearDown();
+      SET_STATUS(status, false, SRC_DRIVER, ERR_FAILED, (char *)"Failed to configure the spi bus.\r\n");
+      return status;
+    }
+  }
+  return STATUS_DRV_SUCCESS;
+}
+
+/**
+ * @brief Close the spidev files
+ */
+void LinuxSpiBus::tearDown()
+{
+  for(LinuxSpiChipSelect_t &entry : m_chip_selects)
+  {
+    if(entry.handle >= 0) { (void) ::close(entry.handle);}
+    entry.handle = -1;
+  }
+  LinuxBus::tearDown();
+}
+
+/**
+ * @brief Refuse devices on a chip select the bus does not have
+ * @param address Chip select of the device
+ * @return Status_t
+ */
+Status_t LinuxSpiBus::checkAddress(uint16_t address)
+{
+  Status_t status;
+
+  if(findChipSelect(address) == nullptr)
+  {
+    SET_STATUS(status, false, SRC_DRIVER, ERR_PARAM_VALUE, (char *)"The spi bus has no such chip select.\r\n");
+    return status;
+  }
+  return STATUS_DRV_SUCCESS;
+}
+
+/**
+ * @brief Tell if two transactions go through the same spidev file
+ * @param first First transaction of the submission
+ * @param other Transaction to add to it
+ * @return bool
+ */
+bool LinuxSpiBus::isCompatible(const BusTransaction_t &first, const BusTransaction_t &other)
+{
+  return first.address == other.address;
+}
+
+/**
+ * @brief Send transactions of one chip select in one SPI_IOC_MESSAGE, the
+ *        chip select is released at the end of each transaction
+ * @param batch The transactions
+ * @param count Number of transactions
+ * @return Status_t
+ */
+Status_t LinuxSpiBus::execute(const BusTransaction_t *batch, uint16_t count)
+{
+  struct spi_ioc_transfer transfers[LINUX_SPI_BUS_MAX_MESSAGES];
+  Status_t status = STATUS_DRV_SUCCESS;
+  uint32_t transfer_count = 0;
+  LinuxSpiChipSelect_t *chip_select = findChipSelect(batch[0].address);
+
+  for(uint16_t i = 0; i < count; i++)
+  {
+    for(uint8_t j = 0; j < batch[i].segment_count; j++)
+    {
+      const BusSegment_t &segment = batch[i].segments[j];
+      if(m_backend != nullptr)
+      {
+        status = m_backend->transfer(segment.tx_data, segment.rx_data, segment.size);
+        if(!status.success) { return status;}
+        continue;
+      }
+      memset(&transfers[transfer_count], 0, sizeof(transfers[0]));
+      transfers[transfer_count].tx_buf = (uintptr_t) segment.tx_data;
+      transfers[transfer_count].rx_buf = (uintptr_t) segment.rx_data;
+      transfers[transfer_count].len = segment.size;
+      transfers[transfer_count].speed_hz = batch[i].speed_hz != 0 ? batch[i].speed_hz : m_speed;
+      transfers[transfer_count].bits_per_word = 8;
+      // Release the chip select between transactions, not at the very end
+      transfers[transfer_count].cs_change = j + 1 == batch[i].segment_count && i + 1 < count;
+      transfer_count++;
+    }
+  }
+  if(m_backend != nullptr) { return status;}
+
+  if(ioctl(chip_select->handle, SPI_IOC_MESSAGE(transfer_count), transfers) < 0)
+  {
+    SET_STATUS(status, false, SRC_DRIVER, ERR_FAILED, (char *)"Failed to transfer data over spi.\r\n");
+  }
+  return status;
+}
+
+/**
+ * @brief Constructor
+ * @param bus The bus, must outlive the handle
+ * @param address IIC 8 bits address, like IIC, or SPI chip select
+ * @param speed_hz SPI clock, 0 for the bus clock, ignored on IIC
+ * @param priority BusPriority_t of the device's transactions
+ */
+BusDevice::BusDevice(LinuxBus &bus, uint16_t address, uint32_t speed_hz, uint8_t priority) : m_bus(bus)
+{
+  m_address = address;
+  m_speed = speed_hz;
+  m_priority = priority;
+  m_is_mergeable = false;
+}
+
+/**
+ * @brief Queue a transaction
+ * @param segments The segments, their buffers must stay valid until the
+ *        transaction completes
+ * @param count Number of segments
+ * @param deadline_ns Latest start on the LinuxBus::getTimeNs() clock, 0
+ *        for none
+ * @return DriverToken
+ */
+DriverToken BusDevice::transferAsync(const BusSegment_t *segments, uint8_t count, uint64_t deadline_ns)
+{
+  return m_bus.submit(*this, segments, count, deadline_ns);
+}
+
+/**
+ * @brief Run a transaction and wait for it
+ * @param segments The segments
+ * @param count Number of segments
+ * @param deadline_ns Latest start on the LinuxBus::getTimeNs() clock, 0
+ *        for none
+ * @return Status_t
+ */
+Status_t BusDevice::transfer(const BusSegment_t *segments, uint8_t count, uint64_t deadline_ns)
+{
+  DriverToken token = m_bus.submit(*this, segments, count, deadline_ns);
+  return token.wait();
+}
+
+/**
+ * @brief Read from the device
+ * @param data Buffer to store the data
+ * @param byte_count Number of bytes
+ * @return Status_t
+ */
+Status_t BusDevice::read(uint8_t *data, uint16_t byte_count)
+{
+  BusSegment_t segment = {nullptr, data, byte_count};
+
+  if(data == nullptr) { return STATUS_DRV_NULL_POINTER;}
+  return transfer(&segment, 1);
+}
+
+/**
+ * @brief Write to the device
+ * @param data The data
+ * @param byte_count Number of bytes
+ * @return Status_t
+ */
+Status_t BusDevice::write(uint8_t *data, uint16_t byte_count)
+{
+  BusSegment_t segment = {data, nullptr, byte_count};
+
+  if(data == nullptr) { return STATUS_DRV_NULL_POINTER;}
+  return transfer(&segment, 1);
+}
+
+/**
+ * @brief Write then read in one transaction, with a repeated start on IIC
+ *        and the chip select held on SPI
+ * @param tx_data Data to write, e.g. a register address
+ * @param tx_size Number of bytes to write
+ * @param rx_data Buffer to store the data read
+ * @param rx_size Number of bytes to read
+ * @return Status_t
+ */
+Status_t BusDevice::writeRead(uint8_t *tx_data, uint16_t tx_size, uint8_t *rx_data, uint16_t rx_size)
+{
+  BusSegment_t segments[2] = {{tx_data, nullptr, tx_size}, {nullptr, rx_data, rx_size}};
+
+  if(tx_data == nullptr || rx_data == nullptr) { return STATUS_DRV_NULL_POINTER;}
+  return transfer(segments, 2);
+}
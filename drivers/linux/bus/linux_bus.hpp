@@ -0,0 +1,321 @@
+/**
+ * @file linux_bus.hpp
+ * @author your name (you@domain.com)
+ * @brief Shared IIC and SPI buses, one file and one worker per bus
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef DRIVERS_LINUX_BUS_LINUX_BUS_HPP
+#define DRIVERS_LINUX_BUS_LINUX_BUS_HPP
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <vector>
+
+#include "commons.hpp"
+#include "driver_base/driver_token.hpp"
+#include "linux/virtual/virtual_backend.hpp"
+#include "linux/utils/linux_thread_attributes.hpp"
+#if __has_include("setup.hpp")
+#include "setup.hpp"
+#endif
+
+// Transactions waiting on a bus, submissions fail with a busy error beyond it
+#ifndef LINUX_BUS_QUEUE_SIZE
+#define LINUX_BUS_QUEUE_SIZE                                                  64
+#endif
+
+// Time the worker busy waits before a scheduled transaction is released,
+// trades CPU for a lower jitter, 0 to only sleep
+#ifndef LINUX_BUS_SPIN_NS
+#define LINUX_BUS_SPIN_NS                                                      0
+#endif
+
+// Segments of a single transaction, e.g. a register address and its data
+#ifndef LINUX_BUS_MAX_SEGMENTS
+#define LINUX_BUS_MAX_SEGMENTS                                                 4
+#endif
+
+// Segments sent in one I2C_RDWR, the kernel accepts up to 42
+#ifndef LINUX_IIC_BUS_MAX_MESSAGES
+#define LINUX_IIC_BUS_MAX_MESSAGES                                            42
+#endif
+
+// Segments sent in one SPI_IOC_MESSAGE
+#ifndef LINUX_SPI_BUS_MAX_MESSAGES
+#define LINUX_SPI_BUS_MAX_MESSAGES                                            32
+#endif
+
+// Bytes sent in one SPI_IOC_MESSAGE, spidev's default bufsiz
+#ifndef LINUX_SPI_BUS_MAX_BYTES
+#define LINUX_SPI_BUS_MAX_BYTES                                             4096
+#endif
+
+/**
+ * @brief Priorities of transactions, higher ones go first
+ */
+typedef enum
+{
+  BUS_PRIORITY_LOW = 0,
+  BUS_PRIORITY_NORMAL,
+  BUS_PRIORITY_HIGH,
+  BUS_PRIORITY_CRITICAL,
+}BusPriority_t;
+
+/**
+ * @brief Part of a transaction
+ *
+ * @note On IIC a segment is a message, it reads when rx_data is set and
+ *       writes otherwise, segments after the first start with a repeated
+ *       start. On SPI a segment is a transfer, either buffer may be nullptr,
+ *       and the chip select stays asserted across the segments.
+ */
+typedef struct
+{
+  uint8_t *tx_data;
+  uint8_t *rx_data;
+  uint16_t size;
+}BusSegment_t;
+
+/**
+ * @brief Activity of a bus
+ */
+typedef struct
+{
+  uint64_t transactions;      /*!< Transactions completed, successful or not */
+  uint64_t submissions;       /*!< Requests to the kernel or backend */
+  uint64_t merged;            /*!< Transactions that shared a submission with others */
+  uint64_t deadline_misses;   /*!< Transactions dropped because their deadline passed in the queue */
+  uint64_t failures;          /*!< Transactions completed with an error */
+  uint32_t max_queued;        /*!< Most transactions waiting at once, scheduled ones included */
+}BusStats_t;
+
+class BusDevice;
+
+/**
+ * @brief Function called on the bus worker when a scheduled transaction
+ *        completes, it must not block
+ * @param status Status of the transaction, STATUS_DRV_ERR_TIMEOUT if its
+ *        deadline passed before it started
+ * @param start_ns Time the transaction started, or was dropped
+ * @param user_arg Argument given to LinuxBus::schedule()
+ */
+typedef void (*BusCompletion_t)(Status_t status, uint64_t start_ns, void *user_arg);
+
+/**
+ * @brief A transaction waiting on a bus
+ */
+typedef struct
+{
+  BusSegment_t segments[LINUX_BUS_MAX_SEGMENTS];
+  uint8_t segment_count;
+  uint8_t priority;
+  uint16_t address;
+  uint32_t speed_hz;
+  uint64_t release_ns;        /*!< Earliest start, 0 to start as soon as possible */
+  uint64_t deadline_ns;       /*!< Latest start, UINT64_MAX for none */
+  uint64_t sequence;          /*!< Submission order, breaks ties */
+  bool is_mergeable;          /*!< May share a submission, see BusDevice::setMergeable() */
+  void *completion;           /*!< DriverToken slot, when function is nullptr */
+  BusCompletion_t function;
+  void *user_arg;
+}BusTransaction_t;
+
+/**
+ * @brief A physical bus, owns the file and the worker thread and runs the
+ *        transactions of all the devices on it
+ *
+ * @note The worker takes the most urgent transactions first: highest
+ *       priority, then earliest deadline, then oldest. Transactions of
+ *       merge-safe devices that queued up while the bus was busy are sent
+ *       together in one submission, if it fails they all fail as any part
+ *       of it may have reached the devices. A device whose last transaction
+ *       failed is not merged until one succeeds, and devices not marked
+ *       merge-safe never are, so that a device that NACKs, e.g. an EEPROM
+ *       in its write cycle, only fails its own transactions. A transaction
+ *       still queued after its deadline
+ *       is dropped with STATUS_DRV_ERR_TIMEOUT, it never reaches the bus.
+ *       Scheduled transactions wait aside until their release time, the
+ *       worker sleeps until the earliest one. Times are on the getTimeNs()
+ *       clock.
+ */
+class LinuxBus
+{
+public:
+  LinuxBus(const char *path, const char *name);
+  virtual ~LinuxBus();
+
+  Status_t open();
+
+  void close();
+
+  bool isOpen() { return m_thread != nullptr;}
+
+  void setThreadAttributes(const LinuxThreadAttributes_t &attributes);
+
+  DriverToken submit(const BusDevice &device, const BusSegment_t *segments, uint8_t count, uint64_t deadline_ns = 0);
+
+  Status_t schedule(const BusDevice &device, const BusSegment_t *segments, uint8_t count, uint64_t release_ns,
+                    uint64_t deadline_ns, BusCompletion_t function, void *user_arg);
+
+  uint32_t cancel(void *user_arg);
+
+  BusStats_t getStats();
+
+  static uint64_t getTimeNs();
+
+protected:
+  const char *m_path;
+  int m_linux_handle;
+  uint16_t m_max_segments;
+  uint32_t m_max_bytes;
+
+  virtual Status_t setUp() = 0;
+  virtual void tearDown();
+  virtual Status_t checkAddress(uint16_t address);
+  virtual bool isCompatible(const BusTransaction_t &first, const BusTransaction_t &other);
+  virtual Status_t execute(const BusTransaction_t *batch, uint16_t count) = 0;
+
+private:
+  const char *m_name;
+  LinuxThreadAttributes_t m_attributes;
+  bool m_use_default_attributes;
+  std::mutex m_mutex;
+  std::condition_variable m_condition;
+  std::thread *m_thread;
+  bool m_terminate;
+  uint64_t m_sequence;
+  std::vector<BusTransaction_t> m_queue;
+  std::vector<BusTransaction_t> m_scheduled;
+  std::vector<uint16_t> m_failed_addresses;   /*!< Devices whose last transaction failed */
+  BusStats_t m_stats;
+
+  Status_t enqueue(BusTransaction_t &transaction);
+
+  void workerThread(void);
+
+  bool releaseScheduled(std::unique_lock<std::mutex> &locker);
+
+  bool canMerge(const BusTransaction_t &first, const BusTransaction_t &other);
+
+  void trackFailures(const std::vector<BusTransaction_t> &batch, Status_t status);
+
+  void finish(const BusTransaction_t &transaction, Status_t status, uint64_t start_ns);
+};
+
+/**
+ * @brief IIC bus, transactions go out through I2C_RDWR with the address in
+ *        each message, no slave address is set on the file
+ */
+class LinuxIicBus final : public LinuxBus
+{
+public:
+  LinuxIicBus(const char *path);
+  LinuxIicBus(VirtualIicBackend &backend);
+  ~LinuxIicBus();
+
+private:
+  VirtualIicBackend *m_backend;
+
+  Status_t setUp() override;
+  Status_t execute(const BusTransaction_t *batch, uint16_t count) override;
+};
+
+/**
+ * @brief A chip select of an SPI bus, spidev has one file per chip select
+ */
+typedef struct
+{
+  uint16_t chip_select;
+  const char *path;
+  int handle;
+}LinuxSpiChipSelect_t;
+
+/**
+ * @brief SPI bus, one spidev file per chip select under one worker,
+ *        transactions go out through SPI_IOC_MESSAGE with the chip select
+ *        released between them
+ *
+ * @note The address of a device is its chip select, the one of the path
+ *       given to the constructor is 0 and addChipSelect() adds the others
+ *       before open(). Transactions are only merged with others of the same
+ *       chip select. The mode is shared by the devices on the bus, the clock
+ *       is set per device. An emulated bus has chip select 0 only.
+ *
+ * @code
+ * LinuxSpiBus bus("/dev/spidev0.0");
+ * bus.addChipSelect(1, "/dev/spidev0.1");
+ * bus.open();
+ * SPI adc(bus, 0);
+ * SPI flash(bus, 1);
+ * @endcode
+ */
+class LinuxSpiBus final : public LinuxBus
+{
+public:
+  LinuxSpiBus(const char *path, uint8_t mode = 0, uint32_t speed_hz = 1000000);
+  LinuxSpiBus(VirtualSpiBackend &backend, uint8_t mode = 0, uint32_t speed_hz = 1000000);
+  ~LinuxSpiBus();
+
+  Status_t addChipSelect(uint16_t chip_select, const char *path);
+
+private:
+  VirtualSpiBackend *m_backend;
+  uint8_t m_mode;
+  uint32_t m_speed;
+  std::vector<LinuxSpiChipSelect_t> m_chip_selects;
+
+  LinuxSpiChipSelect_t *findChipSelect(uint16_t chip_select);
+
+  Status_t setUp() override;
+  void tearDown() override;
+  Status_t checkAddress(uint16_t address) override;
+  bool isCompatible(const BusTransaction_t &first, const BusTransaction_t &other) override;
+  Status_t execute(const BusTransaction_t *batch, uint16_t count) override;
+};
+
+/**
+ * @brief Handle to a device on a bus, cheap to create and to copy
+ *
+ * @note Only devices marked with setMergeable() share submissions, mark
+ *       the ones that always acknowledge.
+ */
+class BusDevice
+{
+public:
+  BusDevice(LinuxBus &bus, uint16_t address = 0, uint32_t speed_hz = 0, uint8_t priority = BUS_PRIORITY_NORMAL);
+
+  void setAddress(uint16_t address) { m_address = address;}
+  void setSpeed(uint32_t speed_hz) { m_speed = speed_hz;}
+  void setPriority(uint8_t priority) { m_priority = priority;}
+  void setMergeable(bool is_mergeable) { m_is_mergeable = is_mergeable;}
+
+  uint16_t getAddress() const { return m_address;}
+  uint32_t getSpeed() const { return m_speed;}
+  uint8_t getPriority() const { return m_priority;}
+  bool isMergeable() const { return m_is_mergeable;}
+  LinuxBus &getBus() const { return m_bus;}
+
+  DriverToken transferAsync(const BusSegment_t *segments, uint8_t count, uint64_t deadline_ns = 0);
+  Status_t transfer(const BusSegment_t *segments, uint8_t count, uint64_t deadline_ns = 0);
+
+  Status_t read(uint8_t *data, uint16_t byte_count);
+  Status_t write(uint8_t *data, uint16_t byte_count);
+  Status_t writeRead(uint8_t *tx_data, uint16_t tx_size, uint8_t *rx_data, uint16_t rx_size);
+
+private:
+  LinuxBus &m_bus;
+  uint16_t m_address;
+  uint32_t m_speed;
+  uint8_t m_priority;
+  bool m_is_mergeable;        /*!< Always acknowledges, may share a submission with other devices */
+};
+
+#endif /* DRIVERS_LINUX_BUS_LINUX_BUS_HPP */
@@ -14,6 +14,7 @@
 #include <errno.h>
 #include <gpiod.h>
 #include <unistd.h>
+#include <poll.h>
 
 /**
  * @brief Constructor
@@ -27,18 +28,33 @@ DIO::DIO(uint32_t line_offset, uint32_t chip_number)
   m_line_number = line_offset;
   m_chip_handle = nullptr;
   m_line_handle = nullptr;
+  m_backend = nullptr;
   m_flags = 0;
   m_value = false;
+  m_requested_edge = EVENT_NONE;
+  m_last_edge = EVENT_NONE;
 
   m_func = nullptr;
   m_arg = nullptr;
 
+  m_sync.thread = nullptr;
   m_sync.run = false;
   m_sync.terminate = false;
   m_sync.buffer = nullptr;
   m_sync.size = 0;
   m_sync.func = nullptr;
   m_sync.arg = nullptr;
+  m_thread_attributes = LinuxThreadAttributes::getDefaults();
+}
+
+/**
+ * @brief Constructor, the line is emulated instead of using a gpiochip
+ *
+ * @param backend The emulated line, must outlive the driver
+ */
+DIO::DIO(VirtualDioBackend &backend) : DIO(0, 0)
+{
+  m_backend = &backend;
 }
 
 /**
@@ -77,6 +93,7 @@ DIO::~DIO()
  */
 Status_t DIO::configure(const DriverSettings_t *list, uint8_t list_size)
 {
+  DRIVER_TRACE_SCOPE("dio", "configure");
   Status_t result;
   struct gpiod_line_request_config settings =
   {
@@ -84,6 +101,7 @@ Status_t DIO::configure(const DriverSettings_t *list, uint8_t list_size)
     .request_type = GPIOD_LINE_REQUEST_DIRECTION_INPUT,
     .flags = GPIOD_LINE_REQUEST_FLAG_BIAS_DISABLE
   };
+  LinuxThreadAttributes_t thread_attributes = LinuxThreadAttributes::getDefaults();
   int ret;
 
   if(list != nullptr)
@@ -110,14 +128,27 @@ Status_t DIO::configure(const DriverSettings_t *list, uint8_t list_size)
           if(list[i].value == DIO_STATE_LOW){m_value = false;}
           if(list[i].value == DIO_STATE_HIGH){m_value = true;}
           break;
-        break;
+        case THREAD_PARAM_POLICY:
+        case THREAD_PARAM_PRIORITY:
+        case THREAD_PARAM_AFFINITY:
+          (void) LinuxThreadAttributes::parse(list[i], thread_attributes);
+          break;
       default:
         break;
       }
     }
   }
 
+  result = LinuxThreadAttributes::check(thread_attributes);
+  if(!result.success) { return result;}
+  m_thread_attributes = thread_attributes;
+
   m_flags = settings.flags;
+  if(m_backend != nullptr)
+  {
+    m_requested_edge = EVENT_NONE;
+    return m_backend->configure(settings.request_type == GPIOD_LINE_REQUEST_DIRECTION_OUTPUT, m_value);
+  }
   m_chip_handle = gpiod_chip_open_by_number(m_chip_number);
   if (m_chip_handle != nullptr)
   {
@@ -127,6 +158,7 @@ Status_t DIO::configure(const DriverSettings_t *list, uint8_t list_size)
       ret = gpiod_line_request((struct gpiod_line *)m_line_handle, &settings, m_value);
       if (ret >= 0)
       {
+        m_requested_edge = EVENT_NONE;
         return STATUS_DRV_SUCCESS;
       }else
       {
@@ -153,12 +185,20 @@ Status_t DIO::configure(const DriverSettings_t *list, uint8_t list_size)
  */
 Status_t DIO::read(bool &state)
 {
+  DRIVER_TRACE_SCOPE("dio", "read");
   int val;
-  if(m_line_handle == nullptr) return STATUS_DRV_NULL_POINTER;
-  val = gpiod_line_get_value((struct gpiod_line *)m_line_handle);
-  if(val < 0) {return STATUS_DRV_UNKNOWN_ERROR;}
-  if(val == 0){state = false;}
-  else {state = true;}
+  if(m_backend != nullptr)
+  {
+    if(!m_backend->read(state).success) {return STATUS_DRV_UNKNOWN_ERROR;}
+  }else
+  {
+    if(m_line_handle == nullptr) return STATUS_DRV_NULL_POINTER;
+    val = gpiod_line_get_value((struct gpiod_line *)m_line_handle);
+    if(val < 0) {return STATUS_DRV_UNKNOWN_ERROR;}
+    if(val == 0){state = false;}
+    else {state = true;}
+  }
+  DRIVER_RECORD(m_record_id, DRIVER_RECORD_READ, &state, 1);
   return STATUS_DRV_SUCCESS;
 }
 
@@ -169,11 +209,19 @@ Status_t DIO::read(bool &state)
  */
 Status_t DIO::write(bool value)
 {
+  DRIVER_TRACE_SCOPE("dio", "write");
   int ret;
-  if(m_line_handle == nullptr) return STATUS_DRV_NULL_POINTER;
-  ret = gpiod_line_set_value((struct gpiod_line *)m_line_handle, (int) value);
+  if(m_backend != nullptr)
+  {
+    ret = m_backend->write(value).success ? 0 : -1;
+  }else
+  {
+    if(m_line_handle == nullptr) return STATUS_DRV_NULL_POINTER;
+    ret = gpiod_line_set_value((struct gpiod_line *)m_line_handle, (int) value);
+  }
   if(ret < 0) {return STATUS_DRV_UNKNOWN_ERROR;}
   m_value = (bool) value;
+  DRIVER_RECORD(m_record_id, DRIVER_RECORD_WRITE, &m_value, 1);
   return STATUS_DRV_SUCCESS;
 }
 
@@ -212,16 +260,8 @@ Status_t DIO::enableCallback(bool enable, DriverEventsList_t edge)
 {
   std::unique_lock<std::mutex> locker1(m_sync.mutex,  std::defer_lock);
   Status_t status = STATUS_DRV_SUCCESS;
-  struct gpiod_line_request_config settings =
-  {
-    .consumer = "my_driver",
-    .request_type = GPIOD_LINE_REQUEST_DIRECTION_INPUT,
-    .flags = GPIOD_LINE_REQUEST_FLAG_BIAS_DISABLE
-  };
-  int ret, val = 0;
 
-  if(m_line_handle == nullptr || m_chip_handle == nullptr) return STATUS_DRV_NULL_POINTER;
-  settings.flags = m_flags;
+  if((m_line_handle == nullptr || m_chip_handle == nullptr) && m_backend == nullptr) return STATUS_DRV_NULL_POINTER;
 
   if(!enable)
   {
@@ -234,6 +274,7 @@ Status_t DIO::enableCallback(bool enable, DriverEventsList_t edge)
       m_sync.condition.notify_one();
       m_sync.thread->join();
       delete m_sync.thread;
+      m_sync.thread = nullptr;
     }
     return STATUS_DRV_SUCCESS;
   }
@@ -241,22 +282,10 @@ Status_t DIO::enableCallback(bool enable, DriverEventsList_t edge)
   switch (edge)
   {
     case EVENT_EDGE_RISING:
-      gpiod_line_release((struct gpiod_line *)m_line_handle);
-      settings.request_type = GPIOD_LINE_REQUEST_EVENT_RISING_EDGE;
-      m_line_handle = gpiod_chip_get_line((struct gpiod_chip *)m_chip_handle, m_line_number);
-      ret = gpiod_line_request((struct gpiod_line *)m_line_handle, &settings, val);
-      break;
     case EVENT_EDGE_FALLING:
-      gpiod_line_release((struct gpiod_line *)m_line_handle);
-      settings.request_type = GPIOD_LINE_REQUEST_EVENT_FALLING_EDGE;
-      m_line_handle = gpiod_chip_get_line((struct gpiod_chip *)m_chip_handle, m_line_number);
-      ret = gpiod_line_request((struct gpiod_line *)m_line_handle, &settings, val);
-      break;
     case EVENT_EDGE_BOTH:
-      gpiod_line_release((struct gpiod_line *)m_line_handle);
-      settings.request_type = GPIOD_LINE_REQUEST_EVENT_BOTH_EDGES;
-      m_line_handle = gpiod_chip_get_line((struct gpiod_chip *)m_chip_handle, m_line_number);
-      ret = gpiod_line_request((struct gpiod_line *)m_line_handle, &settings, val);
+      status = requestEvents(edge);
+      if(!status.success) { return status;}
       break;
     case EVENT_NONE:
       if(m_sync.thread != nullptr)
@@ -267,6 +296,8 @@ Status_t DIO::enableCallback(bool enable, DriverEventsList_t edge)
         // locker1.unlock();
         m_sync.condition.notify_one();
         m_sync.thread->join();
+        delete m_sync.thread;
+        m_sync.thread = nullptr;
       }
       return STATUS_DRV_SUCCESS;
       break;
@@ -275,10 +306,19 @@ Status_t DIO::enableCallback(bool enable, DriverEventsList_t edge)
       break;
   }
 
-  if(ret < 0) { return STATUS_DRV_UNKNOWN_ERROR;}
   if(m_sync.thread == nullptr)
   {
+    m_sync.terminate = false;
     m_sync.thread = new std::thread(&DIO::readAsyncThread, this);
+    status = LinuxThreadAttributes::apply(*m_sync.thread, m_thread_attributes);
+    if(!status.success)
+    {
+      m_sync.terminate = true;
+      m_sync.thread->join();
+      delete m_sync.thread;
+      m_sync.thread = nullptr;
+      return status;
+    }
   }
 
   return STATUS_DRV_SUCCESS;
@@ -291,19 +331,31 @@ void DIO::readAsyncThread(void)
 {
   struct timespec ts = {0, 100000000};
   struct gpiod_line_event event;
+  struct pollfd fds;
   DriverEventsList_t edge;
   Status_t status;
   uint8_t state[1];
   int ret;
 
+  LinuxThreadAttributes::setUp("dio_edges");
   while(!m_sync.terminate)
   {
-    if(m_line_handle == nullptr) break;
-    ret = gpiod_line_event_wait((struct gpiod_line *)m_line_handle, &ts);
-    if (ret <= 0) { continue; }
-    ret = gpiod_line_event_read((struct gpiod_line *)m_line_handle, &event);
-    if (ret < 0) { continue; }
-    if(m_func == nullptr) { continue; }
+    if(m_backend != nullptr)
+    {
+      fds = {m_backend->getEventFd(), POLLIN, 0};
+      ret = poll(&fds, 1, ts.tv_nsec / 1000000);
+      if (ret <= 0) { continue; }
+      if (!m_backend->readEvent(edge).success) { continue; }
+      event.event_type = edge == EVENT_EDGE_RISING ? GPIOD_LINE_EVENT_RISING_EDGE : GPIOD_LINE_EVENT_FALLING_EDGE;
+    }else
+    {
+      if(m_line_handle == nullptr) break;
+      ret = gpiod_line_event_wait((struct gpiod_line *)m_line_handle, &ts);
+      if (ret <= 0) { continue; }
+      ret = gpiod_line_event_read((struct gpiod_line *)m_line_handle, &event);
+      if (ret < 0) { continue; }
+    }
+    DRIVER_TRACE_EVENT("dio", "edge");
     switch(event.event_type)
     {
       case GPIOD_LINE_EVENT_RISING_EDGE:
@@ -322,11 +374,164 @@ void DIO::readAsyncThread(void)
         status = STATUS_DRV_UNKNOWN_ERROR;
         break;
     }
+    if(status.success) { DRIVER_RECORD(m_record_id, DRIVER_RECORD_EDGE, state, 1);}
     if(m_func != nullptr)
     {
-      m_func(status, edge, state, m_sync.arg);
+      DRIVER_TRACE_SCOPE("dio", "callback");
+      m_func(status, edge, state, m_arg);
     }
   }
   m_sync.terminate = false;
   m_sync.run = false;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Wait for an edge from a coroutine
+ *
+ * @note Edges are consumed by whoever reads them first, do not mix this with
+ *       callbacks on the same line.
+ *
+ * @param edge The edge to wait for
+ * @param timeout Time to wait in milliseconds before returning an error
+ * @return DioEdgeAwaiter
+ */
+DioEdgeAwaiter DIO::edge(DriverEventsList_t edge, uint32_t timeout)
+{
+  Status_t status;
+  int fd = -1;
+
+  status = requestEvents(edge);
+  if(status.success)
+  {
+    fd = m_backend != nullptr ? m_backend->getEventFd() : gpiod_line_event_get_fd((struct gpiod_line *)m_line_handle);
+    if(fd < 0) { status = STATUS_DRV_BAD_HANDLE;}
+  }
+  return DioEdgeAwaiter(this, fd, status, timeout);
+}
+
+/**
+ * @brief Get the last edge detected with edge()
+ * @return DriverEventsList_t
+ */
+DriverEventsList_t DIO::getLastEdge()
+{
+  return m_last_edge;
+}
+
+/**
+ * @brief Request the line for edge events, nothing is done if it already is
+ * @param edge The edge that will trigger events
+ * @return Status_t
+ */
+Status_t DIO::requestEvents(DriverEventsList_t edge)
+{
+  struct gpiod_line_request_config settings =
+  {
+    .consumer = "my_driver",
+    .request_type = GPIOD_LINE_REQUEST_EVENT_BOTH_EDGES,
+    .flags = m_flags
+  };
+
+  if((m_line_handle == nullptr || m_chip_handle == nullptr) && m_backend == nullptr) return STATUS_DRV_NULL_POINTER;
+  if(edge == m_requested_edge) { return STATUS_DRV_SUCCESS;}
+  if(m_backend != nullptr)
+  {
+    Status_t status = m_backend->requestEvents(edge);
+    if(status.success) { m_requested_edge = edge;}
+    return status;
+  }
+
+  switch (edge)
+  {
+    case EVENT_EDGE_RISING:
+      settings.request_type = GPIOD_LINE_REQUEST_EVENT_RISING_EDGE;
+      break;
+    case EVENT_EDGE_FALLING:
+      settings.request_type = GPIOD_LINE_REQUEST_EVENT_FALLING_EDGE;
+      break;
+    case EVENT_EDGE_BOTH:
+      settings.request_type = GPIOD_LINE_REQUEST_EVENT_BOTH_EDGES;
+      break;
+    default:
+      return STATUS_DRV_ERR_PARAM;
+  }
+
+  gpiod_line_release((struct gpiod_line *)m_line_handle);
+  m_requested_edge = EVENT_NONE;
+  m_line_handle = gpiod_chip_get_line((struct gpiod_chip *)m_chip_handle, m_line_number);
+  if(m_line_handle == nullptr) { return STATUS_DRV_UNKNOWN_ERROR;}
+  if(gpiod_line_request((struct gpiod_line *)m_line_handle, &settings, 0) < 0) { return STATUS_DRV_UNKNOWN_ERROR;}
+  m_requested_edge = edge;
+
+  return STATUS_DRV_SUCCESS;
+}
+
+/**
+ * @brief Constructor
+ * @param dio Line the edge is awaited on
+ * @param fd Event file descriptor of the line
+ * @param status Outcome of the line request, the awaiter is ready on failure
+ * @param timeout Time to wait in milliseconds before returning an error
+ */
+DioEdgeAwaiter::DioEdgeAwaiter(DIO *dio, int fd, Status_t status, uint32_t timeout)
+: m_fd_awaiter(fd, EPOLLIN, timeout)
+{
+  m_dio = dio;
+  m_fd = fd;
+  m_status = status;
+}
+
+/**
+ * @brief Check if the coroutine can go on without suspending
+ * @return bool
+ */
+bool DioEdgeAwaiter::await_ready()
+{
+  if(!m_status.success) { return true;}
+  return m_fd_awaiter.await_ready();
+}
+
+/**
+ * @brief Register the coroutine with the scheduler, or block if there is none
+ * @param handle Coroutine to resume
+ * @return bool false if the coroutine must not suspend
+ */
+bool DioEdgeAwaiter::await_suspend(std::coroutine_handle<> handle)
+{
+  return m_fd_awaiter.await_suspend(handle);
+}
+
+/**
+ * @brief Read the edge event once the line's file descriptor is ready
+ * @return Status_t
+ */
+Status_t DioEdgeAwaiter::await_resume()
+{
+  struct gpiod_line_event event;
+  DriverEventsList_t edge;
+  bool level;
+
+  if(!m_status.success) { return m_status;}
+  m_status = m_fd_awaiter.await_resume();
+  if(!m_status.success) { return m_status;}
+
+  if(m_dio->m_backend != nullptr)
+  {
+    m_status = m_dio->m_backend->readEvent(edge);
+    if(!m_status.success) { return m_status;}
+    m_dio->m_last_edge = edge;
+  }else
+  {
+    if(gpiod_line_event_read_fd(m_fd, &event) < 0) { return STATUS_DRV_UNKNOWN_ERROR;}
+    if(event.event_type == GPIOD_LINE_EVENT_RISING_EDGE)
+    {
+      m_dio->m_last_edge = EVENT_EDGE_RISING;
+    }else
+    {
+      m_dio->m_last_edge = EVENT_EDGE_FALLING;
+    }
+  }
+  level = m_dio->m_last_edge == EVENT_EDGE_RISING;
+  DRIVER_RECORD(m_dio->m_record_id, DRIVER_RECORD_EDGE, &level, 1);
+  return STATUS_DRV_SUCCESS;
+}
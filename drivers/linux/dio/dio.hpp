@@ -14,6 +14,32 @@
 
 #include "peripherals_base/dio_base.hpp"
 #include "linux/utils/linux_types.hpp"
+#include "linux/utils/linux_thread_attributes.hpp"
+#include "linux/utils/linux_scheduler.hpp"
+#include "linux/virtual/virtual_backend.hpp"
+
+class DIO;
+
+/**
+ * @brief Awaitable that resumes once an edge is detected on a line
+ */
+class DioEdgeAwaiter
+{
+public:
+  DioEdgeAwaiter(DIO *dio, int fd, Status_t status, uint32_t timeout);
+
+  bool await_ready();
+
+  bool await_suspend(std::coroutine_handle<> handle);
+
+  Status_t await_resume();
+
+private:
+  LinuxFdAwaiter m_fd_awaiter;
+  DIO *m_dio;
+  int m_fd;
+  Status_t m_status;
+};
 
 /**
  * @brief Class that export DIO functionalities
@@ -23,6 +49,7 @@ class DIO final : public DioBase
 public:
 
   DIO(uint32_t line_offset, uint32_t chip_number = 0);
+  DIO(VirtualDioBackend &backend);
   virtual ~DIO();
 
   Status_t configure(const DriverSettings_t *list, uint8_t list_size);
@@ -37,16 +64,28 @@ public:
 
   Status_t enableCallback(bool enable, DriverEventsList_t edge = EVENT_NONE);
 
+  DioEdgeAwaiter edge(DriverEventsList_t edge, uint32_t timeout = UINT32_MAX);
+
+  DriverEventsList_t getLastEdge();
+
 private:
   uint32_t m_chip_number;
   uint32_t m_line_number;
   void *m_chip_handle;
   void *m_line_handle;
+  VirtualDioBackend *m_backend;
   UtilsInOutSync_t m_sync;
+  LinuxThreadAttributes_t m_thread_attributes;
   int m_flags;
   bool m_value;
+  DriverEventsList_t m_requested_edge;
+  DriverEventsList_t m_last_edge;
+
+  Status_t requestEvents(DriverEventsList_t edge);
 
   void readAsyncThread(void);
+
+  friend class DioEdgeAwaiter;
 };
 
 #endif /* DRIVERS_LINUX_DIO_DIO_HPP */
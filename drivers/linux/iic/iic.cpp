@@ -14,6 +14,8 @@
 #include <unistd.h>
 #include <fcntl.h>
 #include <sys/ioctl.h>
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
 
 #include "linux/utils/linux_io.hpp"
 #include "iic_types.hpp"
@@ -31,6 +33,34 @@ m_thread_handle(IIC::transferDataAsync, this)
   m_address = address;
   m_handle = port_handle;
   m_linux_handle = -1;
+  m_backend = nullptr;
+  m_bus_device = nullptr;
+  m_thread_handle.setName("iic");
+}
+
+/**
+ * @brief Constructor, requests go to an emulated bus instead of i2c-dev
+ *
+ * @param backend The emulated bus, must outlive the driver
+ * @param address 8 or 10 bits address
+ */
+IIC::IIC(VirtualIicBackend &backend, uint16_t address) : IIC((const void *) &backend, address)
+{
+  m_backend = &backend;
+}
+
+/**
+ * @brief Constructor, requests go through a bus shared with other devices
+ *
+ * @param bus The bus, opened by the caller, must outlive the driver
+ * @param address 8 or 10 bits address
+ * @param is_mergeable True if the device always acknowledges, its requests
+ *        may then share a submission with those of other devices
+ */
+IIC::IIC(LinuxIicBus &bus, uint16_t address, bool is_mergeable) : IIC((const void *) &bus, address)
+{
+  m_bus_device = new BusDevice(bus, address);
+  m_bus_device->setMergeable(is_mergeable);
 }
 
 /**
@@ -38,10 +68,13 @@ m_thread_handle(IIC::transferDataAsync, this)
  */
 IIC::~IIC()
 {
+  // The worker reports to the result queues, stop it before anything else
+  (void) m_thread_handle.terminate();
   if(m_linux_handle >= 0)
   {
     (void) close(m_linux_handle);
   }
+  delete m_bus_device;
 }
 
 /**
@@ -52,11 +85,14 @@ IIC::~IIC()
  */
 Status_t IIC::configure(const DriverSettings_t *list, uint8_t list_size)
 {
+  DRIVER_TRACE_SCOPE("iic", "configure");
   Status_t status = STATUS_DRV_SUCCESS;
+  LinuxThreadAttributes_t thread_attributes = LinuxThreadAttributes::getDefaults();
 
   if(m_handle == nullptr) { return STATUS_DRV_NULL_POINTER;}
-  m_read_status = STATUS_DRV_NOT_CONFIGURED;
-  m_write_status = STATUS_DRV_NOT_CONFIGURED;
+  setReadStatus(STATUS_DRV_NOT_CONFIGURED);
+  setWriteStatus(STATUS_DRV_NOT_CONFIGURED);
+  (void) m_checksum.setType(CHECKSUM_NONE);
 
   if(list != nullptr && list_size != 0)
   {
@@ -67,13 +103,26 @@ Status_t IIC::configure(const DriverSettings_t *list, uint8_t list_size)
       case COMM_WORK_ASYNC:
         m_is_async_mode = (bool)list[i].value;
         break;
+      case COMM_USE_HW_CRC:
+      case COMM_USE_HW_CKSUM:
+        status = m_checksum.configure(list[i]);
+        if(!status.success) { return status;}
+        break;
+      case THREAD_PARAM_POLICY:
+      case THREAD_PARAM_PRIORITY:
+      case THREAD_PARAM_AFFINITY:
+        (void) LinuxThreadAttributes::parse(list[i], thread_attributes);
+        break;
       default:
         break;
       }
     }
   }
 
-  if ((m_linux_handle = open((char *)m_handle, O_RDWR)) < 0)
+  status = LinuxThreadAttributes::check(thread_attributes);
+  if(!status.success) { return status;}
+
+  if (m_backend == nullptr && m_bus_device == nullptr && (m_linux_handle = open((char *)m_handle, O_RDWR)) < 0)
   {
     SET_STATUS(status, false, SRC_DRIVER, ERR_FAILED, (char *)"Failed to open the file.");
     return status;
@@ -81,6 +130,7 @@ Status_t IIC::configure(const DriverSettings_t *list, uint8_t list_size)
 
   if(m_is_async_mode)
   {
+    m_thread_handle.setAttributes(thread_attributes);
     if(!m_thread_handle.create())
     {
       SET_STATUS(status, false, SRC_DRIVER, ERR_FAILED, (char *)"Failed to launch the IIC task.\r\n");
@@ -91,8 +141,8 @@ Status_t IIC::configure(const DriverSettings_t *list, uint8_t list_size)
     (void) m_thread_handle.terminate();
   }
 
-  m_read_status = STATUS_DRV_IDLE;
-  m_write_status = STATUS_DRV_IDLE;
+  setReadStatus(STATUS_DRV_IDLE);
+  setWriteStatus(STATUS_DRV_IDLE);
   return STATUS_DRV_SUCCESS;
 }
 
@@ -103,6 +153,7 @@ Status_t IIC::configure(const DriverSettings_t *list, uint8_t list_size)
 void IIC::setAddress(uint16_t address)
 {
   m_address = address;
+  if(m_bus_device != nullptr) { m_bus_device->setAddress(address);}
 }
 
 /**
@@ -114,39 +165,61 @@ void IIC::setAddress(uint16_t address)
  */
 Status_t IIC::read(uint8_t *data, Size_t byte_count, uint32_t timeout)
 {
+  DRIVER_TRACE_SCOPE("iic", "read");
   Status_t status;
-  DataBundle_t data_bundle;
+  uint64_t start;
   (void) timeout;
 
+  if(m_is_async_mode) { return queueRead(data, byte_count, timeout, nullptr, nullptr);}
+
   status = checkInputs(data, byte_count, timeout);
   if(!status.success) { return status;}
-  if(m_read_status.code == OPERATION_RUNNING) { return STATUS_DRV_ERR_BUSY;}
-  if(m_write_status.code == OPERATION_RUNNING) { return STATUS_DRV_ERR_BUSY;}
 
-  m_read_status = STATUS_DRV_RUNNING;
+  if(getWriteStatus().code == OPERATION_RUNNING || !beginRead()) { m_stats.countBusy(); return STATUS_DRV_ERR_BUSY;}
   m_bytes_read = 0;
+  start = DriverStats::getTimeNs();
+  status = iicRead(data, byte_count, m_address);
+  m_stats.recordSince(DRIVER_LATENCY_SYSCALL, start);
+  m_stats.countRead(status, m_bytes_read);
+  DRIVER_RECORD(m_record_id, DRIVER_RECORD_READ, data, m_bytes_read);
+  setReadStatus(status);
+  return status;
+}
 
-  if(m_is_async_mode)
+/**
+ * @brief Queue a read request for the worker thread
+ * @param data Buffer to store the data
+ * @param byte_count Number of bytes to read
+ * @param timeout Time to wait in milliseconds before returning an error
+ * @param completion Token slot completed with the request, may be nullptr
+ * @param pool_buffer Pooled buffer released with the request, may be nullptr
+ * @return Status_t
+ */
+Status_t IIC::queueRead(uint8_t *data, Size_t byte_count, uint32_t timeout, void *completion, void *pool_buffer)
+{
+  Status_t status;
+  DataBundle_t data_bundle = {};
+
+  status = checkInputs(data, byte_count, timeout);
+  if(!status.success) { return status;}
+
+  data_bundle.rx_buffer = data;
+  data_bundle.rx_size = byte_count;
+  data_bundle.tx_buffer = nullptr;
+  data_bundle.tx_size = 0;
+  data_bundle.timeout = timeout;
+  data_bundle.completion = completion;
+  data_bundle.pool_buffer = pool_buffer;
+  data_bundle.timestamp = DriverStats::getTimeNs();
+  data_bundle.id = submitRead();
+  if(m_thread_handle.setInputData(&data_bundle, 0))
   {
-    data_bundle.buffer = data;
-    data_bundle.size = byte_count;
-    data_bundle.timeout = timeout;
-    if(m_thread_handle.setInputData(&data_bundle, 0))
-    {
-      return STATUS_DRV_SUCCESS;
-    }else
-    {
-      m_read_status = STATUS_DRV_IDLE;
-      return STATUS_DRV_ERR_BUSY;
-    }
+    return STATUS_DRV_SUCCESS;
   }else
   {
-    status = iicRead(data, byte_count, m_address);
-    m_read_status = status;
-    return status;
+    cancelRead();
+    return STATUS_DRV_ERR_BUSY;
   }
-
-  return STATUS_DRV_UNKNOWN_ERROR;
 }
 
 /**
@@ -158,39 +231,107 @@ Status_t IIC::read(uint8_t *data, Size_t byte_count, uint32_t timeout)
  */
 Status_t IIC::write(uint8_t *data, Size_t byte_count, uint32_t timeout)
 {
+  DRIVER_TRACE_SCOPE("iic", "write");
   Status_t status;
-  DataBundle_t data_bundle;
+  uint64_t start;
   (void) timeout;
 
+  if(m_is_async_mode) { return queueWrite(data, byte_count, timeout, nullptr, nullptr);}
+
   status = checkInputs(data, byte_count, timeout);
   if(!status.success) { return status;}
-  if(m_read_status.code == OPERATION_RUNNING) { return STATUS_DRV_ERR_BUSY;}
-  if(m_write_status.code == OPERATION_RUNNING) { return STATUS_DRV_ERR_BUSY;}
 
-  m_write_status = STATUS_DRV_RUNNING;
+  if(getReadStatus().code == OPERATION_RUNNING || !beginWrite()) { m_stats.countBusy(); return STATUS_DRV_ERR_BUSY;}
   m_bytes_written = 0;
+  start = DriverStats::getTimeNs();
+  status = iicWrite(data, byte_count, m_address);
+  m_stats.recordSince(DRIVER_LATENCY_SYSCALL, start);
+  m_stats.countWrite(status, m_bytes_written);
+  DRIVER_RECORD(m_record_id, DRIVER_RECORD_WRITE, data, m_bytes_written);
+  setWriteStatus(status);
+  return status;
+}
 
-  if(m_is_async_mode)
+/**
+ * @brief Write data then read the answer in one transaction, with a repeated
+ *        start instead of a stop between them as register reads need
+ *
+ * @note Runs on the calling thread in both modes. With a checksum the
+ *       written bytes go without one and the read ends with one covering
+ *       the whole transaction, as an SMBus read PEC.
+ * @param tx_data Buffer where data to write is stored, e.g. a register address
+ * @param tx_size Number of bytes to write
+ * @param rx_data Buffer to store the data read
+ * @param rx_size Number of bytes to read
+ * @param timeout Time to wait in milliseconds before returning an error
+ * @return Status_t
+ */
+Status_t IIC::writeRead(uint8_t *tx_data, Size_t tx_size, uint8_t *rx_data, Size_t rx_size, uint32_t timeout)
+{
+  DRIVER_TRACE_SCOPE("iic", "write_read");
+  Status_t status;
+  uint64_t start;
+
+  if(tx_data == nullptr) { return STATUS_DRV_NULL_POINTER;}
+  if(tx_size <= 0) { return STATUS_DRV_ERR_PARAM_SIZE;}
+  status = checkInputs(rx_data, rx_size, timeout);
+  if(!status.success) { return status;}
+
+  if(!beginWrite()) { m_stats.countBusy(); return STATUS_DRV_ERR_BUSY;}
+  if(!beginRead())
   {
-    data_bundle.buffer = data;
-    data_bundle.size = byte_count;
-    data_bundle.timeout = timeout;
-    if(m_thread_handle.setInputData(&data_bundle, 0))
-    {
-      return STATUS_DRV_SUCCESS;
-    }else
-    {
-      m_write_status = STATUS_DRV_IDLE;
-      return STATUS_DRV_ERR_BUSY;
-    }
+    setWriteStatus(STATUS_DRV_IDLE);
+    m_stats.countBusy();
+    return STATUS_DRV_ERR_BUSY;
+  }
+  m_bytes_written = 0;
+  m_bytes_read = 0;
+  start = DriverStats::getTimeNs();
+  status = iicWriteRead(tx_data, tx_size, rx_data, rx_size, m_address);
+  m_stats.recordSince(DRIVER_LATENCY_SYSCALL, start);
+  m_stats.countWrite(status, m_bytes_written);
+  m_stats.countRead(status, m_bytes_read);
+  DRIVER_RECORD(m_record_id, DRIVER_RECORD_WRITE, tx_data, m_bytes_written);
+  DRIVER_RECORD(m_record_id, DRIVER_RECORD_READ, rx_data, m_bytes_read);
+  setWriteStatus(status);
+  setReadStatus(status);
+  return status;
+}
+
+/**
+ * @brief Queue a write request for the worker thread
+ * @param data Buffer where data is stored
+ * @param byte_count Number of bytes to write
+ * @param timeout Time to wait in milliseconds before returning an error
+ * @param completion Token slot completed with the request, may be nullptr
+ * @param pool_buffer Pooled buffer released with the request, may be nullptr
+ * @return Status_t
+ */
+Status_t IIC::queueWrite(uint8_t *data, Size_t byte_count, uint32_t timeout, void *completion, void *pool_buffer)
+{
+  Status_t status;
+  DataBundle_t data_bundle = {};
+
+  status = checkInputs(data, byte_count, timeout);
+  if(!status.success) { return status;}
+
+  data_bundle.rx_buffer = nullptr;
+  data_bundle.rx_size = 0;
+  data_bundle.tx_buffer = data;
+  data_bundle.tx_size = byte_count;
+  data_bundle.timeout = timeout;
+  data_bundle.completion = completion;
+  data_bundle.pool_buffer = pool_buffer;
+  data_bundle.timestamp = DriverStats::getTimeNs();
+  data_bundle.id = submitWrite();
+  if(m_thread_handle.setInputData(&data_bundle, 0))
+  {
+    return STATUS_DRV_SUCCESS;
   }else
   {
-    status = iicWrite(data, byte_count, m_address);
-    m_write_status = status;
-    return status;
+    cancelWrite();
+    return STATUS_DRV_ERR_BUSY;
   }
-
-  return STATUS_DRV_UNKNOWN_ERROR;
 }
 
 /**
@@ -207,7 +348,7 @@ Status_t IIC::setCallback(DriverEventsList_t event, DriverCallback_t function, v
   switch (event)
   {
   case EVENT_READ:
-    if(m_read_status.code != OPERATION_RUNNING)
+    if(getReadStatus().code != OPERATION_RUNNING)
     {
       m_func_rx = function;
       m_arg_rx = user_arg;
@@ -217,7 +358,7 @@ Status_t IIC::setCallback(DriverEventsList_t event, DriverCallback_t function, v
     }
     break;
   case EVENT_WRITE:
-    if (m_write_status.code != OPERATION_RUNNING)
+    if (getWriteStatus().code != OPERATION_RUNNING)
     {
       m_func_tx = function;
       m_arg_tx = user_arg;
@@ -234,6 +375,30 @@ Status_t IIC::setCallback(DriverEventsList_t event, DriverCallback_t function, v
   return status;
 }
 
+/**
+ * @brief Get the outcome of the oldest read request not yet collected
+ * @param request Storage for the outcome of the request
+ * @param timeout Time to wait in milliseconds before returning an error
+ * @return Status_t
+ */
+Status_t IIC::getReadResult(DriverRequest_t &request, uint32_t timeout)
+{
+  if(m_rx_results.get(request, timeout)) { return STATUS_DRV_SUCCESS;}
+  return STATUS_DRV_ERR_TIMEOUT;
+}
+
+/**
+ * @brief Get the outcome of the oldest write request not yet collected
+ * @param request Storage for the outcome of the request
+ * @param timeout Time to wait in milliseconds before returning an error
+ * @return Status_t
+ */
+Status_t IIC::getWriteResult(DriverRequest_t &request, uint32_t timeout)
+{
+  if(m_tx_results.get(request, timeout)) { return STATUS_DRV_SUCCESS;}
+  return STATUS_DRV_ERR_TIMEOUT;
+}
+
 /**
  * @brief Read data synchronously
  * @param buffer Buffer to store the data
@@ -245,8 +410,18 @@ Status_t IIC::iicRead(uint8_t *buffer, uint32_t size, uint16_t address)
 {
   Status_t status = STATUS_DRV_SUCCESS;
   int byte_count;
+  // Covered by the checksum as by an SMBus PEC, the read address
+  uint8_t header = (uint8_t) (address | 0x01);
 
-  if (ioctl(m_linux_handle, I2C_PERIPHERAL_7BITS_ADDRESS, address >> 1) >= 0)
+  if (m_backend != nullptr)
+  {
+    status = m_backend->read(address >> 1, buffer, size);
+    m_bytes_read = status.success ? size : 0;
+  }else if (m_bus_device != nullptr)
+  {
+    status = m_bus_device->read(buffer, size);
+    m_bytes_read = status.success ? size : 0;
+  }else if (ioctl(m_linux_handle, I2C_PERIPHERAL_7BITS_ADDRESS, address >> 1) >= 0)
   {
     byte_count = readSyscall(m_linux_handle, buffer, size);
     m_bytes_read = byte_count > 0 ? byte_count : 0;
@@ -259,6 +434,10 @@ Status_t IIC::iicRead(uint8_t *buffer, uint32_t size, uint16_t address)
     SET_STATUS(status, false, SRC_DRIVER, ERR_FAILED, (char *)"It was not possible to set the desired peripheral address.");
   }
 
+  if (status.success)
+  {
+    status = m_checksum.verify(buffer, m_bytes_read, &header, 1);
+  }
   return status;
 }
 
@@ -273,11 +452,29 @@ Status_t IIC::iicWrite(const uint8_t *buffer, uint32_t size, uint16_t address)
 {
   Status_t status = STATUS_DRV_SUCCESS;
   int byte_count;
+  const uint8_t *frame = buffer;
+  Size_t frame_size = size;
+  // Covered by the checksum as by an SMBus PEC, the write address
+  uint8_t header = (uint8_t) (address & 0xFE);
 
-  if (ioctl(m_linux_handle, I2C_PERIPHERAL_7BITS_ADDRESS, address >> 1) >= 0)
+  if (m_checksum.isEnabled())
   {
-    byte_count = writeSyscall(m_linux_handle, buffer, size);
-    if (byte_count != size)
+    frame = m_checksum.append(buffer, size, frame_size, &header, 1);
+  }
+
+  if (m_backend != nullptr)
+  {
+    status = m_backend->write(address >> 1, frame, frame_size);
+    m_bytes_written = status.success ? size : 0;
+  }else if (m_bus_device != nullptr)
+  {
+    status = m_bus_device->write((uint8_t *) frame, frame_size);
+    m_bytes_written = status.success ? size : 0;
+  }else if (ioctl(m_linux_handle, I2C_PERIPHERAL_7BITS_ADDRESS, address >> 1) >= 0)
+  {
+    byte_count = writeSyscall(m_linux_handle, frame, frame_size);
+    m_bytes_written = byte_count > (int) size ? (int) size : (byte_count > 0 ? byte_count : 0);
+    if (byte_count != frame_size)
     {
       SET_STATUS(status, false, SRC_DRIVER, ERR_FAILED, (char *)"The number of bytes received through iic is smaller than the requested.");
     }
@@ -290,6 +487,56 @@ Status_t IIC::iicWrite(const uint8_t *buffer, uint32_t size, uint16_t address)
   return status;
 }
 
+/**
+ * @brief Write then read synchronously, without a stop between them
+ * @param tx_buffer Buffer where data to write is stored
+ * @param tx_size Number of bytes to write
+ * @param rx_buffer Buffer to store the data read
+ * @param rx_size Number of bytes to read
+ * @param address 8 or 10 bits address of the device
+ * @return Status_t
+ */
+Status_t IIC::iicWriteRead(const uint8_t *tx_buffer, uint32_t tx_size, uint8_t *rx_buffer, uint32_t rx_size, uint16_t address)
+{
+  Status_t status = STATUS_DRV_SUCCESS;
+  // An SMBus master sends no PEC after the command, the one it reads covers
+  // the write address, the command, the read address and the data
+  std::vector<uint8_t> header;
+  struct i2c_msg messages[2];
+  struct i2c_rdwr_ioctl_data data;
+
+  if (m_backend != nullptr)
+  {
+    // Backends see messages, a repeated start does not change them
+    status = m_backend->write(address >> 1, tx_buffer, tx_size);
+    if (status.success) { status = m_backend->read(address >> 1, rx_buffer, rx_size);}
+  }else if (m_bus_device != nullptr)
+  {
+    status = m_bus_device->writeRead((uint8_t *) tx_buffer, tx_size, rx_buffer, rx_size);
+  }else
+  {
+    messages[0] = {(uint16_t) (address >> 1), 0, (uint16_t) tx_size, (uint8_t *) tx_buffer};
+    messages[1] = {(uint16_t) (address >> 1), I2C_M_RD, (uint16_t) rx_size, rx_buffer};
+    data.msgs = messages;
+    data.nmsgs = 2;
+    if (ioctl(m_linux_handle, I2C_RDWR, &data) < 0)
+    {
+      SET_STATUS(status, false, SRC_DRIVER, ERR_FAILED, (char *)"The iic transaction was not acknowledged.\r\n");
+    }
+  }
+
+  m_bytes_written = status.success ? tx_size : 0;
+  m_bytes_read = status.success ? rx_size : 0;
+  if (status.success && m_checksum.isEnabled())
+  {
+    header.push_back((uint8_t) (address & 0xFE));
+    header.insert(header.end(), tx_buffer, tx_buffer + tx_size);
+    header.push_back((uint8_t) (address | 0x01));
+    status = m_checksum.verify(rx_buffer, m_bytes_read, header.data(), (Size_t) header.size());
+  }
+  return status;
+}
+
 /**
  * @brief Task method that process iic data transfer
  * @param data_bundle
@@ -298,31 +545,57 @@ Status_t IIC::iicWrite(const uint8_t *buffer, uint32_t size, uint16_t address)
  */
 Status_t IIC::transferDataAsync(DataBundle_t data_bundle, void *user_arg)
 {
-  Status_t status;
+  DRIVER_TRACE_SCOPE("iic", "transfer");
+  Status_t status = STATUS_DRV_NULL_POINTER;
+  uint64_t start;
+  DriverRequest_t request;
   IIC *obj = static_cast<IIC *>(user_arg);
   if(obj != nullptr)
   {
-
-    if (obj->m_read_status.code == OPERATION_RUNNING)
+    obj->m_stats.recordSince(DRIVER_LATENCY_QUEUE_WAIT, data_bundle.timestamp);
+    if (data_bundle.rx_buffer != nullptr)
     {
-      status = obj->iicRead(data_bundle.buffer, data_bundle.size, obj->m_address);
-      obj->m_read_status = status;
+      start = DriverStats::getTimeNs();
+      status = obj->iicRead(data_bundle.rx_buffer, data_bundle.rx_size, obj->m_address);
+      obj->m_stats.recordSince(DRIVER_LATENCY_SYSCALL, start);
+      request = {data_bundle.id, status, obj->m_bytes_read, EVENT_READ};
+      obj->completeRead(status);
+      obj->m_stats.countRead(status, obj->m_bytes_read);
+      DRIVER_RECORD(obj->m_record_id, DRIVER_RECORD_READ, data_bundle.rx_buffer, obj->m_bytes_read);
       if (obj->m_func_rx != nullptr)
       {
-        Buffer_t data(data_bundle.buffer, data_bundle.size);
+        DRIVER_TRACE_SCOPE("iic", "callback");
+        start = DriverStats::getTimeNs();
+        Buffer_t data(data_bundle.rx_buffer, obj->m_bytes_read);
         obj->m_func_rx(status, EVENT_READ, data, obj->m_arg_rx);
+        obj->m_stats.recordSince(DRIVER_LATENCY_CALLBACK, start);
       }
+      // Results nobody collects are dropped oldest first once the queue is full
+      (void) obj->m_rx_results.putOverwrite(request);
+      DriverToken::complete(data_bundle.completion, request);
+      PoolBuffer::release(data_bundle.pool_buffer);
     }
 
-    if (obj->m_write_status.code == OPERATION_RUNNING)
+    if (data_bundle.tx_buffer != nullptr)
     {
-      status = obj->iicWrite(data_bundle.buffer, data_bundle.size, obj->m_address);
-      obj->m_write_status = status;
+      start = DriverStats::getTimeNs();
+      status = obj->iicWrite(data_bundle.tx_buffer, data_bundle.tx_size, obj->m_address);
+      obj->m_stats.recordSince(DRIVER_LATENCY_SYSCALL, start);
+      request = {data_bundle.id, status, obj->m_bytes_written, EVENT_WRITE};
+      obj->completeWrite(status);
+      obj->m_stats.countWrite(status, obj->m_bytes_written);
+      DRIVER_RECORD(obj->m_record_id, DRIVER_RECORD_WRITE, data_bundle.tx_buffer, obj->m_bytes_written);
       if (obj->m_func_tx != nullptr)
       {
-        Buffer_t data(data_bundle.buffer, data_bundle.size);
+        DRIVER_TRACE_SCOPE("iic", "callback");
+        start = DriverStats::getTimeNs();
+        Buffer_t data(data_bundle.tx_buffer, obj->m_bytes_written);
         obj->m_func_tx(status, EVENT_WRITE, data, obj->m_arg_tx);
+        obj->m_stats.recordSince(DRIVER_LATENCY_CALLBACK, start);
       }
+      (void) obj->m_tx_results.putOverwrite(request);
+      DriverToken::complete(data_bundle.completion, request);
+      PoolBuffer::release(data_bundle.pool_buffer);
     }
 
   }
@@ -340,7 +613,7 @@ Status_t IIC::transferDataAsync(DataBundle_t data_bundle, void *user_arg)
 Status_t IIC::checkInputs(const uint8_t *buffer, uint32_t size, uint32_t timeout)
 {
   if(buffer == nullptr) { return STATUS_DRV_NULL_POINTER;}
-  if(m_handle == nullptr || m_linux_handle < 0) { return STATUS_DRV_BAD_HANDLE;}
+  if(m_handle == nullptr || (m_linux_handle < 0 && m_backend == nullptr && m_bus_device == nullptr)) { return STATUS_DRV_BAD_HANDLE;}
   if(size == 0) { return STATUS_DRV_ERR_PARAM_SIZE;}
   return STATUS_DRV_SUCCESS;
 }
\ No newline at end of file
@@ -19,6 +19,9 @@
 #include "peripherals_base/iic_base.hpp"
 #include "linux/utils/linux_types.hpp"
 #include "linux/utils/linux_threads.hpp"
+#include "linux/virtual/virtual_backend.hpp"
+#include "linux/bus/linux_bus.hpp"
+#include "checksum/checksum.hpp"
 
 /**
  * @brief Base class for iic drivers
@@ -27,6 +30,8 @@ class IIC final : public IicBase
 {
 public:
   IIC(const void *port_handle, uint16_t address);
+  IIC(VirtualIicBackend &backend, uint16_t address);
+  IIC(LinuxIicBus &bus, uint16_t address, bool is_mergeable = false);
 
   ~IIC();
 
@@ -40,17 +45,33 @@ public:
   using DriverInOutBase::write;
   Status_t write(uint8_t *data, Size_t byte_count, uint32_t timeout = UINT32_MAX);
 
+  Status_t writeRead(uint8_t *tx_data, Size_t tx_size, uint8_t *rx_data, Size_t rx_size, uint32_t timeout = UINT32_MAX);
+
   Status_t setCallback(DriverEventsList_t event = EVENT_NONE, DriverCallback_t function = nullptr, void *user_arg = nullptr);
 
+  Status_t getReadResult(DriverRequest_t &request, uint32_t timeout = UINT32_MAX);
+
+  Status_t getWriteResult(DriverRequest_t &request, uint32_t timeout = UINT32_MAX);
+
 private:
   LinuxThreads<DataBundle_t, Status_t, IIC_QUEUE_SIZE, 0> m_thread_handle;
+  LinuxQueue<DriverRequest_t, IIC_QUEUE_SIZE> m_rx_results;
+  LinuxQueue<DriverRequest_t, IIC_QUEUE_SIZE> m_tx_results;
   uint16_t m_address;
   int m_linux_handle;
+  VirtualIicBackend *m_backend;
+  BusDevice *m_bus_device;
+  FrameChecksum m_checksum;
+
+  Status_t queueRead(uint8_t *data, Size_t byte_count, uint32_t timeout, void *completion, void *pool_buffer);
+  Status_t queueWrite(uint8_t *data, Size_t byte_count, uint32_t timeout, void *completion, void *pool_buffer);
 
   Status_t iicRead(uint8_t *buffer, uint32_t size, uint16_t address);
 
   Status_t iicWrite(const uint8_t *buffer, uint32_t size, uint16_t address);
 
+  Status_t iicWriteRead(const uint8_t *tx_buffer, uint32_t tx_size, uint8_t *rx_buffer, uint32_t rx_size, uint16_t address);
+
   static Status_t transferDataAsync(DataBundle_t data_bundle, void *user_arg);
 
   Status_t checkInputs(const uint8_t *buffer, uint32_t size, uint32_t timeout);
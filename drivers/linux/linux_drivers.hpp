@@ -37,6 +37,42 @@
 #include "linux/spt/spt.hpp"
 #endif
 
+#if __has_include("linux/bus/linux_bus.hpp")
+#include "linux/bus/linux_bus.hpp"
+#endif
+
+#if __has_include("linux/bus/acquisition_scheduler.hpp")
+#include "linux/bus/acquisition_scheduler.hpp"
+#endif
+
+#if __has_include("linux/modbus/modbus_master.hpp")
+#include "linux/modbus/modbus_master.hpp"
+#endif
+
+#if __has_include("linux/serial_mux/serial_mux.hpp")
+#include "linux/serial_mux/serial_mux.hpp"
+#endif
+
+#if __has_include("linux/logger/async_logger.hpp")
+#include "linux/logger/async_logger.hpp"
+#endif
+
+#if __has_include("linux/virtual/virtual_spi.hpp")
+#include "linux/virtual/virtual_spi.hpp"
+#endif
+
+#if __has_include("linux/virtual/virtual_iic.hpp")
+#include "linux/virtual/virtual_iic.hpp"
+#endif
+
+#if __has_include("linux/virtual/virtual_dio.hpp")
+#include "linux/virtual/virtual_dio.hpp"
+#endif
+
+#if __has_include("linux/virtual/virtual_replay.hpp")
+#include "linux/virtual/virtual_replay.hpp"
+#endif
+
 #ifndef AP_MAIN
 #define AP_MAIN() \
     int main(void)
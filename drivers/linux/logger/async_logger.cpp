@@ -0,0 +1,504 @@
+/**
+ * @file async_logger.cpp
+ * @author your name (you@domain.com)
+ * @brief Logger that formats and writes its records on a background thread
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "linux/logger/async_logger.hpp"
+
+#include <stdio.h>
+#include <errno.h>
+#include <poll.h>
+#include <unistd.h>
+
+// Loggers a thread remembers its ring in, the others are looked up
+constexpr uint32_t ASYNC_LOGGER_THREAD_CACHE = 4;
+// Time given to a non-blocking file to take more bytes
+constexpr int ASYNC_LOGGER_WRITE_WAIT_MS = 100;
+
+static std::atomic<uint64_t> s_next_id(1);
+static const char s_level_letters[] = {'D', 'I', 'W', 'E'};
+
+/**
+ * @brief Rings claimed by a thread, handed back when it exits
+ *
+ * @note The rings are shared with their loggers, whichever goes last frees
+ *       them.
+ */
+class AsyncLoggerClaims
+{
+public:
+  ~AsyncLoggerClaims()
+  {
+    // Pairs with the acquire of getRing(), the next owner sees the head
+    for(std::shared_ptr<AsyncLoggerRing_t> &ring : m_rings) { ring->owner.store(0, std::memory_order_release);}
+  }
+
+  void add(const std::shared_ptr<AsyncLoggerRing_t> &ring) { m_rings.push_back(ring);}
+
+private:
+  std::vector<std::shared_ptr<AsyncLoggerRing_t>> m_rings;
+};
+
+/**
+ * @brief Constructor
+ * @param output Serial file the lines are written to, configured before open()
+ */
+AsyncLogger::AsyncLogger(LinuxSerialFile &output) : m_output(output)
+{
+  m_id = s_next_id.fetch_add(1, std::memory_order_relaxed);
+  for(std::atomic<AsyncLoggerRing_t *> &ring : m_rings) { ring = nullptr;}
+  m_ring_count = 0;
+  m_level = LOG_LEVEL_DEBUG;
+  m_dropped = 0;
+  m_dropped_reported = 0;
+  m_records = 0;
+  m_writes = 0;
+  m_bytes = 0;
+  m_start_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+  m_use_default_attributes = true;
+  m_thread = nullptr;
+  m_terminate = false;
+  m_is_waiting = false;
+  m_flush_requested = 0;
+  m_flush_done = 0;
+}
+
+/**
+ * @brief Destructor, writes what is left in the rings when open
+ */
+AsyncLogger::~AsyncLogger()
+{
+  close();
+}
+
+/**
+ * @brief Start the logger thread
+ * @return Status_t
+ */
+Status_t AsyncLogger::open()
+{
+  Status_t status;
+
+  if(m_thread != nullptr) { return STATUS_DRV_SUCCESS;}
+  if(m_output.getLinuxHandle() < 0) { return STATUS_DRV_NOT_CONFIGURED;}
+
+  m_terminate = false;
+  m_thread = new std::thread(&AsyncLogger::loggerThread, this);
+  if(m_use_default_attributes) { m_attributes = LinuxThreadAttributes::getDefaults();}
+  status = LinuxThreadAttributes::apply(*m_thread, m_attributes);
+  if(!status.success)
+  {
+    close();
+    return status;
+  }
+  return STATUS_DRV_SUCCESS;
+}
+
+/**
+ * @brief Write the records queued so far and stop the logger thread, later
+ *        records wait in the rings for the next open()
+ */
+void AsyncLogger::close()
+{
+  if(m_thread == nullptr) { return;}
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_terminate = true;
+  }
+  m_wake.notify_one();
+  m_thread->join();
+  delete m_thread;
+  m_thread = nullptr;
+}
+
+/**
+ * @brief Set the scheduling of the logger thread, applied on the next open()
+ * @param attributes Policy, priority and affinity
+ */
+void AsyncLogger::setThreadAttributes(const LinuxThreadAttributes_t &attributes)
+{
+  m_attributes = attributes;
+  m_use_default_attributes = false;
+}
+
+/**
+ * @brief Wait until the records queued before the call were written
+ */
+void AsyncLogger::flush()
+{
+  uint64_t ticket;
+
+  if(m_thread == nullptr) { return;}
+  std::unique_lock<std::mutex> lock(m_mutex);
+  ticket = ++m_flush_requested;
+  m_wake.notify_one();
+  m_flushed.wait(lock, [this, ticket] { return m_flush_done >= ticket;});
+}
+
+/**
+ * @brief Get the activity of the logger
+ * @param stats Storage for the counters
+ */
+void AsyncLogger::getStats(AsyncLoggerStats_t &stats)
+{
+  uint32_t ring_count = m_ring_count.load(std::memory_order_acquire);
+
+  stats.records = m_records.load(std::memory_order_relaxed);
+  stats.dropped = m_dropped.load(std::memory_order_relaxed);
+  for(uint32_t i = 0; i < ring_count; i++)
+  {
+    stats.dropped += m_rings[i].load(std::memory_order_acquire)->dropped.load(std::memory_order_relaxed);
+  }
+  stats.writes = m_writes.load(std::memory_order_relaxed);
+  stats.bytes = m_bytes.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Get the calling thread's ring, claiming one on first use
+ *
+ * @note Rings are found again by thread id, so a thread that logs through
+ *       more loggers than it remembers keeps its ring. A thread that exits
+ *       hands its rings back, the next thread without one takes them over,
+ *       records still in them included. The logger thread reads a ring the
+ *       same whoever writes it.
+ * @return AsyncLoggerRing_t* or nullptr when every ring is taken
+ */
+AsyncLoggerRing_t *AsyncLogger::getRing()
+{
+  thread_local uint64_t cached_ids[ASYNC_LOGGER_THREAD_CACHE] = {};
+  thread_local AsyncLoggerRing_t *cached_rings[ASYNC_LOGGER_THREAD_CACHE] = {};
+  thread_local AsyncLoggerClaims claims;
+  uint32_t slot = m_id % ASYNC_LOGGER_THREAD_CACHE;
+  AsyncLoggerRing_t *ring = nullptr, *free_ring = nullptr;
+  std::shared_ptr<AsyncLoggerRing_t> storage;
+  pid_t thread_id;
+  uint32_t ring_count;
+
+  if(cached_ids[slot] == m_id) { return cached_rings[slot];}
+
+  thread_id = gettid();
+  std::lock_guard<std::mutex> lock(m_ring_mutex);
+  ring_count = m_ring_count.load(std::memory_order_relaxed);
+  for(uint32_t i = 0; i < ring_count && ring == nullptr; i++)
+  {
+    pid_t owner = m_rings[i].load(std::memory_order_relaxed)->owner.load(std::memory_order_acquire);
+    if(owner == thread_id)
+    {
+      ring = m_rings[i];
+    }else if(owner == 0 && free_ring == nullptr)
+    {
+      free_ring = m_rings[i];
+      storage = m_ring_storage[i];
+    }
+  }
+  if(ring == nullptr && free_ring != nullptr)
+  {
+    ring = free_ring;
+    ring->owner.store(thread_id, std::memory_order_relaxed);
+    claims.add(storage);
+  }else if(ring == nullptr && ring_count < ASYNC_LOGGER_MAX_THREADS)
+  {
+    storage = std::make_shared<AsyncLoggerRing_t>();
+    ring = storage.get();
+    ring->owner = thread_id;
+    ring->head = 0;
+    ring->tail = 0;
+    ring->dropped = 0;
+    ring->dropped_reported = 0;
+    m_ring_storage.push_back(storage);
+    claims.add(storage);
+    m_rings[ring_count].store(ring, std::memory_order_release);
+    m_ring_count.store(ring_count + 1, std::memory_order_release);
+  }
+
+  // A thread without a ring looks again on its next record, one may have
+  // been handed back since
+  if(ring != nullptr)
+  {
+    cached_ids[slot] = m_id;
+    cached_rings[slot] = ring;
+  }
+  return ring;
+}
+
+/**
+ * @brief Wake the logger thread up if it sleeps
+ *
+ * @note Not taking the mutex may lose the wake up, the thread then comes
+ *       at the end of its period.
+ */
+void AsyncLogger::notify()
+{
+  if(m_is_waiting.load(std::memory_order_relaxed)) { m_wake.notify_one();}
+}
+
+/**
+ * @brief Logger thread, writes the rings out until close()
+ */
+void AsyncLogger::loggerThread(void)
+{
+  uint64_t requested;
+  bool terminate;
+
+  LinuxThreadAttributes::setUp("logger");
+  do
+  {
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      if(!m_terminate && m_flush_requested == m_flush_done)
+      {
+        m_is_waiting = true;
+        m_wake.wait_for(lock, std::chrono::milliseconds(ASYNC_LOGGER_PERIOD_MS));
+        m_is_waiting = false;
+      }
+      requested = m_flush_requested;
+      terminate = m_terminate;
+    }
+
+    drain();
+
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_flush_done = requested;
+    }
+    m_flushed.notify_all();
+  }while(!terminate);
+}
+
+/**
+ * @brief Format and write every record committed so far, oldest first
+ *        across the rings
+ */
+void AsyncLogger::drain()
+{
+  struct iovec lines[ASYNC_LOGGER_BATCH_MAX];
+  uint64_t heads[ASYNC_LOGGER_MAX_THREADS];
+  AsyncLoggerRing_t *rings[ASYNC_LOGGER_MAX_THREADS];
+  uint32_t ring_count = m_ring_count.load(std::memory_order_acquire);
+  AsyncLoggerRing_t *oldest;
+  uint64_t dropped, ring_dropped, tail, oldest_timestamp;
+  int count = 0;
+
+  // Records committed after the snapshot wait for the next pass, records
+  // dropped before it were dropped for want of room behind its records
+  for(uint32_t i = 0; i < ring_count; i++)
+  {
+    rings[i] = m_rings[i].load(std::memory_order_acquire);
+    heads[i] = rings[i]->head.load(std::memory_order_acquire);
+  }
+  ring_dropped = m_dropped.load(std::memory_order_relaxed);
+  dropped = ring_dropped - m_dropped_reported;
+  m_dropped_reported = ring_dropped;
+  for(uint32_t i = 0; i < ring_count; i++)
+  {
+    ring_dropped = rings[i]->dropped.load(std::memory_order_relaxed);
+    dropped += ring_dropped - rings[i]->dropped_reported;
+    rings[i]->dropped_reported = ring_dropped;
+  }
+
+  while(true)
+  {
+    oldest = nullptr;
+    oldest_timestamp = UINT64_MAX;
+    for(uint32_t i = 0; i < ring_count; i++)
+    {
+      tail = rings[i]->tail.load(std::memory_order_relaxed);
+      if(tail == heads[i]) { continue;}
+      if(rings[i]->records[tail & (ASYNC_LOGGER_RING_SIZE - 1)].timestamp < oldest_timestamp)
+      {
+        oldest = rings[i];
+        oldest_timestamp = oldest->records[tail & (ASYNC_LOGGER_RING_SIZE - 1)].timestamp;
+      }
+    }
+    if(oldest == nullptr) { break;}
+
+    // The slot goes back to its thread as soon as the line holds the text
+    tail = oldest->tail.load(std::memory_order_relaxed);
+    lines[count].iov_base = m_text[count];
+    lines[count].iov_len = format(oldest->records[tail & (ASYNC_LOGGER_RING_SIZE - 1)], m_text[count]);
+    oldest->tail.store(tail + 1, std::memory_order_release);
+    m_records.fetch_add(1, std::memory_order_relaxed);
+    count++;
+
+    if(count == ASYNC_LOGGER_BATCH_MAX)
+    {
+      writeLines(lines, count);
+      count = 0;
+    }
+  }
+
+  if(dropped != 0)
+  {
+    lines[count].iov_base = m_text[count];
+    lines[count].iov_len = formatDropped(dropped, m_text[count]);
+    count++;
+  }
+  if(count > 0) { writeLines(lines, count);}
+}
+
+/**
+ * @brief Format a record as a line
+ * @param record The record
+ * @param text Storage of ASYNC_LOGGER_LINE_SIZE bytes
+ * @return Size_t Length of the line
+ */
+Size_t AsyncLogger::format(const AsyncLoggerRecord_t &record, char *text)
+{
+  constexpr Size_t limit = ASYNC_LOGGER_LINE_SIZE - 3;   // Room for "\r\n" and the terminator
+  uint64_t elapsed_us = record.timestamp > m_start_ns ? (record.timestamp - m_start_ns) / 1000 : 0;
+  const char *cursor = record.format, *run_end, *spec_start;
+  char spec[32], string[ASYNC_LOGGER_STRING_SIZE + 1];
+  uint8_t arg = 0, size;
+  Size_t used, spec_size;
+  uint64_t value;
+  double number;
+  int result;
+
+  result = snprintf(text, limit + 1, "%llu.%06llu %c ", (unsigned long long) (elapsed_us / 1000000),
+                    (unsigned long long) (elapsed_us % 1000000), s_level_letters[record.level & 3]);
+  used = result > 0 ? result : 0;
+
+  while(*cursor != '\0' && used < limit)
+  {
+    if(*cursor != '%' || cursor[1] == '%')
+    {
+      if(*cursor == '%') { cursor++;}
+      run_end = strchrnul(cursor + 1, '%');
+      result = run_end - cursor < (long) (limit - used) ? run_end - cursor : limit - used;
+      memcpy(text + used, cursor, result);
+      used += result;
+      cursor = run_end;
+      continue;
+    }
+
+    // Flags, width and precision are kept, the length is set from the argument
+    spec_start = cursor++;
+    while(*cursor != '\0' && strchr("-+ #0", *cursor) != nullptr) { cursor++;}
+    while(*cursor >= '0' && *cursor <= '9') { cursor++;}
+    if(*cursor == '.') { cursor++;}
+    while(*cursor >= '0' && *cursor <= '9') { cursor++;}
+    spec_size = cursor - spec_start < (long) sizeof(spec) - 4 ? cursor - spec_start : sizeof(spec) - 4;
+    memcpy(spec, spec_start, spec_size);
+    while(*cursor != '\0' && strchr("hljztLq", *cursor) != nullptr) { cursor++;}
+    if(*cursor == '\0' || arg >= record.arg_count) { break;}
+
+    value = record.args[arg];
+    size = record.sizes[arg];
+    memcpy(&number, &value, sizeof(number));
+    if(record.types[arg] != LOG_ARG_DOUBLE) { number = record.types[arg] == LOG_ARG_INT ? (double) (int64_t) value : (double) value;}
+    if(record.types[arg] == LOG_ARG_DOUBLE) { value = (uint64_t) (int64_t) number;}
+    arg++;
+
+    switch(*cursor)
+    {
+      case 'd': case 'i': case 'u': case 'x': case 'X': case 'o':
+        // Cut back to the width of the argument, signed conversions extend its sign
+        if(size < sizeof(uint64_t))
+        {
+          value &= (1ULL << (8 * size)) - 1;
+          if((*cursor == 'd' || *cursor == 'i') && (value >> (8 * size - 1)) != 0) { value |= ~0ULL << (8 * size);}
+        }
+        spec[spec_size++] = 'l';
+        spec[spec_size++] = 'l';
+        spec[spec_size++] = *cursor;
+        spec[spec_size] = '\0';
+        result = snprintf(text + used, limit - used + 1, spec, (unsigned long long) value);
+        break;
+      case 'c':
+        spec[spec_size++] = 'c';
+        spec[spec_size] = '\0';
+        result = snprintf(text + used, limit - used + 1, spec, (int) value);
+        break;
+      case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+        spec[spec_size++] = *cursor;
+        spec[spec_size] = '\0';
+        result = snprintf(text + used, limit - used + 1, spec, number);
+        break;
+      case 's':
+        string[0] = '\0';
+        if(record.types[arg - 1] == LOG_ARG_STRING)
+        {
+          memcpy(string, record.strings + (value >> 16), value & 0xFFFF);
+          string[value & 0xFFFF] = '\0';
+        }
+        spec[spec_size++] = 's';
+        spec[spec_size] = '\0';
+        result = snprintf(text + used, limit - used + 1, spec, string);
+        break;
+      case 'p':
+        spec[spec_size++] = 'p';
+        spec[spec_size] = '\0';
+        result = snprintf(text + used, limit - used + 1, spec, (void *) (uintptr_t) value);
+        break;
+      default:
+        result = 0;
+        break;
+    }
+    cursor++;
+    if(result > 0) { used += (Size_t) result < limit - used ? (Size_t) result : limit - used;}
+  }
+
+  // Lines end the same whether the format ended them or not
+  while(used > 0 && (text[used - 1] == '\n' || text[used - 1] == '\r')) { used--;}
+  text[used++] = '\r';
+  text[used++] = '\n';
+  return used;
+}
+
+/**
+ * @brief Format the line standing for dropped records
+ * @param count Number of records dropped
+ * @param text Storage of ASYNC_LOGGER_LINE_SIZE bytes
+ * @return Size_t Length of the line
+ */
+Size_t AsyncLogger::formatDropped(uint64_t count, char *text)
+{
+  int result = snprintf(text, ASYNC_LOGGER_LINE_SIZE, "... %llu log records dropped\r\n", (unsigned long long) count);
+  return result > 0 ? result : 0;
+}
+
+/**
+ * @brief Hand lines to the kernel, a writev() at a time
+ *
+ * @note Lines of a failed write are lost, the logger has nowhere to report
+ *       it.
+ * @param lines The lines, advanced over partial writes
+ * @param count Number of lines
+ */
+void AsyncLogger::writeLines(struct iovec *lines, int count)
+{
+  int fd = m_output.getLinuxHandle();
+  struct pollfd poll_fd = {fd, POLLOUT, 0};
+  ssize_t result;
+
+  while(count > 0)
+  {
+    result = writev(fd, lines, count);
+    if(result < 0)
+    {
+      if(errno == EINTR) { continue;}
+      if(errno == EAGAIN && poll(&poll_fd, 1, ASYNC_LOGGER_WRITE_WAIT_MS) > 0) { continue;}
+      return;
+    }
+    m_writes.fetch_add(1, std::memory_order_relaxed);
+    m_bytes.fetch_add(result, std::memory_order_relaxed);
+    while(count > 0 && (size_t) result >= lines->iov_len)
+    {
+      result -= lines->iov_len;
+      lines++;
+      count--;
+    }
+    if(count > 0)
+    {
+      lines->iov_base = (uint8_t *) lines->iov_base + result;
+      lines->iov_len -= result;
+    }
+  }
+}
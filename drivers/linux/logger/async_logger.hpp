@@ -0,0 +1,318 @@
+/**
+ * @file async_logger.hpp
+ * @author your name (you@domain.com)
+ * @brief Logger that formats and writes its records on a background thread
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef DRIVERS_LINUX_LOGGER_ASYNC_LOGGER_HPP
+#define DRIVERS_LINUX_LOGGER_ASYNC_LOGGER_HPP
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "commons.hpp"
+#include "linux/utils/linux_serial_file.hpp"
+#include "linux/utils/linux_thread_attributes.hpp"
+#if __has_include("setup.hpp")
+#include "setup.hpp"
+#endif
+
+// Threads that may log through one logger at once, records of the others
+// are dropped until one of them exits
+#ifndef ASYNC_LOGGER_MAX_THREADS
+#define ASYNC_LOGGER_MAX_THREADS                                              32
+#endif
+
+// Records waiting in the ring of each thread, a power of 2
+#ifndef ASYNC_LOGGER_RING_SIZE
+#define ASYNC_LOGGER_RING_SIZE                                               256
+#endif
+
+// Arguments captured by a record
+#ifndef ASYNC_LOGGER_MAX_ARGS
+#define ASYNC_LOGGER_MAX_ARGS                                                  8
+#endif
+
+// Bytes of the string arguments of a record, longer strings are cut
+#ifndef ASYNC_LOGGER_STRING_SIZE
+#define ASYNC_LOGGER_STRING_SIZE                                              64
+#endif
+
+// Longest line written, longer lines are cut
+#ifndef ASYNC_LOGGER_LINE_SIZE
+#define ASYNC_LOGGER_LINE_SIZE                                               256
+#endif
+
+// Lines handed to the kernel by one writev()
+#ifndef ASYNC_LOGGER_BATCH_MAX
+#define ASYNC_LOGGER_BATCH_MAX                                                64
+#endif
+
+// Longest time a record waits before the thread looks at the rings
+#ifndef ASYNC_LOGGER_PERIOD_MS
+#define ASYNC_LOGGER_PERIOD_MS                                                10
+#endif
+
+static_assert((ASYNC_LOGGER_RING_SIZE & (ASYNC_LOGGER_RING_SIZE - 1)) == 0, "ASYNC_LOGGER_RING_SIZE must be a power of 2");
+
+/**
+ * @brief Severity of a record
+ */
+typedef enum
+{
+  LOG_LEVEL_DEBUG,
+  LOG_LEVEL_INFO,
+  LOG_LEVEL_WARNING,
+  LOG_LEVEL_ERROR,
+}LogLevel_t;
+
+/**
+ * @brief Type of a captured argument
+ */
+typedef enum : uint8_t
+{
+  LOG_ARG_INT,
+  LOG_ARG_UINT,
+  LOG_ARG_DOUBLE,
+  LOG_ARG_STRING,         /*!< Copied, offset << 16 | length in the string area */
+  LOG_ARG_POINTER,
+}LogArgType_t;
+
+/**
+ * @brief A log call, stored as given: the format is kept by address, the
+ *        arguments by value
+ */
+typedef struct
+{
+  uint64_t timestamp;                             /*!< Nanoseconds of the monotonic clock */
+  const char *format;
+  uint8_t level;
+  uint8_t arg_count;
+  uint16_t string_size;                           /*!< Bytes of the string area in use */
+  LogArgType_t types[ASYNC_LOGGER_MAX_ARGS];
+  uint8_t sizes[ASYNC_LOGGER_MAX_ARGS];           /*!< Bytes of the arguments as given, integers are cut back to it */
+  uint64_t args[ASYNC_LOGGER_MAX_ARGS];
+  char strings[ASYNC_LOGGER_STRING_SIZE];
+}AsyncLoggerRecord_t;
+
+/**
+ * @brief Records of one thread, the indexes run freely and are masked on
+ *        access
+ */
+typedef struct
+{
+  std::atomic<pid_t> owner;                       /*!< Thread writing it, 0 once that thread exited */
+  std::atomic<uint64_t> head;                     /*!< Written by the owner */
+  std::atomic<uint64_t> tail;                     /*!< Written by the logger thread */
+  std::atomic<uint64_t> dropped;                  /*!< Records lost to a full ring */
+  uint64_t dropped_reported;                      /*!< Logger thread only */
+  AsyncLoggerRecord_t records[ASYNC_LOGGER_RING_SIZE];
+}AsyncLoggerRing_t;
+
+/**
+ * @brief Activity of a logger
+ */
+typedef struct
+{
+  uint64_t records;           /*!< Records written */
+  uint64_t dropped;           /*!< Records lost to full rings or too many threads */
+  uint64_t writes;            /*!< System calls that wrote them */
+  uint64_t bytes;             /*!< Bytes written */
+}AsyncLoggerStats_t;
+
+/**
+ * @brief Logs printf-style lines without formatting or writing them on the
+ *        calling thread
+ *
+ * @note A log call copies the format address, the arguments and a time
+ *       stamp into a ring of the calling thread, with no lock and no system
+ *       call. The format must be a string literal or outlive the logger,
+ *       string arguments are copied. A ring goes to the next thread that
+ *       needs one once its thread exits. A thread of the logger formats the
+ *       records of every ring in time order and writes them to the file of a
+ *       LinuxSerialFile, e.g. StdInOut, up to ASYNC_LOGGER_BATCH_MAX lines
+ *       per writev(). It looks at the rings every ASYNC_LOGGER_PERIOD_MS, or
+ *       sooner once a ring is half full. A full ring drops new records
+ *       instead of blocking, the count is written in place of the records
+ *       lost. Conversions take flags, width and precision but not '*', and
+ *       print integers at the width they were given, as printf does.
+ *
+ * @code
+ * StdInOut terminal;
+ * terminal.configure(nullptr, 0);
+ * AsyncLogger logger(terminal);
+ * logger.open();
+ * logger.log(LOG_LEVEL_INFO, "loop %u took %.3f ms on %s", cycle, elapsed, name);
+ * @endcode
+ */
+class AsyncLogger
+{
+public:
+  AsyncLogger(LinuxSerialFile &output);
+  ~AsyncLogger();
+
+  Status_t open();
+
+  void close();
+
+  bool isOpen() { return m_thread != nullptr;}
+
+  void setThreadAttributes(const LinuxThreadAttributes_t &attributes);
+
+  void setLevel(LogLevel_t level) { m_level = level;}
+
+  template <typename... ARGS>
+  Status_t log(LogLevel_t level, const char *format, ARGS... args);
+
+  void flush();
+
+  void getStats(AsyncLoggerStats_t &stats);
+
+private:
+  LinuxSerialFile &m_output;
+  uint64_t m_id;                                  /*!< Tells loggers apart in the thread caches */
+  std::atomic<AsyncLoggerRing_t *> m_rings[ASYNC_LOGGER_MAX_THREADS];
+  std::vector<std::shared_ptr<AsyncLoggerRing_t>> m_ring_storage;   /*!< Shared with the threads writing them */
+  std::atomic<uint32_t> m_ring_count;
+  std::mutex m_ring_mutex;                        /*!< Taken only to claim a ring */
+  std::atomic<LogLevel_t> m_level;
+  std::atomic<uint64_t> m_dropped;                /*!< Records of threads without a ring */
+  uint64_t m_dropped_reported;                    /*!< Logger thread only */
+  std::atomic<uint64_t> m_records;
+  std::atomic<uint64_t> m_writes;
+  std::atomic<uint64_t> m_bytes;
+  uint64_t m_start_ns;
+  LinuxThreadAttributes_t m_attributes;
+  bool m_use_default_attributes;
+  std::thread *m_thread;
+  std::atomic<bool> m_terminate;
+  std::atomic<bool> m_is_waiting;                 /*!< The thread sleeps on m_wake */
+  std::mutex m_mutex;
+  std::condition_variable m_wake;
+  std::condition_variable m_flushed;
+  uint64_t m_flush_requested;
+  uint64_t m_flush_done;
+  char m_text[ASYNC_LOGGER_BATCH_MAX][ASYNC_LOGGER_LINE_SIZE];
+
+  AsyncLoggerRing_t *getRing();
+
+  void notify();
+
+  void loggerThread(void);
+
+  void drain();
+
+  Size_t format(const AsyncLoggerRecord_t &record, char *text);
+
+  Size_t formatDropped(uint64_t count, char *text);
+
+  void writeLines(struct iovec *lines, int count);
+
+  /**
+   * @brief Store an argument in a record
+   * @tparam ARG Type of the argument
+   * @param record The record
+   * @param value The argument
+   */
+  template <typename ARG>
+  static void capture(AsyncLoggerRecord_t &record, ARG value)
+  {
+    uint8_t index = record.arg_count;
+    Size_t length;
+
+    record.sizes[index] = sizeof(uint64_t);
+    if constexpr(std::is_enum_v<ARG>)
+    {
+      capture(record, (std::underlying_type_t<ARG>) value);
+      return;
+    }else if constexpr(std::is_same_v<ARG, const char *> || std::is_same_v<ARG, char *>)
+    {
+      length = value != nullptr ? strnlen(value, ASYNC_LOGGER_STRING_SIZE - record.string_size) : 0;
+      memcpy(record.strings + record.string_size, value, length);
+      record.types[index] = LOG_ARG_STRING;
+      record.args[index] = (uint64_t) record.string_size << 16 | length;
+      record.string_size += length;
+    }else if constexpr(std::is_floating_point_v<ARG>)
+    {
+      double number = value;
+      record.types[index] = LOG_ARG_DOUBLE;
+      memcpy(&record.args[index], &number, sizeof(number));
+    }else if constexpr(std::is_pointer_v<ARG>)
+    {
+      record.types[index] = LOG_ARG_POINTER;
+      record.args[index] = (uint64_t) (uintptr_t) value;
+    }else
+    {
+      static_assert(std::is_integral_v<ARG>, "Log arguments are numbers, pointers or strings");
+      record.types[index] = std::is_signed_v<ARG> ? LOG_ARG_INT : LOG_ARG_UINT;
+      // As printf gets them, narrower integers are promoted to int
+      record.sizes[index] = sizeof(ARG) < sizeof(int) ? sizeof(int) : sizeof(ARG);
+      record.args[index] = (uint64_t) value;
+    }
+    record.arg_count++;
+  }
+};
+
+/**
+ * @brief Queue a line, formatted later on the logger thread
+ * @tparam ARGS Types of the arguments
+ * @param level Severity, records under the logger level are discarded
+ * @param format printf-style format, must outlive the logger
+ * @param args Numbers, pointers or strings
+ * @return Status_t STATUS_DRV_ERR_BUSY if the record was dropped
+ */
+template <typename... ARGS>
+Status_t AsyncLogger::log(LogLevel_t level, const char *format, ARGS... args)
+{
+  static_assert(sizeof...(ARGS) <= ASYNC_LOGGER_MAX_ARGS, "Too many log arguments, see ASYNC_LOGGER_MAX_ARGS");
+  AsyncLoggerRing_t *ring;
+  uint64_t head, tail;
+
+  if(level < m_level.load(std::memory_order_relaxed)) { return STATUS_DRV_SUCCESS;}
+  ring = getRing();
+  if(ring == nullptr)
+  {
+    m_dropped.fetch_add(1, std::memory_order_relaxed);
+    return STATUS_DRV_ERR_BUSY;
+  }
+
+  head = ring->head.load(std::memory_order_relaxed);
+  tail = ring->tail.load(std::memory_order_acquire);
+  if(head - tail >= ASYNC_LOGGER_RING_SIZE)
+  {
+    ring->dropped.fetch_add(1, std::memory_order_relaxed);
+    return STATUS_DRV_ERR_BUSY;
+  }
+
+  AsyncLoggerRecord_t &record = ring->records[head & (ASYNC_LOGGER_RING_SIZE - 1)];
+  record.timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+  record.format = format;
+  record.level = level;
+  record.arg_count = 0;
+  record.string_size = 0;
+  (capture(record, args), ...);
+  ring->head.store(head + 1, std::memory_order_release);
+
+  // Below half a ring the thread comes on its own, a system call is saved
+  if(head - tail + 1 == ASYNC_LOGGER_RING_SIZE / 2) { notify();}
+  return STATUS_DRV_SUCCESS;
+}
+
+#endif /* DRIVERS_LINUX_LOGGER_ASYNC_LOGGER_HPP */
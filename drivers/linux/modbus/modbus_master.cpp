@@ -0,0 +1,678 @@
+/**
+ * @file modbus_master.cpp
+ * @author your name (you@domain.com)
+ * @brief Modbus RTU master on a UART
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "linux/modbus/modbus_master.hpp"
+#include "checksum/checksum.hpp"
+
+#include <string.h>
+#include <time.h>
+#include <sys/prctl.h>
+#include <chrono>
+
+constexpr uint8_t MODBUS_EXCEPTION_FLAG = 0x80;
+constexpr Size_t MODBUS_ADU_SIZE_MAX = 256;
+constexpr Size_t MODBUS_EXCEPTION_SIZE = 5;
+constexpr uint16_t MODBUS_READ_REGISTERS_MAX = 125;
+constexpr uint16_t MODBUS_READ_BITS_MAX = 2000;
+constexpr uint16_t MODBUS_WRITE_REGISTERS_MAX = 123;
+constexpr uint16_t MODBUS_WRITE_BITS_MAX = 1968;
+constexpr uint32_t MODBUS_FIXED_BAUD_MIN = 19200;
+constexpr uint32_t MODBUS_FIXED_FRAME_DELAY_US = 1750;
+
+static bool isRead(uint8_t function)
+{
+  return function == MODBUS_READ_COILS || function == MODBUS_READ_DISCRETE_INPUTS ||
+         function == MODBUS_READ_HOLDING_REGISTERS || function == MODBUS_READ_INPUT_REGISTERS;
+}
+
+static bool isBitAccess(uint8_t function)
+{
+  return function == MODBUS_READ_COILS || function == MODBUS_READ_DISCRETE_INPUTS ||
+         function == MODBUS_WRITE_SINGLE_COIL || function == MODBUS_WRITE_MULTIPLE_COILS;
+}
+
+/**
+ * @brief Get the size of the response a request calls for
+ * @param function The function code
+ * @param count Registers or coils read
+ * @return Size_t
+ */
+static Size_t getResponseSize(uint8_t function, uint16_t count)
+{
+  switch(function)
+  {
+    case MODBUS_READ_COILS:
+    case MODBUS_READ_DISCRETE_INPUTS:
+      return 5 + (count + 7) / 8;
+    case MODBUS_READ_HOLDING_REGISTERS:
+    case MODBUS_READ_INPUT_REGISTERS:
+      return 5 + 2 * count;
+    default:
+      // Writes echo the address and the value or count
+      return 8;
+  }
+}
+
+/**
+ * @brief Constructor
+ * @param uart The port, configured in blocking mode and without checksum,
+ *        must outlive the master
+ */
+ModbusMaster::ModbusMaster(UART &uart) : m_uart(uart)
+{
+  m_attributes = LinuxThreadAttributes::getDefaults();
+  m_use_default_attributes = true;
+  m_thread = nullptr;
+  m_terminate = false;
+  m_queue.reserve(MODBUS_QUEUE_SIZE);
+  memset(m_slave_stats, 0, sizeof(m_slave_stats));
+  memset(&m_stats, 0, sizeof(m_stats));
+  m_response_timeout_us = MODBUS_RESPONSE_TIMEOUT_US;
+  m_frame_delay_us = MODBUS_FIXED_FRAME_DELAY_US;
+  m_idle_us = MODBUS_RTU_IDLE_MIN_US;
+  m_line_idle_ns = 0;
+  m_frame.resize(MODBUS_ADU_SIZE_MAX);
+}
+
+/**
+ * @brief Destructor, queued requests fail
+ */
+ModbusMaster::~ModbusMaster()
+{
+  close();
+  for(DriverStats *stats : m_slave_stats) { delete stats;}
+}
+
+/**
+ * @brief Start the worker, the timing is derived from the baud rate the
+ *        UART has at this point
+ * @return Status_t
+ */
+Status_t ModbusMaster::open()
+{
+  Status_t status;
+  uint32_t character_ns = m_uart.getCharacterTimeNs();
+
+  if(m_thread != nullptr) { return STATUS_DRV_SUCCESS;}
+  if(character_ns == 0) { return STATUS_DRV_NOT_CONFIGURED;}
+
+  if(MODBUS_RTU_FIXED_DELAYS && m_uart.getBaudRate() > MODBUS_FIXED_BAUD_MIN)
+  {
+    m_frame_delay_us = MODBUS_FIXED_FRAME_DELAY_US;
+  }else
+  {
+    m_frame_delay_us = (uint32_t) (((uint64_t) character_ns * 35 / 10 + 999) / 1000);
+  }
+  m_idle_us = m_frame_delay_us > MODBUS_RTU_IDLE_MIN_US ? m_frame_delay_us : MODBUS_RTU_IDLE_MIN_US;
+  m_line_idle_ns = getTimeNs();
+
+  m_terminate = false;
+  m_thread = new std::thread(&ModbusMaster::workerThread, this);
+  if(m_use_default_attributes) { m_attributes = LinuxThreadAttributes::getDefaults();}
+  status = LinuxThreadAttributes::apply(*m_thread, m_attributes);
+  if(!status.success)
+  {
+    close();
+    return status;
+  }
+  return STATUS_DRV_SUCCESS;
+}
+
+/**
+ * @brief Stop the worker, queued requests fail
+ */
+void ModbusMaster::close()
+{
+  std::vector<ModbusPending_t> pending;
+  Status_t status;
+
+  if(m_thread != nullptr)
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_terminate = true;
+    }
+    m_condition.notify_one();
+    m_thread->join();
+    delete m_thread;
+    m_thread = nullptr;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    pending.swap(m_queue);
+    m_queue.reserve(MODBUS_QUEUE_SIZE);
+  }
+  SET_STATUS(status, false, SRC_DRIVER, ERR_FAILED, (char *)"The Modbus master was closed.\r\n");
+  for(ModbusPending_t &request : pending) { finish(request, status);}
+}
+
+/**
+ * @brief Set the scheduling of the worker, must be called before open(),
+ *        LinuxThreadAttributes::getDefaults() is used otherwise
+ * @param attributes Policy, priority and CPU affinity
+ */
+void ModbusMaster::setThreadAttributes(const LinuxThreadAttributes_t &attributes)
+{
+  m_attributes = attributes;
+  m_use_default_attributes = false;
+}
+
+/**
+ * @brief Check a request before queueing it
+ * @param request The request
+ * @return Status_t
+ */
+Status_t ModbusMaster::check(const ModbusRequest_t &request)
+{
+  uint16_t count_max;
+
+  if(request.slave > MODBUS_SLAVE_MAX) { return STATUS_DRV_ERR_PARAM;}
+  if(request.values == nullptr) { return STATUS_DRV_NULL_POINTER;}
+  switch(request.function)
+  {
+    case MODBUS_READ_COILS:
+    case MODBUS_READ_DISCRETE_INPUTS:
+      count_max = MODBUS_READ_BITS_MAX;
+      break;
+    case MODBUS_READ_HOLDING_REGISTERS:
+    case MODBUS_READ_INPUT_REGISTERS:
+      count_max = MODBUS_READ_REGISTERS_MAX;
+      break;
+    case MODBUS_WRITE_SINGLE_COIL:
+    case MODBUS_WRITE_SINGLE_REGISTER:
+      count_max = 1;
+      break;
+    case MODBUS_WRITE_MULTIPLE_COILS:
+      count_max = MODBUS_WRITE_BITS_MAX;
+      break;
+    case MODBUS_WRITE_MULTIPLE_REGISTERS:
+      count_max = MODBUS_WRITE_REGISTERS_MAX;
+      break;
+    default:
+      return STATUS_DRV_ERR_PARAM;
+  }
+  // Nobody answers a broadcast, only writes make sense
+  if(request.slave == MODBUS_BROADCAST && isRead(request.function)) { return STATUS_DRV_ERR_PARAM;}
+  if(request.count == 0 || request.count > count_max) { return STATUS_DRV_ERR_PARAM_SIZE;}
+  if((uint32_t) request.address + request.count > 0x10000) { return STATUS_DRV_ERR_PARAM_SIZE;}
+  return STATUS_DRV_SUCCESS;
+}
+
+/**
+ * @brief Queue a request
+ * @param request The request, copied, its values must stay valid until it
+ *        completes
+ * @return DriverToken completed with the request, its byte count is the
+ *         number of registers or coils transferred
+ */
+DriverToken ModbusMaster::submit(const ModbusRequest_t &request)
+{
+  ModbusPending_t pending;
+  DriverToken token;
+  Status_t status;
+
+  status = check(request);
+  if(!status.success) { return DriverToken(status);}
+
+  token = DriverToken::create(isRead(request.function) ? EVENT_READ : EVENT_WRITE, Buffer_t());
+  if(!token.valid()) { return token;}
+
+  pending.request = request;
+  pending.submit_ns = getTimeNs();
+  pending.completion = token.attach();
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if(m_thread == nullptr)
+    {
+      status = STATUS_DRV_NOT_CONFIGURED;
+    }else if(m_queue.size() >= MODBUS_QUEUE_SIZE)
+    {
+      status = STATUS_DRV_ERR_BUSY;
+    }else
+    {
+      if(m_slave_stats[request.slave] == nullptr) { m_slave_stats[request.slave] = new DriverStats();}
+      pending.slave_stats = m_slave_stats[request.slave];
+      m_queue.push_back(pending);
+    }
+  }
+  if(!status.success)
+  {
+    DriverToken::complete(pending.completion, {0, status, 0, EVENT_READ_WRITE});
+    return token;
+  }
+  m_condition.notify_one();
+  return token;
+}
+
+/**
+ * @brief Run a request and wait for it
+ * @param request The request
+ * @return Status_t
+ */
+Status_t ModbusMaster::transfer(const ModbusRequest_t &request)
+{
+  DriverToken token = submit(request);
+  return token.wait();
+}
+
+/**
+ * @brief Read holding registers and wait for them
+ * @param slave The slave, 1 to 247
+ * @param address First register
+ * @param count Number of registers, up to 125
+ * @param values Storage for the registers
+ * @return Status_t
+ */
+Status_t ModbusMaster::readHoldingRegisters(uint8_t slave, uint16_t address, uint16_t count, uint16_t *values)
+{
+  return transfer({slave, MODBUS_READ_HOLDING_REGISTERS, address, count, values, nullptr, 0});
+}
+
+/**
+ * @brief Read input registers and wait for them
+ * @param slave The slave, 1 to 247
+ * @param address First register
+ * @param count Number of registers, up to 125
+ * @param values Storage for the registers
+ * @return Status_t
+ */
+Status_t ModbusMaster::readInputRegisters(uint8_t slave, uint16_t address, uint16_t count, uint16_t *values)
+{
+  return transfer({slave, MODBUS_READ_INPUT_REGISTERS, address, count, values, nullptr, 0});
+}
+
+/**
+ * @brief Write a register and wait for the slave to confirm it
+ * @param slave The slave, MODBUS_BROADCAST for all
+ * @param address The register
+ * @param value The value
+ * @return Status_t
+ */
+Status_t ModbusMaster::writeRegister(uint8_t slave, uint16_t address, uint16_t value)
+{
+  return transfer({slave, MODBUS_WRITE_SINGLE_REGISTER, address, 1, &value, nullptr, 0});
+}
+
+/**
+ * @brief Write consecutive registers and wait for the slave to confirm them
+ * @param slave The slave, MODBUS_BROADCAST for all
+ * @param address First register
+ * @param count Number of registers, up to 123
+ * @param values The values
+ * @return Status_t
+ */
+Status_t ModbusMaster::writeRegisters(uint8_t slave, uint16_t address, uint16_t count, const uint16_t *values)
+{
+  return transfer({slave, MODBUS_WRITE_MULTIPLE_REGISTERS, address, count, (uint16_t *) values, nullptr, 0});
+}
+
+/**
+ * @brief Get the activity of the master
+ * @return ModbusMasterStats_t
+ */
+ModbusMasterStats_t ModbusMaster::getStats()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_stats;
+}
+
+/**
+ * @brief Get the counters and latencies of a slave
+ *
+ * @note Writes count frames sent and reads responses, the syscall latency
+ *       is the round trip and the queue wait the time before it started.
+ * @param slave The slave
+ * @param snapshot Storage for the counters
+ * @return true if the slave was addressed and statistics are enabled
+ */
+bool ModbusMaster::getSlaveStats(uint8_t slave, DriverStatsSnapshot_t &snapshot)
+{
+  DriverStats *stats;
+
+  if(slave > MODBUS_SLAVE_MAX) { return false;}
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    stats = m_slave_stats[slave];
+  }
+  if(stats == nullptr) { return false;}
+  return stats->getSnapshot(snapshot);
+}
+
+/**
+ * @brief Get the time on the clock of the master
+ * @return uint64_t Nanoseconds
+ */
+uint64_t ModbusMaster::getTimeNs()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief Worker thread, runs the queued requests one transaction at a time
+ */
+void ModbusMaster::workerThread(void)
+{
+  std::unique_lock<std::mutex> locker(m_mutex);
+  ModbusPending_t batch[MODBUS_COALESCE_MAX];
+  uint16_t batch_size, first, count;
+
+  LinuxThreadAttributes::setUp("modbus");
+  // Frame delays are a few hundred microseconds, the default slack is 50
+  (void) prctl(PR_SET_TIMERSLACK, 1UL);
+  while(true)
+  {
+    m_condition.wait(locker, [this] { return m_terminate || !m_queue.empty();});
+    if(m_terminate) { break;}
+    batch_size = takeBatch(batch, first, count);
+    locker.unlock();
+    (void) execute(batch, batch_size, first, count);
+    locker.lock();
+  }
+}
+
+/**
+ * @brief Take the oldest request and the reads that can share its
+ *        transaction, called with the lock held
+ * @param batch Storage for the requests, the oldest first
+ * @param first Storage for the first register or coil of the transaction
+ * @param count Storage for the registers or coils of the transaction
+ * @return Number of requests taken
+ */
+uint16_t ModbusMaster::takeBatch(ModbusPending_t *batch, uint16_t &first, uint16_t &count)
+{
+  uint16_t batch_size = 1;
+  uint32_t low, high;
+  size_t i = 0;
+
+  batch[0] = m_queue.front();
+  m_queue.erase(m_queue.begin());
+  const ModbusRequest_t &head = batch[0].request;
+  first = head.address;
+  count = head.count;
+  if(!isRead(head.function)) { return batch_size;}
+
+  while(i < m_queue.size() && batch_size < MODBUS_COALESCE_MAX)
+  {
+    const ModbusRequest_t &other = m_queue[i].request;
+    // A read never moves ahead of a write that may change what it reads
+    if((other.slave == head.slave || other.slave == MODBUS_BROADCAST) && !isRead(other.function)) { break;}
+    if(other.slave == head.slave && other.function == head.function &&
+       (uint32_t) other.address <= (uint32_t) first + count + MODBUS_COALESCE_GAP_MAX &&
+       (uint32_t) other.address + other.count + MODBUS_COALESCE_GAP_MAX >= first)
+    {
+      low = other.address < first ? other.address : first;
+      high = (uint32_t) other.address + other.count > (uint32_t) first + count ? (uint32_t) other.address + other.count : (uint32_t) first + count;
+      if(high - low <= (isBitAccess(head.function) ? MODBUS_READ_BITS_MAX : MODBUS_READ_REGISTERS_MAX))
+      {
+        batch[batch_size++] = m_queue[i];
+        m_queue.erase(m_queue.begin() + i);
+        first = (uint16_t) low;
+        count = (uint16_t) (high - low);
+        m_stats.coalesced++;
+        continue;
+      }
+    }
+    i++;
+  }
+  return batch_size;
+}
+
+/**
+ * @brief Build the frame of a request in m_frame
+ * @param request The request
+ * @param first First register or coil, differs from the request's when
+ *        reads were merged
+ * @param count Registers or coils
+ * @return Size of the frame, CRC included
+ */
+Size_t ModbusMaster::buildRequest(const ModbusRequest_t &request, uint16_t first, uint16_t count)
+{
+  uint8_t *frame = m_frame.data();
+  Size_t size = 0;
+  uint16_t value;
+
+  frame[size++] = request.slave;
+  frame[size++] = request.function;
+  frame[size++] = (uint8_t) (first >> 8);
+  frame[size++] = (uint8_t) first;
+  switch(request.function)
+  {
+    case MODBUS_WRITE_SINGLE_COIL:
+      value = request.values[0] != 0 ? 0xFF00 : 0x0000;
+      frame[size++] = (uint8_t) (value >> 8);
+      frame[size++] = (uint8_t) value;
+      break;
+    case MODBUS_WRITE_SINGLE_REGISTER:
+      frame[size++] = (uint8_t) (request.values[0] >> 8);
+      frame[size++] = (uint8_t) request.values[0];
+      break;
+    case MODBUS_WRITE_MULTIPLE_COILS:
+      frame[size++] = (uint8_t) (count >> 8);
+      frame[size++] = (uint8_t) count;
+      frame[size++] = (uint8_t) ((count + 7) / 8);
+      memset(frame + size, 0, (count + 7) / 8);
+      for(uint16_t i = 0; i < count; i++)
+      {
+        if(request.values[i] != 0) { frame[size + i / 8] |= (uint8_t) (1 << (i % 8));}
+      }
+      size += (count + 7) / 8;
+      break;
+    case MODBUS_WRITE_MULTIPLE_REGISTERS:
+      frame[size++] = (uint8_t) (count >> 8);
+      frame[size++] = (uint8_t) count;
+      frame[size++] = (uint8_t) (2 * count);
+      for(uint16_t i = 0; i < count; i++)
+      {
+        frame[size++] = (uint8_t) (request.values[i] >> 8);
+        frame[size++] = (uint8_t) request.values[i];
+      }
+      break;
+    default:
+      frame[size++] = (uint8_t) (count >> 8);
+      frame[size++] = (uint8_t) count;
+      break;
+  }
+  return Checksum::append(CHECKSUM_CRC16_MODBUS, frame, size);
+}
+
+/**
+ * @brief Sleep until the line has been silent for 3.5 characters
+ */
+void ModbusMaster::waitForSilence()
+{
+  uint64_t deadline_ns = m_line_idle_ns + (uint64_t) m_frame_delay_us * 1000;
+  struct timespec deadline;
+
+  if(getTimeNs() >= deadline_ns) { return;}
+  deadline.tv_sec = deadline_ns / 1000000000;
+  deadline.tv_nsec = deadline_ns % 1000000000;
+  // steady_clock is CLOCK_MONOTONIC
+  while(clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, nullptr) == EINTR) {}
+}
+
+/**
+ * @brief Receive the response to the request in m_frame, into m_frame
+ *
+ * @note The first 5 bytes tell an exception, which ends there, from a
+ *       normal response, the rest follows within the idle time.
+ * @param request The request
+ * @param expected_size Size of a normal response
+ * @param timeout_us Time the slave has to start its response
+ * @param received_size Storage for the number of bytes received
+ * @return Status_t
+ */
+Status_t ModbusMaster::receive(const ModbusRequest_t &request, Size_t expected_size, uint32_t timeout_us, Size_t &received_size)
+{
+  Status_t status;
+  uint8_t echo[4];
+  uint8_t *response = m_frame.data();
+
+  // Writes echo the address and the value or count of the request
+  memcpy(echo, response + 2, sizeof(echo));
+  received_size = 0;
+  status = m_uart.readFrame(response, MODBUS_EXCEPTION_SIZE, timeout_us, m_idle_us);
+  received_size = m_uart.getBytesRead();
+  if(received_size == 0)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stats.timeouts++;
+    return STATUS_DRV_ERR_TIMEOUT;
+  }
+  if(!status.success) { return status;}
+
+  if(received_size == MODBUS_EXCEPTION_SIZE && response[0] == request.slave &&
+     response[1] == (request.function | MODBUS_EXCEPTION_FLAG))
+  {
+    if(!Checksum::verify(CHECKSUM_CRC16_MODBUS, response, MODBUS_EXCEPTION_SIZE))
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_stats.crc_errors++;
+      SET_STATUS(status, false, SRC_DRIVER, ERR_CRC, (char *)"The CRC of the Modbus response does not match.\r\n");
+      return status;
+    }
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_stats.exceptions++;
+    }
+    SET_STATUS(status, false, SRC_DRIVER, ERR_COMMAND, (char *)"The Modbus slave answered with an exception.\r\n");
+    return status;
+  }
+
+  if(received_size == MODBUS_EXCEPTION_SIZE && expected_size > MODBUS_EXCEPTION_SIZE)
+  {
+    status = m_uart.readFrame(response + MODBUS_EXCEPTION_SIZE, expected_size - MODBUS_EXCEPTION_SIZE, m_idle_us, m_idle_us);
+    received_size += m_uart.getBytesRead();
+  }
+  if(received_size == expected_size && !Checksum::verify(CHECKSUM_CRC16_MODBUS, response, expected_size))
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stats.crc_errors++;
+    SET_STATUS(status, false, SRC_DRIVER, ERR_CRC, (char *)"The CRC of the Modbus response does not match.\r\n");
+    return status;
+  }
+  if(received_size != expected_size || response[0] != request.slave || response[1] != request.function ||
+     (isRead(request.function) && response[2] != expected_size - 5) ||
+     (!isRead(request.function) && memcmp(response + 2, echo, sizeof(echo)) != 0))
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stats.malformed++;
+    SET_STATUS(status, false, SRC_DRIVER, ERR_RECEPTION, (char *)"The Modbus response does not match the request.\r\n");
+    return status;
+  }
+  return STATUS_DRV_SUCCESS;
+}
+
+/**
+ * @brief Run one transaction and complete the requests it serves
+ * @param batch The requests, the first one gives the slave and function
+ * @param batch_size Number of requests
+ * @param first First register or coil of the transaction
+ * @param count Registers or coils of the transaction
+ * @return Status_t
+ */
+Status_t ModbusMaster::execute(ModbusPending_t *batch, uint16_t batch_size, uint16_t first, uint16_t count)
+{
+  DRIVER_TRACE_SCOPE("modbus", "transaction");
+  const ModbusRequest_t &head = batch[0].request;
+  DriverStats *stats = batch[0].slave_stats;
+  uint8_t stale[64];
+  Size_t frame_size, expected_size, received_size = 0;
+  uint32_t offset, bit;
+  uint64_t start;
+  Status_t status;
+
+  // Late responses to earlier requests would be taken for this one
+  while(m_uart.read(stale, sizeof(stale), 0).success && m_uart.getBytesRead() > 0)
+  {
+    m_line_idle_ns = getTimeNs();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stats.stale_bytes += m_uart.getBytesRead();
+  }
+
+  frame_size = buildRequest(head, first, count);
+  expected_size = getResponseSize(head.function, count);
+  waitForSilence();
+
+  start = getTimeNs();
+  for(uint16_t i = 0; i < batch_size; i++) { stats->recordLatency(DRIVER_LATENCY_QUEUE_WAIT, start - batch[i].submit_ns);}
+  status = m_uart.write(m_frame.data(), frame_size);
+  stats->countWrite(status, frame_size);
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stats.transactions++;
+  }
+  if(status.success && head.slave == MODBUS_BROADCAST)
+  {
+    // The next frame waits for the turnaround instead of the frame delay
+    m_line_idle_ns = getTimeNs();
+    if(MODBUS_TURNAROUND_US > m_frame_delay_us) { m_line_idle_ns += (uint64_t) (MODBUS_TURNAROUND_US - m_frame_delay_us) * 1000;}
+    finish(batch[0], status);
+    return status;
+  }
+  if(status.success)
+  {
+    status = receive(head, expected_size, head.timeout_us != 0 ? head.timeout_us : m_response_timeout_us, received_size);
+  }
+  m_line_idle_ns = getTimeNs();
+  stats->countRead(status, received_size);
+  stats->recordLatency(DRIVER_LATENCY_SYSCALL, m_line_idle_ns - start);
+
+  // The exception may come from a register only the merge asked for
+  if(status.code == ERR_COMMAND && batch_size > 1)
+  {
+    for(uint16_t i = 0; i < batch_size; i++) { (void) execute(&batch[i], 1, batch[i].request.address, batch[i].request.count);}
+    return status;
+  }
+
+  for(uint16_t i = 0; i < batch_size; i++)
+  {
+    ModbusRequest_t &request = batch[i].request;
+    if(request.exception != nullptr)
+    {
+      *request.exception = status.code == ERR_COMMAND ? m_frame[2] : 0;
+    }
+    if(status.success && isRead(request.function))
+    {
+      offset = request.address - first;
+      for(uint16_t j = 0; j < request.count; j++)
+      {
+        if(isBitAccess(request.function))
+        {
+          bit = offset + j;
+          request.values[j] = (m_frame[3 + bit / 8] >> (bit % 8)) & 1;
+        }else
+        {
+          request.values[j] = (uint16_t) ((m_frame[3 + 2 * (offset + j)] << 8) | m_frame[4 + 2 * (offset + j)]);
+        }
+      }
+    }
+    finish(batch[i], status);
+  }
+  return status;
+}
+
+/**
+ * @brief Complete a request
+ * @param pending The request
+ * @param status Its outcome
+ */
+void ModbusMaster::finish(ModbusPending_t &pending, Status_t status)
+{
+  DriverRequest_t result = {0, status, status.success ? pending.request.count : 0,
+                            isRead(pending.request.function) ? EVENT_READ : EVENT_WRITE};
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stats.requests++;
+  }
+  DriverToken::complete(pending.completion, result);
+}
@@ -0,0 +1,226 @@
+/**
+ * @file modbus_master.hpp
+ * @author your name (you@domain.com)
+ * @brief Modbus RTU master on a UART
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef DRIVERS_LINUX_MODBUS_MODBUS_MASTER_HPP
+#define DRIVERS_LINUX_MODBUS_MODBUS_MASTER_HPP
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <vector>
+
+#include "commons.hpp"
+#include "driver_base/driver_token.hpp"
+#include "driver_base/driver_stats.hpp"
+#include "linux/uart/uart.hpp"
+#include "linux/utils/linux_thread_attributes.hpp"
+#if __has_include("setup.hpp")
+#include "setup.hpp"
+#endif
+
+// Requests waiting on the master, submissions fail with a busy error beyond it
+#ifndef MODBUS_QUEUE_SIZE
+#define MODBUS_QUEUE_SIZE                                                     64
+#endif
+
+// Time a slave has to start its response
+#ifndef MODBUS_RESPONSE_TIMEOUT_US
+#define MODBUS_RESPONSE_TIMEOUT_US                                        100000
+#endif
+
+// Silence after a broadcast, slaves answer nothing but need time to process it
+#ifndef MODBUS_TURNAROUND_US
+#define MODBUS_TURNAROUND_US                                              100000
+#endif
+
+// Follow the specification above 19200 bauds, 1750 us between frames and
+// 750 us between characters, 0 derives both from the character time
+#ifndef MODBUS_RTU_FIXED_DELAYS
+#define MODBUS_RTU_FIXED_DELAYS                                                1
+#endif
+
+// Shortest idle time that ends a response, covers adapters that deliver
+// bytes in bursts, e.g. USB adapters with a 1 ms latency timer
+#ifndef MODBUS_RTU_IDLE_MIN_US
+#define MODBUS_RTU_IDLE_MIN_US                                              2000
+#endif
+
+// Registers or coils read for nothing to merge two reads into one, 0 only
+// merges reads that overlap or touch, a gap may hold addresses the slave
+// does not have
+#ifndef MODBUS_COALESCE_GAP_MAX
+#define MODBUS_COALESCE_GAP_MAX                                                0
+#endif
+
+// Requests served by one merged read
+#ifndef MODBUS_COALESCE_MAX
+#define MODBUS_COALESCE_MAX                                                   16
+#endif
+
+constexpr uint8_t MODBUS_BROADCAST = 0;
+constexpr uint8_t MODBUS_SLAVE_MAX = 247;
+
+/**
+ * @brief Supported function codes
+ */
+typedef enum
+{
+  MODBUS_READ_COILS                 = 0x01,
+  MODBUS_READ_DISCRETE_INPUTS       = 0x02,
+  MODBUS_READ_HOLDING_REGISTERS     = 0x03,
+  MODBUS_READ_INPUT_REGISTERS       = 0x04,
+  MODBUS_WRITE_SINGLE_COIL          = 0x05,
+  MODBUS_WRITE_SINGLE_REGISTER      = 0x06,
+  MODBUS_WRITE_MULTIPLE_COILS       = 0x0F,
+  MODBUS_WRITE_MULTIPLE_REGISTERS   = 0x10,
+}ModbusFunction_t;
+
+/**
+ * @brief A request to a slave
+ */
+typedef struct
+{
+  uint8_t slave;              /*!< 1 to 247, MODBUS_BROADCAST for writes to every slave */
+  uint8_t function;           /*!< One of ModbusFunction_t */
+  uint16_t address;           /*!< First register or coil */
+  uint16_t count;             /*!< Registers or coils, 1 for the single writes */
+  uint16_t *values;           /*!< Values written or storage for the values read, one per register or coil, coils are 0 or 1 */
+  uint8_t *exception;         /*!< Storage for the exception code the slave answered, may be nullptr */
+  uint32_t timeout_us;        /*!< Response timeout, 0 for the master's */
+}ModbusRequest_t;
+
+/**
+ * @brief Activity of a master
+ */
+typedef struct
+{
+  uint64_t requests;          /*!< Requests completed, successful or not */
+  uint64_t transactions;      /*!< Frames sent */
+  uint64_t coalesced;         /*!< Requests served by the read of another */
+  uint64_t timeouts;          /*!< Transactions without a response */
+  uint64_t crc_errors;        /*!< Responses dropped for a bad CRC */
+  uint64_t malformed;         /*!< Responses too short or not matching the request */
+  uint64_t exceptions;        /*!< Exception responses */
+  uint64_t stale_bytes;       /*!< Bytes found on the line before a request, e.g. late responses */
+}ModbusMasterStats_t;
+
+/**
+ * @brief A request waiting on the master
+ */
+typedef struct
+{
+  ModbusRequest_t request;
+  uint64_t submit_ns;
+  void *completion;           /*!< DriverToken slot */
+  DriverStats *slave_stats;
+}ModbusPending_t;
+
+/**
+ * @brief Modbus RTU master, owns a UART and a worker thread that runs the
+ *        requests of every slave on the line
+ *
+ * @note Requests are queued from any thread and sent back to back, the
+ *       worker only waits the 3.5 characters the line must stay silent
+ *       between frames, on microsecond deadlines. A response ends as soon
+ *       as the bytes the request calls for came, no idle timeout is waited
+ *       for. Reads of the same slave and function queued together are
+ *       merged into one when their ranges overlap or are at most
+ *       MODBUS_COALESCE_GAP_MAX apart, never across a write to that slave.
+ *       When the slave answers a merged read with an exception, each
+ *       request is sent again on its own.
+ *       Latencies are kept per slave: the syscall histogram holds round
+ *       trips, from the first byte sent to the last received.
+ *
+ * @code
+ * UART uart("/dev/ttyUSB0");
+ * uart.configure(settings, 2);               // blocking mode, no checksum
+ * ModbusMaster master(uart);
+ * master.open();
+ * uint16_t temperature[2], flow[4];
+ * DriverToken first = master.submit({1, MODBUS_READ_HOLDING_REGISTERS, 100, 2, temperature});
+ * DriverToken second = master.submit({2, MODBUS_READ_INPUT_REGISTERS, 0, 4, flow});
+ * first.wait();
+ * second.wait();
+ * @endcode
+ */
+class ModbusMaster
+{
+public:
+  ModbusMaster(UART &uart);
+  ~ModbusMaster();
+
+  Status_t open();
+
+  void close();
+
+  bool isOpen() { return m_thread != nullptr;}
+
+  void setThreadAttributes(const LinuxThreadAttributes_t &attributes);
+
+  void setResponseTimeout(uint32_t timeout_us) { m_response_timeout_us = timeout_us;}
+
+  DriverToken submit(const ModbusRequest_t &request);
+
+  Status_t transfer(const ModbusRequest_t &request);
+
+  Status_t readHoldingRegisters(uint8_t slave, uint16_t address, uint16_t count, uint16_t *values);
+
+  Status_t readInputRegisters(uint8_t slave, uint16_t address, uint16_t count, uint16_t *values);
+
+  Status_t writeRegister(uint8_t slave, uint16_t address, uint16_t value);
+
+  Status_t writeRegisters(uint8_t slave, uint16_t address, uint16_t count, const uint16_t *values);
+
+  ModbusMasterStats_t getStats();
+
+  bool getSlaveStats(uint8_t slave, DriverStatsSnapshot_t &snapshot);
+
+  uint32_t getFrameDelayUs() { return m_frame_delay_us;}
+
+  static Status_t check(const ModbusRequest_t &request);
+
+  static uint64_t getTimeNs();
+
+private:
+  UART &m_uart;
+  LinuxThreadAttributes_t m_attributes;
+  bool m_use_default_attributes;
+  std::mutex m_mutex;
+  std::condition_variable m_condition;
+  std::thread *m_thread;
+  bool m_terminate;
+  std::vector<ModbusPending_t> m_queue;
+  DriverStats *m_slave_stats[MODBUS_SLAVE_MAX + 1];
+  ModbusMasterStats_t m_stats;
+  uint32_t m_response_timeout_us;
+  uint32_t m_frame_delay_us;    /*!< Silence between frames, 3.5 characters */
+  uint32_t m_idle_us;           /*!< Silence that ends a response */
+  uint64_t m_line_idle_ns;      /*!< Time the line went silent */
+  std::vector<uint8_t> m_frame;
+
+  void workerThread(void);
+
+  uint16_t takeBatch(ModbusPending_t *batch, uint16_t &first, uint16_t &count);
+
+  Status_t execute(ModbusPending_t *batch, uint16_t batch_size, uint16_t first, uint16_t count);
+
+  Size_t buildRequest(const ModbusRequest_t &request, uint16_t first, uint16_t count);
+
+  Status_t receive(const ModbusRequest_t &request, Size_t expected_size, uint32_t timeout_us, Size_t &received_size);
+
+  void finish(ModbusPending_t &pending, Status_t status);
+
+  void waitForSilence();
+};
+
+#endif /* DRIVERS_LINUX_MODBUS_MODBUS_MASTER_HPP */
@@ -0,0 +1,583 @@
+/**
+ * @file serial_mux.cpp
+ * @author your name (you@domain.com)
+ * @brief Many serial ports served by one thread
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "linux/serial_mux/serial_mux.hpp"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/uio.h>
+
+#include "linux/utils/linux_io.hpp"
+
+constexpr uint32_t SERIAL_MUX_RING_MASK = SERIAL_MUX_RX_RING_SIZE - 1;
+constexpr int SERIAL_MUX_MAX_EVENTS = SERIAL_MUX_MAX_PORTS + 1;
+
+/**
+ * @brief Constructor
+ */
+SerialMux::SerialMux()
+{
+  for(SerialMuxPort_t &port : m_ports)
+  {
+    port.uart = nullptr;
+    port.fd = -1;
+    port.rx_ring = nullptr;
+  }
+  m_port_count = 0;
+  m_attributes = LinuxThreadAttributes::getDefaults();
+  m_use_default_attributes = true;
+  m_thread = nullptr;
+  m_terminate = false;
+  m_epoll_handle = -1;
+  m_event_handle = -1;
+  m_completions.reserve(SERIAL_MUX_TX_BATCH_MAX);
+}
+
+/**
+ * @brief Destructor, queued writes fail
+ */
+SerialMux::~SerialMux()
+{
+  close();
+  for(SerialMuxPort_t &port : m_ports)
+  {
+    delete[] port.rx_ring;
+  }
+}
+
+/**
+ * @brief Hand a port to the multiplexer, while it is closed
+ * @param uart The port, configured in blocking mode, must outlive the
+ *        multiplexer
+ * @param port Storage for the identifier of the port
+ * @param function Called on the loop thread with the bytes received,
+ *        nullptr to keep them until read()
+ * @param user_arg Argument of the function
+ * @return Status_t
+ */
+Status_t SerialMux::addPort(UART &uart, uint8_t &port, DriverCallback_t function, void *user_arg)
+{
+  uint8_t i;
+
+  if(m_thread != nullptr) { return STATUS_DRV_ERR_BUSY;}
+  if(uart.getLinuxHandle() < 0) { return STATUS_DRV_NOT_CONFIGURED;}
+  if(uart.m_is_async_mode) { return STATUS_DRV_ERR_PARAM;}
+
+  for(i = 0; i < SERIAL_MUX_MAX_PORTS && m_ports[i].uart != nullptr; i++) {}
+  if(i == SERIAL_MUX_MAX_PORTS) { return STATUS_DRV_ERR_BUSY;}
+
+  SerialMuxPort_t &slot = m_ports[i];
+  if(slot.rx_ring == nullptr) { slot.rx_ring = new uint8_t[SERIAL_MUX_RX_RING_SIZE];}
+  slot.uart = &uart;
+  slot.fd = uart.getLinuxHandle();
+  slot.flags = 0;
+  slot.is_closed = false;
+  slot.function = function;
+  slot.user_arg = user_arg;
+  slot.rx_head = 0;
+  slot.rx_tail = 0;
+  slot.tx_queue.clear();
+  slot.tx_requested = false;
+  slot.tx_armed = false;
+  slot.rx_bytes = 0;
+  slot.rx_dropped = 0;
+  slot.tx_bytes = 0;
+  slot.tx_frames = 0;
+  slot.tx_calls = 0;
+  if(i >= m_port_count) { m_port_count = i + 1;}
+  port = i;
+  return STATUS_DRV_SUCCESS;
+}
+
+/**
+ * @brief Give a port back, while the multiplexer is closed
+ * @param port Identifier of the port
+ * @return Status_t
+ */
+Status_t SerialMux::removePort(uint8_t port)
+{
+  if(m_thread != nullptr) { return STATUS_DRV_ERR_BUSY;}
+  if(!isValid(port)) { return STATUS_DRV_ERR_PARAM;}
+
+  m_ports[port].uart = nullptr;
+  m_ports[port].fd = -1;
+  m_ports[port].function = nullptr;
+  while(m_port_count > 0 && m_ports[m_port_count - 1].uart == nullptr) { m_port_count--;}
+  return STATUS_DRV_SUCCESS;
+}
+
+/**
+ * @brief Take over the ports and start the loop
+ * @return Status_t
+ */
+Status_t SerialMux::open()
+{
+  struct epoll_event event;
+  Status_t status;
+
+  if(m_thread != nullptr) { return STATUS_DRV_SUCCESS;}
+
+  m_epoll_handle = epoll_create1(EPOLL_CLOEXEC);
+  m_event_handle = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+  if(m_epoll_handle < 0 || m_event_handle < 0)
+  {
+    status = convertErrnoCode(errno);
+    close();
+    return status;
+  }
+  // The wake up descriptor is told apart from the ports by its own address
+  event.events = EPOLLIN;
+  event.data.ptr = &m_event_handle;
+  (void) epoll_ctl(m_epoll_handle, EPOLL_CTL_ADD, m_event_handle, &event);
+
+  for(uint8_t i = 0; i < m_port_count; i++)
+  {
+    SerialMuxPort_t &port = m_ports[i];
+    if(port.uart == nullptr) { continue;}
+    port.flags = fcntl(port.fd, F_GETFL);
+    (void) fcntl(port.fd, F_SETFL, port.flags | O_NONBLOCK);
+    port.is_closed = false;
+    port.tx_armed = false;
+    event.events = EPOLLIN;
+    event.data.ptr = &port;
+    if(epoll_ctl(m_epoll_handle, EPOLL_CTL_ADD, port.fd, &event) < 0)
+    {
+      status = convertErrnoCode(errno);
+      close();
+      return status;
+    }
+  }
+
+  m_terminate = false;
+  m_thread = new std::thread(&SerialMux::loopThread, this);
+  if(m_use_default_attributes) { m_attributes = LinuxThreadAttributes::getDefaults();}
+  status = LinuxThreadAttributes::apply(*m_thread, m_attributes);
+  if(!status.success)
+  {
+    close();
+    return status;
+  }
+  return STATUS_DRV_SUCCESS;
+}
+
+/**
+ * @brief Stop the loop and give the ports their blocking mode back, queued
+ *        writes fail, bytes received stay in the rings
+ */
+void SerialMux::close()
+{
+  Status_t status;
+
+  if(m_thread != nullptr)
+  {
+    m_terminate = true;
+    wake();
+    m_thread->join();
+    delete m_thread;
+    m_thread = nullptr;
+  }
+
+  SET_STATUS(status, false, SRC_DRIVER, ERR_FAILED, (char *)"Multiplexer closed.\r\n");
+  for(uint8_t i = 0; i < m_port_count; i++)
+  {
+    SerialMuxPort_t &port = m_ports[i];
+    if(port.uart == nullptr) { continue;}
+    if(m_epoll_handle >= 0)
+    {
+      (void) epoll_ctl(m_epoll_handle, EPOLL_CTL_DEL, port.fd, nullptr);
+      (void) fcntl(port.fd, F_SETFL, port.flags);
+    }
+    std::deque<SerialMuxWrite_t> pending;
+    {
+      std::lock_guard<std::mutex> lock(port.tx_mutex);
+      pending.swap(port.tx_queue);
+    }
+    for(SerialMuxWrite_t &write : pending)
+    {
+      DriverToken::complete(write.completion, {0, status, write.offset, EVENT_WRITE});
+    }
+  }
+
+  if(m_event_handle >= 0) { (void) ::close(m_event_handle);}
+  if(m_epoll_handle >= 0) { (void) ::close(m_epoll_handle);}
+  m_event_handle = -1;
+  m_epoll_handle = -1;
+}
+
+/**
+ * @brief Set the scheduling of the loop, applied on the next open()
+ * @param attributes Policy, priority and affinity
+ */
+void SerialMux::setThreadAttributes(const LinuxThreadAttributes_t &attributes)
+{
+  m_attributes = attributes;
+  m_use_default_attributes = false;
+}
+
+/**
+ * @brief Queue a write on a port
+ * @param port Identifier of the port
+ * @param data Bytes to send, must stay valid until the token completes
+ * @param byte_count Number of bytes
+ * @return DriverToken Completes once the kernel took every byte
+ */
+DriverToken SerialMux::write(uint8_t port, uint8_t *data, Size_t byte_count)
+{
+  DriverToken token;
+  SerialMuxWrite_t write;
+  Status_t status = STATUS_DRV_SUCCESS;
+  bool was_idle = false;
+
+  if(!isValid(port)) { return DriverToken(STATUS_DRV_ERR_PARAM);}
+  if(data == nullptr) { return DriverToken(STATUS_DRV_NULL_POINTER);}
+  if(byte_count <= 0) { return DriverToken(STATUS_DRV_ERR_PARAM_SIZE);}
+
+  token = DriverToken::create(EVENT_WRITE, Buffer_t(data, byte_count));
+  if(!token.valid()) { return token;}
+
+  write.data = data;
+  write.size = byte_count;
+  write.offset = 0;
+  write.completion = token.attach();
+  SerialMuxPort_t &slot = m_ports[port];
+  {
+    std::lock_guard<std::mutex> lock(slot.tx_mutex);
+    if(m_thread == nullptr)
+    {
+      status = STATUS_DRV_NOT_CONFIGURED;
+    }else if(slot.is_closed)
+    {
+      status = STATUS_DRV_BAD_HANDLE;
+    }else if(slot.tx_queue.size() >= SERIAL_MUX_TX_QUEUE_SIZE)
+    {
+      status = STATUS_DRV_ERR_BUSY;
+    }else
+    {
+      was_idle = slot.tx_queue.empty();
+      slot.tx_queue.push_back(write);
+    }
+  }
+  if(!status.success)
+  {
+    DriverToken::complete(write.completion, {0, status, 0, EVENT_WRITE});
+    return token;
+  }
+
+  // A queue with writes is already on the loop's list or waiting for room
+  if(was_idle)
+  {
+    slot.tx_requested = true;
+    wake();
+  }
+  return token;
+}
+
+/**
+ * @brief Take the bytes a port received, without waiting
+ * @param port Identifier of the port, without a callback
+ * @param data Storage for the bytes
+ * @param byte_count Size of the storage
+ * @param bytes_read Storage for the number of bytes taken
+ * @return Status_t
+ */
+Status_t SerialMux::read(uint8_t port, uint8_t *data, Size_t byte_count, Size_t &bytes_read)
+{
+  uint32_t head, tail, first;
+
+  bytes_read = 0;
+  if(!isValid(port)) { return STATUS_DRV_ERR_PARAM;}
+  if(data == nullptr) { return STATUS_DRV_NULL_POINTER;}
+  if(byte_count <= 0) { return STATUS_DRV_ERR_PARAM_SIZE;}
+
+  SerialMuxPort_t &slot = m_ports[port];
+  head = slot.rx_head.load(std::memory_order_acquire);
+  tail = slot.rx_tail.load(std::memory_order_relaxed);
+  bytes_read = (Size_t) (head - tail) < byte_count ? (Size_t) (head - tail) : byte_count;
+  first = SERIAL_MUX_RX_RING_SIZE - (tail & SERIAL_MUX_RING_MASK);
+  if(first > (uint32_t) bytes_read) { first = bytes_read;}
+  memcpy(data, slot.rx_ring + (tail & SERIAL_MUX_RING_MASK), first);
+  memcpy(data + first, slot.rx_ring, bytes_read - first);
+  slot.rx_tail.store(tail + bytes_read, std::memory_order_release);
+
+  if(bytes_read == 0 && slot.is_closed) { return STATUS_DRV_BAD_HANDLE;}
+  return STATUS_DRV_SUCCESS;
+}
+
+/**
+ * @brief Get the number of bytes waiting in the ring of a port
+ * @param port Identifier of the port
+ * @return Size_t
+ */
+Size_t SerialMux::getBytesAvailable(uint8_t port)
+{
+  if(!isValid(port)) { return 0;}
+  return m_ports[port].rx_head.load(std::memory_order_acquire) - m_ports[port].rx_tail.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Get the activity of a port
+ * @param port Identifier of the port
+ * @param stats Storage for the counters
+ * @return Status_t
+ */
+Status_t SerialMux::getStats(uint8_t port, SerialMuxStats_t &stats)
+{
+  if(!isValid(port)) { return STATUS_DRV_ERR_PARAM;}
+
+  SerialMuxPort_t &slot = m_ports[port];
+  stats.rx_bytes = slot.rx_bytes.load(std::memory_order_relaxed);
+  stats.rx_dropped = slot.rx_dropped.load(std::memory_order_relaxed);
+  stats.tx_bytes = slot.tx_bytes.load(std::memory_order_relaxed);
+  stats.tx_frames = slot.tx_frames.load(std::memory_order_relaxed);
+  stats.tx_calls = slot.tx_calls.load(std::memory_order_relaxed);
+  return STATUS_DRV_SUCCESS;
+}
+
+/**
+ * @brief Loop thread, serves every port until close()
+ */
+void SerialMux::loopThread(void)
+{
+  struct epoll_event events[SERIAL_MUX_MAX_EVENTS];
+  SerialMuxPort_t *port;
+  uint64_t counter;
+  int event_count;
+  bool is_woken;
+
+  LinuxThreadAttributes::setUp("serial_mux");
+  while(!m_terminate)
+  {
+    event_count = epoll_wait(m_epoll_handle, events, SERIAL_MUX_MAX_EVENTS, -1);
+    if(event_count < 0)
+    {
+      if(errno == EINTR) { continue;}
+      break;
+    }
+
+    is_woken = false;
+    for(int i = 0; i < event_count; i++)
+    {
+      if(events[i].data.ptr == &m_event_handle)
+      {
+        (void) ::read(m_event_handle, &counter, sizeof(counter));
+        is_woken = true;
+        continue;
+      }
+      port = (SerialMuxPort_t *) events[i].data.ptr;
+      if(events[i].events & (EPOLLIN | EPOLLERR | EPOLLHUP)) { receive(*port);}
+      if(!port->is_closed && (events[i].events & EPOLLOUT)) { transmit(*port);}
+    }
+
+    if(!is_woken) { continue;}
+    for(uint8_t i = 0; i < m_port_count; i++)
+    {
+      if(m_ports[i].uart != nullptr && m_ports[i].tx_requested.exchange(false) && !m_ports[i].is_closed)
+      {
+        transmit(m_ports[i]);
+      }
+    }
+  }
+}
+
+/**
+ * @brief Move the bytes a port received into its ring
+ * @param port The port
+ */
+void SerialMux::receive(SerialMuxPort_t &port)
+{
+  uint8_t discard[256];
+  struct iovec segments[2];
+  uint32_t head, tail, room, offset, first;
+  int segment_count = 0;
+  ssize_t size;
+
+  head = port.rx_head.load(std::memory_order_relaxed);
+  tail = port.rx_tail.load(std::memory_order_acquire);
+  room = SERIAL_MUX_RX_RING_SIZE - (head - tail);
+  offset = head & SERIAL_MUX_RING_MASK;
+  first = SERIAL_MUX_RX_RING_SIZE - offset;
+  if(room != 0)
+  {
+    segments[0].iov_base = port.rx_ring + offset;
+    segments[0].iov_len = first < room ? first : room;
+    segment_count = 1;
+    if(room > first)
+    {
+      segments[1].iov_base = port.rx_ring;
+      segments[1].iov_len = room - first;
+      segment_count = 2;
+    }
+    size = readv(port.fd, segments, segment_count);
+  }else
+  {
+    // Left in the kernel they would overflow its buffer, the new bytes are
+    // dropped and counted instead, the ring keeps the older ones for read()
+    size = ::read(port.fd, discard, sizeof(discard));
+    if(size > 0) { port.rx_dropped.fetch_add(size, std::memory_order_relaxed);}
+    return;
+  }
+
+  if(size < 0)
+  {
+    if(errno == EAGAIN || errno == EINTR) { return;}
+    hangUp(port, convertErrnoCode(errno));
+    return;
+  }
+  if(size == 0)
+  {
+    // Readable without data, the other end is gone
+    hangUp(port, STATUS_DRV_BAD_HANDLE);
+    return;
+  }
+
+  port.rx_head.store(head + size, std::memory_order_release);
+  port.rx_bytes.fetch_add(size, std::memory_order_relaxed);
+  if(port.function == nullptr) { return;}
+
+  // The new bytes may wrap around the end of the ring, one call per segment
+  first = (uint32_t) size < first ? (uint32_t) size : first;
+  (void) port.function(STATUS_DRV_SUCCESS, EVENT_READ, Buffer_t(port.rx_ring + offset, first), port.user_arg);
+  if((uint32_t) size > first)
+  {
+    (void) port.function(STATUS_DRV_SUCCESS, EVENT_READ, Buffer_t(port.rx_ring, size - first), port.user_arg);
+  }
+  port.rx_tail.store(head + size, std::memory_order_release);
+}
+
+/**
+ * @brief Hand the writes queued on a port to the kernel, all of them by one
+ *        writev() when they fit
+ * @param port The port
+ */
+void SerialMux::transmit(SerialMuxPort_t &port)
+{
+  struct iovec segments[SERIAL_MUX_TX_BATCH_MAX];
+  int segment_count;
+  ssize_t size;
+  Size_t taken;
+  bool want_out;
+
+  {
+    std::lock_guard<std::mutex> lock(port.tx_mutex);
+    while(!port.tx_queue.empty())
+    {
+      segment_count = 0;
+      for(SerialMuxWrite_t &write : port.tx_queue)
+      {
+        if(segment_count == SERIAL_MUX_TX_BATCH_MAX) { break;}
+        segments[segment_count].iov_base = write.data + write.offset;
+        segments[segment_count].iov_len = write.size - write.offset;
+        segment_count++;
+      }
+      size = writev(port.fd, segments, segment_count);
+      if(size < 0)
+      {
+        if(errno == EAGAIN) { break;}
+        if(errno == EINTR) { continue;}
+        // The oldest write takes the error, the others get their turn
+        SerialMuxWrite_t &write = port.tx_queue.front();
+        m_completions.push_back({write.completion, {0, convertErrnoCode(errno), write.offset, EVENT_WRITE}});
+        port.tx_queue.pop_front();
+        continue;
+      }
+      port.tx_calls.fetch_add(1, std::memory_order_relaxed);
+      port.tx_bytes.fetch_add(size, std::memory_order_relaxed);
+
+      // Walk the queue by the bytes the kernel took
+      while(size > 0)
+      {
+        SerialMuxWrite_t &write = port.tx_queue.front();
+        taken = (Size_t) size < write.size - write.offset ? (Size_t) size : write.size - write.offset;
+        write.offset += taken;
+        size -= taken;
+        if(write.offset < write.size) { break;}
+        m_completions.push_back({write.completion, {0, STATUS_DRV_SUCCESS, write.size, EVENT_WRITE}});
+        port.tx_frames.fetch_add(1, std::memory_order_relaxed);
+        port.tx_queue.pop_front();
+      }
+      // A short write means the kernel buffer is full
+      if(!port.tx_queue.empty() && port.tx_queue.front().offset != 0) { break;}
+    }
+    want_out = !port.tx_queue.empty();
+  }
+
+  watch(port, want_out);
+  // Completions may queue new writes, they run with the queue unlocked
+  for(std::pair<void *, DriverRequest_t> &completion : m_completions)
+  {
+    DriverToken::complete(completion.first, completion.second);
+  }
+  m_completions.clear();
+}
+
+/**
+ * @brief Stop serving a port whose descriptor failed, its queued writes fail
+ * @param port The port
+ * @param status Reported to the writes and the callback
+ */
+void SerialMux::hangUp(SerialMuxPort_t &port, Status_t status)
+{
+  (void) epoll_ctl(m_epoll_handle, EPOLL_CTL_DEL, port.fd, nullptr);
+  {
+    std::lock_guard<std::mutex> lock(port.tx_mutex);
+    port.is_closed = true;
+    for(SerialMuxWrite_t &write : port.tx_queue)
+    {
+      m_completions.push_back({write.completion, {0, status, write.offset, EVENT_WRITE}});
+    }
+    port.tx_queue.clear();
+  }
+  for(std::pair<void *, DriverRequest_t> &completion : m_completions)
+  {
+    DriverToken::complete(completion.first, completion.second);
+  }
+  m_completions.clear();
+  if(port.function != nullptr) { (void) port.function(status, EVENT_READ, Buffer_t(), port.user_arg);}
+}
+
+/**
+ * @brief Wait for room in the kernel buffer of a port, or stop waiting
+ * @param port The port
+ * @param want_out True to be woken once writes can go on
+ */
+void SerialMux::watch(SerialMuxPort_t &port, bool want_out)
+{
+  struct epoll_event event;
+
+  if(want_out == port.tx_armed) { return;}
+  event.events = EPOLLIN | (want_out ? (uint32_t) EPOLLOUT : 0);
+  event.data.ptr = &port;
+  if(epoll_ctl(m_epoll_handle, EPOLL_CTL_MOD, port.fd, &event) == 0) { port.tx_armed = want_out;}
+}
+
+/**
+ * @brief Have the loop look at the queued writes
+ */
+void SerialMux::wake()
+{
+  uint64_t counter = 1;
+
+  if(m_event_handle >= 0) { (void) ::write(m_event_handle, &counter, sizeof(counter));}
+}
+
+/**
+ * @brief Check a port identifier
+ * @param port Identifier of the port
+ * @return true if it names a port
+ */
+bool SerialMux::isValid(uint8_t port)
+{
+  return port < m_port_count && m_ports[port].uart != nullptr;
+}
@@ -0,0 +1,179 @@
+/**
+ * @file serial_mux.hpp
+ * @author your name (you@domain.com)
+ * @brief Many serial ports served by one thread
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef DRIVERS_LINUX_SERIAL_MUX_SERIAL_MUX_HPP
+#define DRIVERS_LINUX_SERIAL_MUX_SERIAL_MUX_HPP
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "commons.hpp"
+#include "driver_base/driver_token.hpp"
+#include "linux/uart/uart.hpp"
+#include "linux/utils/linux_thread_attributes.hpp"
+#if __has_include("setup.hpp")
+#include "setup.hpp"
+#endif
+
+// Ports a multiplexer serves
+#ifndef SERIAL_MUX_MAX_PORTS
+#define SERIAL_MUX_MAX_PORTS                                                  32
+#endif
+
+// Reception ring of each port, a power of 2
+#ifndef SERIAL_MUX_RX_RING_SIZE
+#define SERIAL_MUX_RX_RING_SIZE                                             4096
+#endif
+
+// Writes waiting on each port, writes fail with a busy error beyond it
+#ifndef SERIAL_MUX_TX_QUEUE_SIZE
+#define SERIAL_MUX_TX_QUEUE_SIZE                                              16
+#endif
+
+// Queued writes handed to the kernel by one writev()
+#ifndef SERIAL_MUX_TX_BATCH_MAX
+#define SERIAL_MUX_TX_BATCH_MAX                                               16
+#endif
+
+static_assert((SERIAL_MUX_RX_RING_SIZE & (SERIAL_MUX_RX_RING_SIZE - 1)) == 0, "SERIAL_MUX_RX_RING_SIZE must be a power of 2");
+
+/**
+ * @brief Activity of one port
+ */
+typedef struct
+{
+  uint64_t rx_bytes;          /*!< Bytes received */
+  uint64_t rx_dropped;        /*!< Bytes received while the ring was full */
+  uint64_t tx_bytes;          /*!< Bytes handed to the kernel */
+  uint64_t tx_frames;         /*!< Writes completed */
+  uint64_t tx_calls;          /*!< System calls that wrote them */
+}SerialMuxStats_t;
+
+/**
+ * @brief A write waiting on a port
+ */
+typedef struct
+{
+  uint8_t *data;
+  Size_t size;
+  Size_t offset;              /*!< Bytes already handed to the kernel */
+  void *completion;           /*!< DriverToken slot */
+}SerialMuxWrite_t;
+
+/**
+ * @brief A port and its rings, the ring indexes run freely and are masked
+ *        on access
+ */
+typedef struct
+{
+  UART *uart;
+  int fd;
+  int flags;                              /*!< File status flags before open() */
+  std::atomic<bool> is_closed;            /*!< Hung up, e.g. an adapter unplugged */
+  DriverCallback_t function;
+  void *user_arg;
+  uint8_t *rx_ring;
+  std::atomic<uint32_t> rx_head;          /*!< Written by the loop */
+  std::atomic<uint32_t> rx_tail;          /*!< Written by readers, or the loop with a callback */
+  std::mutex tx_mutex;
+  std::deque<SerialMuxWrite_t> tx_queue;
+  std::atomic<bool> tx_requested;         /*!< Writes queued since the loop last looked */
+  bool tx_armed;                          /*!< Waiting for room in the kernel, loop only */
+  std::atomic<uint64_t> rx_bytes;
+  std::atomic<uint64_t> rx_dropped;
+  std::atomic<uint64_t> tx_bytes;
+  std::atomic<uint64_t> tx_frames;
+  std::atomic<uint64_t> tx_calls;
+}SerialMuxPort_t;
+
+/**
+ * @brief Serves many UARTs from one thread
+ *
+ * @note The thread waits on every port with one epoll set. Received bytes go
+ *       straight from the kernel into the ring of their port, by one readv()
+ *       per readiness. Ports with a callback have it called on the loop
+ *       thread with a view of the new bytes, which are consumed on return.
+ *       The others keep them until read(). Writes are queued per port and
+ *       handed to the kernel by the same loop, the writes queued on a port
+ *       by one writev(). Their tokens complete once the kernel took every
+ *       byte, not once the bytes left the line. A full kernel buffer arms
+ *       EPOLLOUT on that port only. Ports belong to the multiplexer while it
+ *       is open: their descriptors are non-blocking and their checksums,
+ *       RS-485 control and worker threads are bypassed.
+ *
+ * @code
+ * UART ports[16] = {...};                    // configured in blocking mode
+ * SerialMux mux;
+ * uint8_t id[16];
+ * for(int i = 0; i < 16; i++) { mux.addPort(ports[i], id[i], onData, &ports[i]);}
+ * mux.open();
+ * DriverToken token = mux.write(id[3], frame, sizeof(frame));
+ * @endcode
+ */
+class SerialMux
+{
+public:
+  SerialMux();
+  ~SerialMux();
+
+  Status_t addPort(UART &uart, uint8_t &port, DriverCallback_t function = nullptr, void *user_arg = nullptr);
+
+  Status_t removePort(uint8_t port);
+
+  Status_t open();
+
+  void close();
+
+  bool isOpen() { return m_thread != nullptr;}
+
+  void setThreadAttributes(const LinuxThreadAttributes_t &attributes);
+
+  DriverToken write(uint8_t port, uint8_t *data, Size_t byte_count);
+
+  Status_t read(uint8_t port, uint8_t *data, Size_t byte_count, Size_t &bytes_read);
+
+  Size_t getBytesAvailable(uint8_t port);
+
+  Status_t getStats(uint8_t port, SerialMuxStats_t &stats);
+
+private:
+  SerialMuxPort_t m_ports[SERIAL_MUX_MAX_PORTS];
+  uint8_t m_port_count;
+  LinuxThreadAttributes_t m_attributes;
+  bool m_use_default_attributes;
+  std::thread *m_thread;
+  std::atomic<bool> m_terminate;
+  int m_epoll_handle;
+  int m_event_handle;
+  std::vector<std::pair<void *, DriverRequest_t>> m_completions;  /*!< Completed while the queue was locked */
+
+  void loopThread(void);
+
+  void receive(SerialMuxPort_t &port);
+
+  void transmit(SerialMuxPort_t &port);
+
+  void hangUp(SerialMuxPort_t &port, Status_t status);
+
+  void watch(SerialMuxPort_t &port, bool want_out);
+
+  void wake();
+
+  bool isValid(uint8_t port);
+};
+
+#endif /* DRIVERS_LINUX_SERIAL_MUX_SERIAL_MUX_HPP */
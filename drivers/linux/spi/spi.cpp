@@ -30,6 +30,32 @@ m_thread_handle(SPI::transferDataAsync, this)
 {
   m_handle = port_handle;
   m_linux_handle = -1;
+  m_speed = 1000000;
+  m_backend = nullptr;
+  m_bus_device = nullptr;
+  m_thread_handle.setName("spi");
+}
+
+/**
+ * @brief Constructor, transfers go to an emulated device instead of spidev
+ * @param backend The emulated device, must outlive the driver
+ */
+SPI::SPI(VirtualSpiBackend &backend) : SPI((const void *) &backend)
+{
+  m_backend = &backend;
+}
+
+/**
+ * @brief Constructor, transfers go through a bus shared with other devices
+ * @param bus The bus, opened by the caller, must outlive the driver
+ * @param chip_select Chip select of the device, see LinuxSpiBus::addChipSelect()
+ * @param is_mergeable True if the transfers may share a submission with
+ *        those of other drivers on the same chip select
+ */
+SPI::SPI(LinuxSpiBus &bus, uint16_t chip_select, bool is_mergeable) : SPI((const void *) &bus)
+{
+  m_bus_device = new BusDevice(bus, chip_select);
+  m_bus_device->setMergeable(is_mergeable);
 }
 
 /**
@@ -37,10 +63,13 @@ m_thread_handle(SPI::transferDataAsync, this)
  */
 SPI::~SPI()
 {
+  // The worker reports to the result queues, stop it before anything else
+  (void) m_thread_handle.terminate();
   if(m_linux_handle >= 0)
   {
     (void) close(m_linux_handle);
   }
+  delete m_bus_device;
 }
 
 /**
@@ -51,14 +80,17 @@ SPI::~SPI()
  */
 Status_t SPI::configure(const DriverSettings_t *list, uint8_t list_size)
 {
+  DRIVER_TRACE_SCOPE("spi", "configure");
   Status_t status = STATUS_DRV_SUCCESS;
   char mode = 0;
   char n_bits = 8;
   int max_baud = 1000000;
+  LinuxThreadAttributes_t thread_attributes = LinuxThreadAttributes::getDefaults();
 
   if(m_handle == nullptr) { return STATUS_DRV_NULL_POINTER;}
-  m_read_status = STATUS_DRV_NOT_CONFIGURED;
-  m_write_status = STATUS_DRV_NOT_CONFIGURED;
+  setReadStatus(STATUS_DRV_NOT_CONFIGURED);
+  setWriteStatus(STATUS_DRV_NOT_CONFIGURED);
+  (void) m_checksum.setType(CHECKSUM_NONE);
 
   if(list != nullptr && list_size != 0)
   {
@@ -90,41 +122,66 @@ Status_t SPI::configure(const DriverSettings_t *list, uint8_t list_size)
       case COMM_WORK_ASYNC:
         m_is_async_mode = (bool)list[i].value;
         break;
+      case COMM_USE_HW_CRC:
+      case COMM_USE_HW_CKSUM:
+        status = m_checksum.configure(list[i]);
+        if(!status.success) { return status;}
+        break;
+      case THREAD_PARAM_POLICY:
+      case THREAD_PARAM_PRIORITY:
+      case THREAD_PARAM_AFFINITY:
+        (void) LinuxThreadAttributes::parse(list[i], thread_attributes);
+        break;
       default:
         break;
       }
     }
   }
 
-  if ((m_linux_handle = open((char *)m_handle, O_RDWR)) < 0)
-  {
-    SET_STATUS(status, false, SRC_DRIVER, ERR_FAILED, (char *)"Failed to open the file.");
-    return status;
-  }
+  status = LinuxThreadAttributes::check(thread_attributes);
+  if(!status.success) { return status;}
 
-  if (ioctl(m_linux_handle, SPI_IOC_WR_MODE, &mode) < 0)
+  if(m_backend != nullptr)
   {
-    close(m_linux_handle);
-    SET_STATUS(status, false, SRC_DRIVER, ERR_FAILED, (char *)"Failed to configure spi mode.");
-    return status;
-  }
-
-  if (ioctl(m_linux_handle, SPI_IOC_WR_BITS_PER_WORD, &n_bits) < 0)
+    status = m_backend->configure(m_speed, mode);
+    if(!status.success) { return status;}
+  }else if(m_bus_device != nullptr)
   {
-    close(m_linux_handle);
-    SET_STATUS(status, false, SRC_DRIVER, ERR_FAILED, (char *)"Failed to configure spi bits per word.");
-    return status;
-  }
-
-  if (ioctl(m_linux_handle, SPI_IOC_WR_MAX_SPEED_HZ, &max_baud) < 0)
+    // The mode belongs to the bus, only the clock is per device
+    m_bus_device->setSpeed(m_speed);
+  }else
   {
-    close(m_linux_handle);
-    SET_STATUS(status, false, SRC_DRIVER, ERR_FAILED, (char *)"Failed to configure spi clock frequency (Hz).");
-    return status;
+    if ((m_linux_handle = open((char *)m_handle, O_RDWR)) < 0)
+    {
+      SET_STATUS(status, false, SRC_DRIVER, ERR_FAILED, (char *)"Failed to open the file.");
+      return status;
+    }
+
+    if (ioctl(m_linux_handle, SPI_IOC_WR_MODE, &mode) < 0)
+    {
+      close(m_linux_handle);
+      SET_STATUS(status, false, SRC_DRIVER, ERR_FAILED, (char *)"Failed to configure spi mode.");
+      return status;
+    }
+
+    if (ioctl(m_linux_handle, SPI_IOC_WR_BITS_PER_WORD, &n_bits) < 0)
+    {
+      close(m_linux_handle);
+      SET_STATUS(status, false, SRC_DRIVER, ERR_FAILED, (char *)"Failed to configure spi bits per word.");
+      return status;
+    }
+
+    if (ioctl(m_linux_handle, SPI_IOC_WR_MAX_SPEED_HZ, &max_baud) < 0)
+    {
+      close(m_linux_handle);
+      SET_STATUS(status, false, SRC_DRIVER, ERR_FAILED, (char *)"Failed to configure spi clock frequency (Hz).");
+      return status;
+    }
   }
 
   if(m_is_async_mode)
   {
+    m_thread_handle.setAttributes(thread_attributes);
     if(!m_thread_handle.create())
     {
       SET_STATUS(status, false, SRC_DRIVER, ERR_FAILED, (char *)"Failed to launch the spi task.\r\n");
@@ -135,8 +192,8 @@ Status_t SPI::configure(const DriverSettings_t *list, uint8_t list_size)
     (void) m_thread_handle.terminate();
   }
 
-  m_read_status = STATUS_DRV_IDLE;
-  m_write_status = STATUS_DRV_IDLE;
+  setReadStatus(STATUS_DRV_IDLE);
+  setWriteStatus(STATUS_DRV_IDLE);
   return STATUS_DRV_SUCCESS;
 }
 
@@ -149,36 +206,61 @@ Status_t SPI::configure(const DriverSettings_t *list, uint8_t list_size)
  */
 Status_t SPI::read(uint8_t *data, Size_t byte_count, uint32_t timeout)
 {
+  DRIVER_TRACE_SCOPE("spi", "read");
   Status_t status;
-  DataBundle_t data_bundle;
+  uint64_t start;
+
+  if(m_is_async_mode) { return queueRead(data, byte_count, timeout, nullptr, nullptr);}
 
   status = checkInputs(data, byte_count, timeout);
   if(!status.success) { return status;}
-  if(m_read_status.code == OPERATION_RUNNING) { return STATUS_DRV_ERR_BUSY;}
-  if(m_write_status.code == OPERATION_RUNNING) { return STATUS_DRV_ERR_BUSY;}
 
-  m_read_status = STATUS_DRV_RUNNING;
+  if(getWriteStatus().code == OPERATION_RUNNING || !beginRead()) { m_stats.countBusy(); return STATUS_DRV_ERR_BUSY;}
   m_bytes_read = 0;
+  start = DriverStats::getTimeNs();
+  status = xSpiXfer(nullptr, data, byte_count);
+  m_stats.recordSince(DRIVER_LATENCY_SYSCALL, start);
+  if(status.success) { m_bytes_read = byte_count;}
+  m_stats.countRead(status, m_bytes_read);
+  DRIVER_RECORD(m_record_id, DRIVER_RECORD_READ, data, m_bytes_read);
+  setReadStatus(status);
 
-  if(m_is_async_mode)
+  return status;
+}
+
+/**
+ * @brief Queue a read request for the worker thread
+ * @param data Buffer to store the data
+ * @param byte_count Number of bytes to read
+ * @param timeout Time to wait in milliseconds before returning an error
+ * @param completion Token slot completed with the request, may be nullptr
+ * @param pool_buffer Pooled buffer released with the request, may be nullptr
+ * @return Status_t
+ */
+Status_t SPI::queueRead(uint8_t *data, Size_t byte_count, uint32_t timeout, void *completion, void *pool_buffer)
+{
+  Status_t status;
+  DataBundle_t data_bundle = {};
+
+  status = checkInputs(data, byte_count, timeout);
+  if(!status.success) { return status;}
+
+  data_bundle.rx_buffer = data;
+  data_bundle.rx_size = byte_count;
+  data_bundle.tx_buffer = nullptr;
+  data_bundle.tx_size = 0;
+  data_bundle.timeout = timeout;
+  data_bundle.completion = completion;
+  data_bundle.pool_buffer = pool_buffer;
+  data_bundle.timestamp = DriverStats::getTimeNs();
+  data_bundle.id = submitRead();
+  if(m_thread_handle.setInputData(&data_bundle, 0))
   {
-    data_bundle.rx_buffer = data;
-    data_bundle.rx_size = byte_count;
-    data_bundle.tx_buffer = nullptr;
-    data_bundle.tx_size = 0;
-    data_bundle.timeout = timeout;
-    if(m_thread_handle.setInputData(&data_bundle, 0))
-    {
-      status = STATUS_DRV_SUCCESS;
-    }else
-    {
-      m_read_status = STATUS_DRV_IDLE;
-      status = STATUS_DRV_ERR_BUSY;
-    }
+    status = STATUS_DRV_SUCCESS;
   }else
   {
-    status = xSpiXfer(nullptr, data, byte_count);
-    m_read_status = status;
+    cancelRead();
+    status = STATUS_DRV_ERR_BUSY;
   }
 
   return status;
@@ -193,36 +275,61 @@ Status_t SPI::read(uint8_t *data, Size_t byte_count, uint32_t timeout)
  */
 Status_t SPI::write(uint8_t *data, Size_t byte_count, uint32_t timeout)
 {
+  DRIVER_TRACE_SCOPE("spi", "write");
   Status_t status;
-  DataBundle_t data_bundle;
+  uint64_t start;
+
+  if(m_is_async_mode) { return queueWrite(data, byte_count, timeout, nullptr, nullptr);}
 
   status = checkInputs(data, byte_count, timeout);
   if(!status.success) { return status;}
-  if(m_read_status.code == OPERATION_RUNNING) { return STATUS_DRV_ERR_BUSY;}
-  if(m_write_status.code == OPERATION_RUNNING) { return STATUS_DRV_ERR_BUSY;}
 
-  m_write_status = STATUS_DRV_RUNNING;
+  if(getReadStatus().code == OPERATION_RUNNING || !beginWrite()) { m_stats.countBusy(); return STATUS_DRV_ERR_BUSY;}
   m_bytes_written = 0;
+  start = DriverStats::getTimeNs();
+  status = xSpiXfer(data, nullptr, byte_count);
+  m_stats.recordSince(DRIVER_LATENCY_SYSCALL, start);
+  if(status.success) { m_bytes_written = byte_count;}
+  m_stats.countWrite(status, m_bytes_written);
+  DRIVER_RECORD(m_record_id, DRIVER_RECORD_WRITE, data, m_bytes_written);
+  setWriteStatus(status);
 
-  if(m_is_async_mode)
+  return status;
+}
+
+/**
+ * @brief Queue a write request for the worker thread
+ * @param data Buffer where data is stored
+ * @param byte_count Number of bytes to write
+ * @param timeout Time to wait in milliseconds before returning an error
+ * @param completion Token slot completed with the request, may be nullptr
+ * @param pool_buffer Pooled buffer released with the request, may be nullptr
+ * @return Status_t
+ */
+Status_t SPI::queueWrite(uint8_t *data, Size_t byte_count, uint32_t timeout, void *completion, void *pool_buffer)
+{
+  Status_t status;
+  DataBundle_t data_bundle = {};
+
+  status = checkInputs(data, byte_count, timeout);
+  if(!status.success) { return status;}
+
+  data_bundle.rx_buffer = nullptr;
+  data_bundle.rx_size = 0;
+  data_bundle.tx_buffer = data;
+  data_bundle.tx_size = byte_count;
+  data_bundle.timeout = timeout;
+  data_bundle.completion = completion;
+  data_bundle.pool_buffer = pool_buffer;
+  data_bundle.timestamp = DriverStats::getTimeNs();
+  data_bundle.id = submitWrite();
+  if(m_thread_handle.setInputData(&data_bundle, 0))
   {
-    data_bundle.rx_buffer = nullptr;
-    data_bundle.rx_size = 0;
-    data_bundle.tx_buffer = data;
-    data_bundle.tx_size = byte_count;
-    data_bundle.timeout = timeout;
-    if(m_thread_handle.setInputData(&data_bundle, 0))
-    {
-      status = STATUS_DRV_SUCCESS;
-    }else
-    {
-      m_write_status = STATUS_DRV_IDLE;
-      status = STATUS_DRV_ERR_BUSY;
-    }
+    status = STATUS_DRV_SUCCESS;
   }else
   {
-    status = xSpiXfer(data, nullptr, byte_count);
-    m_write_status = status;
+    cancelWrite();
+    status = STATUS_DRV_ERR_BUSY;
   }
 
   return status;
@@ -238,40 +345,76 @@ Status_t SPI::write(uint8_t *data, Size_t byte_count, uint32_t timeout)
  */
 Status_t SPI::transfer(uint8_t *rx_data, uint8_t *tx_data, Size_t byte_count, uint32_t timeout)
 {
+  DRIVER_TRACE_SCOPE("spi", "transfer");
   Status_t status;
-  DataBundle_t data_bundle;
+  uint64_t start;
+
+  if(m_is_async_mode) { return queueTransfer(rx_data, tx_data, byte_count, timeout, nullptr, nullptr);}
 
   status = checkInputs(rx_data, byte_count, timeout);
   if(!status.success) { return status;}
-  if(m_read_status.code == OPERATION_RUNNING) { return STATUS_DRV_ERR_BUSY;}
-  if(m_write_status.code == OPERATION_RUNNING) { return STATUS_DRV_ERR_BUSY;}
 
-  m_read_status = STATUS_DRV_RUNNING;
-  m_write_status = STATUS_DRV_RUNNING;
+  if(getWriteStatus().code == OPERATION_RUNNING || !beginRead()) { m_stats.countBusy(); return STATUS_DRV_ERR_BUSY;}
+  setWriteStatus(STATUS_DRV_RUNNING);
   m_bytes_read = 0;
   m_bytes_written = 0;
+  start = DriverStats::getTimeNs();
+  status = xSpiXfer(tx_data, rx_data, byte_count);
+  m_stats.recordSince(DRIVER_LATENCY_SYSCALL, start);
+  if(status.success)
+  {
+    m_bytes_read = byte_count;
+    m_bytes_written = byte_count;
+  }
+  m_stats.countRead(status, m_bytes_read);
+  m_stats.countWrite(status, m_bytes_written);
+  DRIVER_RECORD(m_record_id, DRIVER_RECORD_WRITE, tx_data, m_bytes_written);
+  DRIVER_RECORD(m_record_id, DRIVER_RECORD_READ, rx_data, m_bytes_read);
+  setReadStatus(status);
+  setWriteStatus(status);
 
-  if(m_is_async_mode)
+  return status;
+}
+
+/**
+ * @brief Queue a transfer request for the worker thread
+ * @param rx_data Buffer to store the data read
+ * @param tx_data Buffer where data to write is stored
+ * @param byte_count Number of bytes to write and read
+ * @param timeout Time to wait in milliseconds before returning an error
+ * @param completion Token slot completed with the request, may be nullptr
+ * @param pool_buffer Pooled buffer released with the request, may be nullptr
+ * @return Status_t
+ */
+Status_t SPI::queueTransfer(uint8_t *rx_data, uint8_t *tx_data, Size_t byte_count, uint32_t timeout, void *completion, void *pool_buffer)
+{
+  Status_t status;
+  DataBundle_t data_bundle = {};
+
+  status = checkInputs(rx_data, byte_count, timeout);
+  if(!status.success) { return status;}
+
+  data_bundle.rx_buffer = rx_data;
+  data_bundle.rx_size = byte_count;
+  data_bundle.tx_buffer = tx_data;
+  data_bundle.tx_size = byte_count;
+  data_bundle.timeout = timeout;
+  data_bundle.completion = completion;
+  data_bundle.pool_buffer = pool_buffer;
+  data_bundle.timestamp = DriverStats::getTimeNs();
+  // A transfer is accounted as both a read and a write, its outcome is
+  // reported with the read requests
+  data_bundle.id = submitRead();
+  (void) submitWrite();
+  if(m_thread_handle.setInputData(&data_bundle, 0))
   {
-    data_bundle.rx_buffer = rx_data;
-    data_bundle.rx_size = byte_count;
-    data_bundle.tx_buffer = tx_data;
-    data_bundle.tx_size = byte_count;
-    data_bundle.timeout = timeout;
-    if(m_thread_handle.setInputData(&data_bundle, 0))
-    {
-      status = STATUS_DRV_SUCCESS;
-    }else
-    {
-      m_read_status = STATUS_DRV_IDLE;
-      m_write_status = STATUS_DRV_IDLE;
-      status = STATUS_DRV_ERR_BUSY;
-    }
+    status = STATUS_DRV_SUCCESS;
   }else
   {
-    status = xSpiXfer(tx_data, rx_data, byte_count);
-    m_read_status = status;
-    m_write_status = status;
+    // One rejected request for the statistics
+    cancelRead();
+    cancelWrite(false);
+    status = STATUS_DRV_ERR_BUSY;
   }
 
   return status;
@@ -289,6 +432,69 @@ Status_t SPI::transfer(Buffer_t rx_data, Buffer_t tx_data, uint32_t timeout)
   return transfer(rx_data.data(), tx_data.data(), rx_data.size(), timeout);
 }
 
+/**
+ * @brief Submit a transfer and get a token to track its completion
+ * @param rx_data Buffer to store the data read
+ * @param tx_data Buffer where data to write is stored
+ * @param byte_count Number of bytes to write and read
+ * @param timeout Time to wait in milliseconds before returning an error
+ * @return DriverToken
+ */
+DriverToken SPI::transferAsync(uint8_t *rx_data, uint8_t *tx_data, Size_t byte_count, uint32_t timeout)
+{
+  return transferAsync(rx_data, tx_data, byte_count, timeout, nullptr);
+}
+
+/**
+ * @brief Submit a full-duplex transfer done in place on a pooled buffer, the
+ *        data read replaces the data written
+ * @param buffer Buffer taken from a BufferPool, its size is the byte count
+ * @param timeout Time to wait in milliseconds before returning an error
+ * @return DriverToken
+ */
+DriverToken SPI::transferAsync(PoolBuffer buffer, uint32_t timeout)
+{
+  if(!buffer.valid()) { return DriverToken(STATUS_DRV_NULL_POINTER);}
+  return transferAsync(buffer.data(), buffer.data(), buffer.size(), timeout, &buffer);
+}
+
+/**
+ * @brief Submit a transfer and get a token to track its completion
+ * @param rx_data Buffer to store the data read
+ * @param tx_data Buffer where data to write is stored
+ * @param byte_count Number of bytes to write and read
+ * @param timeout Time to wait in milliseconds before returning an error
+ * @param buffer Pooled buffer kept alive while the request is in flight, may be nullptr
+ * @return DriverToken
+ */
+DriverToken SPI::transferAsync(uint8_t *rx_data, uint8_t *tx_data, Size_t byte_count, uint32_t timeout, const PoolBuffer *buffer)
+{
+  Status_t status;
+  DriverToken token;
+  void *completion;
+  void *pool_buffer;
+
+  if(!m_is_async_mode)
+  {
+    status = transfer(rx_data, tx_data, byte_count, timeout);
+    return DriverToken(status, status.success ? byte_count : 0);
+  }
+
+  if(rx_data == nullptr) { return DriverToken(STATUS_DRV_NULL_POINTER);}
+  token = DriverToken::create(EVENT_READ_WRITE, Buffer_t(rx_data, byte_count));
+  if(!token.valid()) { return token;}
+
+  completion = token.attach();
+  pool_buffer = buffer != nullptr ? buffer->retain() : nullptr;
+  status = queueTransfer(rx_data, tx_data, byte_count, timeout, completion, pool_buffer);
+  if(!status.success)
+  {
+    DriverToken::complete(completion, {0, status, 0, EVENT_READ_WRITE});
+    PoolBuffer::release(pool_buffer);
+  }
+  return token;
+}
+
 /**
  * @brief Install a callback function
  * @param event An event to trigger the call
@@ -298,21 +504,108 @@ Status_t SPI::transfer(Buffer_t rx_data, Buffer_t tx_data, uint32_t timeout)
  */
 Status_t SPI::setCallback(DriverEventsList_t event, DriverCallback_t function, void *user_arg)
 {
-  return STATUS_DRV_NOT_IMPLEMENTED;
+  Status_t status = STATUS_DRV_SUCCESS;
+
+  switch (event)
+  {
+  case EVENT_READ:
+    if(getReadStatus().code != OPERATION_RUNNING)
+    {
+      m_func_rx = function;
+      m_arg_rx = user_arg;
+    }else
+    {
+      status = STATUS_DRV_ERR_BUSY;
+    }
+    break;
+  case EVENT_WRITE:
+    if (getWriteStatus().code != OPERATION_RUNNING)
+    {
+      m_func_tx = function;
+      m_arg_tx = user_arg;
+    }else
+    {
+      status = STATUS_DRV_ERR_BUSY;
+    }
+    break;
+  default:
+    status = STATUS_DRV_ERR_PARAM;
+    break;
+  }
+
+  return status;
 }
 
 /**
- * @brief Perform a data transaction on the bus
+ * @brief Get the outcome of the oldest read or transfer request not yet collected
+ * @param request Storage for the outcome of the request
+ * @param timeout Time to wait in milliseconds before returning an error
+ * @return Status_t
+ */
+Status_t SPI::getReadResult(DriverRequest_t &request, uint32_t timeout)
+{
+  if(m_rx_results.get(request, timeout)) { return STATUS_DRV_SUCCESS;}
+  return STATUS_DRV_ERR_TIMEOUT;
+}
+
+/**
+ * @brief Get the outcome of the oldest write request not yet collected
+ * @param request Storage for the outcome of the request
+ * @param timeout Time to wait in milliseconds before returning an error
+ * @return Status_t
+ */
+Status_t SPI::getWriteResult(DriverRequest_t &request, uint32_t timeout)
+{
+  if(m_tx_results.get(request, timeout)) { return STATUS_DRV_SUCCESS;}
+  return STATUS_DRV_ERR_TIMEOUT;
+}
+
+/**
+ * @brief Perform a data transaction on the bus, with the checksum of a write
+ *        appended and the one of a read checked
  * @param txBuf Buffer where data to write is stored
  * @param rxBuf Buffer to store the data read
  * @param byte_count Number of bytes to write and read
  * @return Status_t
  */
 Status_t SPI::xSpiXfer(uint8_t *txBuf, uint8_t *rxBuf, uint32_t byte_count)
+{
+  Status_t status;
+  Size_t frame_size;
+
+  if(!m_checksum.isEnabled() || (txBuf != nullptr && rxBuf != nullptr))
+  {
+    // Full duplex transfers carry no checksum, the device answers as it reads
+    return xSpiTransfer(txBuf, rxBuf, byte_count);
+  }
+  if(rxBuf == nullptr)
+  {
+    txBuf = m_checksum.append(txBuf, byte_count, frame_size);
+    return xSpiTransfer(txBuf, nullptr, frame_size);
+  }
+  status = xSpiTransfer(nullptr, rxBuf, byte_count);
+  if(!status.success) { return status;}
+  return m_checksum.verify(rxBuf, byte_count);
+}
+
+/**
+ * @brief Perform a data transaction on the bus, as given
+ * @param txBuf Buffer where data to write is stored
+ * @param rxBuf Buffer to store the data read
+ * @param byte_count Number of bytes to write and read
+ * @return Status_t
+ */
+Status_t SPI::xSpiTransfer(uint8_t *txBuf, uint8_t *rxBuf, uint32_t byte_count)
 {
   Status_t status;
   struct spi_ioc_transfer spi;
 
+  if(m_backend != nullptr) { return m_backend->transfer(txBuf, rxBuf, byte_count);}
+  if(m_bus_device != nullptr)
+  {
+    BusSegment_t segment = {txBuf, rxBuf, (uint16_t) byte_count};
+    return m_bus_device->transfer(&segment, 1);
+  }
    memset(&spi, 0, sizeof(spi));
 
   spi.tx_buf        = (uintptr_t)txBuf;
@@ -344,7 +637,7 @@ Status_t SPI::xSpiXfer(uint8_t *txBuf, uint8_t *rxBuf, uint32_t byte_count)
 Status_t SPI::checkInputs(const uint8_t *buffer, uint32_t size, uint32_t timeout)
 {
   if(buffer == nullptr) { return STATUS_DRV_NULL_POINTER;}
-  if(m_handle == nullptr || m_linux_handle < 0) { return STATUS_DRV_BAD_HANDLE;}
+  if(m_handle == nullptr || (m_linux_handle < 0 && m_backend == nullptr && m_bus_device == nullptr)) { return STATUS_DRV_BAD_HANDLE;}
   if(size == 0) { return STATUS_DRV_ERR_PARAM_SIZE;}
   return STATUS_DRV_SUCCESS;
 }
@@ -357,23 +650,76 @@ Status_t SPI::checkInputs(const uint8_t *buffer, uint32_t size, uint32_t timeout
  */
 Status_t SPI::transferDataAsync(DataBundle_t data_bundle, void *self_ptr)
 {
+  DRIVER_TRACE_SCOPE("spi", "transfer");
+  Status_t status;
+  uint64_t start;
+  uint32_t byte_count;
   SPI *obj = static_cast<SPI *>(self_ptr);
   if(obj == nullptr)
   {
     return STATUS_DRV_NULL_POINTER;
   }
-  if(data_bundle.rx_size > data_bundle.tx_size)
+  byte_count = data_bundle.rx_size > data_bundle.tx_size ? data_bundle.rx_size : data_bundle.tx_size;
+  obj->m_stats.recordSince(DRIVER_LATENCY_QUEUE_WAIT, data_bundle.timestamp);
+  start = DriverStats::getTimeNs();
+  status = obj->xSpiXfer(data_bundle.tx_buffer, data_bundle.rx_buffer, byte_count);
+  obj->m_stats.recordSince(DRIVER_LATENCY_SYSCALL, start);
+  obj->finishRequest(data_bundle, status, status.success ? byte_count : 0);
+  return status;
+}
+
+/**
+ * @brief Report the end of a queued request, in the order they were queued
+ * @param data_bundle The request
+ * @param status Status of the request
+ * @param byte_count Number of bytes transferred
+ */
+void SPI::finishRequest(const DataBundle_t &data_bundle, Status_t status, Size_t byte_count)
+{
+  uint64_t start;
+  DriverRequest_t request = {data_bundle.id, status, byte_count, EVENT_READ};
+
+  if(data_bundle.tx_buffer != nullptr)
+  {
+    m_bytes_written = byte_count;
+    completeWrite(status);
+    m_stats.countWrite(status, byte_count);
+    DRIVER_RECORD(m_record_id, DRIVER_RECORD_WRITE, data_bundle.tx_buffer, byte_count);
+  }
+  if(data_bundle.rx_buffer != nullptr)
   {
-    obj->m_read_status = obj->xSpiXfer(data_bundle.tx_buffer, data_bundle.rx_buffer, data_bundle.rx_size);
-    return obj->m_read_status;
-  }else if(data_bundle.rx_size < data_bundle.tx_size)
+    m_bytes_read = byte_count;
+    completeRead(status);
+    m_stats.countRead(status, byte_count);
+    DRIVER_RECORD(m_record_id, DRIVER_RECORD_READ, data_bundle.rx_buffer, byte_count);
+  }
+
+  if(data_bundle.rx_buffer != nullptr)
   {
-    obj->m_write_status = obj->xSpiXfer(data_bundle.tx_buffer, data_bundle.rx_buffer, data_bundle.tx_size);
-    return obj->m_write_status;
+    if(data_bundle.tx_buffer != nullptr) { request.event = EVENT_READ_WRITE;}
+    if(m_func_rx != nullptr)
+    {
+      DRIVER_TRACE_SCOPE("spi", "callback");
+      start = DriverStats::getTimeNs();
+      Buffer_t data_container(data_bundle.rx_buffer, byte_count);
+      m_func_rx(status, request.event, data_container, m_arg_rx);
+      m_stats.recordSince(DRIVER_LATENCY_CALLBACK, start);
+    }
+    // Results nobody collects are dropped oldest first once the queue is full
+    (void) m_rx_results.putOverwrite(request);
   }else
   {
-    obj->m_read_status = obj->xSpiXfer(data_bundle.tx_buffer, data_bundle.rx_buffer, data_bundle.rx_size);
-    obj->m_write_status = obj->m_read_status;
-    return obj->m_read_status;
+    request.event = EVENT_WRITE;
+    if(m_func_tx != nullptr)
+    {
+      DRIVER_TRACE_SCOPE("spi", "callback");
+      start = DriverStats::getTimeNs();
+      Buffer_t data_container(data_bundle.tx_buffer, byte_count);
+      m_func_tx(status, EVENT_WRITE, data_container, m_arg_tx);
+      m_stats.recordSince(DRIVER_LATENCY_CALLBACK, start);
+    }
+    (void) m_tx_results.putOverwrite(request);
   }
+  DriverToken::complete(data_bundle.completion, request);
+  PoolBuffer::release(data_bundle.pool_buffer);
 }
\ No newline at end of file
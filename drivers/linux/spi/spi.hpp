@@ -15,6 +15,9 @@
 #include "peripherals_base/spi_base.hpp"
 #include "linux/utils/linux_types.hpp"
 #include "linux/utils/linux_threads.hpp"
+#include "linux/virtual/virtual_backend.hpp"
+#include "linux/bus/linux_bus.hpp"
+#include "checksum/checksum.hpp"
 
 /**
  * @brief Base class for spi drivers
@@ -23,6 +26,8 @@ class SPI final : public SpiBase
 {
 public:
   SPI(const void *port_handle);
+  SPI(VirtualSpiBackend &backend);
+  SPI(LinuxSpiBus &bus, uint16_t chip_select = 0, bool is_mergeable = false);
 
   ~SPI();
 
@@ -37,18 +42,39 @@ public:
   Status_t transfer(uint8_t *rx_data, uint8_t *tx_data, Size_t byte_count, uint32_t timeout = UINT32_MAX);
   Status_t transfer(Buffer_t rx_data, Buffer_t tx_data, uint32_t timeout = UINT32_MAX);
 
+  DriverToken transferAsync(uint8_t *rx_data, uint8_t *tx_data, Size_t byte_count, uint32_t timeout = UINT32_MAX);
+  DriverToken transferAsync(PoolBuffer buffer, uint32_t timeout = UINT32_MAX);
+
   Status_t setCallback(DriverEventsList_t event = EVENT_NONE, DriverCallback_t function = nullptr, void *user_arg = nullptr);
 
+  Status_t getReadResult(DriverRequest_t &request, uint32_t timeout = UINT32_MAX);
+
+  Status_t getWriteResult(DriverRequest_t &request, uint32_t timeout = UINT32_MAX);
+
 private:
   LinuxThreads<DataBundle_t, Status_t, SPI_QUEUE_SIZE, 0> m_thread_handle;
+  LinuxQueue<DriverRequest_t, SPI_QUEUE_SIZE> m_rx_results;
+  LinuxQueue<DriverRequest_t, SPI_QUEUE_SIZE> m_tx_results;
   int m_linux_handle;
   uint32_t m_speed;
+  VirtualSpiBackend *m_backend;
+  BusDevice *m_bus_device;
+  FrameChecksum m_checksum;
+
+  Status_t queueRead(uint8_t *data, Size_t byte_count, uint32_t timeout, void *completion, void *pool_buffer);
+  Status_t queueWrite(uint8_t *data, Size_t byte_count, uint32_t timeout, void *completion, void *pool_buffer);
+  Status_t queueTransfer(uint8_t *rx_data, uint8_t *tx_data, Size_t byte_count, uint32_t timeout, void *completion, void *pool_buffer);
 
   Status_t xSpiXfer(uint8_t *txBuf, uint8_t *rxBuf, uint32_t byte_count);
+  Status_t xSpiTransfer(uint8_t *txBuf, uint8_t *rxBuf, uint32_t byte_count);
 
   Status_t checkInputs(const uint8_t *buffer, uint32_t size, uint32_t timeout);
 
   static Status_t transferDataAsync(DataBundle_t data_bundle, void *self_ptr);
+
+  void finishRequest(const DataBundle_t &data_bundle, Status_t status, Size_t byte_count);
+
+  DriverToken transferAsync(uint8_t *rx_data, uint8_t *tx_data, Size_t byte_count, uint32_t timeout, const PoolBuffer *buffer);
 };
 
 #endif /* DRIVERS_LINUX_SPI_SPI_HPP */
\ No newline at end of file
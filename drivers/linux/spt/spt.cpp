@@ -56,4 +56,24 @@ void SPT::delay(uint32_t duration)
       std::this_thread::sleep_for(std::chrono::milliseconds(duration));
       break;
   }
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Non-blocking delay for coroutines, falls back to delay() outside
+ *        of a scheduler
+ * @param duration The specified time to delay
+ * @return LinuxSleepAwaiter
+ */
+LinuxSleepAwaiter SPT::sleep(uint32_t duration)
+{
+  switch(m_unit)
+  {
+    case SOFTWARE_TIMER_SECONDS:
+      return LinuxSleepAwaiter((uint64_t) duration * 1000000);
+    case SOFTWARE_TIMER_MICROSECONDS:
+      return LinuxSleepAwaiter(duration);
+    case SOFTWARE_TIMER_MILLISECONDS:
+    default:
+      return LinuxSleepAwaiter((uint64_t) duration * 1000);
+  }
+}
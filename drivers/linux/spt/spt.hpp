@@ -16,6 +16,7 @@
 #include <stdbool.h>
 
 #include "peripherals_base/spt_base.hpp"
+#include "linux/utils/linux_scheduler.hpp"
 
 class SPT final : public SptBase
 {
@@ -26,6 +27,8 @@ public:
   sft_time_us_t getTimeSincePowerOnUs();
 
   void delay(uint32_t duration);
+
+  LinuxSleepAwaiter sleep(uint32_t duration);
 };
 
 #endif /* DRIVERS_LINUX_SPT_SPT_HPP */
\ No newline at end of file
@@ -18,7 +18,7 @@
 
 #include "linux/utils/linux_io.hpp"
 
-static speed_t convertSpeed(uint32_t speed);
+static bool convertSpeed(uint32_t speed, speed_t &output);
 
 /**
  * @brief Constructor
@@ -31,6 +31,14 @@ m_tx_thread_handle(UART::writeFromThreadBlocking, this)
   m_handle = port_handle;
   m_linux_handle = -1;
   m_is_async_mode = false;
+  m_is_pipelined_mode = false;
+  m_baud_rate = 1152000;
+  m_requested_baud_rate = 1152000;
+  m_latency_timer_ms = -1;
+  m_low_latency = -1;
+  m_character_bits = 10;
+  m_rx_thread_handle.setName("uart_rx");
+  m_tx_thread_handle.setName("uart_tx");
 }
 
 /**
@@ -38,6 +46,11 @@ m_tx_thread_handle(UART::writeFromThreadBlocking, this)
  */
 UART::~UART()
 {
+  // Workers report to the result queues, stop them before anything else
+  (void) m_rx_thread_handle.terminate();
+  (void) m_tx_thread_handle.terminate();
+  m_tx_pipeline.stop();
+  m_rs485.stop();
   if(m_linux_handle >= 0)
   {
     (void) close(m_linux_handle);
@@ -52,15 +65,25 @@ UART::~UART()
  */
 Status_t UART::configure(const DriverSettings_t *list, uint8_t list_size)
 {
+  DRIVER_TRACE_SCOPE("uart", "configure");
   Status_t status;
   struct termios termios_structure;
   speed_t speed = B1152000;
+  uint32_t baud_rate = 1152000;
+  int actual_rate;
+  bool is_standard_rate = true;
+  uint32_t latency_timer_ms = 0;
+  int low_latency = -1;
+  bool use_rs485 = false;
+  Rs485Settings_t rs485_settings = {true, RS485_NO_GPIO, 0, 0, 0};
   uint32_t stop_bits_count = 1;
   bool use_parity = false, use_hw_flow_ctrl = false;
+  LinuxThreadAttributes_t thread_attributes = LinuxThreadAttributes::getDefaults();
 
   if(m_handle == nullptr) { return STATUS_DRV_NULL_POINTER;}
-  m_read_status = STATUS_DRV_NOT_CONFIGURED;
-  m_write_status = STATUS_DRV_NOT_CONFIGURED;
+  setReadStatus(STATUS_DRV_NOT_CONFIGURED);
+  setWriteStatus(STATUS_DRV_NOT_CONFIGURED);
+  (void) m_checksum.setType(CHECKSUM_NONE);
 
   if(list != nullptr && list_size != 0)
   {
@@ -77,11 +100,15 @@ Status_t UART::configure(const DriverSettings_t *list, uint8_t list_size)
         case COMM_USE_HW_FLOW_CTRL:
           use_hw_flow_ctrl = true;
           break;
-        case COMM_PARAM_BAUD:
-          speed = convertSpeed(list[i].value);
+        case COMM_USE_HW_CRC:
+        case COMM_USE_HW_CKSUM:
+          status = m_checksum.configure(list[i]);
+          if(!status.success) { return status;}
           break;
+        case COMM_PARAM_BAUD:
         case COMM_PARAM_CLOCK_SPEED:
-          speed = convertSpeed(list[i].value);
+          is_standard_rate = convertSpeed(list[i].value, speed);
+          baud_rate = list[i].value;
           break;
         case COMM_PARAM_LINE_MODE:
           if(list[i].value == 0) { use_parity = false; stop_bits_count = 1; use_hw_flow_ctrl = false;}
@@ -96,12 +123,43 @@ Status_t UART::configure(const DriverSettings_t *list, uint8_t list_size)
         case COMM_WORK_ASYNC:
           m_is_async_mode = (bool) list[i].value;
           break;
+        case COMM_WORK_PIPELINED:
+          m_is_pipelined_mode = (bool) list[i].value;
+          break;
+        case COMM_PARAM_LOW_LATENCY:
+          latency_timer_ms = list[i].value;
+          break;
+        case COMM_USE_LOW_LATENCY:
+          low_latency = list[i].value != 0 ? 1 : 0;
+          break;
+        case COMM_USE_RS485:
+          use_rs485 = list[i].value != 0;
+          rs485_settings.active_high = list[i].value != 2;
+          break;
+        case COMM_PARAM_RTS_GPIO:
+          use_rs485 = true;
+          rs485_settings.gpio = list[i].value;
+          break;
+        case COMM_PARAM_START_DELAY_US:
+          rs485_settings.start_delay_us = list[i].value;
+          break;
+        case COMM_PARAM_END_DELAY_US:
+          rs485_settings.end_delay_us = list[i].value;
+          break;
+        case THREAD_PARAM_POLICY:
+        case THREAD_PARAM_PRIORITY:
+        case THREAD_PARAM_AFFINITY:
+          (void) LinuxThreadAttributes::parse(list[i], thread_attributes);
+          break;
         default:
           break;
       }
     }
   }
 
+  status = LinuxThreadAttributes::check(thread_attributes);
+  if(!status.success) { return status;}
+
   // m_linux_handle = open((char *)m_handle, O_RDWR | O_NOCTTY | O_NDELAY | O_NONBLOCK);
   m_linux_handle = open((char *)m_handle, O_RDWR | O_NOCTTY);
   if (m_linux_handle < 0)
@@ -134,6 +192,8 @@ Status_t UART::configure(const DriverSettings_t *list, uint8_t list_size)
   {
     termios_structure.c_cflag |= CSTOPB;
   }
+  // Start bit, 8 data bits, parity and stop bits
+  m_character_bits = 9 + (use_parity ? 1 : 0) + stop_bits_count;
 
   // For more info on how to setup VMIN and VTIME,
   // please refer to http://www.unixwiz.net/techtips/termios-vmin-vtime.html
@@ -143,8 +203,70 @@ Status_t UART::configure(const DriverSettings_t *list, uint8_t list_size)
   tcflush(m_linux_handle, TCIFLUSH);
   tcsetattr(m_linux_handle, TCSANOW, &termios_structure);
 
+  // Rates without a Bxxx constant go through termios2, then the port tells
+  // which rate its divider reached, the nearest to the one asked
+  if(!is_standard_rate && setBaudRateSyscall(m_linux_handle, baud_rate) < 0)
+  {
+    SET_STATUS(status, false, SRC_DRIVER, ERR_PARAM_VALUE, (char *)"The port does not support this baud rate.\r\n");
+    (void) close(m_linux_handle);
+    m_linux_handle = -1;
+    return status;
+  }
+  m_requested_baud_rate = baud_rate;
+  actual_rate = getBaudRateSyscall(m_linux_handle);
+  m_baud_rate = (actual_rate > 0) ? (uint32_t) actual_rate : baud_rate;
+  if((uint64_t) (m_baud_rate > baud_rate ? m_baud_rate - baud_rate : baud_rate - m_baud_rate) * 1000 > (uint64_t) baud_rate * UART_BAUD_TOLERANCE)
+  {
+    SET_STATUS(status, false, SRC_DRIVER, ERR_PARAM_VALUE, (char *)"The port can not reach this baud rate.\r\n");
+    (void) close(m_linux_handle);
+    m_linux_handle = -1;
+    return status;
+  }
+
+  // Both are best effort, ports without serial settings or a latency timer
+  // already deliver bytes as they come. The flag goes first, FTDI adapters
+  // run a 1 ms timer whatever was written while it is set
+  if(low_latency >= 0) { (void) setLowLatencySyscall(m_linux_handle, low_latency == 1);}
+  if(latency_timer_ms != 0) { (void) setLatencyTimerSysfs((const char *) m_handle, latency_timer_ms);}
+  m_latency_timer_ms = getLatencyTimerSysfs((const char *) m_handle);
+  m_low_latency = getLowLatencySyscall(m_linux_handle);
+
+  m_rs485.stop();
+  if(use_rs485)
+  {
+    rs485_settings.character_ns = getCharacterTimeNs();
+    status = m_rs485.start(m_linux_handle, rs485_settings);
+    if(!status.success)
+    {
+      (void) close(m_linux_handle);
+      m_linux_handle = -1;
+      return status;
+    }
+    // Writes switched from here return once the frame left, the pipeline
+    // would release the transceiver before
+    if(m_rs485.isSwitchedHere()) { m_is_pipelined_mode = false;}
+  }
+
+  if(m_is_pipelined_mode)
+  {
+    m_tx_pipeline.setAttributes(thread_attributes);
+    if(!m_tx_pipeline.start(m_linux_handle, m_baud_rate))
+    {
+      SET_STATUS(status, false, SRC_DRIVER, ERR_FAILED, (char *)"Failed to launch the UART transmission tracker.\r\n");
+      m_rs485.stop();
+      (void) close(m_linux_handle);
+      m_linux_handle = -1;
+      return status;
+    }
+  }else
+  {
+    m_tx_pipeline.stop();
+  }
+
   if(m_is_async_mode)
   {
+    m_rx_thread_handle.setAttributes(thread_attributes);
+    m_tx_thread_handle.setAttributes(thread_attributes);
     if(!m_rx_thread_handle.create() || !m_tx_thread_handle.create())
     {
       SET_STATUS(status, false, SRC_DRIVER, ERR_FAILED, (char *)"Failed to launch one or more UART tasks.\r\n");
@@ -156,8 +278,8 @@ Status_t UART::configure(const DriverSettings_t *list, uint8_t list_size)
     (void) m_tx_thread_handle.terminate();
   }
 
-  m_read_status = STATUS_DRV_IDLE;
-  m_write_status = STATUS_DRV_IDLE;
+  setReadStatus(STATUS_DRV_IDLE);
+  setWriteStatus(STATUS_DRV_IDLE);
   return STATUS_DRV_SUCCESS;
 }
 
@@ -170,39 +292,58 @@ Status_t UART::configure(const DriverSettings_t *list, uint8_t list_size)
  */
 Status_t UART::read(uint8_t *data, Size_t byte_count, uint32_t timeout)
 {
+  DRIVER_TRACE_SCOPE("uart", "read");
   Status_t status;
-  int bytes_read = 0;
-  DataBundle_t data_bundle;
+  uint64_t start;
+
+  if(m_is_async_mode) { return queueRead(data, byte_count, timeout, nullptr, nullptr);}
 
   status = checkInputs(data, byte_count, timeout);
   if(!status.success) { return status;}
-  if(m_read_status.code == OPERATION_RUNNING) { return STATUS_DRV_ERR_BUSY;}
 
-  m_read_status = STATUS_DRV_RUNNING;
-  m_read_status.success = false;
+  if(!beginRead()) { m_stats.countBusy(); return STATUS_DRV_ERR_BUSY;}
   m_bytes_read = 0;
+  start = DriverStats::getTimeNs();
+  status = readBlocking(data, byte_count, timeout, false);
+  m_stats.recordSince(DRIVER_LATENCY_SYSCALL, start);
+  m_stats.countRead(status, m_bytes_read);
+  DRIVER_RECORD(m_record_id, DRIVER_RECORD_READ, data, m_bytes_read);
+  setReadStatus(status);
+  return status;
+}
 
-  if(m_is_async_mode)
+/**
+ * @brief Queue a read request for the reception thread
+ * @param data Buffer to store the data
+ * @param byte_count Number of bytes to read
+ * @param timeout Time to wait in milliseconds before returning an error
+ * @param completion Token slot completed with the request, may be nullptr
+ * @param pool_buffer Pooled buffer released with the request, may be nullptr
+ * @return Status_t
+ */
+Status_t UART::queueRead(uint8_t *data, Size_t byte_count, uint32_t timeout, void *completion, void *pool_buffer)
+{
+  Status_t status;
+  DataBundle_t data_bundle = {};
+
+  status = checkInputs(data, byte_count, timeout);
+  if(!status.success) { return status;}
+
+  data_bundle.buffer = data;
+  data_bundle.size = byte_count;
+  data_bundle.timeout = timeout;
+  data_bundle.completion = completion;
+  data_bundle.pool_buffer = pool_buffer;
+  data_bundle.timestamp = DriverStats::getTimeNs();
+  data_bundle.id = submitRead();
+  if(m_rx_thread_handle.setInputData(&data_bundle, 0))
   {
-    data_bundle.buffer = data;
-    data_bundle.size = byte_count;
-    data_bundle.timeout = timeout;
-    if(m_rx_thread_handle.setInputData(&data_bundle, 0))
-    {
-      return STATUS_DRV_SUCCESS;
-    }else
-    {
-      m_read_status = STATUS_DRV_IDLE;
-      return STATUS_DRV_ERR_BUSY;
-    }
+    return STATUS_DRV_SUCCESS;
   }else
   {
-    status = readBlocking(data, byte_count, timeout, false);
-    m_read_status = status;
-    return status;
+    cancelRead();
+    return STATUS_DRV_ERR_BUSY;
   }
-
-  return STATUS_DRV_UNKNOWN_ERROR;
 }
 
 /**
@@ -214,39 +355,150 @@ Status_t UART::read(uint8_t *data, Size_t byte_count, uint32_t timeout)
  */
 Status_t UART::write(uint8_t *data, Size_t byte_count, uint32_t timeout)
 {
+  DRIVER_TRACE_SCOPE("uart", "write");
   Status_t status;
-  int bytes_written, drain_status;
-  DataBundle_t data_bundle;
+  uint64_t start;
+
+  if(m_is_async_mode) { return queueWrite(data, byte_count, timeout, nullptr, nullptr);}
 
   status = checkInputs(data, byte_count, timeout);
   if(!status.success) { return status;}
-  if(m_write_status.code == OPERATION_RUNNING) { return STATUS_DRV_ERR_BUSY;}
 
-  m_write_status = STATUS_DRV_RUNNING;
-  m_write_status.success = false;
+  if(!beginWrite()) { m_stats.countBusy(); return STATUS_DRV_ERR_BUSY;}
   m_bytes_written = 0;
+  start = DriverStats::getTimeNs();
+  status = writeBlocking(data, byte_count, timeout);
+  m_stats.recordSince(DRIVER_LATENCY_SYSCALL, start);
+  m_stats.countWrite(status, m_bytes_written);
+  DRIVER_RECORD(m_record_id, DRIVER_RECORD_WRITE, data, m_bytes_written);
+  setWriteStatus(status);
+  return status;
+}
 
-  if(m_is_async_mode)
+/**
+ * @brief Queue a write request for the transmission thread
+ * @param data Buffer where data is stored
+ * @param byte_count Number of bytes to write
+ * @param timeout Time to wait in milliseconds before returning an error
+ * @param completion Token slot completed with the request, may be nullptr
+ * @param pool_buffer Pooled buffer released with the request, may be nullptr
+ * @return Status_t
+ */
+Status_t UART::queueWrite(uint8_t *data, Size_t byte_count, uint32_t timeout, void *completion, void *pool_buffer)
+{
+  Status_t status;
+  DataBundle_t data_bundle = {};
+
+  status = checkInputs(data, byte_count, timeout);
+  if(!status.success) { return status;}
+
+  data_bundle.buffer = data;
+  data_bundle.size = byte_count;
+  data_bundle.timeout = timeout;
+  data_bundle.completion = completion;
+  data_bundle.pool_buffer = pool_buffer;
+  data_bundle.timestamp = DriverStats::getTimeNs();
+  data_bundle.id = submitWrite();
+  if(m_tx_thread_handle.setInputData(&data_bundle, 0))
   {
-    data_bundle.buffer = data;
-    data_bundle.size = byte_count;
-    data_bundle.timeout = timeout;
-    if(m_tx_thread_handle.setInputData(&data_bundle, 0))
-    {
-      return STATUS_DRV_SUCCESS;
-    }else
-    {
-      m_write_status = STATUS_DRV_IDLE;
-      return STATUS_DRV_ERR_BUSY;
-    }
+    return STATUS_DRV_SUCCESS;
   }else
   {
-    status = writeBlocking(data, byte_count, timeout, false);
-    m_write_status = status;
-    return status;
+    cancelWrite();
+    return STATUS_DRV_ERR_BUSY;
   }
+}
+
+/**
+ * @brief Read a frame that ends when the line stays idle
+ *
+ * @note Deadlines are in microseconds, so that frame boundaries of a few
+ *       characters can be told apart, see getCharacterTimeNs(). Only in
+ *       blocking mode, the reception thread owns the port otherwise.
+ * @param data Buffer to store the data
+ * @param byte_count Number of bytes to read, returns as soon as they came
+ * @param timeout_us Time to wait for the first byte
+ * @param gap_us Idle time after a byte that ends the frame
+ * @return Status_t
+ */
+Status_t UART::readFrame(uint8_t *data, Size_t byte_count, uint32_t timeout_us, uint32_t gap_us)
+{
+  DRIVER_TRACE_SCOPE("uart", "read");
+  Status_t status = STATUS_DRV_SUCCESS;
+  uint64_t start;
+  int bytes_read;
+
+  if(m_is_async_mode) { return STATUS_DRV_ERR_BUSY;}
+
+  status = checkInputs(data, byte_count, timeout_us);
+  if(!status.success) { return status;}
 
-  return STATUS_DRV_UNKNOWN_ERROR;
+  if(!beginRead()) { m_stats.countBusy(); return STATUS_DRV_ERR_BUSY;}
+  m_bytes_read = 0;
+  start = DriverStats::getTimeNs();
+  bytes_read = readOnGapSyscall(m_linux_handle, data, byte_count, timeout_us, gap_us);
+  if(bytes_read < 0)
+  {
+    status = convertErrnoCode(errno);
+  }else if(bytes_read == 0)
+  {
+    status = STATUS_DRV_TIMED_OUT;
+  }else
+  {
+    m_bytes_read = bytes_read;
+    status = m_checksum.verify(data, m_bytes_read);
+  }
+  m_stats.recordSince(DRIVER_LATENCY_SYSCALL, start);
+  m_stats.countRead(status, m_bytes_read);
+  DRIVER_RECORD(m_record_id, DRIVER_RECORD_READ, data, m_bytes_read);
+  setReadStatus(status);
+  return status;
+}
+
+/**
+ * @brief Get the time a character takes on the line at the configured baud
+ *        rate, start, parity and stop bits included
+ * @return uint32_t
+ */
+uint32_t UART::getCharacterTimeNs()
+{
+  if(m_baud_rate == 0) { return 0;}
+  return (uint32_t) ((uint64_t) m_character_bits * 1000000000ULL / m_baud_rate);
+}
+
+/**
+ * @brief Block until every byte written has left the transmitter
+ * @return Status_t
+ */
+Status_t UART::flush()
+{
+  DRIVER_TRACE_SCOPE("uart", "flush");
+  if(m_handle == nullptr || m_linux_handle < 0) { return STATUS_DRV_BAD_HANDLE;}
+  if(m_is_pipelined_mode)
+  {
+    return m_tx_pipeline.flush();
+  }
+  if(tcdrain(m_linux_handle) < 0)
+  {
+    return convertErrnoCode(errno);
+  }
+  return STATUS_DRV_SUCCESS;
+}
+
+/**
+ * @brief Get the number of bytes written but not yet sent
+ * @return Size_t
+ */
+Size_t UART::getBytesPending()
+{
+  int byte_count;
+  if(m_is_pipelined_mode)
+  {
+    return m_tx_pipeline.getBytesPending();
+  }
+  if(m_linux_handle < 0) { return 0;}
+  byte_count = bytesPendingSyscall(m_linux_handle);
+  return byte_count > 0 ? byte_count : 0;
 }
 
 /**
@@ -264,7 +516,7 @@ Status_t UART::setCallback(DriverEventsList_t event, DriverCallback_t function,
   switch (event)
   {
   case EVENT_READ:
-    if(m_read_status.code != OPERATION_RUNNING)
+    if(getReadStatus().code != OPERATION_RUNNING)
     {
       m_func_rx = function;
       m_arg_rx = user_arg;
@@ -274,7 +526,7 @@ Status_t UART::setCallback(DriverEventsList_t event, DriverCallback_t function,
     }
     break;
   case EVENT_WRITE:
-    if (m_write_status.code != OPERATION_RUNNING)
+    if (getWriteStatus().code != OPERATION_RUNNING)
     {
       m_func_tx = function;
       m_arg_tx = user_arg;
@@ -291,21 +543,46 @@ Status_t UART::setCallback(DriverEventsList_t event, DriverCallback_t function,
   return status;
 }
 
+/**
+ * @brief Get the outcome of the oldest read request not yet collected
+ * @param request Storage for the outcome of the request
+ * @param timeout Time to wait in milliseconds before returning an error
+ * @return Status_t
+ */
+Status_t UART::getReadResult(DriverRequest_t &request, uint32_t timeout)
+{
+  if(m_rx_results.get(request, timeout)) { return STATUS_DRV_SUCCESS;}
+  return STATUS_DRV_ERR_TIMEOUT;
+}
+
+/**
+ * @brief Get the outcome of the oldest write request not yet collected
+ * @param request Storage for the outcome of the request
+ * @param timeout Time to wait in milliseconds before returning an error
+ * @return Status_t
+ */
+Status_t UART::getWriteResult(DriverRequest_t &request, uint32_t timeout)
+{
+  if(m_tx_results.get(request, timeout)) { return STATUS_DRV_SUCCESS;}
+  return STATUS_DRV_ERR_TIMEOUT;
+}
+
 /**
  * @brief Read data synchronously
  * @param data Buffer to store the data
  * @param byte_count Number of bytes to read
  * @param timeout Time to wait in milliseconds before returning an error
+ * @param is_async True if called from the reception thread
  * @return Status_t
  */
-Status_t UART::readBlocking(uint8_t *data, Size_t byte_count, uint32_t timeout, bool call_back)
+Status_t UART::readBlocking(uint8_t *data, Size_t byte_count, uint32_t timeout, bool is_async)
 {
   Status_t status = STATUS_DRV_SUCCESS;
   int bytes_read = 0;
 
   m_bytes_read = 0;
 
-  if(call_back)
+  if(is_async)
   {
     timeout = 5;
     bytes_read = readOnTimeoutSyscall(m_linux_handle, data, byte_count, timeout);
@@ -331,14 +608,8 @@ Status_t UART::readBlocking(uint8_t *data, Size_t byte_count, uint32_t timeout,
   }else
   {
     m_bytes_read = bytes_read;
-  }
-
-  m_read_status = status;
-
-  if(call_back && m_func_rx != nullptr)
-  {
-    Buffer_t data_container(data, m_bytes_read);
-    m_func_rx(status, EVENT_READ, data_container, m_arg_rx);
+    // Reads end on an idle line, so the bytes returned are the frame
+    status = m_checksum.verify(data, m_bytes_read);
   }
 
   return status;
@@ -351,10 +622,18 @@ Status_t UART::readBlocking(uint8_t *data, Size_t byte_count, uint32_t timeout,
  */
 Status_t UART::readFromThreadBlocking(DataBundle_t data_bundle, void *user_arg)
 {
+  DRIVER_TRACE_SCOPE("uart", "read");
+  Status_t status;
+  uint64_t start;
   UART *obj = static_cast<UART *>(user_arg);
   if(obj != nullptr)
   {
-    return obj->readBlocking(data_bundle.buffer, data_bundle.size, data_bundle.timeout, true);
+    obj->m_stats.recordSince(DRIVER_LATENCY_QUEUE_WAIT, data_bundle.timestamp);
+    start = DriverStats::getTimeNs();
+    status = obj->readBlocking(data_bundle.buffer, data_bundle.size, data_bundle.timeout, true);
+    obj->m_stats.recordSince(DRIVER_LATENCY_SYSCALL, start);
+    obj->finishRead(data_bundle, status, obj->m_bytes_read);
+    return status;
   }
   return STATUS_DRV_NULL_POINTER;
 }
@@ -366,21 +645,42 @@ Status_t UART::readFromThreadBlocking(DataBundle_t data_bundle, void *user_arg)
  * @param timeout Time to wait in milliseconds before returning an error
  * @return Status_t
  */
-Status_t UART::writeBlocking(uint8_t *data, Size_t byte_count, uint32_t timeout, bool call_back)
+Status_t UART::writeBlocking(uint8_t *data, Size_t byte_count, uint32_t timeout)
 {
   Status_t status = STATUS_DRV_SUCCESS;
   int bytes_written, drain_status;
-  bytes_written = writeSyscall(m_linux_handle, data, byte_count);
-  if (byte_count >= 0)
+  const uint8_t *frame = data;
+  Size_t frame_size = byte_count;
+
+  if(m_is_pipelined_mode)
+  {
+    // The callback runs once the frame has left the transmitter, not here
+    return writePipelined(data, byte_count, m_func_tx, m_arg_tx);
+  }
+
+  if(m_checksum.isEnabled())
+  {
+    // One system call for the data and its checksum, no gap inside the frame
+    frame = m_checksum.append(data, byte_count, frame_size);
+  }
+  if(m_rs485.isSwitchedHere())
+  {
+    // Returns with the frame sent and the transceiver back to receiving
+    bytes_written = m_rs485.write(frame, frame_size);
+  }else
+  {
+    bytes_written = writeSyscall(m_linux_handle, frame, frame_size);
+  }
+  if (bytes_written >= 0)
   {
-    drain_status = tcdrain(m_linux_handle);
+    drain_status = m_rs485.isSwitchedHere() ? 0 : tcdrain(m_linux_handle);
     if (drain_status < 0)
     {
       status = convertErrnoCode(errno);
     }
     else
     {
-      m_bytes_written = bytes_written;
+      m_bytes_written = bytes_written < byte_count ? bytes_written : byte_count;
     }
   }
   else
@@ -388,25 +688,137 @@ Status_t UART::writeBlocking(uint8_t *data, Size_t byte_count, uint32_t timeout,
     status = convertErrnoCode(errno);
   }
 
-  m_write_status = status;
+  return status;
+}
+
+/**
+ * @brief Write data through the transmission tracker
+ *
+ * @note With a checksum the frame sent is a copy, the callback still gets
+ *       the caller's data and byte counts leave the checksum out.
+ * @param data Buffer where data is stored
+ * @param byte_count Number of bytes to write
+ * @param function Called once the frame has left the transmitter
+ * @param user_arg Argument of the function
+ * @return Status_t
+ */
+Status_t UART::writePipelined(uint8_t *data, Size_t byte_count, DriverCallback_t function, void *user_arg)
+{
+  Status_t status;
+  uint8_t *frame;
+  Size_t frame_size;
 
-  if(call_back && m_func_tx != nullptr)
+  if(!m_checksum.isEnabled())
   {
-    Buffer_t data_container(data, m_bytes_read);
-    m_func_tx(status, EVENT_WRITE, data_container, m_arg_tx);
+    return m_tx_pipeline.write(data, byte_count, m_bytes_written, function, user_arg);
   }
 
+  frame = m_checksum.append(data, byte_count, frame_size);
+  status = m_tx_pipeline.write(frame, frame_size, m_bytes_written,
+    [function, user_arg, data, byte_count](Status_t status, DriverEventsList_t event, const Buffer_t sent, void *)
+    {
+      Size_t size = (Size_t) sent.size() < byte_count ? (Size_t) sent.size() : byte_count;
+      if(function == nullptr) { return status;}
+      return function(status, event, Buffer_t(data, size), user_arg);
+    }, nullptr);
+  if(m_bytes_written > byte_count) { m_bytes_written = byte_count;}
   return status;
 }
 
+/**
+ * @brief Write data synchronously
+ * @param data_bundle Data needed to perform the operation
+ * @return Status_t
+ */
 Status_t UART::writeFromThreadBlocking(DataBundle_t data_bundle, void *user_arg)
 {
+  DRIVER_TRACE_SCOPE("uart", "write");
+  Status_t status;
+  uint64_t start;
   UART *obj = static_cast<UART *>(user_arg);
-  if(obj != nullptr)
+  if(obj == nullptr)
   {
-    return obj->writeBlocking(data_bundle.buffer, data_bundle.size, data_bundle.timeout, true);
+    return STATUS_DRV_NULL_POINTER;
   }
-  return STATUS_DRV_NULL_POINTER;
+
+  obj->m_stats.recordSince(DRIVER_LATENCY_QUEUE_WAIT, data_bundle.timestamp);
+  start = DriverStats::getTimeNs();
+  if(obj->m_is_pipelined_mode)
+  {
+    // The request only ends once the frame has left the transmitter
+    status = obj->writePipelined(data_bundle.buffer, data_bundle.size,
+      [obj, data_bundle](Status_t status, DriverEventsList_t, const Buffer_t data, void *)
+      {
+        obj->finishWrite(data_bundle, status, data.size());
+        return status;
+      }, nullptr);
+    obj->m_stats.recordSince(DRIVER_LATENCY_SYSCALL, start);
+    if(!status.success)
+    {
+      obj->finishWrite(data_bundle, status, 0);
+    }
+    return status;
+  }
+
+  status = obj->writeBlocking(data_bundle.buffer, data_bundle.size, data_bundle.timeout);
+  obj->m_stats.recordSince(DRIVER_LATENCY_SYSCALL, start);
+  obj->finishWrite(data_bundle, status, obj->m_bytes_written);
+  return status;
+}
+
+/**
+ * @brief Report the end of a queued read request
+ * @param data_bundle The request
+ * @param status Status of the request
+ * @param byte_count Number of bytes read
+ */
+void UART::finishRead(const DataBundle_t &data_bundle, Status_t status, Size_t byte_count)
+{
+  uint64_t start;
+  DriverRequest_t request = {data_bundle.id, status, byte_count, EVENT_READ};
+
+  completeRead(status);
+  m_stats.countRead(status, byte_count);
+  DRIVER_RECORD(m_record_id, DRIVER_RECORD_READ, data_bundle.buffer, byte_count);
+  if(m_func_rx != nullptr)
+  {
+    DRIVER_TRACE_SCOPE("uart", "callback");
+    start = DriverStats::getTimeNs();
+    Buffer_t data_container(data_bundle.buffer, byte_count);
+    m_func_rx(status, EVENT_READ, data_container, m_arg_rx);
+    m_stats.recordSince(DRIVER_LATENCY_CALLBACK, start);
+  }
+  // Results nobody collects are dropped oldest first once the queue is full
+  (void) m_rx_results.putOverwrite(request);
+  DriverToken::complete(data_bundle.completion, request);
+  PoolBuffer::release(data_bundle.pool_buffer);
+}
+
+/**
+ * @brief Report the end of a queued write request
+ * @param data_bundle The request
+ * @param status Status of the request
+ * @param byte_count Number of bytes written
+ */
+void UART::finishWrite(const DataBundle_t &data_bundle, Status_t status, Size_t byte_count)
+{
+  uint64_t start;
+  DriverRequest_t request = {data_bundle.id, status, byte_count, EVENT_WRITE};
+
+  completeWrite(status);
+  m_stats.countWrite(status, byte_count);
+  DRIVER_RECORD(m_record_id, DRIVER_RECORD_WRITE, data_bundle.buffer, byte_count);
+  if(m_func_tx != nullptr)
+  {
+    DRIVER_TRACE_SCOPE("uart", "callback");
+    start = DriverStats::getTimeNs();
+    Buffer_t data_container(data_bundle.buffer, byte_count);
+    m_func_tx(status, EVENT_WRITE, data_container, m_arg_tx);
+    m_stats.recordSince(DRIVER_LATENCY_CALLBACK, start);
+  }
+  (void) m_tx_results.putOverwrite(request);
+  DriverToken::complete(data_bundle.completion, request);
+  PoolBuffer::release(data_bundle.pool_buffer);
 }
 
 /**
@@ -430,12 +842,11 @@ Status_t UART::checkInputs(const uint8_t *buffer, uint32_t size, uint32_t timeou
  * @brief Convert a speed value into something linux can understand
  *
  * @param speed
- * @return speed_t
+ * @param output Bxxx constant, B38400 for the rates without one
+ * @return true if the rate has a Bxxx constant
  */
-speed_t convertSpeed(uint32_t speed)
+bool convertSpeed(uint32_t speed, speed_t &output)
 {
-  speed_t output;
-
   switch(speed)
   {
     // POSIX compliant options
@@ -472,7 +883,7 @@ speed_t convertSpeed(uint32_t speed)
     case 3000000: output = B3000000; break;
     case 3500000: output = B3500000; break;
     case 4000000: output = B4000000; break;
-    default: output = B115200; break;
+    default: output = B38400; return false;
   }
-  return output;
+  return true;
 }
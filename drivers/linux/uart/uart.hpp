@@ -18,6 +18,18 @@
 #include "peripherals_base/uart_base.hpp"
 #include "linux/utils/linux_types.hpp"
 #include "linux/utils/linux_threads.hpp"
+#include "linux/utils/linux_tx_pipeline.hpp"
+#include "linux/utils/linux_rs485.hpp"
+#include "checksum/checksum.hpp"
+#if __has_include("setup.hpp")
+#include "setup.hpp"
+#endif
+
+// Largest gap between the baud rate asked and the one the port reached, in
+// tenths of a percent, configure() fails beyond it
+#ifndef UART_BAUD_TOLERANCE
+#define UART_BAUD_TOLERANCE                                                   20
+#endif
 
 
 /**
@@ -38,20 +50,62 @@ public:
   using UartBase::write;
   Status_t write(uint8_t *data, Size_t byte_count, uint32_t timeout = UINT32_MAX);
 
+  Status_t readFrame(uint8_t *data, Size_t byte_count, uint32_t timeout_us, uint32_t gap_us);
+
+  uint32_t getCharacterTimeNs();
+
+  uint32_t getBaudRate() { return m_baud_rate;}
+
+  uint32_t getRequestedBaudRate() { return m_requested_baud_rate;}
+
+  int getLatencyTimerMs() { return m_latency_timer_ms;}
+
+  int getLowLatency() { return m_low_latency;}
+
+  Rs485Mode_t getRs485Mode() { return m_rs485.getMode();}
+
+  int getLinuxHandle() { return m_linux_handle;}
+
+  Status_t flush();
+
+  Size_t getBytesPending();
+
+  Status_t getReadResult(DriverRequest_t &request, uint32_t timeout = UINT32_MAX);
+
+  Status_t getWriteResult(DriverRequest_t &request, uint32_t timeout = UINT32_MAX);
+
   Status_t setCallback(DriverEventsList_t event = EVENT_NONE, DriverCallback_t function = nullptr, void *user_arg = nullptr);
 
 private:
   LinuxThreads<DataBundle_t, Status_t, UART_QUEUE_SIZE, 0> m_rx_thread_handle;
   LinuxThreads<DataBundle_t, Status_t, UART_QUEUE_SIZE, 0> m_tx_thread_handle;
+  LinuxQueue<DriverRequest_t, UART_QUEUE_SIZE> m_rx_results;
+  LinuxQueue<DriverRequest_t, UART_QUEUE_SIZE> m_tx_results;
+  LinuxTxPipeline m_tx_pipeline;
+  LinuxRs485 m_rs485;
+  FrameChecksum m_checksum;
   int m_linux_handle;
   bool m_terminate;
+  bool m_is_pipelined_mode;
+  uint32_t m_baud_rate;             /*!< Rate the port reached */
+  uint32_t m_requested_baud_rate;
+  int m_latency_timer_ms;           /*!< Latency timer of the USB adapter, -1 if unknown */
+  int m_low_latency;                /*!< ASYNC_LOW_LATENCY of the port, -1 if unknown */
+  uint8_t m_character_bits;
+
+  Status_t queueRead(uint8_t *data, Size_t byte_count, uint32_t timeout, void *completion, void *pool_buffer);
+  Status_t queueWrite(uint8_t *data, Size_t byte_count, uint32_t timeout, void *completion, void *pool_buffer);
 
-  Status_t readBlocking(uint8_t *data, Size_t byte_count, uint32_t timeout, bool call_back);
+  Status_t readBlocking(uint8_t *data, Size_t byte_count, uint32_t timeout, bool is_async);
   static Status_t readFromThreadBlocking(DataBundle_t data_bundle, void *user_arg);
 
-  Status_t writeBlocking(uint8_t *data, Size_t byte_count, uint32_t timeout, bool call_back);
+  Status_t writeBlocking(uint8_t *data, Size_t byte_count, uint32_t timeout);
+  Status_t writePipelined(uint8_t *data, Size_t byte_count, DriverCallback_t function, void *user_arg);
   static Status_t writeFromThreadBlocking(DataBundle_t data_bundle, void *user_arg);
 
+  void finishRead(const DataBundle_t &data_bundle, Status_t status, Size_t byte_count);
+  void finishWrite(const DataBundle_t &data_bundle, Status_t status, Size_t byte_count);
+
   Status_t checkInputs(const uint8_t *buffer, uint32_t size, uint32_t timeout);
 };
 
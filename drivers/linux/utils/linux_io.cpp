@@ -17,8 +17,15 @@
 #include <thread>
 #include <chrono>
 #include <poll.h>
+#include <errno.h>
 #include <sys/types.h>
 #include <string.h>
+#include <asm/termbits.h>
+#include <linux/serial.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <libgen.h>
+#include <limits.h>
 
 
 
@@ -201,7 +208,60 @@ int readOnTimeoutSyscall3(int fd, uint8_t *buffer, size_t cnt, uint32_t timeout_
     }
     end = std::chrono::steady_clock::now();
     elapsed_time = std::chrono::duration_cast<std::chrono::milliseconds>(end-start).count();
-  } while(elapsed_time < timeout_ms);
+  } while(elapsed_time < timeout_ms && bytes_read < (int) cnt);
+
+  return bytes_read;
+}
+
+/**
+ * @brief Read a frame that ends when the line stays idle, with microsecond
+ *        deadlines
+ *
+ * @note The file must return at once when no byte is available, as a tty
+ *       with VMIN and VTIME at 0. The gap is measured between the bytes as
+ *       the process sees them, an adapter that delivers bytes in bursts
+ *       needs a gap longer than its bursts are apart.
+ * @param fd File descriptor
+ * @param buffer Buffer to store the data
+ * @param cnt Number of bytes to read, returns as soon as they came
+ * @param timeout_us Max. time to wait for the first byte
+ * @param gap_us Max. time to wait for each following byte
+ * @return int Number of bytes actually read
+ */
+int readOnGapSyscall(int fd, uint8_t *buffer, size_t cnt, uint32_t timeout_us, uint32_t gap_us)
+{
+  struct pollfd fds[1];
+  struct timespec wait;
+  int byte_count, bytes_read = 0, ready;
+  if(cnt == 0 || buffer == nullptr) { return 0;}
+
+  fds[0].fd = fd;
+  fds[0].events = POLLIN;
+
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(timeout_us);
+  while(bytes_read < (int) cnt)
+  {
+    auto remaining = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - std::chrono::steady_clock::now()).count();
+    if(remaining <= 0) { break;}
+    wait.tv_sec = remaining / 1000000000;
+    wait.tv_nsec = remaining % 1000000000;
+    ready = ppoll(fds, 1, &wait, nullptr);
+    if(ready < 0)
+    {
+      if(errno == EINTR) { continue;}
+      return -1;
+    }else if(ready == 0)
+    {
+      break;
+    }
+    byte_count = readSyscall(fd, buffer + bytes_read, cnt - bytes_read);
+    if(byte_count < 0) { return -1;}
+    if(byte_count > 0)
+    {
+      bytes_read += byte_count;
+      deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(gap_us);
+    }
+  }
 
   return bytes_read;
 }
@@ -233,6 +293,166 @@ int bytesAvailableSyscall(int fd)
   return byte_count;
 }
 
+/**
+ * @brief Return the number of bytes still waiting on the transmission buffer
+ *
+ * @param fd File descriptor
+ * @return int
+ */
+int bytesPendingSyscall(int fd)
+{
+  int byte_count;
+  if(ioctl(fd, TIOCOUTQ, &byte_count) < 0) { return -1;}
+  return byte_count;
+}
+
+/**
+ * @brief Check if the transmitter shift register is empty
+ *
+ * @param fd File descriptor
+ * @return int 1 if empty, 0 if still shifting data out, -1 if not supported
+ */
+int transmitterEmptySyscall(int fd)
+{
+  unsigned int lsr;
+  if(ioctl(fd, TIOCSERGETLSR, &lsr) < 0) { return -1;}
+  return (lsr & TIOCSER_TEMT) ? 1 : 0;
+}
+
+/**
+ * @brief Set any baud rate, standard or not, both directions
+ *
+ * @note termios only knows the Bxxx rates, termios2 takes the rate itself
+ *       with BOTHER. The driver picks the nearest rate its clock divider
+ *       reaches, getBaudRateSyscall() tells which.
+ *
+ * @param fd File descriptor
+ * @param baud_rate Rate in bauds
+ * @return int 0 on success, -1 on error
+ */
+int setBaudRateSyscall(int fd, uint32_t baud_rate)
+{
+  struct termios2 options;
+  if(ioctl(fd, TCGETS2, &options) < 0) { return -1;}
+  options.c_cflag &= ~(CBAUD | (CBAUD << IBSHIFT));
+  options.c_cflag |= BOTHER | (BOTHER << IBSHIFT);
+  options.c_ispeed = baud_rate;
+  options.c_ospeed = baud_rate;
+  return ioctl(fd, TCSETS2, &options);
+}
+
+/**
+ * @brief Get the baud rate the driver set up
+ *
+ * @param fd File descriptor
+ * @return int Output rate in bauds, -1 on error
+ */
+int getBaudRateSyscall(int fd)
+{
+  struct termios2 options;
+  if(ioctl(fd, TCGETS2, &options) < 0) { return -1;}
+  return (int) options.c_ospeed;
+}
+
+/**
+ * @brief Have the tty layer hand received bytes to readers without deferring
+ *        them, and USB adapters that read the flag drop their latency timer
+ *        to 1 ms
+ *
+ * @param fd File descriptor
+ * @param enable True to set ASYNC_LOW_LATENCY, false to clear it
+ * @return int 0 on success, -1 if the driver has no serial settings
+ */
+int setLowLatencySyscall(int fd, bool enable)
+{
+  struct serial_struct serial;
+  if(ioctl(fd, TIOCGSERIAL, &serial) < 0) { return -1;}
+  if(enable)
+  {
+    serial.flags |= ASYNC_LOW_LATENCY;
+  }else
+  {
+    serial.flags &= ~ASYNC_LOW_LATENCY;
+  }
+  return ioctl(fd, TIOCSSERIAL, &serial);
+}
+
+/**
+ * @brief Tell if ASYNC_LOW_LATENCY is set on a port
+ *
+ * @param fd File descriptor
+ * @return int 1 if set, 0 if clear, -1 if the driver has no serial settings
+ */
+int getLowLatencySyscall(int fd)
+{
+  struct serial_struct serial;
+  if(ioctl(fd, TIOCGSERIAL, &serial) < 0) { return -1;}
+  return (serial.flags & ASYNC_LOW_LATENCY) != 0 ? 1 : 0;
+}
+
+/**
+ * @brief Path to the latency timer of a USB adapter
+ *
+ * @param device Path to the device, symbolic links are followed
+ * @param path Storage for the path
+ * @param size Size of the storage
+ * @return true if the device path resolved
+ */
+static bool getLatencyTimerPath(const char *device, char *path, size_t size)
+{
+  char device_path[PATH_MAX];
+
+  if(device == nullptr || realpath(device, device_path) == nullptr) { return false;}
+  snprintf(path, size, "/sys/class/tty/%s/device/latency_timer", basename(device_path));
+  return true;
+}
+
+/**
+ * @brief Set the latency timer of a USB adapter, the longest time it holds
+ *        received bytes before sending them to the host, 16 ms by default on
+ *        FTDI chips
+ *
+ * @note Writing the attribute usually needs root or a udev rule.
+ *
+ * @param device Path to the device, symbolic links are followed
+ * @param latency_ms Timer in milliseconds
+ * @return int 0 on success, -1 if the adapter has no timer or it can't be written
+ */
+int setLatencyTimerSysfs(const char *device, uint32_t latency_ms)
+{
+  char path[PATH_MAX + 64], value[16];
+  int fd, size, result;
+
+  if(!getLatencyTimerPath(device, path, sizeof(path))) { return -1;}
+  fd = open(path, O_WRONLY);
+  if(fd < 0) { return -1;}
+  size = snprintf(value, sizeof(value), "%u", latency_ms);
+  result = (write(fd, value, size) == size) ? 0 : -1;
+  (void) close(fd);
+  return result;
+}
+
+/**
+ * @brief Get the latency timer of a USB adapter
+ *
+ * @param device Path to the device, symbolic links are followed
+ * @return int Timer in milliseconds, -1 if the adapter has none
+ */
+int getLatencyTimerSysfs(const char *device)
+{
+  char path[PATH_MAX + 64], value[16];
+  int fd, size;
+
+  if(!getLatencyTimerPath(device, path, sizeof(path))) { return -1;}
+  fd = open(path, O_RDONLY);
+  if(fd < 0) { return -1;}
+  size = read(fd, value, sizeof(value) - 1);
+  (void) close(fd);
+  if(size <= 0) { return -1;}
+  value[size] = '\0';
+  return atoi(value);
+}
+
 /**
  * @brief Wait for the reception of a number of bytes until it timeout
  *
@@ -26,10 +26,28 @@ int readOnTimeoutSyscall2(int fd, uint8_t *buffer, size_t cnt, uint32_t timeout_
 
 int readOnTimeoutSyscall3(int fd, uint8_t *buffer, size_t cnt, uint32_t timeout_ms);
 
+int readOnGapSyscall(int fd, uint8_t *buffer, size_t cnt, uint32_t timeout_us, uint32_t gap_us);
+
 int writeSyscall(int fd, const uint8_t *buffer, size_t cnt);
 
 int bytesAvailableSyscall(int fd);
 
+int bytesPendingSyscall(int fd);
+
+int transmitterEmptySyscall(int fd);
+
+int setBaudRateSyscall(int fd, uint32_t baud_rate);
+
+int getBaudRateSyscall(int fd);
+
+int setLowLatencySyscall(int fd, bool enable);
+
+int getLowLatencySyscall(int fd);
+
+int setLatencyTimerSysfs(const char *device, uint32_t latency_ms);
+
+int getLatencyTimerSysfs(const char *device);
+
 int waitOnReceptionTimeoutSyscall(int fd, uint32_t size, uint32_t wait_time);
 
 Status_t checkInputs(const uint8_t *buffer, uint32_t size, uint32_t timeout, const void *handle, int fd);
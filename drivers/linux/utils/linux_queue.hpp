@@ -52,6 +52,25 @@ public:
     return false;
   }
 
+  // Enqueue data without waiting, the oldest element makes room when the queue
+  // is full, returns false if one was dropped
+  bool putOverwrite(const T &item)
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    bool is_dropped = false;
+
+    if(max_size == 0) return false;
+
+    if(queue.size() >= max_size)
+    {
+      queue.pop();
+      is_dropped = true;
+    }
+    queue.push(item);
+    not_empty.notify_one(); // Notify that the queue is not empty now
+    return !is_dropped;
+  }
+
   // Dequeue data, timeout in milliseconds
   bool get(T &item, uint32_t timeout = UINT32_MAX)
   {
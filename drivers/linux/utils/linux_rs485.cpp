@@ -0,0 +1,267 @@
+/**
+ * @file linux_rs485.cpp
+ * @author your name (you@domain.com)
+ * @brief Direction control of RS-485 transceivers on tty files
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "linux/utils/linux_rs485.hpp"
+
+#include <termios.h>
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+#include <time.h>
+#include <sys/ioctl.h>
+#include <linux/serial.h>
+#include <chrono>
+
+#include "linux/utils/linux_io.hpp"
+#include "linux/dio/dio.hpp"
+
+// Time allowed on top of the frame for the transmitter to empty, beyond it
+// the wait is left to tcdrain()
+constexpr uint64_t RS485_DRAIN_MARGIN_NS = 20000000;
+// Shortest sleep between two samples of the line status register
+constexpr uint64_t RS485_MIN_POLL_NS = 2000;
+
+/**
+ * @brief Constructor
+ */
+LinuxRs485::LinuxRs485()
+{
+  m_fd = -1;
+  m_mode = RS485_MODE_OFF;
+  m_settings = {true, RS485_NO_GPIO, 0, 0, 0};
+  m_dio = nullptr;
+}
+
+/**
+ * @brief Destructor
+ */
+LinuxRs485::~LinuxRs485()
+{
+  stop();
+}
+
+/**
+ * @brief Set up the direction control, by the serial driver when it can and
+ *        no GPIO line was given, from here otherwise
+ * @param fd File descriptor of an opened tty
+ * @param settings Settings of the line
+ * @return Status_t
+ */
+Status_t LinuxRs485::start(int fd, const Rs485Settings_t &settings)
+{
+  if(fd < 0) { return STATUS_DRV_BAD_HANDLE;}
+  stop();
+
+  m_fd = fd;
+  m_settings = settings;
+  if(m_settings.gpio != RS485_NO_GPIO) { return startGpio();}
+  if(startKernel())
+  {
+    m_mode = RS485_MODE_KERNEL;
+  }else
+  {
+    m_mode = RS485_MODE_RTS;
+    setEnable(false);
+  }
+  return STATUS_DRV_SUCCESS;
+}
+
+/**
+ * @brief Release the transceiver and give the line back to full duplex
+ */
+void LinuxRs485::stop()
+{
+  struct serial_rs485 rs485;
+
+  if(m_mode == RS485_MODE_KERNEL)
+  {
+    if(ioctl(m_fd, TIOCGRS485, &rs485) == 0)
+    {
+      rs485.flags &= ~SER_RS485_ENABLED;
+      (void) ioctl(m_fd, TIOCSRS485, &rs485);
+    }
+  }else if(isSwitchedHere())
+  {
+    setEnable(false);
+  }
+  if(m_dio != nullptr)
+  {
+    delete m_dio;
+    m_dio = nullptr;
+  }
+  m_mode = RS485_MODE_OFF;
+  m_fd = -1;
+}
+
+/**
+ * @brief Write a frame with the transceiver enabled, then release it
+ *
+ * @note Returns once the last stop bit left, and the end delay passed, when
+ *       the transceiver is switched from here. Otherwise like write().
+ * @param frame Data to send
+ * @param size Number of bytes
+ * @return int Number of bytes written, -1 on error with errno set
+ */
+int LinuxRs485::write(const uint8_t *frame, Size_t size)
+{
+  int bytes_written, error = 0;
+
+  if(!isSwitchedHere()) { return writeSyscall(m_fd, frame, size);}
+
+  setEnable(true);
+  if(m_settings.start_delay_us != 0) { sleepUntil(getTimeNs() + (uint64_t) m_settings.start_delay_us * 1000);}
+  bytes_written = writeSyscall(m_fd, frame, size);
+  if(bytes_written < 0 || (bytes_written > 0 && waitTransmitterEmpty(bytes_written) < 0))
+  {
+    error = errno;
+    bytes_written = -1;
+  }
+  if(m_settings.end_delay_us != 0) { sleepUntil(getTimeNs() + (uint64_t) m_settings.end_delay_us * 1000);}
+  setEnable(false);
+  if(error != 0) { errno = error;}
+
+  return bytes_written;
+}
+
+/**
+ * @brief Hand the direction control to the serial driver
+ *
+ * @note The driver counts its delays in milliseconds, the settings are
+ *       rounded up.
+ * @return true if the driver took it
+ */
+bool LinuxRs485::startKernel()
+{
+  struct serial_rs485 rs485;
+
+  memset(&rs485, 0, sizeof(rs485));
+  if(ioctl(m_fd, TIOCGRS485, &rs485) < 0) { return false;}
+  rs485.flags |= SER_RS485_ENABLED;
+  rs485.flags &= ~SER_RS485_RX_DURING_TX;
+  if(m_settings.active_high)
+  {
+    rs485.flags |= SER_RS485_RTS_ON_SEND;
+    rs485.flags &= ~SER_RS485_RTS_AFTER_SEND;
+  }else
+  {
+    rs485.flags &= ~SER_RS485_RTS_ON_SEND;
+    rs485.flags |= SER_RS485_RTS_AFTER_SEND;
+  }
+  rs485.delay_rts_before_send = (m_settings.start_delay_us + 999) / 1000;
+  rs485.delay_rts_after_send = (m_settings.end_delay_us + 999) / 1000;
+  if(ioctl(m_fd, TIOCSRS485, &rs485) < 0) { return false;}
+
+  // Drivers without RS-485 support may accept the call and clear the flag
+  if(ioctl(m_fd, TIOCGRS485, &rs485) < 0) { return false;}
+  return (rs485.flags & SER_RS485_ENABLED) != 0;
+}
+
+/**
+ * @brief Take the GPIO line of the transceiver enable
+ * @return Status_t
+ */
+Status_t LinuxRs485::startGpio()
+{
+  Status_t status;
+  const DriverSettings_t config_list[]
+  {
+    ADD_PARAMETER(DIO_LINE_DIRECTION, DIO_DIRECTION_OUTPUT),
+    ADD_PARAMETER(DIO_LINE_INITIAL_VALUE, m_settings.active_high ? DIO_STATE_LOW : DIO_STATE_HIGH)
+  };
+
+  m_dio = new DIO(m_settings.gpio & 0xFFFF, m_settings.gpio >> 16);
+  status = m_dio->configure(config_list, sizeof(config_list)/sizeof(config_list[0]));
+  if(!status.success)
+  {
+    delete m_dio;
+    m_dio = nullptr;
+    return status;
+  }
+  m_mode = RS485_MODE_GPIO;
+  return STATUS_DRV_SUCCESS;
+}
+
+/**
+ * @brief Switch the transceiver
+ * @param enable True to send, false to receive
+ */
+void LinuxRs485::setEnable(bool enable)
+{
+  int bits = TIOCM_RTS;
+  bool level = (enable == m_settings.active_high);
+
+  if(m_mode == RS485_MODE_GPIO)
+  {
+    (void) m_dio->write(level);
+  }else if(m_mode == RS485_MODE_RTS)
+  {
+    (void) ioctl(m_fd, level ? TIOCMBIS : TIOCMBIC, &bits);
+  }
+}
+
+/**
+ * @brief Wait for the last stop bit of a frame to leave the transmitter
+ *
+ * @note Sleeps for the time the bytes still queued in the kernel take, then
+ *       polls the line status register for the hardware FIFO and the shift
+ *       register, a fraction of a character at a time.
+ * @param size Number of bytes just written
+ * @return int 0 on success, -1 on error with errno set
+ */
+int LinuxRs485::waitTransmitterEmpty(Size_t size)
+{
+  uint64_t character_ns = m_settings.character_ns;
+  uint64_t poll_ns = character_ns / 2 > RS485_MIN_POLL_NS ? character_ns / 2 : RS485_MIN_POLL_NS;
+  uint64_t limit_ns = getTimeNs() + 2 * (size + 1) * character_ns + RS485_DRAIN_MARGIN_NS;
+  int pending, empty;
+
+  while(getTimeNs() < limit_ns)
+  {
+    pending = bytesPendingSyscall(m_fd);
+    if(pending < 0) { break;}
+    if(pending > 0)
+    {
+      sleepUntil(getTimeNs() + pending * character_ns);
+      continue;
+    }
+    empty = transmitterEmptySyscall(m_fd);
+    if(empty < 0) { break;}
+    if(empty == 1) { return 0;}
+    sleepUntil(getTimeNs() + poll_ns);
+  }
+
+  // No way to look at the transmitter or it is held, e.g. by flow control
+  return tcdrain(m_fd);
+}
+
+/**
+ * @brief Sleep until an absolute time of the monotonic clock
+ * @param deadline_ns Time to wake up at
+ */
+void LinuxRs485::sleepUntil(uint64_t deadline_ns)
+{
+  struct timespec deadline;
+
+  deadline.tv_sec = deadline_ns / 1000000000;
+  deadline.tv_nsec = deadline_ns % 1000000000;
+  // steady_clock is CLOCK_MONOTONIC
+  while(clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, nullptr) == EINTR) {}
+}
+
+/**
+ * @brief Get a monotonic time stamp
+ * @return uint64_t Time in nanoseconds
+ */
+uint64_t LinuxRs485::getTimeNs()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+}
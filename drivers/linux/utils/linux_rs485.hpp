@@ -0,0 +1,97 @@
+/**
+ * @file linux_rs485.hpp
+ * @author your name (you@domain.com)
+ * @brief Direction control of RS-485 transceivers on tty files
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef DRIVERS_LINUX_UTILS_LINUX_RS485_HPP
+#define DRIVERS_LINUX_UTILS_LINUX_RS485_HPP
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "com_types.hpp"
+#include "driver_base/driver_base_types.hpp"
+
+class DIO;
+
+constexpr uint32_t RS485_NO_GPIO = UINT32_MAX;
+
+/**
+ * @brief Who switches the transceiver between sending and receiving
+ */
+typedef enum
+{
+  RS485_MODE_OFF,       /*!< Full duplex line, nothing to switch */
+  RS485_MODE_KERNEL,    /*!< The serial driver, set up with TIOCSRS485 */
+  RS485_MODE_GPIO,      /*!< This class, through a GPIO line */
+  RS485_MODE_RTS,       /*!< This class, through the RTS modem line */
+}Rs485Mode_t;
+
+/**
+ * @brief Settings of a half-duplex line
+ */
+typedef struct
+{
+  bool active_high;         /*!< Level of the enable while sending */
+  uint32_t gpio;            /*!< gpiochip number << 16 | line offset, RS485_NO_GPIO to use RTS */
+  uint32_t start_delay_us;  /*!< From the enable to the first bit */
+  uint32_t end_delay_us;    /*!< From the last stop bit to the release */
+  uint32_t character_ns;    /*!< Time of one character on the line */
+}Rs485Settings_t;
+
+/**
+ * @brief Switches an RS-485 transceiver to send for the time of each write
+ *
+ * @note Serial drivers that support TIOCSRS485 toggle RTS themselves, from
+ *       the interrupt that sees the transmitter empty, no system call is
+ *       added. The others, e.g. most USB adapters, are switched from here:
+ *       the enable is set, the frame written, then the kernel queue is slept
+ *       on for the time its bytes take to go out and the line status register
+ *       polled until the last stop bit left. This releases the bus within
+ *       tens of microseconds where tcdrain() takes a few scheduler ticks.
+ *       Ports without TIOCSERGETLSR fall back on tcdrain(). A GPIO line is
+ *       always switched from here, the kernel only knows its own RTS.
+ */
+class LinuxRs485
+{
+public:
+  LinuxRs485();
+
+  ~LinuxRs485();
+
+  Status_t start(int fd, const Rs485Settings_t &settings);
+
+  void stop();
+
+  Rs485Mode_t getMode() { return m_mode;}
+
+  bool isSwitchedHere() { return m_mode == RS485_MODE_GPIO || m_mode == RS485_MODE_RTS;}
+
+  int write(const uint8_t *frame, Size_t size);
+
+private:
+  int m_fd;
+  Rs485Mode_t m_mode;
+  Rs485Settings_t m_settings;
+  DIO *m_dio;
+
+  bool startKernel();
+
+  Status_t startGpio();
+
+  void setEnable(bool enable);
+
+  int waitTransmitterEmpty(Size_t size);
+
+  static void sleepUntil(uint64_t deadline_ns);
+
+  static uint64_t getTimeNs();
+};
+
+#endif /* DRIVERS_LINUX_UTILS_LINUX_RS485_HPP */
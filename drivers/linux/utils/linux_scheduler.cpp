@@ -0,0 +1,424 @@
+/**
+ * @file linux_scheduler.cpp
+ * @author your name (you@domain.com)
+ * @brief Single-threaded coroutine scheduler built on epoll
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "linux/utils/linux_scheduler.hpp"
+
+#include <errno.h>
+#include <poll.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+
+#include "linux/utils/linux_io.hpp"
+
+/**
+ * @brief Constructor
+ */
+LinuxScheduler::LinuxScheduler()
+{
+  struct epoll_event event;
+
+  m_timer_deadline = 0;
+  m_tasks_alive = 0;
+  m_stop = false;
+
+  m_epoll_handle = epoll_create1(EPOLL_CLOEXEC);
+  m_event_handle = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+  m_timer_handle = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK);
+
+  // The two internal descriptors are told apart by their own address
+  event.events = EPOLLIN;
+  event.data.ptr = &m_event_handle;
+  (void) epoll_ctl(m_epoll_handle, EPOLL_CTL_ADD, m_event_handle, &event);
+  event.events = EPOLLIN;
+  event.data.ptr = &m_timer_handle;
+  (void) epoll_ctl(m_epoll_handle, EPOLL_CTL_ADD, m_timer_handle, &event);
+}
+
+/**
+ * @brief Destructor
+ *
+ * @note Coroutines still suspended are not destroyed, stop the scheduler only
+ *       once the tasks are done with the resources they use.
+ */
+LinuxScheduler::~LinuxScheduler()
+{
+  if(m_timer_handle >= 0) { close(m_timer_handle);}
+  if(m_event_handle >= 0) { close(m_event_handle);}
+  if(m_epoll_handle >= 0) { close(m_epoll_handle);}
+}
+
+/**
+ * @brief Get the scheduler running on the calling thread
+ * @return LinuxScheduler* nullptr if none
+ */
+LinuxScheduler *LinuxScheduler::current()
+{
+  return dynamic_cast<LinuxScheduler *>(SchedulerInterface::current());
+}
+
+/**
+ * @brief Hand a task to the scheduler, it starts on the next loop iteration
+ * @param task Task to run, freed once it ends
+ */
+void LinuxScheduler::spawn(CoroutineTask task)
+{
+  std::coroutine_handle<> handle = task.detach(this);
+
+  if(!handle) { return;}
+  m_tasks_alive++;
+  post(handle);
+}
+
+/**
+ * @brief Resume a coroutine on the scheduler's thread, callable from any thread
+ * @param handle Coroutine to resume
+ */
+void LinuxScheduler::post(std::coroutine_handle<> handle)
+{
+  if(SchedulerInterface::current() == this)
+  {
+    m_ready.push_back(handle);
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_posted_mutex);
+    m_posted.push_back(handle);
+  }
+  wake();
+}
+
+/**
+ * @brief Account for the end of a spawned task
+ */
+void LinuxScheduler::onTaskEnd()
+{
+  if(m_tasks_alive.fetch_sub(1) == 1) { wake();}
+}
+
+/**
+ * @brief Run coroutines on the calling thread until every spawned task has
+ *        ended or stop() is called
+ * @return Status_t
+ */
+Status_t LinuxScheduler::run()
+{
+  struct epoll_event events[LINUX_SCHEDULER_MAX_EVENTS];
+  std::deque<std::coroutine_handle<>> ready;
+  Status_t status = STATUS_DRV_SUCCESS;
+  LinuxWait_t *wait;
+  uint64_t counter;
+  int event_count;
+
+  if(m_epoll_handle < 0 || m_event_handle < 0 || m_timer_handle < 0) { return STATUS_DRV_BAD_HANDLE;}
+  if(SchedulerInterface::current() != nullptr) { return STATUS_DRV_ERR_BUSY;}
+
+  setCurrent(this);
+  m_stop = false;
+  while(!m_stop && m_tasks_alive > 0)
+  {
+    // Coroutines made ready while resuming run on the next iteration
+    ready.swap(m_ready);
+    while(!ready.empty())
+    {
+      ready.front().resume();
+      ready.pop_front();
+    }
+    if(m_stop || m_tasks_alive == 0) { break;}
+
+    armTimer();
+    event_count = epoll_wait(m_epoll_handle, events, LINUX_SCHEDULER_MAX_EVENTS, m_ready.empty() ? -1 : 0);
+    if(event_count < 0)
+    {
+      if(errno == EINTR) { continue;}
+      status = convertErrnoCode(errno);
+      break;
+    }
+
+    for(int i = 0; i < event_count; i++)
+    {
+      if(events[i].data.ptr == &m_event_handle)
+      {
+        (void) ::read(m_event_handle, &counter, sizeof(counter));
+        std::lock_guard<std::mutex> lock(m_posted_mutex);
+        m_ready.insert(m_ready.end(), m_posted.begin(), m_posted.end());
+        m_posted.clear();
+      }else if(events[i].data.ptr == &m_timer_handle)
+      {
+        (void) ::read(m_timer_handle, &counter, sizeof(counter));
+      }else
+      {
+        wait = static_cast<LinuxWait_t *>(events[i].data.ptr);
+        (void) epoll_ctl(m_epoll_handle, EPOLL_CTL_DEL, wait->fd, nullptr);
+        if(wait->has_timer)
+        {
+          m_timers.erase(wait->timer);
+          wait->has_timer = false;
+        }
+        wait->timed_out = false;
+        m_ready.push_back(wait->handle);
+      }
+    }
+    expireTimers();
+  }
+  setCurrent(nullptr);
+
+  return status;
+}
+
+/**
+ * @brief Make run() return after the coroutines being resumed suspend,
+ *        callable from any thread
+ */
+void LinuxScheduler::stop()
+{
+  m_stop = true;
+  wake();
+}
+
+/**
+ * @brief Get the number of spawned tasks not yet ended
+ * @return uint32_t
+ */
+uint32_t LinuxScheduler::getTasksAlive()
+{
+  return m_tasks_alive;
+}
+
+/**
+ * @brief Suspend a coroutine until a file descriptor is ready
+ * @param wait Wait record, must live until the coroutine is resumed
+ * @param events EPOLLIN, EPOLLOUT, EPOLLPRI or a combination
+ * @param timeout_ms Time to wait in milliseconds, UINT32_MAX waits forever
+ * @return Status_t
+ */
+Status_t LinuxScheduler::watch(LinuxWait_t *wait, uint32_t events, uint32_t timeout_ms)
+{
+  struct epoll_event event;
+
+  event.events = events | EPOLLONESHOT;
+  event.data.ptr = wait;
+  if(epoll_ctl(m_epoll_handle, EPOLL_CTL_ADD, wait->fd, &event) < 0)
+  {
+    return convertErrnoCode(errno);
+  }
+
+  wait->has_timer = false;
+  wait->timed_out = false;
+  if(timeout_ms != UINT32_MAX)
+  {
+    addTimer(wait, getTimeNs() + (uint64_t) timeout_ms * 1000000);
+  }
+  return STATUS_DRV_SUCCESS;
+}
+
+/**
+ * @brief Suspend a coroutine for a duration
+ * @param wait Wait record, must live until the coroutine is resumed
+ * @param duration_us Time to sleep in microseconds
+ */
+void LinuxScheduler::sleep(LinuxWait_t *wait, uint64_t duration_us)
+{
+  wait->fd = -1;
+  wait->timed_out = false;
+  addTimer(wait, getTimeNs() + duration_us * 1000);
+}
+
+/**
+ * @brief Get the value of the monotonic clock
+ * @return uint64_t Time in nanoseconds
+ */
+uint64_t LinuxScheduler::getTimeNs()
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t) ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+/**
+ * @brief Register a deadline for a wait record
+ * @param wait Wait record
+ * @param deadline_ns Monotonic time in nanoseconds
+ */
+void LinuxScheduler::addTimer(LinuxWait_t *wait, uint64_t deadline_ns)
+{
+  wait->timer = m_timers.emplace(deadline_ns, wait);
+  wait->has_timer = true;
+}
+
+/**
+ * @brief Program the timer file descriptor with the earliest deadline
+ */
+void LinuxScheduler::armTimer()
+{
+  struct itimerspec spec = {};
+  uint64_t deadline = m_timers.empty() ? 0 : m_timers.begin()->first;
+
+  if(deadline == m_timer_deadline) { return;}
+  m_timer_deadline = deadline;
+
+  // A zero value disarms the timer
+  spec.it_value.tv_sec = deadline / 1000000000;
+  spec.it_value.tv_nsec = deadline % 1000000000;
+  (void) timerfd_settime(m_timer_handle, TFD_TIMER_ABSTIME, &spec, nullptr);
+}
+
+/**
+ * @brief Resume every coroutine whose deadline has passed
+ */
+void LinuxScheduler::expireTimers()
+{
+  uint64_t now;
+  LinuxWait_t *wait;
+
+  if(m_timers.empty()) { return;}
+  now = getTimeNs();
+  while(!m_timers.empty() && m_timers.begin()->first <= now)
+  {
+    wait = m_timers.begin()->second;
+    m_timers.erase(m_timers.begin());
+    wait->has_timer = false;
+    if(wait->fd >= 0)
+    {
+      (void) epoll_ctl(m_epoll_handle, EPOLL_CTL_DEL, wait->fd, nullptr);
+      wait->timed_out = true;
+    }
+    m_ready.push_back(wait->handle);
+  }
+}
+
+/**
+ * @brief Interrupt epoll_wait
+ */
+void LinuxScheduler::wake()
+{
+  uint64_t counter = 1;
+  (void) ::write(m_event_handle, &counter, sizeof(counter));
+}
+
+/**
+ * @brief Constructor
+ * @param fd File descriptor to wait on
+ * @param events EPOLLIN, EPOLLOUT, EPOLLPRI or a combination
+ * @param timeout_ms Time to wait in milliseconds, UINT32_MAX waits forever
+ */
+LinuxFdAwaiter::LinuxFdAwaiter(int fd, uint32_t events, uint32_t timeout_ms)
+{
+  m_wait.fd = fd;
+  m_wait.has_timer = false;
+  m_wait.timed_out = false;
+  m_events = events;
+  m_timeout = timeout_ms;
+  m_status = STATUS_DRV_SUCCESS;
+}
+
+/**
+ * @brief Check if the coroutine can go on without suspending
+ * @return bool
+ */
+bool LinuxFdAwaiter::await_ready()
+{
+  if(m_wait.fd < 0)
+  {
+    m_status = STATUS_DRV_BAD_HANDLE;
+    return true;
+  }
+  return false;
+}
+
+/**
+ * @brief Register the coroutine with the scheduler, or block if there is none
+ * @param handle Coroutine to resume
+ * @return bool false if the coroutine must not suspend
+ */
+bool LinuxFdAwaiter::await_suspend(std::coroutine_handle<> handle)
+{
+  LinuxScheduler *scheduler = LinuxScheduler::current();
+  struct pollfd poll_fd = {m_wait.fd, (short) m_events, 0};
+  int ret;
+
+  if(scheduler != nullptr)
+  {
+    m_wait.handle = handle;
+    m_status = scheduler->watch(&m_wait, m_events, m_timeout);
+    return m_status.success;
+  }
+
+  ret = poll(&poll_fd, 1, m_timeout == UINT32_MAX ? -1 : (int) m_timeout);
+  if(ret < 0) { m_status = convertErrnoCode(errno);}
+  else if(ret == 0) { m_wait.timed_out = true;}
+  return false;
+}
+
+/**
+ * @brief Get the outcome of the wait
+ * @return Status_t STATUS_DRV_ERR_TIMEOUT if the deadline expired first
+ */
+Status_t LinuxFdAwaiter::await_resume()
+{
+  if(m_wait.timed_out) { return STATUS_DRV_ERR_TIMEOUT;}
+  return m_status;
+}
+
+/**
+ * @brief Constructor
+ * @param duration_us Time to sleep in microseconds
+ */
+LinuxSleepAwaiter::LinuxSleepAwaiter(uint64_t duration_us)
+{
+  m_wait.fd = -1;
+  m_wait.has_timer = false;
+  m_wait.timed_out = false;
+  m_duration_us = duration_us;
+}
+
+/**
+ * @brief Check if the coroutine can go on without suspending
+ * @return bool
+ */
+bool LinuxSleepAwaiter::await_ready()
+{
+  return m_duration_us == 0;
+}
+
+/**
+ * @brief Register the coroutine with the scheduler, or block if there is none
+ * @param handle Coroutine to resume
+ * @return bool false if the coroutine must not suspend
+ */
+bool LinuxSleepAwaiter::await_suspend(std::coroutine_handle<> handle)
+{
+  LinuxScheduler *scheduler = LinuxScheduler::current();
+  struct timespec ts;
+
+  if(scheduler != nullptr)
+  {
+    m_wait.handle = handle;
+    scheduler->sleep(&m_wait, m_duration_us);
+    return true;
+  }
+
+  ts.tv_sec = m_duration_us / 1000000;
+  ts.tv_nsec = (m_duration_us % 1000000) * 1000;
+  while(nanosleep(&ts, &ts) < 0 && errno == EINTR) {}
+  return false;
+}
+
+/**
+ * @brief Get the outcome of the sleep
+ * @return Status_t
+ */
+Status_t LinuxSleepAwaiter::await_resume()
+{
+  return STATUS_DRV_SUCCESS;
+}
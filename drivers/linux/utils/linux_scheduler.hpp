@@ -0,0 +1,153 @@
+/**
+ * @file linux_scheduler.hpp
+ * @author your name (you@domain.com)
+ * @brief Single-threaded coroutine scheduler built on epoll
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef DRIVERS_LINUX_UTILS_LINUX_SCHEDULER_HPP
+#define DRIVERS_LINUX_UTILS_LINUX_SCHEDULER_HPP
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <atomic>
+#include <coroutine>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <vector>
+#include <sys/epoll.h>
+
+#include "com_types.hpp"
+#include "task_interface/scheduler_interface.hpp"
+#include "task_interface/coroutine_task.hpp"
+#if __has_include("setup.hpp")
+#include "setup.hpp"
+#endif
+
+#ifndef LINUX_SCHEDULER_MAX_EVENTS
+#define LINUX_SCHEDULER_MAX_EVENTS                                            64
+#endif
+
+/**
+ * @brief A coroutine suspended on a file descriptor and/or a deadline
+ */
+typedef struct LinuxWait
+{
+  std::coroutine_handle<> handle;
+  std::multimap<uint64_t, struct LinuxWait *>::iterator timer;
+  int fd;                 /*!< -1 when only waiting on the deadline */
+  bool has_timer;
+  bool timed_out;
+}LinuxWait_t;
+
+/**
+ * @brief Runs coroutines on the calling thread, resuming them when their file
+ *        descriptors are ready, their deadlines expire or the driver requests
+ *        they await complete
+ *
+ * @code
+ * LinuxScheduler scheduler;
+ * scheduler.spawn(blink(led, timer));
+ * scheduler.spawn(poll_sensor(spi));
+ * scheduler.run();
+ * @endcode
+ */
+class LinuxScheduler final : public SchedulerInterface
+{
+public:
+  LinuxScheduler();
+
+  ~LinuxScheduler();
+
+  static LinuxScheduler *current();
+
+  void spawn(CoroutineTask task);
+
+  void post(std::coroutine_handle<> handle);
+
+  void onTaskEnd();
+
+  Status_t run();
+
+  void stop();
+
+  uint32_t getTasksAlive();
+
+  // Used by awaitables
+  Status_t watch(LinuxWait_t *wait, uint32_t events, uint32_t timeout_ms);
+
+  void sleep(LinuxWait_t *wait, uint64_t duration_us);
+
+  static uint64_t getTimeNs();
+
+private:
+  int m_epoll_handle;
+  int m_event_handle;
+  int m_timer_handle;
+  uint64_t m_timer_deadline;
+  std::atomic<uint32_t> m_tasks_alive;
+  std::atomic<bool> m_stop;
+  std::deque<std::coroutine_handle<>> m_ready;
+  std::vector<std::coroutine_handle<>> m_posted;
+  std::mutex m_posted_mutex;
+  std::multimap<uint64_t, LinuxWait_t *> m_timers;
+
+  void addTimer(LinuxWait_t *wait, uint64_t deadline_ns);
+
+  void armTimer();
+
+  void expireTimers();
+
+  void wake();
+};
+
+/**
+ * @brief Awaitable that resumes once a file descriptor is ready
+ *
+ * @note Without a scheduler on the calling thread it blocks on poll().
+ */
+class LinuxFdAwaiter
+{
+public:
+  LinuxFdAwaiter(int fd, uint32_t events, uint32_t timeout_ms = UINT32_MAX);
+
+  bool await_ready();
+
+  bool await_suspend(std::coroutine_handle<> handle);
+
+  Status_t await_resume();
+
+private:
+  LinuxWait_t m_wait;
+  uint32_t m_events;
+  uint32_t m_timeout;
+  Status_t m_status;
+};
+
+/**
+ * @brief Awaitable that resumes once a duration has elapsed
+ *
+ * @note Without a scheduler on the calling thread it blocks on nanosleep().
+ */
+class LinuxSleepAwaiter
+{
+public:
+  LinuxSleepAwaiter(uint64_t duration_us);
+
+  bool await_ready();
+
+  bool await_suspend(std::coroutine_handle<> handle);
+
+  Status_t await_resume();
+
+private:
+  LinuxWait_t m_wait;
+  uint64_t m_duration_us;
+};
+
+#endif /* DRIVERS_LINUX_UTILS_LINUX_SCHEDULER_HPP */
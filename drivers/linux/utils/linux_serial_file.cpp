@@ -15,6 +15,9 @@
 #include <unistd.h>
 #include <fcntl.h>
 #include <sys/ioctl.h>
+#include <poll.h>
+#include <string.h>
+#include <chrono>
 
 #include "linux/utils/linux_io.hpp"
 
@@ -29,6 +32,13 @@ m_tx_thread_handle(LinuxSerialFile::writeFromThreadBlocking, this)
   m_handle = port_handle;
   m_linux_handle = -1;
   m_is_async_mode = false;
+  m_is_pipelined_mode = false;
+  m_line_start = 0;
+  m_line_end = 0;
+  m_line_scanned = 0;
+  m_line_delimiter = '\n';
+  m_rx_thread_handle.setName("serial_rx");
+  m_tx_thread_handle.setName("serial_tx");
 }
 
 /**
@@ -36,6 +46,10 @@ m_tx_thread_handle(LinuxSerialFile::writeFromThreadBlocking, this)
  */
 LinuxSerialFile::~LinuxSerialFile()
 {
+  // Workers report to the result queues, stop them before anything else
+  (void) m_rx_thread_handle.terminate();
+  (void) m_tx_thread_handle.terminate();
+  m_tx_pipeline.stop();
   if(m_linux_handle >= 0)
   {
     (void) close(m_linux_handle);
@@ -50,12 +64,14 @@ LinuxSerialFile::~LinuxSerialFile()
  */
 Status_t LinuxSerialFile::configure(const DriverSettings_t *list, uint8_t list_size)
 {
+  DRIVER_TRACE_SCOPE("serial", "configure");
   Status_t status;
   struct termios termios_structure;
+  LinuxThreadAttributes_t thread_attributes = LinuxThreadAttributes::getDefaults();
 
   if(m_handle == nullptr) { return STATUS_DRV_NULL_POINTER;}
-  m_read_status = STATUS_DRV_NOT_CONFIGURED;
-  m_write_status = STATUS_DRV_NOT_CONFIGURED;
+  setReadStatus(STATUS_DRV_NOT_CONFIGURED);
+  setWriteStatus(STATUS_DRV_NOT_CONFIGURED);
 
   if(list != nullptr && list_size != 0)
   {
@@ -66,12 +82,23 @@ Status_t LinuxSerialFile::configure(const DriverSettings_t *list, uint8_t list_s
         case COMM_WORK_ASYNC:
           m_is_async_mode = (bool) list[i].value;
           break;
+        case COMM_WORK_PIPELINED:
+          m_is_pipelined_mode = (bool) list[i].value;
+          break;
+        case THREAD_PARAM_POLICY:
+        case THREAD_PARAM_PRIORITY:
+        case THREAD_PARAM_AFFINITY:
+          (void) LinuxThreadAttributes::parse(list[i], thread_attributes);
+          break;
         default:
           break;
       }
     }
   }
 
+  status = LinuxThreadAttributes::check(thread_attributes);
+  if(!status.success) { return status;}
+
   m_linux_handle = open((char *)m_handle, O_RDWR | O_NOCTTY);
   if (m_linux_handle < 0)
   {
@@ -88,9 +115,27 @@ Status_t LinuxSerialFile::configure(const DriverSettings_t *list, uint8_t list_s
   tcflush(m_linux_handle, TCIFLUSH);
   tcflush(m_linux_handle, TCIFLUSH);
   tcsetattr(m_linux_handle, TCSANOW, &termios_structure);
+  m_line_start = 0;
+  m_line_end = 0;
+  m_line_scanned = 0;
+
+  if(m_is_pipelined_mode)
+  {
+    m_tx_pipeline.setAttributes(thread_attributes);
+    if(!m_tx_pipeline.start(m_linux_handle, 0))
+    {
+      SET_STATUS(status, false, SRC_DRIVER, ERR_FAILED, (char *)"Failed to launch the LinuxSerialFile transmission tracker.\r\n");
+      return status;
+    }
+  }else
+  {
+    m_tx_pipeline.stop();
+  }
 
   if(m_is_async_mode)
   {
+    m_rx_thread_handle.setAttributes(thread_attributes);
+    m_tx_thread_handle.setAttributes(thread_attributes);
     if(!m_rx_thread_handle.create() || !m_tx_thread_handle.create())
     {
       SET_STATUS(status, false, SRC_DRIVER, ERR_FAILED, (char *)"Failed to launch one or more LinuxSerialFile tasks.\r\n");
@@ -102,8 +147,8 @@ Status_t LinuxSerialFile::configure(const DriverSettings_t *list, uint8_t list_s
     (void) m_tx_thread_handle.terminate();
   }
 
-  m_read_status = STATUS_DRV_IDLE;
-  m_write_status = STATUS_DRV_IDLE;
+  setReadStatus(STATUS_DRV_IDLE);
+  setWriteStatus(STATUS_DRV_IDLE);
   return STATUS_DRV_SUCCESS;
 }
 
@@ -116,40 +161,215 @@ Status_t LinuxSerialFile::configure(const DriverSettings_t *list, uint8_t list_s
  */
 Status_t LinuxSerialFile::read(uint8_t *data, Size_t byte_count, uint32_t timeout)
 {
+  DRIVER_TRACE_SCOPE("serial", "read");
   Status_t status;
-  int bytes_read = 0;
-  DataBundle_t data_bundle;
+  uint64_t start;
+
+  if(m_is_async_mode) { return queueRead(data, byte_count, timeout, nullptr, nullptr);}
 
   status = checkInputs(data, byte_count, timeout, m_handle, m_linux_handle);
   if(!status.success) { return status;}
-  if(m_read_status.code == OPERATION_RUNNING) { return STATUS_DRV_ERR_BUSY;}
 
-  m_read_status = STATUS_DRV_RUNNING;
-  m_read_status.success = false;
+  if(!beginRead()) { m_stats.countBusy(); return STATUS_DRV_ERR_BUSY;}
   m_bytes_read = 0;
+  start = DriverStats::getTimeNs();
+  if(m_line_end > m_line_start)
+  {
+    // Bytes a line read left behind come first
+    m_bytes_read = (m_line_end - m_line_start) < byte_count ? (m_line_end - m_line_start) : byte_count;
+    memcpy(data, m_line_buffer.data() + m_line_start, m_bytes_read);
+    m_line_start += m_bytes_read;
+    m_line_scanned = 0;
+    status = STATUS_DRV_SUCCESS;
+  }else
+  {
+    status = readBlocking(data, byte_count, timeout);
+  }
+  m_stats.recordSince(DRIVER_LATENCY_SYSCALL, start);
+  m_stats.countRead(status, m_bytes_read);
+  DRIVER_RECORD(m_record_id, DRIVER_RECORD_READ, data, m_bytes_read);
+  setReadStatus(status);
+  return status;
+}
 
-  if(m_is_async_mode)
+/**
+ * @brief Read up to a delimiter
+ *
+ * @note Only in blocking mode. A timeout leaves the bytes of an unfinished
+ *       line buffered for the next call. At the end of a file its last bytes
+ *       are returned as a line even without a delimiter.
+ * @param delimiter Byte that ends a line, left out of it
+ * @param line Storage for a view of the line in the internal buffer, valid
+ *        until the next read, empty on failure or timeout
+ * @param timeout Time to wait for a complete line in milliseconds
+ * @return Status_t STATUS_DRV_TIMED_OUT if no line completed in time, an
+ *         ERR_PARAM_SIZE error with the buffer as the line if it filled up
+ *         without a delimiter
+ */
+Status_t LinuxSerialFile::readUntil(uint8_t delimiter, Buffer_t &line, uint32_t timeout)
+{
+  DRIVER_TRACE_SCOPE("serial", "readUntil");
+  Status_t status;
+  uint8_t *found;
+  uint64_t start, deadline_ns;
+
+  line = Buffer_t();
+  if(m_is_async_mode) { return STATUS_DRV_ERR_BUSY;}
+  if(m_handle == nullptr || m_linux_handle < 0) { return STATUS_DRV_BAD_HANDLE;}
+  if(!beginRead()) { m_stats.countBusy(); return STATUS_DRV_ERR_BUSY;}
+  if(m_line_buffer.empty()) { m_line_buffer.resize(SERIAL_FILE_LINE_BUFFER_SIZE);}
+  if(delimiter != m_line_delimiter)
+  {
+    m_line_delimiter = delimiter;
+    m_line_scanned = 0;
+  }
+
+  start = DriverStats::getTimeNs();
+  deadline_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+  deadline_ns = (timeout == UINT32_MAX) ? UINT64_MAX : deadline_ns + (uint64_t) timeout * 1000000;
+  while(true)
   {
-    data_bundle.buffer = data;
-    data_bundle.size = byte_count;
-    data_bundle.timeout = timeout;
-    if(m_rx_thread_handle.setInputData(&data_bundle, 0))
+    // Only the bytes of the last burst are searched
+    found = (uint8_t *) memchr(m_line_buffer.data() + m_line_start + m_line_scanned, delimiter, m_line_end - m_line_start - m_line_scanned);
+    if(found != nullptr)
     {
+      line = Buffer_t(m_line_buffer.data() + m_line_start, found - (m_line_buffer.data() + m_line_start));
+      m_line_start += line.size() + 1;
+      m_line_scanned = 0;
       status = STATUS_DRV_SUCCESS;
-    }else
+      break;
+    }
+    m_line_scanned = m_line_end - m_line_start;
+
+    status = fillLineBuffer(deadline_ns);
+    if(status.code == ERR_PARAM_SIZE || (status.code == ERR_FAILED && m_line_end > m_line_start))
     {
-      m_read_status = STATUS_DRV_IDLE;
-      status = STATUS_DRV_ERR_BUSY;
+      // Buffer full or end of the file, hand over what is there
+      line = Buffer_t(m_line_buffer.data() + m_line_start, m_line_end - m_line_start);
+      m_line_start = m_line_end;
+      m_line_scanned = 0;
+      if(status.code == ERR_FAILED) { status = STATUS_DRV_SUCCESS;}
+      break;
     }
-  }else
-  {
-    status = readBlocking(data, byte_count, timeout, false);
-    m_read_status = status;
+    if(!status.success || status.code == OPERATION_TIMED_OUT) { break;}
   }
 
+  m_bytes_read = line.size();
+  m_stats.recordSince(DRIVER_LATENCY_SYSCALL, start);
+  m_stats.countRead(status, m_bytes_read);
+  setReadStatus(status);
   return status;
 }
 
+/**
+ * @brief Read a line ended by a line feed, the line feed and a carriage
+ *        return before it are left out
+ * @param line Storage for a view of the line in the internal buffer, valid
+ *        until the next read
+ * @param timeout Time to wait for a complete line in milliseconds
+ * @return Status_t
+ */
+Status_t LinuxSerialFile::readLine(Buffer_t &line, uint32_t timeout)
+{
+  Status_t status = readUntil('\n', line, timeout);
+
+  if(!line.empty() && line.back() == '\r') { line = line.first(line.size() - 1);}
+  return status;
+}
+
+/**
+ * @brief Read the next burst into the line buffer
+ * @param deadline_ns Steady clock time to give up at, UINT64_MAX to wait forever
+ * @return Status_t STATUS_DRV_TIMED_OUT if nothing came, an ERR_FAILED error
+ *         at the end of the file
+ */
+Status_t LinuxSerialFile::fillLineBuffer(uint64_t deadline_ns)
+{
+  Status_t status;
+  struct pollfd fds[1];
+  uint64_t now_ns;
+  int timeout_ms, ready, bytes_read;
+
+  if(m_line_start == m_line_end)
+  {
+    m_line_start = 0;
+    m_line_end = 0;
+  }else if(m_line_end == (Size_t) m_line_buffer.size())
+  {
+    if(m_line_start == 0)
+    {
+      SET_STATUS(status, false, SRC_DRIVER, ERR_PARAM_SIZE, (char *)"Line longer than the buffer.\r\n");
+      return status;
+    }
+    memmove(m_line_buffer.data(), m_line_buffer.data() + m_line_start, m_line_end - m_line_start);
+    m_line_end -= m_line_start;
+    m_line_start = 0;
+  }
+
+  timeout_ms = -1;
+  if(deadline_ns != UINT64_MAX)
+  {
+    now_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+    timeout_ms = now_ns >= deadline_ns ? 0 : (int) ((deadline_ns - now_ns + 999999) / 1000000);
+  }
+  fds[0].fd = m_linux_handle;
+  fds[0].events = POLLIN;
+  do
+  {
+    ready = poll(fds, 1, timeout_ms);
+  } while(ready < 0 && errno == EINTR);
+  if(ready < 0) { return convertErrnoCode(errno);}
+  if(ready == 0) { return STATUS_DRV_TIMED_OUT;}
+
+  bytes_read = readSyscall(m_linux_handle, m_line_buffer.data() + m_line_end, m_line_buffer.size() - m_line_end);
+  if(bytes_read < 0) { return convertErrnoCode(errno);}
+  if(bytes_read == 0)
+  {
+    // Readable without data, the writer is gone
+    SET_STATUS(status, false, SRC_DRIVER, ERR_FAILED, (char *)"End of file.\r\n");
+    return status;
+  }
+  DRIVER_RECORD(m_record_id, DRIVER_RECORD_READ, m_line_buffer.data() + m_line_end, bytes_read);
+  m_line_end += bytes_read;
+  return STATUS_DRV_SUCCESS;
+}
+
+/**
+ * @brief Queue a read request for the reception thread
+ * @param data Buffer to store the data
+ * @param byte_count Number of bytes to read
+ * @param timeout Time to wait in milliseconds before returning an error
+ * @param completion Token slot completed with the request, may be nullptr
+ * @param pool_buffer Pooled buffer released with the request, may be nullptr
+ * @return Status_t
+ */
+Status_t LinuxSerialFile::queueRead(uint8_t *data, Size_t byte_count, uint32_t timeout, void *completion, void *pool_buffer)
+{
+  Status_t status;
+  DataBundle_t data_bundle = {};
+
+  status = checkInputs(data, byte_count, timeout, m_handle, m_linux_handle);
+  if(!status.success) { return status;}
+
+  data_bundle.buffer = data;
+  data_bundle.size = byte_count;
+  data_bundle.timeout = timeout;
+  data_bundle.completion = completion;
+  data_bundle.pool_buffer = pool_buffer;
+  data_bundle.timestamp = DriverStats::getTimeNs();
+  data_bundle.id = submitRead();
+  if(m_rx_thread_handle.setInputData(&data_bundle, 0))
+  {
+    return STATUS_DRV_SUCCESS;
+  }else
+  {
+    cancelRead();
+    return STATUS_DRV_ERR_BUSY;
+  }
+}
+
 /**
  * @brief Write data to a linux file
  * @param data Buffer where data is stored
@@ -159,38 +379,93 @@ Status_t LinuxSerialFile::read(uint8_t *data, Size_t byte_count, uint32_t timeou
  */
 Status_t LinuxSerialFile::write(uint8_t *data, Size_t byte_count, uint32_t timeout)
 {
+  DRIVER_TRACE_SCOPE("serial", "write");
   Status_t status;
-  int bytes_written, drain_status;
-  DataBundle_t data_bundle;
+  uint64_t start;
+
+  if(m_is_async_mode) { return queueWrite(data, byte_count, timeout, nullptr, nullptr);}
 
   status = checkInputs(data, byte_count, timeout, m_handle, m_linux_handle);
   if(!status.success) { return status;}
-  if(m_write_status.code == OPERATION_RUNNING) { return STATUS_DRV_ERR_BUSY;}
 
-  m_write_status = STATUS_DRV_RUNNING;
-  m_write_status.success = false;
+  if(!beginWrite()) { m_stats.countBusy(); return STATUS_DRV_ERR_BUSY;}
   m_bytes_written = 0;
+  start = DriverStats::getTimeNs();
+  status = writeBlocking(data, byte_count, timeout);
+  m_stats.recordSince(DRIVER_LATENCY_SYSCALL, start);
+  m_stats.countWrite(status, m_bytes_written);
+  DRIVER_RECORD(m_record_id, DRIVER_RECORD_WRITE, data, m_bytes_written);
+  setWriteStatus(status);
+  return status;
+}
 
-  if(m_is_async_mode)
+/**
+ * @brief Queue a write request for the transmission thread
+ * @param data Buffer where data is stored
+ * @param byte_count Number of bytes to write
+ * @param timeout Time to wait in milliseconds before returning an error
+ * @param completion Token slot completed with the request, may be nullptr
+ * @param pool_buffer Pooled buffer released with the request, may be nullptr
+ * @return Status_t
+ */
+Status_t LinuxSerialFile::queueWrite(uint8_t *data, Size_t byte_count, uint32_t timeout, void *completion, void *pool_buffer)
+{
+  Status_t status;
+  DataBundle_t data_bundle = {};
+
+  status = checkInputs(data, byte_count, timeout, m_handle, m_linux_handle);
+  if(!status.success) { return status;}
+
+  data_bundle.buffer = data;
+  data_bundle.size = byte_count;
+  data_bundle.timeout = timeout;
+  data_bundle.completion = completion;
+  data_bundle.pool_buffer = pool_buffer;
+  data_bundle.timestamp = DriverStats::getTimeNs();
+  data_bundle.id = submitWrite();
+  if(m_tx_thread_handle.setInputData(&data_bundle, 0))
   {
-    data_bundle.buffer = data;
-    data_bundle.size = byte_count;
-    data_bundle.timeout = timeout;
-    if(m_tx_thread_handle.setInputData(&data_bundle, 0))
-    {
-      status = STATUS_DRV_SUCCESS;
-    }else
-    {
-      m_write_status = STATUS_DRV_IDLE;
-      status = STATUS_DRV_ERR_BUSY;
-    }
+    return STATUS_DRV_SUCCESS;
   }else
   {
-    status = writeBlocking(data, byte_count, timeout, false);
-    m_write_status = status;
+    cancelWrite();
+    return STATUS_DRV_ERR_BUSY;
   }
+}
 
-  return status;
+/**
+ * @brief Block until every byte written has left the file
+ * @return Status_t
+ */
+Status_t LinuxSerialFile::flush()
+{
+  DRIVER_TRACE_SCOPE("serial", "flush");
+  if(m_handle == nullptr || m_linux_handle < 0) { return STATUS_DRV_BAD_HANDLE;}
+  if(m_is_pipelined_mode)
+  {
+    return m_tx_pipeline.flush();
+  }
+  if(tcdrain(m_linux_handle) < 0)
+  {
+    return convertErrnoCode(errno);
+  }
+  return STATUS_DRV_SUCCESS;
+}
+
+/**
+ * @brief Get the number of bytes written but not yet sent
+ * @return Size_t
+ */
+Size_t LinuxSerialFile::getBytesPending()
+{
+  int byte_count;
+  if(m_is_pipelined_mode)
+  {
+    return m_tx_pipeline.getBytesPending();
+  }
+  if(m_linux_handle < 0) { return 0;}
+  byte_count = bytesPendingSyscall(m_linux_handle);
+  return byte_count > 0 ? byte_count : 0;
 }
 
 /**
@@ -207,7 +482,7 @@ Status_t LinuxSerialFile::setCallback(DriverEventsList_t event, DriverCallback_t
   switch (event)
   {
   case EVENT_READ:
-    if(m_read_status.code != OPERATION_RUNNING)
+    if(getReadStatus().code != OPERATION_RUNNING)
     {
       m_func_rx = function;
       m_arg_rx = user_arg;
@@ -217,7 +492,7 @@ Status_t LinuxSerialFile::setCallback(DriverEventsList_t event, DriverCallback_t
     }
     break;
   case EVENT_WRITE:
-    if (m_write_status.code != OPERATION_RUNNING)
+    if (getWriteStatus().code != OPERATION_RUNNING)
     {
       m_func_tx = function;
       m_arg_tx = user_arg;
@@ -234,18 +509,43 @@ Status_t LinuxSerialFile::setCallback(DriverEventsList_t event, DriverCallback_t
   return status;
 }
 
+/**
+ * @brief Get the outcome of the oldest read request not yet collected
+ * @param request Storage for the outcome of the request
+ * @param timeout Time to wait in milliseconds before returning an error
+ * @return Status_t
+ */
+Status_t LinuxSerialFile::getReadResult(DriverRequest_t &request, uint32_t timeout)
+{
+  if(m_rx_results.get(request, timeout)) { return STATUS_DRV_SUCCESS;}
+  return STATUS_DRV_ERR_TIMEOUT;
+}
+
+/**
+ * @brief Get the outcome of the oldest write request not yet collected
+ * @param request Storage for the outcome of the request
+ * @param timeout Time to wait in milliseconds before returning an error
+ * @return Status_t
+ */
+Status_t LinuxSerialFile::getWriteResult(DriverRequest_t &request, uint32_t timeout)
+{
+  if(m_tx_results.get(request, timeout)) { return STATUS_DRV_SUCCESS;}
+  return STATUS_DRV_ERR_TIMEOUT;
+}
+
 /**
  * @brief Read data synchronously
  * @param data Buffer to store the data
  * @param byte_count Number of bytes to read
  * @param timeout Time to wait in milliseconds before returning an error
- * @param call_back True if should call the callback function
  * @return Status_t
  */
-Status_t LinuxSerialFile::readBlocking(uint8_t *data, Size_t byte_count, uint32_t timeout, bool call_back)
+Status_t LinuxSerialFile::readBlocking(uint8_t *data, Size_t byte_count, uint32_t timeout)
 {
   Status_t status = STATUS_DRV_SUCCESS;
   int bytes_read = 0;
+
+  m_bytes_read = 0;
   if (timeout == 0)
   {
     bytes_read = readSyscall(m_linux_handle, data, byte_count);
@@ -266,14 +566,6 @@ Status_t LinuxSerialFile::readBlocking(uint8_t *data, Size_t byte_count, uint32_
     m_bytes_read = bytes_read;
   }
 
-  m_read_status = status;
-
-  if(call_back && m_func_rx != nullptr)
-  {
-    Buffer_t data_container(data, m_bytes_read);
-    m_func_rx(status, EVENT_READ, data_container, m_arg_rx);
-  }
-
   return status;
 }
 
@@ -285,10 +577,18 @@ Status_t LinuxSerialFile::readBlocking(uint8_t *data, Size_t byte_count, uint32_
  */
 Status_t LinuxSerialFile::readFromThreadBlocking(DataBundle_t data_bundle, void *self_ptr)
 {
+  DRIVER_TRACE_SCOPE("serial", "read");
+  Status_t status;
+  uint64_t start;
   LinuxSerialFile *obj = static_cast<LinuxSerialFile *>(self_ptr);
   if(obj != nullptr)
   {
-    return obj->readBlocking(data_bundle.buffer, data_bundle.size, data_bundle.timeout, true);
+    obj->m_stats.recordSince(DRIVER_LATENCY_QUEUE_WAIT, data_bundle.timestamp);
+    start = DriverStats::getTimeNs();
+    status = obj->readBlocking(data_bundle.buffer, data_bundle.size, data_bundle.timeout);
+    obj->m_stats.recordSince(DRIVER_LATENCY_SYSCALL, start);
+    obj->finishRead(data_bundle, status, obj->m_bytes_read);
+    return status;
   }
   return STATUS_DRV_NULL_POINTER;
 }
@@ -298,15 +598,21 @@ Status_t LinuxSerialFile::readFromThreadBlocking(DataBundle_t data_bundle, void
  * @param data Buffer where data is stored
  * @param byte_count Number of bytes to write
  * @param timeout Time to wait in milliseconds before returning an error
- * @param call_back True if should call the callback function
  * @return Status_t
  */
-Status_t LinuxSerialFile::writeBlocking(uint8_t *data, Size_t byte_count, uint32_t timeout, bool call_back)
+Status_t LinuxSerialFile::writeBlocking(uint8_t *data, Size_t byte_count, uint32_t timeout)
 {
   Status_t status = STATUS_DRV_SUCCESS;
   int bytes_written, drain_status;
+
+  if(m_is_pipelined_mode)
+  {
+    // The callback runs once the frame has left the file, not here
+    return m_tx_pipeline.write(data, byte_count, m_bytes_written, m_func_tx, m_arg_tx);
+  }
+
   bytes_written = writeSyscall(m_linux_handle, data, byte_count);
-  if (byte_count >= 0)
+  if (bytes_written >= 0)
   {
     drain_status = tcdrain(m_linux_handle);
     if (drain_status < 0)
@@ -323,14 +629,6 @@ Status_t LinuxSerialFile::writeBlocking(uint8_t *data, Size_t byte_count, uint32
     status = convertErrnoCode(errno);
   }
 
-  m_write_status = status;
-
-  if(call_back && m_func_tx != nullptr)
-  {
-    Buffer_t data_container(data, m_bytes_read);
-    m_func_tx(status, EVENT_WRITE, data_container, m_arg_tx);
-  }
-
   return status;
 }
 
@@ -342,10 +640,91 @@ Status_t LinuxSerialFile::writeBlocking(uint8_t *data, Size_t byte_count, uint32
  */
 Status_t LinuxSerialFile::writeFromThreadBlocking(DataBundle_t data_bundle, void *self_ptr)
 {
+  DRIVER_TRACE_SCOPE("serial", "write");
+  Status_t status;
+  uint64_t start;
   LinuxSerialFile *obj = static_cast<LinuxSerialFile *>(self_ptr);
-  if(obj != nullptr)
+  if(obj == nullptr)
   {
-    return obj->writeBlocking(data_bundle.buffer, data_bundle.size, data_bundle.timeout, true);
+    return STATUS_DRV_NULL_POINTER;
   }
-  return STATUS_DRV_NULL_POINTER;
+
+  obj->m_stats.recordSince(DRIVER_LATENCY_QUEUE_WAIT, data_bundle.timestamp);
+  start = DriverStats::getTimeNs();
+  if(obj->m_is_pipelined_mode)
+  {
+    // The request only ends once the frame has left the file
+    status = obj->m_tx_pipeline.write(data_bundle.buffer, data_bundle.size, obj->m_bytes_written,
+      [obj, data_bundle](Status_t status, DriverEventsList_t, const Buffer_t data, void *)
+      {
+        obj->finishWrite(data_bundle, status, data.size());
+        return status;
+      }, nullptr);
+    obj->m_stats.recordSince(DRIVER_LATENCY_SYSCALL, start);
+    if(!status.success)
+    {
+      obj->finishWrite(data_bundle, status, 0);
+    }
+    return status;
+  }
+
+  status = obj->writeBlocking(data_bundle.buffer, data_bundle.size, data_bundle.timeout);
+  obj->m_stats.recordSince(DRIVER_LATENCY_SYSCALL, start);
+  obj->finishWrite(data_bundle, status, obj->m_bytes_written);
+  return status;
+}
+
+/**
+ * @brief Report the end of a queued read request
+ * @param data_bundle The request
+ * @param status Status of the request
+ * @param byte_count Number of bytes read
+ */
+void LinuxSerialFile::finishRead(const DataBundle_t &data_bundle, Status_t status, Size_t byte_count)
+{
+  uint64_t start;
+  DriverRequest_t request = {data_bundle.id, status, byte_count, EVENT_READ};
+
+  completeRead(status);
+  m_stats.countRead(status, byte_count);
+  DRIVER_RECORD(m_record_id, DRIVER_RECORD_READ, data_bundle.buffer, byte_count);
+  if(m_func_rx != nullptr)
+  {
+    DRIVER_TRACE_SCOPE("serial", "callback");
+    start = DriverStats::getTimeNs();
+    Buffer_t data_container(data_bundle.buffer, byte_count);
+    m_func_rx(status, EVENT_READ, data_container, m_arg_rx);
+    m_stats.recordSince(DRIVER_LATENCY_CALLBACK, start);
+  }
+  // Results nobody collects are dropped oldest first once the queue is full
+  (void) m_rx_results.putOverwrite(request);
+  DriverToken::complete(data_bundle.completion, request);
+  PoolBuffer::release(data_bundle.pool_buffer);
+}
+
+/**
+ * @brief Report the end of a queued write request
+ * @param data_bundle The request
+ * @param status Status of the request
+ * @param byte_count Number of bytes written
+ */
+void LinuxSerialFile::finishWrite(const DataBundle_t &data_bundle, Status_t status, Size_t byte_count)
+{
+  uint64_t start;
+  DriverRequest_t request = {data_bundle.id, status, byte_count, EVENT_WRITE};
+
+  completeWrite(status);
+  m_stats.countWrite(status, byte_count);
+  DRIVER_RECORD(m_record_id, DRIVER_RECORD_WRITE, data_bundle.buffer, byte_count);
+  if(m_func_tx != nullptr)
+  {
+    DRIVER_TRACE_SCOPE("serial", "callback");
+    start = DriverStats::getTimeNs();
+    Buffer_t data_container(data_bundle.buffer, byte_count);
+    m_func_tx(status, EVENT_WRITE, data_container, m_arg_tx);
+    m_stats.recordSince(DRIVER_LATENCY_CALLBACK, start);
+  }
+  (void) m_tx_results.putOverwrite(request);
+  DriverToken::complete(data_bundle.completion, request);
+  PoolBuffer::release(data_bundle.pool_buffer);
 }
@@ -14,11 +14,38 @@
 
 #include <stdio.h>
 #include <stdbool.h>
+#include <vector>
 
 #include "peripherals_base/uart_base.hpp"
 #include "linux/utils/linux_types.hpp"
 #include "linux/utils/linux_threads.hpp"
+#include "linux/utils/linux_tx_pipeline.hpp"
+#if __has_include("setup.hpp")
+#include "setup.hpp"
+#endif
 
+// Bytes buffered by the line reads, the longest line they return
+#ifndef SERIAL_FILE_LINE_BUFFER_SIZE
+#define SERIAL_FILE_LINE_BUFFER_SIZE                                        4096
+#endif
+
+/**
+ * @brief Serial port on a linux file
+ *
+ * @note readUntil() and readLine() read bursts into an internal buffer and
+ *       search them with memchr(), one system call per burst instead of one
+ *       per byte. The line returned is a view into the buffer, valid until
+ *       the next read. Bytes buffered after the line are returned first by
+ *       the next read of any kind.
+ *
+ * @code
+ * Buffer_t line;
+ * while(gps.readLine(line, 1000).success)
+ * {
+ *   parseNmea((const char *) line.data(), line.size());
+ * }
+ * @endcode
+ */
 class LinuxSerialFile : public UartBase
 {
 public:
@@ -33,19 +60,50 @@ public:
   using UartBase::write;
   Status_t write(uint8_t *data, Size_t byte_count, uint32_t timeout = UINT32_MAX);
 
+  Status_t readUntil(uint8_t delimiter, Buffer_t &line, uint32_t timeout = UINT32_MAX);
+
+  Status_t readLine(Buffer_t &line, uint32_t timeout = UINT32_MAX);
+
+  Status_t flush();
+
+  Size_t getBytesPending();
+
+  Status_t getReadResult(DriverRequest_t &request, uint32_t timeout = UINT32_MAX);
+
+  Status_t getWriteResult(DriverRequest_t &request, uint32_t timeout = UINT32_MAX);
+
   Status_t setCallback(DriverEventsList_t event = EVENT_NONE, DriverCallback_t function = nullptr, void *user_arg = nullptr);
 
+  int getLinuxHandle() { return m_linux_handle;}
+
 private:
   LinuxThreads<DataBundle_t, Status_t, UART_QUEUE_SIZE, 0> m_rx_thread_handle;
   LinuxThreads<DataBundle_t, Status_t, UART_QUEUE_SIZE, 0> m_tx_thread_handle;
+  LinuxQueue<DriverRequest_t, UART_QUEUE_SIZE> m_rx_results;
+  LinuxQueue<DriverRequest_t, UART_QUEUE_SIZE> m_tx_results;
+  LinuxTxPipeline m_tx_pipeline;
   int m_linux_handle;
   bool m_terminate;
+  bool m_is_pipelined_mode;
+  std::vector<uint8_t> m_line_buffer;
+  Size_t m_line_start;          /*!< First byte not returned yet */
+  Size_t m_line_end;            /*!< End of the bytes read */
+  Size_t m_line_scanned;        /*!< Bytes from m_line_start known to hold no delimiter */
+  uint8_t m_line_delimiter;     /*!< Delimiter m_line_scanned applies to */
 
-  Status_t readBlocking(uint8_t *data, Size_t byte_count, uint32_t timeout, bool call_back);
+  Status_t queueRead(uint8_t *data, Size_t byte_count, uint32_t timeout, void *completion, void *pool_buffer);
+  Status_t queueWrite(uint8_t *data, Size_t byte_count, uint32_t timeout, void *completion, void *pool_buffer);
+
+  Status_t readBlocking(uint8_t *data, Size_t byte_count, uint32_t timeout);
   static Status_t readFromThreadBlocking(DataBundle_t data_bundle, void *self_ptr);
 
-  Status_t writeBlocking(uint8_t *data, Size_t byte_count, uint32_t timeout, bool call_back);
+  Status_t writeBlocking(uint8_t *data, Size_t byte_count, uint32_t timeout);
   static Status_t writeFromThreadBlocking(DataBundle_t data_bundle, void *self_ptr);
+
+  Status_t fillLineBuffer(uint64_t deadline_ns);
+
+  void finishRead(const DataBundle_t &data_bundle, Status_t status, Size_t byte_count);
+  void finishWrite(const DataBundle_t &data_bundle, Status_t status, Size_t byte_count);
 };
 
 #endif /* DRIVERS_LINUX_UTILS_LINUX_SERIAL_FILE_HPP */
\ No newline at end of file
@@ -0,0 +1,243 @@
+/**
+ * @file linux_thread_attributes.cpp
+ * @author your name (you@domain.com)
+ * @brief Scheduling, CPU affinity and memory locking of driver threads
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "linux/utils/linux_thread_attributes.hpp"
+#include "driver_base/driver_trace.hpp"
+
+#include <alloca.h>
+#include <malloc.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <atomic>
+#include <mutex>
+
+static std::mutex s_defaults_mutex;
+static LinuxThreadAttributes_t s_defaults = {THREAD_POLICY_DEFAULT, 0, 0};
+static std::atomic<uint32_t> s_stack_prefault_size(0);
+static std::atomic<bool> s_memory_locked(false);
+
+/**
+ * @brief Touch the stack below the caller so that its pages are mapped
+ *        before the time critical work starts
+ * @param size Number of bytes to touch
+ */
+static void __attribute__((noinline)) prefaultStack(uint32_t size)
+{
+  volatile uint8_t *stack = (volatile uint8_t *) alloca(size);
+  long page_size = sysconf(_SC_PAGESIZE);
+
+  for(uint32_t i = 0; i < size; i += (uint32_t) page_size) { stack[i] = 0;}
+}
+
+/**
+ * @brief Set the attributes drivers start from, affects the workers started
+ *        afterwards
+ * @param attributes The attributes
+ */
+void LinuxThreadAttributes::setDefaults(const LinuxThreadAttributes_t &attributes)
+{
+  std::lock_guard<std::mutex> lock(s_defaults_mutex);
+  s_defaults = attributes;
+}
+
+/**
+ * @brief Get the attributes drivers start from
+ * @return LinuxThreadAttributes_t
+ */
+LinuxThreadAttributes_t LinuxThreadAttributes::getDefaults()
+{
+  std::lock_guard<std::mutex> lock(s_defaults_mutex);
+  return s_defaults;
+}
+
+/**
+ * @brief Take a configuration entry if it is a THREAD_PARAM_* one
+ * @param setting The entry
+ * @param attributes Attributes to update
+ * @return true if the entry was a thread parameter
+ */
+bool LinuxThreadAttributes::parse(const DriverSettings_t &setting, LinuxThreadAttributes_t &attributes)
+{
+  switch(setting.parameter)
+  {
+    case THREAD_PARAM_POLICY:
+      attributes.policy = (uint8_t) setting.value;
+      return true;
+    case THREAD_PARAM_PRIORITY:
+      attributes.priority = (uint8_t) setting.value;
+      return true;
+    case THREAD_PARAM_AFFINITY:
+      attributes.affinity = setting.value;
+      return true;
+    default:
+      return false;
+  }
+}
+
+/**
+ * @brief Check attributes before starting a thread with them
+ * @param attributes The attributes
+ * @return Status_t
+ */
+Status_t LinuxThreadAttributes::check(const LinuxThreadAttributes_t &attributes)
+{
+  int policy;
+
+  switch(attributes.policy)
+  {
+    case THREAD_POLICY_DEFAULT:
+      return STATUS_DRV_SUCCESS;
+    case THREAD_POLICY_FIFO:
+      policy = SCHED_FIFO;
+      break;
+    case THREAD_POLICY_RR:
+      policy = SCHED_RR;
+      break;
+    default:
+      return STATUS_DRV_ERR_PARAM;
+  }
+  if(attributes.priority < sched_get_priority_min(policy) || attributes.priority > sched_get_priority_max(policy))
+  {
+    return STATUS_DRV_ERR_PARAM;
+  }
+  return STATUS_DRV_SUCCESS;
+}
+
+/**
+ * @brief Apply attributes to a thread just started
+ *
+ * @note With THREAD_POLICY_DEFAULT the thread keeps the policy it inherited
+ *       from the one that started it.
+ * @param thread The thread
+ * @param attributes The attributes
+ * @return Status_t
+ */
+Status_t LinuxThreadAttributes::apply(std::thread &thread, const LinuxThreadAttributes_t &attributes)
+{
+  pthread_t handle = thread.native_handle();
+  struct sched_param parameters;
+  cpu_set_t cpus;
+  Status_t status;
+
+  status = check(attributes);
+  if(!status.success) { return status;}
+
+  if(attributes.policy != THREAD_POLICY_DEFAULT)
+  {
+    memset(&parameters, 0, sizeof(parameters));
+    parameters.sched_priority = attributes.priority;
+    if(pthread_setschedparam(handle, attributes.policy == THREAD_POLICY_FIFO ? SCHED_FIFO : SCHED_RR, &parameters) != 0)
+    {
+      SET_STATUS(status, false, SRC_DRIVER, ERR_FAILED, (char *)"Failed to set the thread priority, check CAP_SYS_NICE or RLIMIT_RTPRIO.\r\n");
+      return status;
+    }
+  }
+
+  if(attributes.affinity != 0)
+  {
+    CPU_ZERO(&cpus);
+    for(uint32_t cpu = 0; cpu < 32; cpu++)
+    {
+      if((attributes.affinity & (1UL << cpu)) != 0) { CPU_SET(cpu, &cpus);}
+    }
+    if(pthread_setaffinity_np(handle, sizeof(cpus), &cpus) != 0)
+    {
+      SET_STATUS(status, false, SRC_DRIVER, ERR_FAILED, (char *)"Failed to set the thread affinity, no allowed CPU in the mask.\r\n");
+      return status;
+    }
+  }
+  return STATUS_DRV_SUCCESS;
+}
+
+/**
+ * @brief Called first by each driver thread, names it and prefaults its
+ *        stack if the memory is locked
+ * @param name Name shown by the system and on traces, at most 15 characters
+ *        are kept by the system, may be nullptr
+ */
+void LinuxThreadAttributes::setUp(const char *name)
+{
+  uint32_t stack_size = s_stack_prefault_size.load(std::memory_order_relaxed);
+
+  if(name != nullptr)
+  {
+    (void) pthread_setname_np(pthread_self(), name);
+    DRIVER_TRACE_THREAD_NAME(name);
+  }
+  if(stack_size != 0) { prefaultStack(stack_size);}
+}
+
+/**
+ * @brief Lock the memory of the process so that no driver thread waits on a
+ *        page fault, call once at start up before the drivers
+ *
+ * @note Memory mapped later is locked as well, including the stacks of the
+ *       threads started afterwards, RLIMIT_MEMLOCK must cover them or
+ *       CAP_IPC_LOCK is needed. Freed memory is kept by the allocator
+ *       instead of being returned to the system.
+ * @param stack_size Bytes of stack touched by the caller and then by every
+ *        driver thread when it starts
+ * @param heap_size Bytes allocated and touched once so that later
+ *        allocations reuse them
+ * @return Status_t
+ */
+Status_t LinuxThreadAttributes::lockMemory(uint32_t stack_size, uint32_t heap_size)
+{
+  Status_t status;
+  volatile uint8_t *heap;
+  long page_size = sysconf(_SC_PAGESIZE);
+
+  if(mlockall(MCL_CURRENT | MCL_FUTURE) != 0)
+  {
+    SET_STATUS(status, false, SRC_DRIVER, ERR_FAILED, (char *)"Failed to lock the memory, check CAP_IPC_LOCK or RLIMIT_MEMLOCK.\r\n");
+    return status;
+  }
+  (void) mallopt(M_TRIM_THRESHOLD, -1);
+  (void) mallopt(M_MMAP_MAX, 0);
+
+  if(heap_size != 0)
+  {
+    heap = (volatile uint8_t *) malloc(heap_size);
+    if(heap != nullptr)
+    {
+      for(uint32_t i = 0; i < heap_size; i += (uint32_t) page_size) { heap[i] = 0;}
+      free((void *) heap);
+    }
+  }
+  if(stack_size != 0) { prefaultStack(stack_size);}
+  s_stack_prefault_size = stack_size;
+  s_memory_locked = true;
+  return STATUS_DRV_SUCCESS;
+}
+
+/**
+ * @brief Unlock the memory of the process, threads no longer prefault their
+ *        stacks
+ */
+void LinuxThreadAttributes::unlockMemory()
+{
+  s_stack_prefault_size = 0;
+  s_memory_locked = false;
+  (void) munlockall();
+}
+
+/**
+ * @brief Tell if lockMemory() succeeded
+ * @return true if the memory is locked
+ */
+bool LinuxThreadAttributes::isMemoryLocked()
+{
+  return s_memory_locked.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,81 @@
+/**
+ * @file linux_thread_attributes.hpp
+ * @author your name (you@domain.com)
+ * @brief Scheduling, CPU affinity and memory locking of driver threads
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef DRIVERS_LINUX_UTILS_LINUX_THREAD_ATTRIBUTES_HPP
+#define DRIVERS_LINUX_UTILS_LINUX_THREAD_ATTRIBUTES_HPP
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <thread>
+
+#include "com_types.hpp"
+#include "driver_base/driver_base_types.hpp"
+#if __has_include("setup.hpp")
+#include "setup.hpp"
+#endif
+
+// Stack touched by each driver thread once the memory is locked
+#ifndef LINUX_THREAD_STACK_PREFAULT_SIZE
+#define LINUX_THREAD_STACK_PREFAULT_SIZE                             (64 * 1024)
+#endif
+
+/**
+ * @brief How a driver thread is scheduled
+ */
+typedef struct
+{
+  uint8_t policy;         /*!< One of ThreadPolicy_t */
+  uint8_t priority;       /*!< 1 to 99 with the real time policies, ignored otherwise */
+  uint32_t affinity;      /*!< One bit per CPU, 0 runs anywhere */
+}LinuxThreadAttributes_t;
+
+/**
+ * @brief Applies the same scheduling to every driver worker
+ *
+ * @note Drivers start from the defaults and override them with the
+ *       THREAD_PARAM_* entries of their configuration list. The attributes
+ *       are applied by the thread starting the worker, so a missing
+ *       permission fails configure() instead of going unnoticed.
+ *
+ * @code
+ * LinuxThreadAttributes::lockMemory();
+ * LinuxThreadAttributes::setDefaults({THREAD_POLICY_FIFO, 50, 0x2});  // every worker on CPU 1
+ * const DriverSettings_t settings[] =
+ * {
+ *   ADD_PARAMETER(COMM_WORK_ASYNC, 1),
+ *   ADD_PARAMETER(THREAD_PARAM_PRIORITY, 80),                         // above the other workers
+ * };
+ * uart.configure(settings, 2);
+ * @endcode
+ */
+class LinuxThreadAttributes
+{
+public:
+  static void setDefaults(const LinuxThreadAttributes_t &attributes);
+
+  static LinuxThreadAttributes_t getDefaults();
+
+  static bool parse(const DriverSettings_t &setting, LinuxThreadAttributes_t &attributes);
+
+  static Status_t check(const LinuxThreadAttributes_t &attributes);
+
+  static Status_t apply(std::thread &thread, const LinuxThreadAttributes_t &attributes);
+
+  static void setUp(const char *name);
+
+  static Status_t lockMemory(uint32_t stack_size = LINUX_THREAD_STACK_PREFAULT_SIZE, uint32_t heap_size = 0);
+
+  static void unlockMemory();
+
+  static bool isMemoryLocked();
+};
+
+#endif /* DRIVERS_LINUX_UTILS_LINUX_THREAD_ATTRIBUTES_HPP */
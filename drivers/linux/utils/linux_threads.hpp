@@ -17,10 +17,15 @@
 #include <thread>
 #include <chrono>
 #include <functional>
+#include <atomic>
+#include <type_traits>
 
 #include "linux_types.hpp"
 #include "linux_queue.hpp"
+#include "linux_thread_attributes.hpp"
 #include "task_interface/task_interface.hpp"
+#include "driver_base/driver_trace.hpp"
+#include "driver_base/driver_token.hpp"
 
 /**
  * @brief Task implementation for linux systems
@@ -48,15 +53,28 @@ public:
 
   bool getOutputData(void *data, uint32_t timeout = UINT32_MAX);
 
+  void setName(const char *name);
+
+  void setAttributes(const LinuxThreadAttributes_t &attributes);
+
 private:
   std::thread *m_thread_handle;
   bool m_terminate;
   ThreadFunction_t m_function;
   void *m_user_arg;
+  const char *m_name;
+  LinuxThreadAttributes_t m_attributes;
+  bool m_use_default_attributes;
+  std::atomic<uint64_t> m_hops_in;
+  uint64_t m_hops_out;
   LinuxQueue<INPUT_DATA, MAX_IN_QUEUE_SIZE> m_input_queue;
   LinuxQueue<OUTPUT_DATA, MAX_OUT_QUEUE_SIZE> m_output_queue;
 
   void run();
+
+  void discard(INPUT_DATA &input_data);
+
+  uint64_t getHopId(uint64_t hop);
 };
 
 #include "linux_threads.tpp"
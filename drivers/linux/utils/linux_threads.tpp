@@ -11,6 +11,8 @@
 
 #include "linux/utils/linux_threads.hpp"
 
+#include <pthread.h>
+
 /**
  * @brief Constructor
  *
@@ -28,6 +30,11 @@ LinuxThreads<INPUT_DATA, OUTPUT_DATA, MAX_IN_QUEUE_SIZE, MAX_OUT_QUEUE_SIZE>::Li
   m_terminate = true;
   m_function = function;
   m_user_arg = user_arg;
+  m_name = nullptr;
+  m_attributes = {THREAD_POLICY_DEFAULT, 0, 0};
+  m_use_default_attributes = true;
+  m_hops_in = 0;
+  m_hops_out = 0;
 }
 
 /**
@@ -62,11 +69,17 @@ bool LinuxThreads<INPUT_DATA, OUTPUT_DATA, MAX_IN_QUEUE_SIZE, MAX_OUT_QUEUE_SIZE
   }
   m_terminate = false;
   m_thread_handle = new std::thread(&LinuxThreads::run, this);
-  if(m_thread_handle != nullptr)
+  if(m_thread_handle == nullptr)
   {
-    return true;
+    return false;
   }
-  return false;
+  if(m_use_default_attributes) { m_attributes = LinuxThreadAttributes::getDefaults();}
+  if(!LinuxThreadAttributes::apply(*m_thread_handle, m_attributes).success)
+  {
+    (void) terminate();
+    return false;
+  }
+  return true;
 }
 
 /**
@@ -81,7 +94,7 @@ bool LinuxThreads<INPUT_DATA, OUTPUT_DATA, MAX_IN_QUEUE_SIZE, MAX_OUT_QUEUE_SIZE
 template <typename INPUT_DATA, typename OUTPUT_DATA, uint32_t MAX_IN_QUEUE_SIZE, uint32_t MAX_OUT_QUEUE_SIZE>
 bool LinuxThreads<INPUT_DATA, OUTPUT_DATA, MAX_IN_QUEUE_SIZE, MAX_OUT_QUEUE_SIZE>::terminate()
 {
-  INPUT_DATA input_data;
+  INPUT_DATA input_data = {};
   if(!m_terminate)
   {
     m_terminate = true;
@@ -89,10 +102,40 @@ bool LinuxThreads<INPUT_DATA, OUTPUT_DATA, MAX_IN_QUEUE_SIZE, MAX_OUT_QUEUE_SIZE
     join();
     delete m_thread_handle;
     m_thread_handle = nullptr;
+    // The worker stops at the next request, whoever waits on the others is told
+    while(m_input_queue.get(input_data, 0))
+    {
+      discard(input_data);
+    }
   }
   return true;
 }
 
+/**
+ * @brief Fail a request left in the queue by a terminated worker and give
+ *        back its pooled buffer
+ *
+ * @tparam INPUT_DATA Data type of the input
+ * @tparam OUTPUT_DATA Data type of the output
+ * @tparam MAX_IN_QUEUE_SIZE Maximum number of bytes in the input queue
+ * @tparam MAX_OUT_QUEUE_SIZE Maximum number of bytes in the input queue
+ * @param input_data The request
+ */
+template <typename INPUT_DATA, typename OUTPUT_DATA, uint32_t MAX_IN_QUEUE_SIZE, uint32_t MAX_OUT_QUEUE_SIZE>
+void LinuxThreads<INPUT_DATA, OUTPUT_DATA, MAX_IN_QUEUE_SIZE, MAX_OUT_QUEUE_SIZE>::discard(INPUT_DATA &input_data)
+{
+  if constexpr(std::is_same_v<INPUT_DATA, DataBundle_t>)
+  {
+    Status_t status;
+    SET_STATUS(status, false, SRC_DRIVER, ERR_DISABLED, (char *)"The worker stopped before the request ran.\r\n");
+    DriverToken::complete(input_data.completion, {input_data.id, status, 0, EVENT_NONE});
+    PoolBuffer::release(input_data.pool_buffer);
+  }else
+  {
+    (void) input_data;
+  }
+}
+
 /**
  * @brief Block until the task is terminated
  *
@@ -113,7 +156,10 @@ bool LinuxThreads<INPUT_DATA, OUTPUT_DATA, MAX_IN_QUEUE_SIZE, MAX_OUT_QUEUE_SIZE
   INPUT_DATA *input_data = (INPUT_DATA *) data;
   if(input_data != nullptr)
   {
-    return m_input_queue.put(input_data[0], timeout);
+    if(!m_input_queue.put(input_data[0], timeout)) { return false;}
+    // Arrow from the caller's current event to the worker picking the data
+    DRIVER_TRACE_HOP_BEGIN("thread", "queue", getHopId(m_hops_in.fetch_add(1, std::memory_order_relaxed)));
+    return true;
   }
   return false;
 }
@@ -129,6 +175,57 @@ bool LinuxThreads<INPUT_DATA, OUTPUT_DATA, MAX_IN_QUEUE_SIZE, MAX_OUT_QUEUE_SIZE
   return false;
 }
 
+/**
+ * @brief Name the worker thread, must be called before create()
+ *
+ * @tparam INPUT_DATA Data type of the input
+ * @tparam OUTPUT_DATA Data type of the output
+ * @tparam MAX_IN_QUEUE_SIZE Maximum number of bytes in the input queue
+ * @tparam MAX_OUT_QUEUE_SIZE Maximum number of bytes in the input queue
+ * @param name Name shown by the system and on traces, at most 15 characters
+ *        are kept by the system
+ */
+template <typename INPUT_DATA, typename OUTPUT_DATA, uint32_t MAX_IN_QUEUE_SIZE, uint32_t MAX_OUT_QUEUE_SIZE>
+void LinuxThreads<INPUT_DATA, OUTPUT_DATA, MAX_IN_QUEUE_SIZE, MAX_OUT_QUEUE_SIZE>::setName(const char *name)
+{
+  m_name = name;
+}
+
+/**
+ * @brief Set the scheduling of the worker thread, must be called before
+ *        create(), LinuxThreadAttributes::getDefaults() is used otherwise
+ *
+ * @tparam INPUT_DATA Data type of the input
+ * @tparam OUTPUT_DATA Data type of the output
+ * @tparam MAX_IN_QUEUE_SIZE Maximum number of bytes in the input queue
+ * @tparam MAX_OUT_QUEUE_SIZE Maximum number of bytes in the input queue
+ * @param attributes Policy, priority and CPU affinity
+ */
+template <typename INPUT_DATA, typename OUTPUT_DATA, uint32_t MAX_IN_QUEUE_SIZE, uint32_t MAX_OUT_QUEUE_SIZE>
+void LinuxThreads<INPUT_DATA, OUTPUT_DATA, MAX_IN_QUEUE_SIZE, MAX_OUT_QUEUE_SIZE>::setAttributes(const LinuxThreadAttributes_t &attributes)
+{
+  m_attributes = attributes;
+  m_use_default_attributes = false;
+}
+
+/**
+ * @brief Identifier linking a queue hop's trace events
+ *
+ * @note Hops are numbered in queue order on both ends, concurrent producers
+ *       may only swap the arrows of requests queued at the same time.
+ * @tparam INPUT_DATA Data type of the input
+ * @tparam OUTPUT_DATA Data type of the output
+ * @tparam MAX_IN_QUEUE_SIZE Maximum number of bytes in the input queue
+ * @tparam MAX_OUT_QUEUE_SIZE Maximum number of bytes in the input queue
+ * @param hop Sequence number of the hop
+ * @return uint64_t
+ */
+template <typename INPUT_DATA, typename OUTPUT_DATA, uint32_t MAX_IN_QUEUE_SIZE, uint32_t MAX_OUT_QUEUE_SIZE>
+uint64_t LinuxThreads<INPUT_DATA, OUTPUT_DATA, MAX_IN_QUEUE_SIZE, MAX_OUT_QUEUE_SIZE>::getHopId(uint64_t hop)
+{
+  return ((uint64_t) reinterpret_cast<uintptr_t>(this) << 16) ^ hop;
+}
+
 /**
  * @brief Worker task calling a work function as demanded
  *
@@ -143,16 +240,23 @@ void LinuxThreads<INPUT_DATA, OUTPUT_DATA, MAX_IN_QUEUE_SIZE, MAX_OUT_QUEUE_SIZE
   INPUT_DATA input;
   OUTPUT_DATA output;
 
+  LinuxThreadAttributes::setUp(m_name);
+
   while(true)
   {
     m_input_queue.get(input);
     if(m_terminate)
     {
+      discard(input);
       break;
     }
-    if(m_function != nullptr)
     {
-      output = m_function(input, m_user_arg);
+      DRIVER_TRACE_SCOPE("thread", "work");
+      DRIVER_TRACE_HOP_END("thread", "queue", getHopId(m_hops_out++));
+      if(m_function != nullptr)
+      {
+        output = m_function(input, m_user_arg);
+      }
     }
     m_output_queue.put(output);
   }
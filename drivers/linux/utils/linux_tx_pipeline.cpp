@@ -0,0 +1,295 @@
+/**
+ * @file linux_tx_pipeline.cpp
+ * @author your name (you@domain.com)
+ * @brief Non-draining transmission with completion tracking for tty files
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "linux/utils/linux_tx_pipeline.hpp"
+
+#include <termios.h>
+#include <unistd.h>
+#include <chrono>
+
+#include "linux/utils/linux_io.hpp"
+#include "driver_base/driver_trace.hpp"
+
+// Bounds for the time the tracker sleeps between two TIOCOUTQ samples
+constexpr uint32_t TX_PIPELINE_MIN_WAIT_US = 100;
+constexpr uint32_t TX_PIPELINE_MAX_WAIT_US = 20000;
+// Used when the baud rate is unknown
+constexpr uint32_t TX_PIPELINE_DEFAULT_WAIT_US = 1000;
+
+/**
+ * @brief Constructor
+ */
+LinuxTxPipeline::LinuxTxPipeline()
+{
+  m_thread_handle = nullptr;
+  m_attributes = {THREAD_POLICY_DEFAULT, 0, 0};
+  m_use_default_attributes = true;
+  m_bytes_queued = 0;
+  m_bytes_completed = 0;
+  m_bytes_drained = 0;
+  m_drain_status = STATUS_DRV_SUCCESS;
+  m_char_time_us = 0;
+  m_linux_handle = -1;
+  m_terminate = true;
+}
+
+/**
+ * @brief Destructor
+ */
+LinuxTxPipeline::~LinuxTxPipeline()
+{
+  stop();
+}
+
+/**
+ * @brief Launch the completion tracker
+ * @param fd File descriptor of an opened tty
+ * @param baud_rate Line speed in bits per second, zero if unknown
+ * @return true if the tracker is running
+ */
+bool LinuxTxPipeline::start(int fd, uint32_t baud_rate)
+{
+  if(fd < 0) { return false;}
+  stop();
+
+  m_linux_handle = fd;
+  m_bytes_queued = 0;
+  m_bytes_completed = 0;
+  m_bytes_drained = 0;
+  // Start bit, 8 data bits, parity or stop bit and a stop bit
+  m_char_time_us = baud_rate > 0 ? (11 * 1000000) / baud_rate : 0;
+  m_terminate = false;
+  m_thread_handle = new std::thread(&LinuxTxPipeline::run, this);
+  if(m_thread_handle == nullptr) { return false;}
+  if(m_use_default_attributes) { m_attributes = LinuxThreadAttributes::getDefaults();}
+  if(!LinuxThreadAttributes::apply(*m_thread_handle, m_attributes).success)
+  {
+    stop();
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Stop the completion tracker, frames not yet confirmed are dropped
+ */
+void LinuxTxPipeline::stop()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+
+  if(m_thread_handle == nullptr) { return;}
+  m_terminate = true;
+  lock.unlock();
+  m_condition.notify_one();
+  m_thread_handle->join();
+  delete m_thread_handle;
+  m_thread_handle = nullptr;
+
+  lock.lock();
+  m_frames = std::queue<LinuxTxFrame_t>();
+  m_bytes_completed = m_bytes_queued;
+  m_completed.notify_all();
+}
+
+/**
+ * @brief Hand data to the kernel's transmission buffer without draining it
+ * @param data Buffer where data is stored
+ * @param byte_count Number of bytes to write
+ * @param bytes_written Number of bytes accepted by the kernel
+ * @param function Function called once the frame has left the transmitter
+ * @param user_arg Argument passed to the callback function
+ * @return Status_t
+ */
+Status_t LinuxTxPipeline::write(uint8_t *data, Size_t byte_count, Size_t &bytes_written, DriverCallback_t function, void *user_arg)
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  LinuxTxFrame_t frame;
+  int byte_count_written;
+
+  bytes_written = 0;
+  if(m_thread_handle == nullptr) { return STATUS_DRV_NOT_CONFIGURED;}
+
+  // The lock is held through the system call so that TIOCOUTQ samples are
+  // always consistent with m_bytes_queued
+  byte_count_written = writeSyscall(m_linux_handle, data, byte_count);
+  if(byte_count_written < 0)
+  {
+    return convertErrnoCode(errno);
+  }
+
+  m_bytes_queued += byte_count_written;
+  bytes_written = byte_count_written;
+
+  frame.data = data;
+  frame.size = byte_count_written;
+  frame.end_offset = m_bytes_queued;
+  frame.func = function;
+  frame.arg = user_arg;
+  m_frames.push(frame);
+  lock.unlock();
+  m_condition.notify_one();
+
+  return STATUS_DRV_SUCCESS;
+}
+
+/**
+ * @brief Block until every queued byte has left the transmitter and the
+ *        frames are called back
+ *
+ * @note The callbacks run on the tracker thread, writes may go on while the
+ *       line drains.
+ * @return Status_t
+ */
+Status_t LinuxTxPipeline::flush()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  Status_t status = STATUS_DRV_SUCCESS;
+  uint64_t bytes_queued = m_bytes_queued;
+
+  if(m_linux_handle < 0) { return STATUS_DRV_NOT_CONFIGURED;}
+
+  lock.unlock();
+  if(tcdrain(m_linux_handle) < 0)
+  {
+    status = convertErrnoCode(errno);
+  }
+  lock.lock();
+
+  if(bytes_queued > m_bytes_drained)
+  {
+    m_bytes_drained = bytes_queued;
+    m_drain_status = status;
+  }
+  m_condition.notify_one();
+  // A callback flushing would wait on its own thread
+  if(m_thread_handle != nullptr && m_thread_handle->get_id() != std::this_thread::get_id())
+  {
+    m_completed.wait(lock, [this, bytes_queued] { return m_terminate || m_bytes_completed >= bytes_queued;});
+  }
+
+  return status;
+}
+
+/**
+ * @brief Get the number of bytes written but not yet sent
+ * @return Size_t
+ */
+Size_t LinuxTxPipeline::getBytesPending()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  if(m_linux_handle < 0) { return 0;}
+  return (Size_t)(m_bytes_queued - getBytesSent());
+}
+
+/**
+ * @brief Check if the completion tracker is running
+ * @return bool
+ */
+bool LinuxTxPipeline::isRunning()
+{
+  return m_thread_handle != nullptr;
+}
+
+/**
+ * @brief Set the scheduling of the completion tracker, must be called before
+ *        start(), LinuxThreadAttributes::getDefaults() is used otherwise
+ * @param attributes Policy, priority and CPU affinity
+ */
+void LinuxTxPipeline::setAttributes(const LinuxThreadAttributes_t &attributes)
+{
+  m_attributes = attributes;
+  m_use_default_attributes = false;
+}
+
+/**
+ * @brief Completion tracker, sleeps for about the time the next frame takes
+ *        to go out and then confirms it through TIOCOUTQ
+ */
+void LinuxTxPipeline::run()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  uint64_t bytes_sent, bytes_left;
+  uint32_t wait_us;
+
+  LinuxThreadAttributes::setUp("tx_pipeline");
+  while(!m_terminate)
+  {
+    if(m_frames.empty())
+    {
+      m_condition.wait(lock);
+      continue;
+    }
+
+    bytes_sent = getBytesSent();
+    complete(lock, bytes_sent, STATUS_DRV_SUCCESS);
+    // Frames a flush() saw drained go with its status
+    complete(lock, m_bytes_drained, m_drain_status);
+    if(m_frames.empty() || m_terminate) { continue;}
+
+    bytes_left = m_frames.front().end_offset > bytes_sent ? m_frames.front().end_offset - bytes_sent : 1;
+    if(m_char_time_us == 0)
+    {
+      wait_us = TX_PIPELINE_DEFAULT_WAIT_US;
+    }else
+    {
+      wait_us = bytes_left * m_char_time_us;
+      if(wait_us < TX_PIPELINE_MIN_WAIT_US) { wait_us = TX_PIPELINE_MIN_WAIT_US;}
+      if(wait_us > TX_PIPELINE_MAX_WAIT_US) { wait_us = TX_PIPELINE_MAX_WAIT_US;}
+    }
+    m_condition.wait_for(lock, std::chrono::microseconds(wait_us));
+  }
+}
+
+/**
+ * @brief Get the number of bytes that already left the transmitter,
+ *        must be called with the lock held
+ * @return uint64_t
+ */
+uint64_t LinuxTxPipeline::getBytesSent()
+{
+  int pending = bytesPendingSyscall(m_linux_handle);
+
+  // Without TIOCOUTQ support there is no way to know, assume sent
+  if(pending < 0) { return m_bytes_queued;}
+
+  // The last byte may still be in the shift register
+  if(pending == 0 && transmitterEmptySyscall(m_linux_handle) == 0) { pending = 1;}
+
+  if((uint64_t) pending > m_bytes_queued) { return 0;}
+  return m_bytes_queued - pending;
+}
+
+/**
+ * @brief Call back every frame that ends before a given offset,
+ *        must be called from the tracker with the lock held
+ * @param lock Lock on the frame queue, released while calling back
+ * @param bytes_sent Number of bytes confirmed as sent
+ * @param status Status reported to the callback functions
+ */
+void LinuxTxPipeline::complete(std::unique_lock<std::mutex> &lock, uint64_t bytes_sent, Status_t status)
+{
+  LinuxTxFrame_t frame;
+
+  while(!m_frames.empty() && m_frames.front().end_offset <= bytes_sent)
+  {
+    frame = m_frames.front();
+    m_frames.pop();
+    if(frame.func != nullptr)
+    {
+      lock.unlock();
+      Buffer_t data_container(frame.data, frame.size);
+      frame.func(status, EVENT_WRITE, data_container, frame.arg);
+      lock.lock();
+    }
+    m_bytes_completed = frame.end_offset;
+    m_completed.notify_all();
+  }
+}
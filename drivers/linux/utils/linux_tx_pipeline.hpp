@@ -0,0 +1,91 @@
+/**
+ * @file linux_tx_pipeline.hpp
+ * @author your name (you@domain.com)
+ * @brief Non-draining transmission with completion tracking for tty files
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef DRIVERS_LINUX_UTILS_LINUX_TX_PIPELINE_HPP
+#define DRIVERS_LINUX_UTILS_LINUX_TX_PIPELINE_HPP
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <thread>
+#include <mutex>
+#include <queue>
+#include <condition_variable>
+
+#include "com_types.hpp"
+#include "driver_base/driver_base_types.hpp"
+#include "linux/utils/linux_thread_attributes.hpp"
+
+/**
+ * @brief Queues writes on the kernel's transmission buffer without draining
+ *        it and calls back once each frame has left the transmitter
+ *
+ * @note Completion is detected by comparing the number of bytes handed to the
+ *       kernel with the number of bytes TIOCOUTQ still reports as pending.
+ *       Callbacks only run on the tracker thread, one at a time and in the
+ *       order of the writes.
+ */
+class LinuxTxPipeline
+{
+public:
+  LinuxTxPipeline();
+
+  ~LinuxTxPipeline();
+
+  bool start(int fd, uint32_t baud_rate);
+
+  void stop();
+
+  void setAttributes(const LinuxThreadAttributes_t &attributes);
+
+  Status_t write(uint8_t *data, Size_t byte_count, Size_t &bytes_written, DriverCallback_t function, void *user_arg);
+
+  Status_t flush();
+
+  Size_t getBytesPending();
+
+  bool isRunning();
+
+private:
+  /**
+   * @brief A frame handed to the kernel and not yet confirmed as sent
+   */
+  typedef struct
+  {
+    uint8_t *data;
+    Size_t size;
+    uint64_t end_offset;
+    DriverCallback_t func;
+    void *arg;
+  }LinuxTxFrame_t;
+
+  std::thread *m_thread_handle;
+  LinuxThreadAttributes_t m_attributes;
+  bool m_use_default_attributes;
+  std::mutex m_mutex;
+  std::condition_variable m_condition;
+  std::condition_variable m_completed;        /*!< Signaled once frames are called back */
+  std::queue<LinuxTxFrame_t> m_frames;
+  uint64_t m_bytes_queued;
+  uint64_t m_bytes_completed;                 /*!< End offset of the last frame called back */
+  uint64_t m_bytes_drained;                   /*!< Offset confirmed by the last flush() */
+  Status_t m_drain_status;
+  uint32_t m_char_time_us;
+  int m_linux_handle;
+  bool m_terminate;
+
+  void run();
+
+  uint64_t getBytesSent();
+
+  void complete(std::unique_lock<std::mutex> &lock, uint64_t bytes_sent, Status_t status);
+};
+
+#endif /* DRIVERS_LINUX_UTILS_LINUX_TX_PIPELINE_HPP */
@@ -0,0 +1,77 @@
+/**
+ * @file virtual_backend.cpp
+ * @author your name (you@domain.com)
+ * @brief In-process stand-ins for SPI, IIC and DIO hardware
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "linux/virtual/virtual_backend.hpp"
+
+#include <thread>
+#include <chrono>
+
+// Delays shorter than this are spun, sleeping would overshoot them
+constexpr uint64_t VIRTUAL_SPIN_LIMIT_NS = 100000;
+
+/**
+ * @brief Constructor, devices answer immediately by default
+ */
+VirtualBackend::VirtualBackend()
+{
+  m_fixed_us = 0;
+  m_per_byte_ns = 0;
+}
+
+/**
+ * @brief Change the time the device takes to answer
+ * @param latency The new latency
+ */
+void VirtualBackend::setLatency(const VirtualLatency_t &latency)
+{
+  m_fixed_us = latency.fixed_us;
+  m_per_byte_ns = latency.per_byte_ns;
+}
+
+/**
+ * @brief Get the time the device takes to answer
+ * @return VirtualLatency_t
+ */
+VirtualLatency_t VirtualBackend::getLatency()
+{
+  return {m_fixed_us.load(), m_per_byte_ns.load()};
+}
+
+/**
+ * @brief Hold the calling thread for the configured latency
+ * @param byte_count Number of bytes moved by the request
+ */
+void VirtualBackend::delay(Size_t byte_count)
+{
+  uint64_t duration_ns = (uint64_t) m_fixed_us.load() * 1000 + (uint64_t) m_per_byte_ns.load() * byte_count;
+  auto end = std::chrono::steady_clock::now() + std::chrono::nanoseconds(duration_ns);
+
+  if(duration_ns == 0) { return;}
+  if(duration_ns >= VIRTUAL_SPIN_LIMIT_NS)
+  {
+    std::this_thread::sleep_until(end);
+    return;
+  }
+  while(std::chrono::steady_clock::now() < end) {}
+}
+
+/**
+ * @brief Apply the bus settings, emulated devices accept any
+ * @param speed_hz Clock frequency
+ * @param mode SPI mode, 0 to 3
+ * @return Status_t
+ */
+Status_t VirtualSpiBackend::configure(uint32_t speed_hz, uint8_t mode)
+{
+  (void) speed_hz;
+  if(mode > 3) { return STATUS_DRV_ERR_PARAM;}
+  return STATUS_DRV_SUCCESS;
+}
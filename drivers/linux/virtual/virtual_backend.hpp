@@ -0,0 +1,105 @@
+/**
+ * @file virtual_backend.hpp
+ * @author your name (you@domain.com)
+ * @brief In-process stand-ins for SPI, IIC and DIO hardware
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef DRIVERS_LINUX_VIRTUAL_VIRTUAL_BACKEND_HPP
+#define DRIVERS_LINUX_VIRTUAL_VIRTUAL_BACKEND_HPP
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <atomic>
+
+#include "commons.hpp"
+#include "driver_base/driver_base_types.hpp"
+
+/**
+ * @brief Time an emulated device takes to answer a request
+ */
+typedef struct
+{
+  uint32_t fixed_us;     /*!< Paid once per request */
+  uint32_t per_byte_ns;  /*!< Paid for every byte moved */
+}VirtualLatency_t;
+
+/**
+ * @brief Base class for emulated devices, adds a configurable latency to
+ *        every request
+ *
+ * @note Short delays are spun so that microsecond latencies stay accurate,
+ *       longer ones sleep.
+ */
+class VirtualBackend
+{
+public:
+  VirtualBackend();
+
+  virtual ~VirtualBackend() {}
+
+  void setLatency(const VirtualLatency_t &latency);
+
+  VirtualLatency_t getLatency();
+
+protected:
+  void delay(Size_t byte_count);
+
+private:
+  std::atomic<uint32_t> m_fixed_us;
+  std::atomic<uint32_t> m_per_byte_ns;
+};
+
+/**
+ * @brief Device the SPI driver talks to instead of /dev/spidev*
+ *
+ * @note Each call to transfer() is one chip select cycle.
+ */
+class VirtualSpiBackend : public VirtualBackend
+{
+public:
+  virtual Status_t configure(uint32_t speed_hz, uint8_t mode);
+
+  virtual Status_t transfer(const uint8_t *tx_data, uint8_t *rx_data, Size_t byte_count) = 0;
+};
+
+/**
+ * @brief Bus the IIC driver talks to instead of /dev/i2c-*
+ *
+ * @note Addresses are 7 bits wide, as the kernel expects them.
+ */
+class VirtualIicBackend : public VirtualBackend
+{
+public:
+  virtual Status_t read(uint16_t address, uint8_t *data, Size_t byte_count) = 0;
+
+  virtual Status_t write(uint16_t address, const uint8_t *data, Size_t byte_count) = 0;
+};
+
+/**
+ * @brief Line the DIO driver talks to instead of a gpiochip
+ *
+ * @note Pending edges are signalled through a file descriptor so that the
+ *       driver can poll or await it as it does with gpiod's.
+ */
+class VirtualDioBackend : public VirtualBackend
+{
+public:
+  virtual Status_t configure(bool is_output, bool value) = 0;
+
+  virtual Status_t read(bool &state) = 0;
+
+  virtual Status_t write(bool value) = 0;
+
+  virtual Status_t requestEvents(DriverEventsList_t edge) = 0;
+
+  virtual int getEventFd() = 0;
+
+  virtual Status_t readEvent(DriverEventsList_t &edge) = 0;
+};
+
+#endif /* DRIVERS_LINUX_VIRTUAL_VIRTUAL_BACKEND_HPP */
@@ -0,0 +1,221 @@
+/**
+ * @file virtual_dio.cpp
+ * @author your name (you@domain.com)
+ * @brief Emulated GPIO line with scripted edges
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "linux/virtual/virtual_dio.hpp"
+
+#include <errno.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include <chrono>
+
+#include "driver_base/driver_trace.hpp"
+
+// Edges kept before the oldest are dropped, the kernel also bounds its queue
+constexpr Size_t VIRTUAL_DIO_MAX_EVENTS = 64;
+
+/**
+ * @brief Constructor, the line starts as a low input
+ */
+VirtualDioLine::VirtualDioLine()
+{
+  m_script_thread = nullptr;
+  m_script_running = false;
+  m_edge_count = 0;
+  m_requested_edge = EVENT_NONE;
+  m_repeat = 0;
+  m_terminate = false;
+  m_is_output = false;
+  m_level = false;
+  m_event_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK | EFD_SEMAPHORE);
+}
+
+/**
+ * @brief Destructor
+ */
+VirtualDioLine::~VirtualDioLine()
+{
+  stopScript();
+  if(m_event_fd >= 0) { close(m_event_fd);}
+}
+
+/**
+ * @brief Set the direction, pending edges are discarded
+ * @param is_output True for an output
+ * @param value Initial level of an output
+ * @return Status_t
+ */
+Status_t VirtualDioLine::configure(bool is_output, bool value)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  uint64_t count;
+
+  if(m_event_fd < 0) { return STATUS_DRV_BAD_HANDLE;}
+  m_is_output = is_output;
+  if(is_output) { m_level = value;}
+  m_requested_edge = EVENT_NONE;
+  m_events.clear();
+  while(::read(m_event_fd, &count, sizeof(count)) > 0) {}
+  return STATUS_DRV_SUCCESS;
+}
+
+/**
+ * @brief Read the line level
+ * @param state The level
+ * @return Status_t
+ */
+Status_t VirtualDioLine::read(bool &state)
+{
+  delay(0);
+  std::lock_guard<std::mutex> lock(m_mutex);
+  state = m_level;
+  return STATUS_DRV_SUCCESS;
+}
+
+/**
+ * @brief Drive the line, only outputs can be written
+ * @param value The level
+ * @return Status_t
+ */
+Status_t VirtualDioLine::write(bool value)
+{
+  delay(0);
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if(!m_is_output) { return STATUS_DRV_UNKNOWN_ERROR;}
+  m_level = value;
+  return STATUS_DRV_SUCCESS;
+}
+
+/**
+ * @brief Turn the line into an input reporting edges
+ * @param edge The edges to report
+ * @return Status_t
+ */
+Status_t VirtualDioLine::requestEvents(DriverEventsList_t edge)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  switch(edge)
+  {
+    case EVENT_EDGE_RISING:
+    case EVENT_EDGE_FALLING:
+    case EVENT_EDGE_BOTH:
+      break;
+    default:
+      return STATUS_DRV_ERR_PARAM;
+  }
+  m_is_output = false;
+  m_requested_edge = edge;
+  return STATUS_DRV_SUCCESS;
+}
+
+/**
+ * @brief Take the oldest pending edge
+ * @param edge The edge
+ * @return Status_t STATUS_DRV_ERR_TIMEOUT if there is none
+ */
+Status_t VirtualDioLine::readEvent(DriverEventsList_t &edge)
+{
+  uint64_t count;
+
+  delay(0);
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if(::read(m_event_fd, &count, sizeof(count)) < 0 || m_events.empty()) { return STATUS_DRV_ERR_TIMEOUT;}
+  edge = m_events.front();
+  m_events.pop_front();
+  return STATUS_DRV_SUCCESS;
+}
+
+/**
+ * @brief Drive an input from the outside, records an edge if one was
+ *        requested
+ * @param level The new level
+ */
+void VirtualDioLine::setLevel(bool level)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  DriverEventsList_t edge = level ? EVENT_EDGE_RISING : EVENT_EDGE_FALLING;
+  uint64_t count = 1;
+
+  if(m_is_output || level == m_level) { return;}
+  m_level = level;
+  if(m_requested_edge != edge && m_requested_edge != EVENT_EDGE_BOTH) { return;}
+  if(m_events.size() >= VIRTUAL_DIO_MAX_EVENTS) { return;}
+  m_events.push_back(edge);
+  m_edge_count++;
+  if(::write(m_event_fd, &count, sizeof(count)) < 0) { m_events.pop_back();}
+}
+
+/**
+ * @brief Play a sequence of levels on a thread, stops any script running
+ * @param steps The sequence, copied
+ * @param step_count Number of steps
+ * @param repeat Number of times the sequence is played, 0 to loop until
+ *        stopScript()
+ * @return Status_t
+ */
+Status_t VirtualDioLine::playScript(const VirtualDioStep_t *steps, Size_t step_count, uint32_t repeat)
+{
+  if(steps == nullptr) { return STATUS_DRV_NULL_POINTER;}
+  if(step_count == 0) { return STATUS_DRV_ERR_PARAM_SIZE;}
+
+  stopScript();
+  m_script.assign(steps, steps + step_count);
+  m_repeat = repeat;
+  m_terminate = false;
+  m_script_running = true;
+  m_script_thread = new std::thread(&VirtualDioLine::scriptThread, this);
+  return STATUS_DRV_SUCCESS;
+}
+
+/**
+ * @brief Stop the script and wait for its thread
+ */
+void VirtualDioLine::stopScript()
+{
+  std::unique_lock<std::mutex> locker(m_mutex);
+
+  if(m_script_thread == nullptr) { return;}
+  m_terminate = true;
+  locker.unlock();
+  m_condition.notify_all();
+  m_script_thread->join();
+  delete m_script_thread;
+  m_script_thread = nullptr;
+  m_script_running = false;
+}
+
+/**
+ * @brief Thread playing the script, steps are timed from the start of the
+ *        script so that delays do not drift
+ */
+void VirtualDioLine::scriptThread(void)
+{
+  std::unique_lock<std::mutex> locker(m_mutex, std::defer_lock);
+  auto deadline = std::chrono::steady_clock::now();
+
+  DRIVER_TRACE_THREAD_NAME("dio_script");
+  for(uint32_t i = 0; m_repeat == 0 || i < m_repeat; i++)
+  {
+    for(const VirtualDioStep_t &step : m_script)
+    {
+      deadline += std::chrono::microseconds(step.delay_us);
+      locker.lock();
+      if(m_condition.wait_until(locker, deadline, [this] { return m_terminate;}))
+      {
+        m_script_running = false;
+        return;
+      }
+      locker.unlock();
+      setLevel(step.level);
+    }
+  }
+  m_script_running = false;
+}
@@ -0,0 +1,85 @@
+/**
+ * @file virtual_dio.hpp
+ * @author your name (you@domain.com)
+ * @brief Emulated GPIO line with scripted edges
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef DRIVERS_LINUX_VIRTUAL_VIRTUAL_DIO_HPP
+#define DRIVERS_LINUX_VIRTUAL_VIRTUAL_DIO_HPP
+
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <deque>
+#include <vector>
+
+#include "linux/virtual/virtual_backend.hpp"
+
+/**
+ * @brief One step of an edge script
+ */
+typedef struct
+{
+  uint32_t delay_us;  /*!< Time since the previous step */
+  bool level;         /*!< Level the line is driven to */
+}VirtualDioStep_t;
+
+/**
+ * @brief Line driven from the test side, by setLevel() or by a script
+ *        played on its own thread
+ *
+ * @note Edges are only recorded while the line is an input with events
+ *       requested, like the kernel does.
+ */
+class VirtualDioLine : public VirtualDioBackend
+{
+public:
+  VirtualDioLine();
+  virtual ~VirtualDioLine();
+
+  Status_t configure(bool is_output, bool value) override;
+
+  Status_t read(bool &state) override;
+
+  Status_t write(bool value) override;
+
+  Status_t requestEvents(DriverEventsList_t edge) override;
+
+  int getEventFd() override { return m_event_fd;}
+
+  Status_t readEvent(DriverEventsList_t &edge) override;
+
+  void setLevel(bool level);
+
+  Status_t playScript(const VirtualDioStep_t *steps, Size_t step_count, uint32_t repeat = 1);
+
+  void stopScript();
+
+  bool isScriptRunning() { return m_script_running;}
+
+  uint64_t getEdgeCount() { return m_edge_count;}
+
+private:
+  void scriptThread(void);
+
+  std::mutex m_mutex;
+  std::condition_variable m_condition;
+  std::deque<DriverEventsList_t> m_events;
+  std::vector<VirtualDioStep_t> m_script;
+  std::thread *m_script_thread;
+  std::atomic<bool> m_script_running;
+  std::atomic<uint64_t> m_edge_count;
+  DriverEventsList_t m_requested_edge;
+  uint32_t m_repeat;
+  int m_event_fd;
+  bool m_terminate;
+  bool m_is_output;
+  bool m_level;
+};
+
+#endif /* DRIVERS_LINUX_VIRTUAL_VIRTUAL_DIO_HPP */
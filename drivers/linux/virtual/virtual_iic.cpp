@@ -0,0 +1,170 @@
+/**
+ * @file virtual_iic.cpp
+ * @author your name (you@domain.com)
+ * @brief Emulated IIC bus and register mapped devices
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "linux/virtual/virtual_iic.hpp"
+
+/**
+ * @brief Constructor, registers start cleared
+ * @param register_count Number of registers
+ * @param address_size Number of bytes of the register address, 1 or 2
+ */
+VirtualIicRegisterDevice::VirtualIicRegisterDevice(Size_t register_count, uint8_t address_size)
+{
+  m_registers.assign(register_count > 0 ? register_count : 1, 0);
+  m_pointer = 0;
+  m_address_size = address_size == 2 ? 2 : 1;
+}
+
+/**
+ * @brief Read registers starting at the current address
+ * @param data Buffer to store the values
+ * @param byte_count Number of registers to read
+ * @return Status_t
+ */
+Status_t VirtualIicRegisterDevice::read(uint8_t *data, Size_t byte_count)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  for(Size_t i = 0; i < byte_count; i++)
+  {
+    data[i] = m_registers[m_pointer];
+    m_pointer = (m_pointer + 1) % m_registers.size();
+  }
+  return STATUS_DRV_SUCCESS;
+}
+
+/**
+ * @brief Set the register address and store any value after it
+ * @param data Register address followed by the values
+ * @param byte_count Number of bytes
+ * @return Status_t
+ */
+Status_t VirtualIicRegisterDevice::write(const uint8_t *data, Size_t byte_count)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  Size_t i;
+
+  if(byte_count < m_address_size) { return STATUS_DRV_SUCCESS;}
+  m_pointer = 0;
+  for(i = 0; i < m_address_size; i++) { m_pointer = (m_pointer << 8) | data[i];}
+  m_pointer %= m_registers.size();
+  for(; i < byte_count; i++)
+  {
+    m_registers[m_pointer] = data[i];
+    m_pointer = (m_pointer + 1) % m_registers.size();
+  }
+  return STATUS_DRV_SUCCESS;
+}
+
+/**
+ * @brief Change a register from the device side, e.g. a new measurement
+ * @param address Register address
+ * @param value The new value
+ */
+void VirtualIicRegisterDevice::setRegister(Size_t address, uint8_t value)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_registers[address % m_registers.size()] = value;
+}
+
+/**
+ * @brief Get a register from the device side
+ * @param address Register address
+ * @return uint8_t
+ */
+uint8_t VirtualIicRegisterDevice::getRegister(Size_t address)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_registers[address % m_registers.size()];
+}
+
+/**
+ * @brief Constructor, the bus starts empty
+ */
+VirtualIicBus::VirtualIicBus()
+{
+  for(VirtualIicDevice *&device : m_devices) { device = nullptr;}
+}
+
+/**
+ * @brief Attach a device to the bus, replaces any other at that address
+ * @param address 7 bit address
+ * @param device The device, must outlive the bus
+ */
+void VirtualIicBus::attach(uint16_t address, VirtualIicDevice &device)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if(address < 128) { m_devices[address] = &device;}
+}
+
+/**
+ * @brief Remove the device at an address
+ * @param address 7 bit address
+ */
+void VirtualIicBus::detach(uint16_t address)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if(address < 128) { m_devices[address] = nullptr;}
+}
+
+/**
+ * @brief Read from the device at an address
+ * @param address 7 bit address
+ * @param data Buffer to store the data
+ * @param byte_count Number of bytes to read
+ * @return Status_t
+ */
+Status_t VirtualIicBus::read(uint16_t address, uint8_t *data, Size_t byte_count)
+{
+  VirtualIicDevice *device = getDevice(address);
+
+  // The address byte is clocked whether someone answers or not
+  delay(byte_count + 1);
+  if(device == nullptr)
+  {
+    Status_t status;
+    SET_STATUS(status, false, SRC_DRIVER, ERR_FAILED, (char *)"No device acknowledged the address.\r\n");
+    return status;
+  }
+  return device->read(data, byte_count);
+}
+
+/**
+ * @brief Write to the device at an address
+ * @param address 7 bit address
+ * @param data Data to write
+ * @param byte_count Number of bytes to write
+ * @return Status_t
+ */
+Status_t VirtualIicBus::write(uint16_t address, const uint8_t *data, Size_t byte_count)
+{
+  VirtualIicDevice *device = getDevice(address);
+
+  delay(byte_count + 1);
+  if(device == nullptr)
+  {
+    Status_t status;
+    SET_STATUS(status, false, SRC_DRIVER, ERR_FAILED, (char *)"No device acknowledged the address.\r\n");
+    return status;
+  }
+  return device->write(data, byte_count);
+}
+
+/**
+ * @brief Find the device at an address
+ * @param address 7 bit address
+ * @return VirtualIicDevice* or nullptr
+ */
+VirtualIicDevice* VirtualIicBus::getDevice(uint16_t address)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return address < 128 ? m_devices[address] : nullptr;
+}
@@ -0,0 +1,86 @@
+/**
+ * @file virtual_iic.hpp
+ * @author your name (you@domain.com)
+ * @brief Emulated IIC bus and register mapped devices
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef DRIVERS_LINUX_VIRTUAL_VIRTUAL_IIC_HPP
+#define DRIVERS_LINUX_VIRTUAL_VIRTUAL_IIC_HPP
+
+#include <mutex>
+#include <vector>
+
+#include "linux/virtual/virtual_backend.hpp"
+
+/**
+ * @brief Target attached to a VirtualIicBus
+ */
+class VirtualIicDevice
+{
+public:
+  virtual ~VirtualIicDevice() {}
+
+  virtual Status_t read(uint8_t *data, Size_t byte_count) = 0;
+
+  virtual Status_t write(const uint8_t *data, Size_t byte_count) = 0;
+};
+
+/**
+ * @brief Device exposing a bank of registers, like most sensors and EEPROMs
+ *
+ * @note A write starts with the register address, sent MSB first, and any
+ *       byte after it is stored. Reads continue from the last register
+ *       address. The address auto-increments and wraps around the bank.
+ */
+class VirtualIicRegisterDevice : public VirtualIicDevice
+{
+public:
+  VirtualIicRegisterDevice(Size_t register_count = 256, uint8_t address_size = 1);
+
+  Status_t read(uint8_t *data, Size_t byte_count) override;
+
+  Status_t write(const uint8_t *data, Size_t byte_count) override;
+
+  void setRegister(Size_t address, uint8_t value);
+
+  uint8_t getRegister(Size_t address);
+
+private:
+  std::mutex m_mutex;
+  std::vector<uint8_t> m_registers;
+  Size_t m_pointer;
+  uint8_t m_address_size;
+};
+
+/**
+ * @brief Bus routing requests to the device attached at the address
+ *
+ * @note Requests to an address with no device fail as a NACK does on
+ *       hardware.
+ */
+class VirtualIicBus : public VirtualIicBackend
+{
+public:
+  VirtualIicBus();
+
+  void attach(uint16_t address, VirtualIicDevice &device);
+
+  void detach(uint16_t address);
+
+  Status_t read(uint16_t address, uint8_t *data, Size_t byte_count) override;
+
+  Status_t write(uint16_t address, const uint8_t *data, Size_t byte_count) override;
+
+private:
+  VirtualIicDevice* getDevice(uint16_t address);
+
+  std::mutex m_mutex;
+  VirtualIicDevice *m_devices[128];
+};
+
+#endif /* DRIVERS_LINUX_VIRTUAL_VIRTUAL_IIC_HPP */
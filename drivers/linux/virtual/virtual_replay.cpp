@@ -0,0 +1,332 @@
+/**
+ * @file virtual_replay.cpp
+ * @author your name (you@domain.com)
+ * @brief Devices answering with traffic captured by DriverRecorder
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "linux/virtual/virtual_replay.hpp"
+
+#include <string.h>
+#include <unistd.h>
+#include <poll.h>
+#include <pty.h>
+#include <termios.h>
+
+#include "driver_base/driver_trace.hpp"
+
+// Longest time the UART feeder sleeps before checking for a stop request
+constexpr int REPLAY_POLL_MS = 10;
+
+/**
+ * @brief Status returned when a device is asked for more than was captured
+ * @return Status_t
+ */
+static Status_t getEndOfRecording()
+{
+  Status_t status;
+  SET_STATUS(status, false, SRC_DRIVER, ERR_FAILED, (char *)"The recording has no more data for this driver.\r\n");
+  return status;
+}
+
+/**
+ * @brief Constructor
+ * @param recording The log, must outlive the replay
+ * @param speed Replay speed, 1 for the recorded timing, 0 to not wait
+ */
+VirtualReplay::VirtualReplay(const DriverRecording &recording, double speed) : m_records(recording.getRecords())
+{
+  m_first_timestamp = m_records.empty() ? 0 : m_records.front().timestamp;
+  m_speed = speed > 0 ? speed : 0;
+  m_start = std::chrono::steady_clock::now();
+}
+
+/**
+ * @brief Change the replay speed, call before start()
+ * @param speed Replay speed, 1 for the recorded timing, 0 to not wait
+ */
+void VirtualReplay::setSpeed(double speed)
+{
+  m_speed = speed > 0 ? speed : 0;
+}
+
+/**
+ * @brief Start the clock, the first record is due now
+ */
+void VirtualReplay::start()
+{
+  m_start = std::chrono::steady_clock::now();
+}
+
+/**
+ * @brief Find the next record of a driver
+ * @param driver_id Id of the driver in the capture
+ * @param direction Kind of record
+ * @param cursor Index to search from, moved past the record found
+ * @return const DriverRecord_t* or nullptr at the end of the recording
+ */
+const DriverRecord_t* VirtualReplay::next(uint16_t driver_id, DriverRecordDirection_t direction, Size_t &cursor)
+{
+  for(; cursor < (Size_t) m_records.size(); cursor++)
+  {
+    if(m_records[cursor].driver_id == driver_id && m_records[cursor].direction == direction)
+    {
+      return &m_records[cursor++];
+    }
+  }
+  return nullptr;
+}
+
+/**
+ * @brief Get the time a record is due
+ * @param record The record
+ * @return std::chrono::steady_clock::time_point
+ */
+std::chrono::steady_clock::time_point VirtualReplay::getDueTime(const DriverRecord_t &record)
+{
+  if(m_speed == 0 || record.timestamp < m_first_timestamp) { return m_start;}
+  return m_start + std::chrono::nanoseconds((uint64_t) ((record.timestamp - m_first_timestamp) / m_speed));
+}
+
+/**
+ * @brief Sleep until a record is due
+ * @param record The record
+ */
+void VirtualReplay::waitFor(const DriverRecord_t &record)
+{
+  std::this_thread::sleep_until(getDueTime(record));
+}
+
+/**
+ * @brief Turn the edges of a DIO into a script for VirtualDioLine, play it
+ *        right after start()
+ * @param driver_id Id of the DIO in the capture
+ * @param steps The script
+ * @return Status_t
+ */
+Status_t VirtualReplay::getDioScript(uint16_t driver_id, std::vector<VirtualDioStep_t> &steps)
+{
+  uint64_t previous = m_first_timestamp;
+  Size_t cursor = 0;
+  const DriverRecord_t *record;
+
+  steps.clear();
+  while((record = next(driver_id, DRIVER_RECORD_EDGE, cursor)) != nullptr)
+  {
+    uint32_t delay_us = m_speed == 0 ? 0 : (uint32_t) ((record->timestamp - previous) / 1000 / m_speed);
+    steps.push_back({delay_us, record->data[0] != 0});
+    previous = record->timestamp;
+  }
+  return steps.empty() ? getEndOfRecording() : STATUS_DRV_SUCCESS;
+}
+
+/**
+ * @brief Constructor
+ * @param replay The replay
+ * @param driver_id Id of the SPI driver in the capture
+ */
+VirtualSpiReplay::VirtualSpiReplay(VirtualReplay &replay, uint16_t driver_id) : m_replay(replay)
+{
+  m_driver_id = driver_id;
+  m_read_cursor = 0;
+  m_write_cursor = 0;
+}
+
+/**
+ * @brief Answer with the next recorded reception
+ * @param tx_data Data sent, ignored
+ * @param rx_data Buffer to store the recorded data, can be nullptr
+ * @param byte_count Number of bytes
+ * @return Status_t
+ */
+Status_t VirtualSpiReplay::transfer(const uint8_t *tx_data, uint8_t *rx_data, Size_t byte_count)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  const DriverRecord_t *record = nullptr;
+
+  delay(byte_count);
+  if(tx_data != nullptr) { record = m_replay.next(m_driver_id, DRIVER_RECORD_WRITE, m_write_cursor);}
+  if(rx_data == nullptr)
+  {
+    // Writes only set the pace, running out of them is not an error
+    if(tx_data != nullptr && record != nullptr) { m_replay.waitFor(*record);}
+    return STATUS_DRV_SUCCESS;
+  }
+
+  record = m_replay.next(m_driver_id, DRIVER_RECORD_READ, m_read_cursor);
+  if(record == nullptr) { return getEndOfRecording();}
+  m_replay.waitFor(*record);
+  memset(rx_data, 0xFF, byte_count);
+  memcpy(rx_data, record->data.data(), (Size_t) record->data.size() < byte_count ? (Size_t) record->data.size() : byte_count);
+  return STATUS_DRV_SUCCESS;
+}
+
+/**
+ * @brief Constructor
+ * @param replay The replay
+ * @param driver_id Id of the IIC driver in the capture
+ */
+VirtualIicReplay::VirtualIicReplay(VirtualReplay &replay, uint16_t driver_id) : m_replay(replay)
+{
+  m_driver_id = driver_id;
+  m_read_cursor = 0;
+  m_write_cursor = 0;
+}
+
+/**
+ * @brief Answer with the next recorded reception
+ * @param address Ignored, the capture is per driver
+ * @param data Buffer to store the data
+ * @param byte_count Number of bytes to read
+ * @return Status_t
+ */
+Status_t VirtualIicReplay::read(uint16_t address, uint8_t *data, Size_t byte_count)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  const DriverRecord_t *record;
+
+  (void) address;
+  delay(byte_count + 1);
+  record = m_replay.next(m_driver_id, DRIVER_RECORD_READ, m_read_cursor);
+  if(record == nullptr) { return getEndOfRecording();}
+  m_replay.waitFor(*record);
+  memset(data, 0xFF, byte_count);
+  memcpy(data, record->data.data(), (Size_t) record->data.size() < byte_count ? (Size_t) record->data.size() : byte_count);
+  return STATUS_DRV_SUCCESS;
+}
+
+/**
+ * @brief Accept a write, held until the next recorded write is due
+ * @param address Ignored, the capture is per driver
+ * @param data Data to write
+ * @param byte_count Number of bytes to write
+ * @return Status_t
+ */
+Status_t VirtualIicReplay::write(uint16_t address, const uint8_t *data, Size_t byte_count)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  const DriverRecord_t *record;
+
+  (void) address;
+  (void) data;
+  delay(byte_count + 1);
+  record = m_replay.next(m_driver_id, DRIVER_RECORD_WRITE, m_write_cursor);
+  if(record != nullptr) { m_replay.waitFor(*record);}
+  return STATUS_DRV_SUCCESS;
+}
+
+/**
+ * @brief Constructor
+ * @param replay The replay
+ * @param driver_id Id of the UART or LinuxSerialFile in the capture
+ */
+VirtualUartReplay::VirtualUartReplay(VirtualReplay &replay, uint16_t driver_id) : m_replay(replay)
+{
+  m_thread = nullptr;
+  m_terminate = false;
+  m_is_done = false;
+  m_driver_id = driver_id;
+  m_master = -1;
+  m_slave = -1;
+  m_name[0] = '\0';
+}
+
+/**
+ * @brief Destructor
+ */
+VirtualUartReplay::~VirtualUartReplay()
+{
+  stop();
+}
+
+/**
+ * @brief Open the pseudo-terminal and start feeding it, call after
+ *        VirtualReplay::start()
+ * @return Status_t
+ */
+Status_t VirtualUartReplay::start()
+{
+  struct termios termios_structure;
+  Status_t status;
+
+  stop();
+  if(openpty(&m_master, &m_slave, m_name, nullptr, nullptr) < 0)
+  {
+    SET_STATUS(status, false, SRC_DRIVER, ERR_FAILED, (char *)"Failed to open a pseudo-terminal.\r\n");
+    return status;
+  }
+  // The slave stays open so that the master never sees a hang up
+  tcgetattr(m_slave, &termios_structure);
+  cfmakeraw(&termios_structure);
+  tcsetattr(m_slave, TCSANOW, &termios_structure);
+
+  m_terminate = false;
+  m_is_done = false;
+  m_thread = new std::thread(&VirtualUartReplay::feedThread, this);
+  return STATUS_DRV_SUCCESS;
+}
+
+/**
+ * @brief Stop feeding and close the pseudo-terminal
+ */
+void VirtualUartReplay::stop()
+{
+  if(m_thread != nullptr)
+  {
+    m_terminate = true;
+    m_thread->join();
+    delete m_thread;
+    m_thread = nullptr;
+  }
+  if(m_master >= 0) { close(m_master);}
+  if(m_slave >= 0) { close(m_slave);}
+  m_master = -1;
+  m_slave = -1;
+}
+
+/**
+ * @brief Thread writing the recorded receptions when they are due, and
+ *        discarding what the driver sends in between
+ */
+void VirtualUartReplay::feedThread(void)
+{
+  struct pollfd fds = {m_master, POLLIN, 0};
+  const DriverRecord_t *record;
+  Size_t cursor = 0;
+  uint8_t discard[256];
+  int64_t remaining_ms;
+  Size_t written;
+  ssize_t ret;
+
+  DRIVER_TRACE_THREAD_NAME("uart_replay");
+  record = m_replay.next(m_driver_id, DRIVER_RECORD_READ, cursor);
+  m_is_done = record == nullptr;
+  while(!m_terminate)
+  {
+    remaining_ms = REPLAY_POLL_MS;
+    if(record != nullptr)
+    {
+      remaining_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        m_replay.getDueTime(*record) - std::chrono::steady_clock::now()).count();
+      if(remaining_ms > REPLAY_POLL_MS) { remaining_ms = REPLAY_POLL_MS;}
+    }
+    if(remaining_ms > 0 && poll(&fds, 1, (int) remaining_ms) > 0)
+    {
+      (void) ::read(m_master, discard, sizeof(discard));
+      continue;
+    }
+    if(record == nullptr || std::chrono::steady_clock::now() < m_replay.getDueTime(*record)) { continue;}
+
+    for(written = 0; written < (Size_t) record->data.size() && !m_terminate; written += ret)
+    {
+      ret = ::write(m_master, record->data.data() + written, record->data.size() - written);
+      if(ret < 0) { ret = 0; std::this_thread::sleep_for(std::chrono::milliseconds(1));}
+    }
+    record = m_replay.next(m_driver_id, DRIVER_RECORD_READ, cursor);
+    if(record == nullptr) { m_is_done = true;}
+  }
+}
@@ -0,0 +1,133 @@
+/**
+ * @file virtual_replay.hpp
+ * @author your name (you@domain.com)
+ * @brief Devices answering with traffic captured by DriverRecorder
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef DRIVERS_LINUX_VIRTUAL_VIRTUAL_REPLAY_HPP
+#define DRIVERS_LINUX_VIRTUAL_VIRTUAL_REPLAY_HPP
+
+#include <limits.h>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+#include "driver_base/driver_recorder.hpp"
+#include "linux/virtual/virtual_backend.hpp"
+#include "linux/virtual/virtual_dio.hpp"
+
+/**
+ * @brief Shared clock of a replay, maps recorded timestamps to the time
+ *        they are due
+ *
+ * @note With a speed of 1 the recorded timing is reproduced, 2 replays twice
+ *       as fast and 0 does not wait at all.
+ */
+class VirtualReplay
+{
+public:
+  VirtualReplay(const DriverRecording &recording, double speed = 1.0);
+
+  void setSpeed(double speed);
+
+  void start();
+
+  const DriverRecord_t* next(uint16_t driver_id, DriverRecordDirection_t direction, Size_t &cursor);
+
+  void waitFor(const DriverRecord_t &record);
+
+  std::chrono::steady_clock::time_point getDueTime(const DriverRecord_t &record);
+
+  Status_t getDioScript(uint16_t driver_id, std::vector<VirtualDioStep_t> &steps);
+
+private:
+  const std::vector<DriverRecord_t> &m_records;
+  std::chrono::steady_clock::time_point m_start;
+  uint64_t m_first_timestamp;
+  double m_speed;
+};
+
+/**
+ * @brief SPI device returning the data a driver received during the capture
+ *
+ * @note Transfers are answered in the recorded order and held until their
+ *       recorded time, whatever is sent is accepted.
+ */
+class VirtualSpiReplay : public VirtualSpiBackend
+{
+public:
+  VirtualSpiReplay(VirtualReplay &replay, uint16_t driver_id);
+
+  Status_t transfer(const uint8_t *tx_data, uint8_t *rx_data, Size_t byte_count) override;
+
+private:
+  std::mutex m_mutex;
+  VirtualReplay &m_replay;
+  uint16_t m_driver_id;
+  Size_t m_read_cursor;
+  Size_t m_write_cursor;
+};
+
+/**
+ * @brief IIC bus returning the data a driver received during the capture,
+ *        whatever the address
+ */
+class VirtualIicReplay : public VirtualIicBackend
+{
+public:
+  VirtualIicReplay(VirtualReplay &replay, uint16_t driver_id);
+
+  Status_t read(uint16_t address, uint8_t *data, Size_t byte_count) override;
+
+  Status_t write(uint16_t address, const uint8_t *data, Size_t byte_count) override;
+
+private:
+  std::mutex m_mutex;
+  VirtualReplay &m_replay;
+  uint16_t m_driver_id;
+  Size_t m_read_cursor;
+  Size_t m_write_cursor;
+};
+
+/**
+ * @brief Pseudo-terminal whose peer sends what a serial driver received
+ *        during the capture, at the recorded time
+ *
+ * @note Give getName() to UART or LinuxSerialFile. What the driver writes is
+ *       discarded.
+ */
+class VirtualUartReplay
+{
+public:
+  VirtualUartReplay(VirtualReplay &replay, uint16_t driver_id);
+  ~VirtualUartReplay();
+
+  Status_t start();
+
+  void stop();
+
+  bool isDone() { return m_is_done;}
+
+  const char* getName() { return m_name;}
+
+private:
+  void feedThread(void);
+
+  VirtualReplay &m_replay;
+  std::thread *m_thread;
+  std::atomic<bool> m_terminate;
+  std::atomic<bool> m_is_done;
+  uint16_t m_driver_id;
+  int m_master;
+  int m_slave;
+  char m_name[PATH_MAX];
+};
+
+#endif /* DRIVERS_LINUX_VIRTUAL_VIRTUAL_REPLAY_HPP */
@@ -0,0 +1,159 @@
+/**
+ * @file virtual_spi.cpp
+ * @author your name (you@domain.com)
+ * @brief Emulated SPI devices: a loopback and a NOR flash
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "linux/virtual/virtual_spi.hpp"
+
+#include <string.h>
+
+constexpr uint32_t FLASH_PAGE_SIZE = 256;
+constexpr uint32_t FLASH_SECTOR_SIZE = 0x1000;
+constexpr uint32_t FLASH_BLOCK_SIZE = 0x10000;
+constexpr uint8_t FLASH_STATUS_WEL = 0x02;
+
+/**
+ * @brief Send and receive data, what is sent comes back
+ * @param tx_data Data to send, nullptr sends zeros
+ * @param rx_data Buffer to store what is received, can be nullptr
+ * @param byte_count Number of bytes
+ * @return Status_t
+ */
+Status_t VirtualSpiLoopback::transfer(const uint8_t *tx_data, uint8_t *rx_data, Size_t byte_count)
+{
+  delay(byte_count);
+  if(rx_data == nullptr) { return STATUS_DRV_SUCCESS;}
+  if(tx_data == nullptr)
+  {
+    memset(rx_data, 0, byte_count);
+  }else if(rx_data != tx_data)
+  {
+    memmove(rx_data, tx_data, byte_count);
+  }
+  return STATUS_DRV_SUCCESS;
+}
+
+/**
+ * @brief Constructor, the memory starts erased
+ * @param size Capacity in bytes, rounded up to a whole sector
+ * @param jedec_id Manufacturer and device id returned by 0x9F
+ */
+VirtualSpiFlash::VirtualSpiFlash(uint32_t size, uint32_t jedec_id)
+{
+  size = (size + FLASH_SECTOR_SIZE - 1) & ~(FLASH_SECTOR_SIZE - 1);
+  m_memory.assign(size, 0xFF);
+  m_jedec_id = jedec_id;
+  m_write_enabled = false;
+}
+
+/**
+ * @brief Run one command, the bytes clocked in while the command and address
+ *        are sent read as 0xFF
+ * @param tx_data Command, address and data to send
+ * @param rx_data Buffer to store what is received, can be nullptr
+ * @param byte_count Number of bytes
+ * @return Status_t
+ */
+Status_t VirtualSpiFlash::transfer(const uint8_t *tx_data, uint8_t *rx_data, Size_t byte_count)
+{
+  std::vector<uint8_t> ignored;
+  uint32_t address;
+  Size_t i;
+
+  delay(byte_count);
+  if(rx_data == nullptr)
+  {
+    ignored.resize(byte_count);
+    rx_data = ignored.data();
+  }
+  memset(rx_data, 0xFF, byte_count);
+  // Without a command the flash leaves MISO floating
+  if(tx_data == nullptr || byte_count == 0) { return STATUS_DRV_SUCCESS;}
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  switch(tx_data[0])
+  {
+    case 0x9F:
+      for(i = 1; i < byte_count && i < 4; i++) { rx_data[i] = (uint8_t) (m_jedec_id >> (8 * (3 - i)));}
+      break;
+    case 0x05:
+      for(i = 1; i < byte_count; i++) { rx_data[i] = m_write_enabled ? FLASH_STATUS_WEL : 0;}
+      break;
+    case 0x06:
+      m_write_enabled = true;
+      break;
+    case 0x04:
+      m_write_enabled = false;
+      break;
+    case 0x03:
+    case 0x0B:
+    {
+      Size_t header_size = tx_data[0] == 0x0B ? 5 : 4;
+      if(byte_count <= header_size) { break;}
+      address = getAddress(tx_data);
+      for(i = header_size; i < byte_count; i++)
+      {
+        rx_data[i] = m_memory[address];
+        address = (address + 1) % m_memory.size();
+      }
+      break;
+    }
+    case 0x02:
+      if(!m_write_enabled || byte_count < 4) { break;}
+      address = getAddress(tx_data);
+      // Programming wraps around inside the page
+      for(i = 4; i < byte_count; i++)
+      {
+        m_memory[address] &= tx_data[i];
+        address = (address & ~(FLASH_PAGE_SIZE - 1)) | ((address + 1) & (FLASH_PAGE_SIZE - 1));
+      }
+      m_write_enabled = false;
+      break;
+    case 0x20:
+    case 0xD8:
+      if(!m_write_enabled || byte_count < 4) { break;}
+      erase(getAddress(tx_data), tx_data[0] == 0x20 ? FLASH_SECTOR_SIZE : FLASH_BLOCK_SIZE);
+      m_write_enabled = false;
+      break;
+    case 0xC7:
+    case 0x60:
+      if(!m_write_enabled) { break;}
+      erase(0, m_memory.size());
+      m_write_enabled = false;
+      break;
+    default:
+      break;
+  }
+  return STATUS_DRV_SUCCESS;
+}
+
+/**
+ * @brief Set an aligned region back to 0xFF
+ * @param address Any address inside the region
+ * @param size Region size, a power of two
+ */
+void VirtualSpiFlash::erase(uint32_t address, uint32_t size)
+{
+  address &= ~(size - 1);
+  if(address >= m_memory.size()) { return;}
+  if(size > m_memory.size() - address) { size = m_memory.size() - address;}
+  memset(m_memory.data() + address, 0xFF, size);
+}
+
+/**
+ * @brief Decode the 3 byte address after the command, it wraps around the
+ *        capacity
+ * @param tx_data The command
+ * @return uint32_t
+ */
+uint32_t VirtualSpiFlash::getAddress(const uint8_t *tx_data)
+{
+  uint32_t address = ((uint32_t) tx_data[1] << 16) | ((uint32_t) tx_data[2] << 8) | tx_data[3];
+  return address % m_memory.size();
+}
@@ -0,0 +1,59 @@
+/**
+ * @file virtual_spi.hpp
+ * @author your name (you@domain.com)
+ * @brief Emulated SPI devices: a loopback and a NOR flash
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef DRIVERS_LINUX_VIRTUAL_VIRTUAL_SPI_HPP
+#define DRIVERS_LINUX_VIRTUAL_VIRTUAL_SPI_HPP
+
+#include <mutex>
+#include <vector>
+
+#include "linux/virtual/virtual_backend.hpp"
+
+/**
+ * @brief MISO wired to MOSI, every byte sent is received back
+ */
+class VirtualSpiLoopback : public VirtualSpiBackend
+{
+public:
+  Status_t transfer(const uint8_t *tx_data, uint8_t *rx_data, Size_t byte_count) override;
+};
+
+/**
+ * @brief Serial NOR flash with 3 byte addresses, 256 byte pages and 4 kB
+ *        sectors
+ *
+ * @note Supported commands are read id (0x9F), read status (0x05), write
+ *       enable/disable (0x06/0x04), read (0x03), fast read (0x0B), page
+ *       program (0x02), sector erase (0x20), block erase (0xD8) and chip
+ *       erase (0xC7/0x60). Programming only clears bits and needs a write
+ *       enable first, as on the real parts.
+ */
+class VirtualSpiFlash : public VirtualSpiBackend
+{
+public:
+  VirtualSpiFlash(uint32_t size = 0x100000, uint32_t jedec_id = 0xEF4014);
+
+  Status_t transfer(const uint8_t *tx_data, uint8_t *rx_data, Size_t byte_count) override;
+
+  const std::vector<uint8_t>& getMemory() { return m_memory;}
+
+private:
+  void erase(uint32_t address, uint32_t size);
+
+  uint32_t getAddress(const uint8_t *tx_data);
+
+  std::mutex m_mutex;
+  std::vector<uint8_t> m_memory;
+  uint32_t m_jedec_id;
+  bool m_write_enabled;
+};
+
+#endif /* DRIVERS_LINUX_VIRTUAL_VIRTUAL_SPI_HPP */
@@ -0,0 +1,744 @@
+/**
+ * @file checksum.cpp
+ * @author your name (you@domain.com)
+ * @brief CRC and checksum computation for frames
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "checksum.hpp"
+
+#include <string.h>
+
+#if CHECKSUM_USE_CPU_INSTRUCTIONS && (defined(__x86_64__) || defined(__i386__))
+#define CHECKSUM_HAS_X86_CRC 1
+#include <immintrin.h>
+#elif CHECKSUM_USE_CPU_INSTRUCTIONS && defined(__aarch64__) && defined(__linux__)
+#define CHECKSUM_HAS_ARM_CRC 1
+#include <arm_acle.h>
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#endif
+
+typedef uint32_t (*CrcFunction_t)(const uint8_t *data, size_t size, uint32_t crc);
+
+// Longest run summed before reducing the Fletcher sums, keeps sum2 in 32 bits
+constexpr size_t FLETCHER_BLOCK_SIZE = 4096;
+
+/**
+ * @brief Lookup tables of a CRC, table[k][b] is the CRC of byte b followed
+ *        by k zero bytes
+ */
+template <typename T>
+struct CrcTables_t
+{
+  T table[8][256];
+};
+
+/**
+ * @brief Build the tables of a reflected CRC
+ * @param polynomial Reversed polynomial, e.g. 0xEDB88320 for CRC32
+ * @return CrcTables_t<T>
+ */
+template <typename T>
+static constexpr CrcTables_t<T> makeReflectedTables(T polynomial)
+{
+  CrcTables_t<T> tables = {};
+
+  for(uint32_t b = 0; b < 256; b++)
+  {
+    T crc = (T) b;
+    for(int bit = 0; bit < 8; bit++) { crc = (crc & 1) ? (T) ((crc >> 1) ^ polynomial) : (T) (crc >> 1);}
+    tables.table[0][b] = crc;
+  }
+  for(uint32_t b = 0; b < 256; b++)
+  {
+    for(int k = 1; k < 8; k++)
+    {
+      T previous = tables.table[k - 1][b];
+      tables.table[k][b] = (T) ((previous >> 8) ^ tables.table[0][previous & 0xFF]);
+    }
+  }
+  return tables;
+}
+
+/**
+ * @brief Build the table of a CRC processed most significant bit first
+ * @param polynomial The polynomial, e.g. 0x1021 for CRC16-CCITT
+ * @return CrcTables_t<T>, only table[0] is used
+ */
+template <typename T>
+static constexpr CrcTables_t<T> makeForwardTable(T polynomial)
+{
+  CrcTables_t<T> tables = {};
+  constexpr T top_bit = (T) 1 << (sizeof(T) * 8 - 1);
+
+  for(uint32_t b = 0; b < 256; b++)
+  {
+    T crc = (T) ((T) b << (sizeof(T) * 8 - 8));
+    for(int bit = 0; bit < 8; bit++) { crc = (crc & top_bit) ? (T) ((crc << 1) ^ polynomial) : (T) (crc << 1);}
+    tables.table[0][b] = crc;
+  }
+  return tables;
+}
+
+static constexpr CrcTables_t<uint8_t> s_crc8 = makeForwardTable<uint8_t>(0x07);
+static constexpr CrcTables_t<uint16_t> s_crc16_ccitt = makeForwardTable<uint16_t>(0x1021);
+static constexpr CrcTables_t<uint16_t> s_crc16_modbus = makeReflectedTables<uint16_t>(0xA001);
+static constexpr CrcTables_t<uint16_t> s_crc16_x25 = makeReflectedTables<uint16_t>(0x8408);
+static constexpr CrcTables_t<uint32_t> s_crc32 = makeReflectedTables<uint32_t>(0xEDB88320);
+static constexpr CrcTables_t<uint32_t> s_crc32c = makeReflectedTables<uint32_t>(0x82F63B78);
+
+static inline uint32_t load32(const uint8_t *data)
+{
+  uint32_t value;
+  memcpy(&value, data, sizeof(value));
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  value = __builtin_bswap32(value);
+#endif
+  return value;
+}
+
+/**
+ * @brief Reflected CRC with slicing-by-8, 8 bytes per step with no
+ *        dependency between the lookups of a step
+ * @param tables Tables of the CRC
+ * @param data Bytes to process
+ * @param size Number of bytes
+ * @param crc CRC register, not inverted
+ * @return The CRC register
+ */
+template <typename T>
+static inline T crcSlicing(const CrcTables_t<T> &tables, const uint8_t *data, size_t size, T crc)
+{
+  const auto &t = tables.table;
+
+  while(size >= 8)
+  {
+    // The register is at most 32 bits wide, it only meets the first 4 bytes
+    uint32_t one = load32(data) ^ crc;
+    uint32_t two = load32(data + 4);
+    crc = (T) (t[7][one & 0xFF] ^ t[6][(one >> 8) & 0xFF] ^ t[5][(one >> 16) & 0xFF] ^ t[4][one >> 24]
+             ^ t[3][two & 0xFF] ^ t[2][(two >> 8) & 0xFF] ^ t[1][(two >> 16) & 0xFF] ^ t[0][two >> 24]);
+    data += 8;
+    size -= 8;
+  }
+  while(size-- != 0) { crc = (T) ((crc >> 8) ^ t[0][(crc ^ *data++) & 0xFF]);}
+  return crc;
+}
+
+static uint32_t crc32Table(const uint8_t *data, size_t size, uint32_t crc)
+{
+  return crcSlicing<uint32_t>(s_crc32, data, size, crc);
+}
+
+static uint32_t crc32cTable(const uint8_t *data, size_t size, uint32_t crc)
+{
+  return crcSlicing<uint32_t>(s_crc32c, data, size, crc);
+}
+
+#if defined(CHECKSUM_HAS_X86_CRC)
+
+// Below this the setup of the folding costs more than the tables
+constexpr size_t CRC32_FOLD_SIZE_MIN = 64;
+
+/**
+ * @brief CRC32C with the SSE 4.2 instruction, 8 bytes per instruction
+ * @param data Bytes to process
+ * @param size Number of bytes
+ * @param crc CRC register, not inverted
+ * @return The CRC register
+ */
+__attribute__((target("sse4.2")))
+static uint32_t crc32cSse42(const uint8_t *data, size_t size, uint32_t crc)
+{
+  uint64_t crc64;
+  uint64_t value;
+
+  while(size != 0 && ((uintptr_t) data & 7) != 0)
+  {
+    crc = _mm_crc32_u8(crc, *data++);
+    size--;
+  }
+  crc64 = crc;
+  while(size >= 8)
+  {
+    memcpy(&value, data, sizeof(value));
+    crc64 = _mm_crc32_u64(crc64, value);
+    data += 8;
+    size -= 8;
+  }
+  crc = (uint32_t) crc64;
+  while(size-- != 0) { crc = _mm_crc32_u8(crc, *data++);}
+  return crc;
+}
+
+/**
+ * @brief CRC32 by folding 64 bytes per step with carry-less multiplications,
+ *        then a Barrett reduction, after Intel's "Fast CRC Computation for
+ *        Generic Polynomials Using PCLMULQDQ Instruction"
+ * @param data Bytes to process, at least 64 and a multiple of 16
+ * @param size Number of bytes
+ * @param crc CRC register, not inverted
+ * @return The CRC register
+ */
+__attribute__((target("sse4.2,pclmul")))
+static uint32_t crc32FoldPclmul(const uint8_t *data, size_t size, uint32_t crc)
+{
+  // x^(4*128+32) mod P and x^(4*128-32) mod P, bit reflected
+  const __m128i k1k2 = _mm_set_epi64x(0x01c6e41596, 0x0154442bd4);
+  // x^(128+32) mod P and x^(128-32) mod P
+  const __m128i k3k4 = _mm_set_epi64x(0x00ccaa009e, 0x01751997d0);
+  // x^64 mod P
+  const __m128i k5k0 = _mm_set_epi64x(0x0000000000, 0x0163cd6124);
+  // P and the Barrett constant floor(x^64 / P)
+  const __m128i poly = _mm_set_epi64x(0x01f7011641, 0x01db710641);
+  const __m128i mask32 = _mm_setr_epi32(~0, 0, ~0, 0);
+  __m128i x1, x2, x3, x4, x5, x6, x7, x8;
+
+  x1 = _mm_loadu_si128((const __m128i *) (data + 0x00));
+  x2 = _mm_loadu_si128((const __m128i *) (data + 0x10));
+  x3 = _mm_loadu_si128((const __m128i *) (data + 0x20));
+  x4 = _mm_loadu_si128((const __m128i *) (data + 0x30));
+  x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128((int) crc));
+  data += 64;
+  size -= 64;
+
+  // Four independent lanes keep the multiplier busy
+  while(size >= 64)
+  {
+    x5 = _mm_clmulepi64_si128(x1, k1k2, 0x00);
+    x6 = _mm_clmulepi64_si128(x2, k1k2, 0x00);
+    x7 = _mm_clmulepi64_si128(x3, k1k2, 0x00);
+    x8 = _mm_clmulepi64_si128(x4, k1k2, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, k1k2, 0x11);
+    x2 = _mm_clmulepi64_si128(x2, k1k2, 0x11);
+    x3 = _mm_clmulepi64_si128(x3, k1k2, 0x11);
+    x4 = _mm_clmulepi64_si128(x4, k1k2, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), _mm_loadu_si128((const __m128i *) (data + 0x00)));
+    x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), _mm_loadu_si128((const __m128i *) (data + 0x10)));
+    x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), _mm_loadu_si128((const __m128i *) (data + 0x20)));
+    x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), _mm_loadu_si128((const __m128i *) (data + 0x30)));
+    data += 64;
+    size -= 64;
+  }
+
+  // Fold the four lanes into one
+  x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+  x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+  x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+  x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+  x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+  x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+  x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+  x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+  x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+
+  while(size >= 16)
+  {
+    x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, _mm_loadu_si128((const __m128i *) data)), x5);
+    data += 16;
+    size -= 16;
+  }
+
+  // 128 bits down to 64
+  x2 = _mm_clmulepi64_si128(x1, k3k4, 0x10);
+  x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+  x2 = _mm_srli_si128(x1, 4);
+  x1 = _mm_and_si128(x1, mask32);
+  x1 = _mm_clmulepi64_si128(x1, k5k0, 0x00);
+  x1 = _mm_xor_si128(x1, x2);
+
+  // Barrett reduction down to 32
+  x2 = _mm_and_si128(x1, mask32);
+  x2 = _mm_clmulepi64_si128(x2, poly, 0x10);
+  x2 = _mm_and_si128(x2, mask32);
+  x2 = _mm_clmulepi64_si128(x2, poly, 0x00);
+  x1 = _mm_xor_si128(x1, x2);
+  return (uint32_t) _mm_extract_epi32(x1, 1);
+}
+
+static uint32_t crc32Pclmul(const uint8_t *data, size_t size, uint32_t crc)
+{
+  size_t folded_size;
+
+  if(size >= CRC32_FOLD_SIZE_MIN)
+  {
+    folded_size = size & ~(size_t) 15;
+    crc = crc32FoldPclmul(data, folded_size, crc);
+    data += folded_size;
+    size -= folded_size;
+  }
+  return crc32Table(data, size, crc);
+}
+
+static CrcFunction_t selectCrc32()
+{
+  __builtin_cpu_init();
+  if(__builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse4.2")) { return crc32Pclmul;}
+  return crc32Table;
+}
+
+static CrcFunction_t selectCrc32c()
+{
+  __builtin_cpu_init();
+  if(__builtin_cpu_supports("sse4.2")) { return crc32cSse42;}
+  return crc32cTable;
+}
+
+#elif defined(CHECKSUM_HAS_ARM_CRC)
+
+/**
+ * @brief CRC32 with the ARMv8 CRC extension, 8 bytes per instruction
+ * @param data Bytes to process
+ * @param size Number of bytes
+ * @param crc CRC register, not inverted
+ * @return The CRC register
+ */
+__attribute__((target("+crc")))
+static uint32_t crc32Armv8(const uint8_t *data, size_t size, uint32_t crc)
+{
+  uint64_t value;
+
+  while(size != 0 && ((uintptr_t) data & 7) != 0)
+  {
+    crc = __crc32b(crc, *data++);
+    size--;
+  }
+  while(size >= 8)
+  {
+    memcpy(&value, data, sizeof(value));
+    crc = __crc32d(crc, value);
+    data += 8;
+    size -= 8;
+  }
+  while(size-- != 0) { crc = __crc32b(crc, *data++);}
+  return crc;
+}
+
+/**
+ * @brief CRC32C with the ARMv8 CRC extension, 8 bytes per instruction
+ * @param data Bytes to process
+ * @param size Number of bytes
+ * @param crc CRC register, not inverted
+ * @return The CRC register
+ */
+__attribute__((target("+crc")))
+static uint32_t crc32cArmv8(const uint8_t *data, size_t size, uint32_t crc)
+{
+  uint64_t value;
+
+  while(size != 0 && ((uintptr_t) data & 7) != 0)
+  {
+    crc = __crc32cb(crc, *data++);
+    size--;
+  }
+  while(size >= 8)
+  {
+    memcpy(&value, data, sizeof(value));
+    crc = __crc32cd(crc, value);
+    data += 8;
+    size -= 8;
+  }
+  while(size-- != 0) { crc = __crc32cb(crc, *data++);}
+  return crc;
+}
+
+static CrcFunction_t selectCrc32()
+{
+  if((getauxval(AT_HWCAP) & HWCAP_CRC32) != 0) { return crc32Armv8;}
+  return crc32Table;
+}
+
+static CrcFunction_t selectCrc32c()
+{
+  if((getauxval(AT_HWCAP) & HWCAP_CRC32) != 0) { return crc32cArmv8;}
+  return crc32cTable;
+}
+
+#else
+
+static CrcFunction_t selectCrc32() { return crc32Table;}
+
+static CrcFunction_t selectCrc32c() { return crc32cTable;}
+
+#endif
+
+// Chosen once, on first use, from what the CPU running the program supports
+static CrcFunction_t getCrc32()
+{
+  static const CrcFunction_t function = selectCrc32();
+  return function;
+}
+
+static CrcFunction_t getCrc32c()
+{
+  static const CrcFunction_t function = selectCrc32c();
+  return function;
+}
+
+static uint8_t sum8(const uint8_t *data, Size_t size)
+{
+  uint8_t sum = 0;
+  for(Size_t i = 0; i < size; i++) { sum += data[i];}
+  return sum;
+}
+
+static uint8_t xor8(const uint8_t *data, Size_t size)
+{
+  uint8_t value = 0;
+  for(Size_t i = 0; i < size; i++) { value ^= data[i];}
+  return value;
+}
+
+static uint16_t fletcher16(const uint8_t *data, Size_t size)
+{
+  uint32_t sum1 = 0, sum2 = 0;
+  size_t block_size;
+
+  // The modulo is taken once per block instead of once per byte
+  while(size > 0)
+  {
+    block_size = (size_t) size < FLETCHER_BLOCK_SIZE ? (size_t) size : FLETCHER_BLOCK_SIZE;
+    for(size_t i = 0; i < block_size; i++)
+    {
+      sum1 += data[i];
+      sum2 += sum1;
+    }
+    sum1 %= 255;
+    sum2 %= 255;
+    data += block_size;
+    size -= (Size_t) block_size;
+  }
+  return (uint16_t) ((sum2 << 8) | sum1);
+}
+
+/**
+ * @brief Compute the checksum of a block
+ * @param type The checksum
+ * @param data Bytes to process
+ * @param size Number of bytes
+ * @return The checksum, 0 for CHECKSUM_NONE
+ */
+uint32_t Checksum::compute(ChecksumType_t type, const uint8_t *data, Size_t size)
+{
+  switch(type)
+  {
+    case CHECKSUM_SUM8: return sum8(data, size);
+    case CHECKSUM_XOR8: return xor8(data, size);
+    case CHECKSUM_FLETCHER16: return fletcher16(data, size);
+    case CHECKSUM_CRC8: return crc8(data, size);
+    case CHECKSUM_CRC16_MODBUS: return crc16Modbus(data, size);
+    case CHECKSUM_CRC16_CCITT: return crc16Ccitt(data, size);
+    case CHECKSUM_CRC16_X25: return crc16X25(data, size);
+    case CHECKSUM_CRC32: return crc32(data, size);
+    case CHECKSUM_CRC32C: return crc32c(data, size);
+    default: return 0;
+  }
+}
+
+/**
+ * @brief Get the number of bytes a checksum takes on a frame
+ * @param type The checksum
+ * @return uint8_t
+ */
+uint8_t Checksum::getSize(ChecksumType_t type)
+{
+  switch(type)
+  {
+    case CHECKSUM_SUM8:
+    case CHECKSUM_XOR8:
+    case CHECKSUM_CRC8:
+      return 1;
+    case CHECKSUM_FLETCHER16:
+    case CHECKSUM_CRC16_MODBUS:
+    case CHECKSUM_CRC16_CCITT:
+    case CHECKSUM_CRC16_X25:
+      return 2;
+    case CHECKSUM_CRC32:
+    case CHECKSUM_CRC32C:
+      return 4;
+    default:
+      return 0;
+  }
+}
+
+/**
+ * @brief Tell if a checksum is sent least significant byte first
+ * @param type The checksum
+ * @return true for the reflected CRCs
+ */
+static bool isLittleEndian(ChecksumType_t type)
+{
+  return type == CHECKSUM_CRC16_MODBUS || type == CHECKSUM_CRC16_X25 || type == CHECKSUM_CRC32 || type == CHECKSUM_CRC32C;
+}
+
+/**
+ * @brief Write the checksum of a frame right after it
+ * @param type The checksum
+ * @param frame The frame, with getSize() bytes of room after it
+ * @param size Number of bytes of the frame
+ * @return Size of the frame with its checksum
+ */
+Size_t Checksum::append(ChecksumType_t type, uint8_t *frame, Size_t size)
+{
+  return size + getTrailer(type, frame, size, frame + size);
+}
+
+/**
+ * @brief Write the checksum of data elsewhere, in the byte order it is sent
+ * @param type The checksum
+ * @param data The data
+ * @param size Number of bytes of the data
+ * @param trailer Storage of CHECKSUM_SIZE_MAX bytes
+ * @return uint8_t Number of bytes written, 0 for CHECKSUM_NONE
+ */
+uint8_t Checksum::getTrailer(ChecksumType_t type, const uint8_t *data, Size_t size, uint8_t *trailer)
+{
+  uint8_t checksum_size = getSize(type);
+  uint32_t value;
+
+  if(checksum_size == 0) { return 0;}
+  value = compute(type, data, size);
+  for(uint8_t i = 0; i < checksum_size; i++)
+  {
+    trailer[i] = isLittleEndian(type) ? (uint8_t) (value >> (8 * i)) : (uint8_t) (value >> (8 * (checksum_size - 1 - i)));
+  }
+  return checksum_size;
+}
+
+/**
+ * @brief Check the checksum at the end of a frame
+ * @param type The checksum
+ * @param frame The frame followed by its checksum
+ * @param size Number of bytes of the frame with its checksum
+ * @return true if the checksum matches
+ */
+bool Checksum::verify(ChecksumType_t type, const uint8_t *frame, Size_t size)
+{
+  uint8_t checksum_size = getSize(type);
+  uint32_t value = 0;
+
+  if(size < checksum_size) { return false;}
+  size -= checksum_size;
+  for(uint8_t i = 0; i < checksum_size; i++)
+  {
+    if(isLittleEndian(type))
+    {
+      value |= (uint32_t) frame[size + i] << (8 * i);
+    }else
+    {
+      value = (value << 8) | frame[size + i];
+    }
+  }
+  return compute(type, frame, size) == value;
+}
+
+/**
+ * @brief CRC8 with polynomial 0x07, the SMBus packet error code
+ * @param data Bytes to process
+ * @param size Number of bytes
+ * @param crc Result of the previous block, 0 for the first
+ * @return uint8_t
+ */
+uint8_t Checksum::crc8(const uint8_t *data, Size_t size, uint8_t crc)
+{
+  for(Size_t i = 0; i < size; i++) { crc = s_crc8.table[0][crc ^ data[i]];}
+  return crc;
+}
+
+/**
+ * @brief CRC16 of Modbus RTU
+ * @param data Bytes to process
+ * @param size Number of bytes
+ * @param crc Result of the previous block, 0xFFFF for the first
+ * @return uint16_t
+ */
+uint16_t Checksum::crc16Modbus(const uint8_t *data, Size_t size, uint16_t crc)
+{
+  return crcSlicing<uint16_t>(s_crc16_modbus, data, (size_t) size, crc);
+}
+
+/**
+ * @brief CRC16-CCITT processed most significant bit first, CCITT-FALSE with
+ *        the default start
+ * @param data Bytes to process
+ * @param size Number of bytes
+ * @param crc Result of the previous block, 0xFFFF for the first
+ * @return uint16_t
+ */
+uint16_t Checksum::crc16Ccitt(const uint8_t *data, Size_t size, uint16_t crc)
+{
+  for(Size_t i = 0; i < size; i++) { crc = (uint16_t) ((crc << 8) ^ s_crc16_ccitt.table[0][(crc >> 8) ^ data[i]]);}
+  return crc;
+}
+
+/**
+ * @brief CRC16 X.25, the frame check sequence of HDLC and PPP
+ * @param data Bytes to process
+ * @param size Number of bytes
+ * @param crc Result of the previous block, 0 for the first
+ * @return uint16_t
+ */
+uint16_t Checksum::crc16X25(const uint8_t *data, Size_t size, uint16_t crc)
+{
+  return (uint16_t) ~crcSlicing<uint16_t>(s_crc16_x25, data, (size_t) size, (uint16_t) ~crc);
+}
+
+/**
+ * @brief CRC32 of Ethernet, zlib and PNG
+ * @param data Bytes to process
+ * @param size Number of bytes
+ * @param crc Result of the previous block, 0 for the first
+ * @return uint32_t
+ */
+uint32_t Checksum::crc32(const uint8_t *data, Size_t size, uint32_t crc)
+{
+  return ~getCrc32()(data, (size_t) size, ~crc);
+}
+
+/**
+ * @brief CRC32C of iSCSI, ext4 and SCTP
+ * @param data Bytes to process
+ * @param size Number of bytes
+ * @param crc Result of the previous block, 0 for the first
+ * @return uint32_t
+ */
+uint32_t Checksum::crc32c(const uint8_t *data, Size_t size, uint32_t crc)
+{
+  return ~getCrc32c()(data, (size_t) size, ~crc);
+}
+
+/**
+ * @brief Tell how a checksum is computed on this CPU
+ * @param type The checksum
+ * @return Name of the implementation
+ */
+const char *Checksum::getImplementation(ChecksumType_t type)
+{
+  switch(type)
+  {
+    case CHECKSUM_NONE:
+      return "none";
+    case CHECKSUM_CRC16_MODBUS:
+    case CHECKSUM_CRC16_X25:
+      return "slicing-by-8";
+    case CHECKSUM_CRC32:
+#if defined(CHECKSUM_HAS_X86_CRC)
+      if(getCrc32() == crc32Pclmul) { return "pclmulqdq";}
+#elif defined(CHECKSUM_HAS_ARM_CRC)
+      if(getCrc32() == crc32Armv8) { return "armv8-crc";}
+#endif
+      return "slicing-by-8";
+    case CHECKSUM_CRC32C:
+#if defined(CHECKSUM_HAS_X86_CRC)
+      if(getCrc32c() == crc32cSse42) { return "sse4.2";}
+#elif defined(CHECKSUM_HAS_ARM_CRC)
+      if(getCrc32c() == crc32cArmv8) { return "armv8-crc";}
+#endif
+      return "slicing-by-8";
+    default:
+      return "bytewise";
+  }
+}
+
+/**
+ * @brief Constructor, no checksum until one is configured
+ */
+FrameChecksum::FrameChecksum()
+{
+  m_type = CHECKSUM_NONE;
+}
+
+/**
+ * @brief Take a COMM_USE_HW_CRC or COMM_USE_HW_CKSUM configuration entry,
+ *        its value is a ChecksumType_t, 0 disables the checksum
+ * @param setting The entry
+ * @return Status_t
+ */
+Status_t FrameChecksum::configure(const DriverSettings_t &setting)
+{
+  ChecksumType_t type = (ChecksumType_t) setting.value;
+  bool is_crc = type >= CHECKSUM_CRC8 && type <= CHECKSUM_CRC32C;
+  bool is_sum = type >= CHECKSUM_SUM8 && type <= CHECKSUM_FLETCHER16;
+
+  if(type == CHECKSUM_NONE) { return setType(type);}
+  if(setting.parameter == COMM_USE_HW_CRC && !is_crc) { return STATUS_DRV_ERR_PARAM;}
+  if(setting.parameter == COMM_USE_HW_CKSUM && !is_sum) { return STATUS_DRV_ERR_PARAM;}
+  return setType(type);
+}
+
+/**
+ * @brief Select the checksum
+ * @param type The checksum, CHECKSUM_NONE to disable it
+ * @return Status_t
+ */
+Status_t FrameChecksum::setType(ChecksumType_t type)
+{
+  if(type > CHECKSUM_CRC32C) { return STATUS_DRV_ERR_PARAM;}
+  m_type = type;
+  return STATUS_DRV_SUCCESS;
+}
+
+/**
+ * @brief Build a frame of data followed by its checksum
+ * @param data The data
+ * @param size Number of bytes of data
+ * @param frame_size Storage for the size of the frame
+ * @param header Bytes covered by the checksum ahead of the data, not part of
+ *        the frame, may be nullptr
+ * @param header_size Number of bytes of the header
+ * @return The frame, valid until the next call
+ */
+uint8_t *FrameChecksum::append(const uint8_t *data, Size_t size, Size_t &frame_size, const uint8_t *header, Size_t header_size)
+{
+  if(header == nullptr) { header_size = 0;}
+  m_frame.resize((size_t) (header_size + size + getSize()));
+  if(header_size != 0) { memcpy(m_frame.data(), header, (size_t) header_size);}
+  memcpy(m_frame.data() + header_size, data, (size_t) size);
+  frame_size = Checksum::append(m_type, m_frame.data(), header_size + size) - header_size;
+  return m_frame.data() + header_size;
+}
+
+/**
+ * @brief Check a frame received with its checksum
+ * @param frame The frame, data followed by the checksum
+ * @param size Number of bytes of the frame
+ * @param header Bytes covered by the checksum ahead of the frame, not part of
+ *        it, may be nullptr
+ * @param header_size Number of bytes of the header
+ * @return Status_t
+ */
+Status_t FrameChecksum::verify(const uint8_t *frame, Size_t size, const uint8_t *header, Size_t header_size)
+{
+  Status_t status = STATUS_DRV_SUCCESS;
+  bool is_valid;
+
+  if(m_type == CHECKSUM_NONE) { return status;}
+  if(header == nullptr || header_size == 0)
+  {
+    is_valid = Checksum::verify(m_type, frame, size);
+  }else
+  {
+    m_frame.resize((size_t) (header_size + size));
+    memcpy(m_frame.data(), header, (size_t) header_size);
+    memcpy(m_frame.data() + header_size, frame, (size_t) size);
+    is_valid = size >= getSize() && Checksum::verify(m_type, m_frame.data(), header_size + size);
+  }
+  if(!is_valid)
+  {
+    if(m_type >= CHECKSUM_CRC8)
+    {
+      SET_STATUS(status, false, SRC_DRIVER, ERR_CRC, (char *)"The CRC of the frame received does not match.\r\n");
+    }else
+    {
+      SET_STATUS(status, false, SRC_DRIVER, ERR_CKSUM, (char *)"The checksum of the frame received does not match.\r\n");
+    }
+  }
+  return status;
+}
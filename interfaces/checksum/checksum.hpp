@@ -0,0 +1,136 @@
+/**
+ * @file checksum.hpp
+ * @author your name (you@domain.com)
+ * @brief CRC and checksum computation for frames
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef CHECKSUM_HPP
+#define CHECKSUM_HPP
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <vector>
+
+#include "commons.hpp"
+#include "driver_base/driver_base_types.hpp"
+#if __has_include("setup.hpp")
+#include "setup.hpp"
+#endif
+
+// Use the CRC instructions of the CPU when it has them, 0 to always use tables
+#ifndef CHECKSUM_USE_CPU_INSTRUCTIONS
+#define CHECKSUM_USE_CPU_INSTRUCTIONS                                          1
+#endif
+
+// Longest checksum, in bytes
+constexpr Size_t CHECKSUM_SIZE_MAX = 4;
+
+/**
+ * @brief Supported checksums, values of COMM_USE_HW_CRC and COMM_USE_HW_CKSUM
+ *
+ * @note Reflected CRCs are sent least significant byte first, the others
+ *       most significant byte first.
+ */
+typedef enum
+{
+  CHECKSUM_NONE,
+  CHECKSUM_SUM8,          /*!< Sum of the bytes modulo 256 */
+  CHECKSUM_XOR8,          /*!< XOR of the bytes */
+  CHECKSUM_FLETCHER16,    /*!< Fletcher-16, sums modulo 255 */
+  CHECKSUM_CRC8,          /*!< Polynomial 0x07, initial 0x00, the SMBus PEC */
+  CHECKSUM_CRC16_MODBUS,  /*!< Reflected 0x8005, initial 0xFFFF */
+  CHECKSUM_CRC16_CCITT,   /*!< Polynomial 0x1021, initial 0xFFFF, CCITT-FALSE */
+  CHECKSUM_CRC16_X25,     /*!< Reflected 0x1021, initial and final XOR 0xFFFF, the HDLC FCS-16 */
+  CHECKSUM_CRC32,         /*!< Reflected 0x04C11DB7 as used by Ethernet and zlib */
+  CHECKSUM_CRC32C,        /*!< Reflected 0x1EDC6F41, Castagnoli */
+}ChecksumType_t;
+
+/**
+ * @brief CRC and checksum functions
+ *
+ * @note CRC32 and CRC32C use the CRC instructions of the CPU when it has
+ *       them, PCLMULQDQ and SSE 4.2 on x86, the CRC extension on ARMv8,
+ *       chosen at run time. Reflected 16 bit CRCs and CPUs without them use
+ *       slicing-by-8 tables, 8 bytes per step. The CRC functions take the
+ *       result of the previous block to continue a computation, their
+ *       default starts a new one.
+ */
+class Checksum
+{
+public:
+  static uint32_t compute(ChecksumType_t type, const uint8_t *data, Size_t size);
+
+  static uint8_t getSize(ChecksumType_t type);
+
+  static Size_t append(ChecksumType_t type, uint8_t *frame, Size_t size);
+
+  static uint8_t getTrailer(ChecksumType_t type, const uint8_t *data, Size_t size, uint8_t *trailer);
+
+  static bool verify(ChecksumType_t type, const uint8_t *frame, Size_t size);
+
+  static uint8_t crc8(const uint8_t *data, Size_t size, uint8_t crc = 0x00);
+
+  static uint16_t crc16Modbus(const uint8_t *data, Size_t size, uint16_t crc = 0xFFFF);
+
+  static uint16_t crc16Ccitt(const uint8_t *data, Size_t size, uint16_t crc = 0xFFFF);
+
+  static uint16_t crc16X25(const uint8_t *data, Size_t size, uint16_t crc = 0x0000);
+
+  static uint32_t crc32(const uint8_t *data, Size_t size, uint32_t crc = 0);
+
+  static uint32_t crc32c(const uint8_t *data, Size_t size, uint32_t crc = 0);
+
+  static const char *getImplementation(ChecksumType_t type);
+};
+
+/**
+ * @brief Checksum appended to the frames a driver writes and checked on the
+ *        frames it reads
+ *
+ * @note Drivers configured with COMM_USE_HW_CRC or COMM_USE_HW_CKSUM send
+ *       each write followed by its checksum, in the same transfer. The byte
+ *       count of a read includes the checksum, which is checked on the bytes
+ *       the read returned. The header, when given, is covered by the
+ *       checksum but not transferred, e.g. the address byte of an SMBus PEC.
+ *
+ * @code
+ * const DriverSettings_t settings[] =
+ * {
+ *   ADD_PARAMETER(COMM_PARAM_BAUD, 115200),
+ *   ADD_PARAMETER(COMM_USE_HW_CRC, CHECKSUM_CRC16_MODBUS),
+ * };
+ * uart.configure(settings, 2);
+ * uart.write(request, 6);       // 8 bytes leave, the CRC last
+ * uart.read(response, 7, 5);    // 5 bytes of data, then the CRC
+ * @endcode
+ */
+class FrameChecksum
+{
+public:
+  FrameChecksum();
+
+  Status_t configure(const DriverSettings_t &setting);
+
+  Status_t setType(ChecksumType_t type);
+
+  ChecksumType_t getType() { return m_type;}
+
+  bool isEnabled() { return m_type != CHECKSUM_NONE;}
+
+  uint8_t getSize() { return Checksum::getSize(m_type);}
+
+  uint8_t *append(const uint8_t *data, Size_t size, Size_t &frame_size, const uint8_t *header = nullptr, Size_t header_size = 0);
+
+  Status_t verify(const uint8_t *frame, Size_t size, const uint8_t *header = nullptr, Size_t header_size = 0);
+
+private:
+  ChecksumType_t m_type;
+  std::vector<uint8_t> m_frame;
+};
+
+#endif /* CHECKSUM_HPP */
@@ -20,6 +20,7 @@ DriverBase::DriverBase()
   m_func = nullptr;
   m_arg = nullptr;
   m_is_async_mode = false;
+  m_record_id = DriverRecorder::assignId();
 }
 
 /**
@@ -71,4 +72,29 @@ Status_t DriverBase::enableCallback(bool enable, DriverEventsList_t event)
   (void) enable;
   (void) event;
   return STATUS_DRV_SUCCESS;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Get a consistent copy of the driver's counters and histograms
+ *
+ * @param snapshot Storage for the copy
+ * @return Status_t
+ */
+Status_t DriverBase::getStats(DriverStatsSnapshot_t &snapshot)
+{
+#if DRIVER_ENABLE_STATS
+  if(m_stats.getSnapshot(snapshot)) { return STATUS_DRV_SUCCESS;}
+  return STATUS_DRV_ERR_BUSY;
+#else
+  (void) snapshot;
+  return STATUS_DRV_NOT_IMPLEMENTED;
+#endif
+}
+
+/**
+ * @brief Zero the driver's counters and histograms
+ */
+void DriverBase::resetStats()
+{
+  m_stats.reset();
+}
@@ -14,6 +14,9 @@
 
 #include "commons.hpp"
 #include "driver_base_types.hpp"
+#include "driver_stats.hpp"
+#include "driver_trace.hpp"
+#include "driver_recorder.hpp"
 
 class DriverBase
 {
@@ -22,6 +25,8 @@ public:
   DriverCallback_t m_func;
   void *m_arg;
   bool m_is_async_mode;
+  [[no_unique_address]] DriverStats m_stats;
+  uint16_t m_record_id;  /*!< Identifies the driver in DriverRecorder logs */
 
   DriverBase();
   virtual ~DriverBase();
@@ -34,6 +39,10 @@ public:
 
   // Enable / disable callback
   virtual Status_t enableCallback(bool enable, DriverEventsList_t event = EVENT_NONE);
+
+  // Performance counters
+  virtual Status_t getStats(DriverStatsSnapshot_t &snapshot);
+  virtual void resetStats();
 };
 
 #endif /* DRIVER_BASE_HPP */
\ No newline at end of file
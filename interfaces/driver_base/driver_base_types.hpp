@@ -67,6 +67,16 @@ typedef enum
   EVENT_READ_WRITE,
 }DriverEventsList_t;
 
+/**
+ * @brief List of possible scheduling policies of driver threads
+ */
+typedef enum
+{
+  THREAD_POLICY_DEFAULT,  /*!< Time shared with every other thread */
+  THREAD_POLICY_FIFO,     /*!< Real time, runs until it blocks or a higher priority is ready */
+  THREAD_POLICY_RR,       /*!< Real time, time sliced with threads of the same priority */
+}ThreadPolicy_t;
+
 typedef enum
 {
   // DIO parameters
@@ -86,7 +96,7 @@ typedef enum
   COMM_PARAM_CK_GPIO,
   COMM_PARAM_CS_PARAM,
   COMM_PARAM_CTS_GPIO,
-  COMM_PARAM_RTS_GPIO,
+  COMM_PARAM_RTS_GPIO,     /*!< Line of the transceiver enable, gpiochip number << 16 | line offset */
   COMM_PARAM_STOP_BITS,
   COMM_PARAM_LINE_MODE,
   COMM_PARAM_START_DELAY_US,
@@ -95,6 +105,16 @@ typedef enum
   COMM_USE_HW_CRC,
   COMM_USE_HW_CKSUM,
   COMM_USE_PULL_UP,
+  COMM_WORK_PIPELINED,
+  COMM_PARAM_LOW_LATENCY,  /*!< Latency timer of USB adapters in ms, 0 leaves the timer as it is */
+  COMM_USE_RS485,          /*!< Drive a half-duplex transceiver, 1 for an enable active high, 2 active low */
+  COMM_PARAM_END_DELAY_US,
+  COMM_USE_LOW_LATENCY,    /*!< 1 sets ASYNC_LOW_LATENCY, which FTDI adapters answer with a 1 ms timer, 0 clears it */
+
+  // Worker threads of the driver
+  THREAD_PARAM_POLICY,
+  THREAD_PARAM_PRIORITY,
+  THREAD_PARAM_AFFINITY,  /*!< One bit per CPU, 0 runs anywhere */
 } DriverParamList_t;
 
 /**
@@ -106,6 +126,17 @@ typedef struct
   uint32_t value;
 }DriverSettings_t;
 
+/**
+ * @brief Outcome of one asynchronous request
+ */
+typedef struct
+{
+  uint32_t id;              /*!< Identifier given to the request on submission */
+  Status_t status;          /*!< Status of this request only */
+  Size_t bytes;             /*!< Number of bytes transferred by this request */
+  DriverEventsList_t event; /*!< EVENT_READ, EVENT_WRITE or EVENT_READ_WRITE */
+}DriverRequest_t;
+
 /**
  * @brief Macro to make it easy to add configuration parameters to a list
  */
@@ -21,6 +21,8 @@ DriverInBase::DriverInBase()
   m_func_rx = nullptr;
   m_arg_rx = nullptr;
   m_read_status = STATUS_DRV_NOT_CONFIGURED;
+  m_reads_pending = 0;
+  m_read_id = 0;
 }
 
 /**
@@ -80,6 +82,28 @@ Status_t DriverInBase::read(Buffer_t data, uint32_t timeout)
   return read(data.data(), data.size(), timeout);
 }
 
+/**
+ * @brief Read through a pooled buffer, in asynchronous mode the driver keeps
+ *        the buffer alive until the request is done
+ *
+ * @param buffer Buffer taken from a BufferPool, its size is the byte count
+ * @param timeout Time to wait in milliseconds before returning an error
+ * @return Status_t
+ */
+Status_t DriverInBase::read(PoolBuffer buffer, uint32_t timeout)
+{
+  Status_t status;
+  void *pool_buffer;
+
+  if(!buffer.valid()) { return STATUS_DRV_NULL_POINTER;}
+  if(!m_is_async_mode) { return read(buffer.data(), buffer.size(), timeout);}
+
+  pool_buffer = buffer.retain();
+  status = queueRead(buffer.data(), buffer.size(), timeout, nullptr, pool_buffer);
+  if(!status.success) { PoolBuffer::release(pool_buffer);}
+  return status;
+}
+
 /**
  * @brief Get number of bytes in the driver's internal read buffer
  *
@@ -107,5 +131,214 @@ Size_t DriverInBase::getBytesRead()
  */
 Status_t DriverInBase::getReadStatus()
 {
+  std::lock_guard<std::mutex> lock(m_read_status_lock);
   return m_read_status;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Get the number of read requests queued or running
+ *
+ * @return uint32_t
+ */
+uint32_t DriverInBase::getReadsPending()
+{
+  return m_reads_pending;
+}
+
+/**
+ * @brief Get the identifier given to the last read request submitted
+ *
+ * @return uint32_t
+ */
+uint32_t DriverInBase::getLastReadId()
+{
+  return m_read_id;
+}
+
+/**
+ * @brief Wait for the outcome of the oldest read request not yet collected
+ *
+ * @param request Storage for the outcome of the request
+ * @param timeout Time to wait in milliseconds before returning an error
+ * @return Status_t
+ */
+Status_t DriverInBase::getReadResult(DriverRequest_t &request, uint32_t timeout)
+{
+  (void) request;
+  (void) timeout;
+  return STATUS_DRV_NOT_IMPLEMENTED;
+}
+
+/**
+ * @brief Submit a read request and get a token to track its completion
+ *
+ * @note In synchronous mode the request is processed right away and the
+ *       token returned is already ready.
+ *
+ * @param data Buffer to store the data
+ * @param byte_count Number of bytes to read
+ * @param timeout Time to wait in milliseconds before returning an error
+ * @return DriverToken
+ */
+DriverToken DriverInBase::readAsync(uint8_t *data, Size_t byte_count, uint32_t timeout)
+{
+  return readAsync(data, byte_count, timeout, nullptr);
+}
+
+/**
+ * @brief Submit a read request and get a token to track its completion
+ *
+ * @param data Buffer and size
+ * @param timeout Time to wait in milliseconds before returning an error
+ * @return DriverToken
+ */
+DriverToken DriverInBase::readAsync(Buffer_t data, uint32_t timeout)
+{
+  return readAsync(data.data(), data.size(), timeout);
+}
+
+/**
+ * @brief Submit a read request on a pooled buffer and get a token to track
+ *        its completion, the driver keeps the buffer alive until it is done
+ *
+ * @param buffer Buffer taken from a BufferPool, its size is the byte count
+ * @param timeout Time to wait in milliseconds before returning an error
+ * @return DriverToken
+ */
+DriverToken DriverInBase::readAsync(PoolBuffer buffer, uint32_t timeout)
+{
+  if(!buffer.valid()) { return DriverToken(STATUS_DRV_NULL_POINTER);}
+  return readAsync(buffer.data(), buffer.size(), timeout, &buffer);
+}
+
+/**
+ * @brief Submit a read request and get a token to track its completion
+ *
+ * @param data Buffer to store the data
+ * @param byte_count Number of bytes to read
+ * @param timeout Time to wait in milliseconds before returning an error
+ * @param buffer Pooled buffer kept alive while the request is in flight, may be nullptr
+ * @return DriverToken
+ */
+DriverToken DriverInBase::readAsync(uint8_t *data, Size_t byte_count, uint32_t timeout, const PoolBuffer *buffer)
+{
+  Status_t status;
+  DriverToken token;
+  void *completion;
+  void *pool_buffer;
+
+  if(data == nullptr) { return DriverToken(STATUS_DRV_NULL_POINTER);}
+
+  if(!m_is_async_mode)
+  {
+    status = read(data, byte_count, timeout);
+    return DriverToken(status, status.success ? getBytesRead() : 0);
+  }
+
+  token = DriverToken::create(EVENT_READ, Buffer_t(data, byte_count));
+  if(!token.valid()) { return token;}
+
+  completion = token.attach();
+  pool_buffer = buffer != nullptr ? buffer->retain() : nullptr;
+  status = queueRead(data, byte_count, timeout, completion, pool_buffer);
+  if(!status.success)
+  {
+    // The request never reached the driver, complete it here
+    DriverToken::complete(completion, {0, status, 0, EVENT_READ});
+    PoolBuffer::release(pool_buffer);
+  }
+  return token;
+}
+
+/**
+ * @brief Mark a synchronous read as running
+ *
+ * @return false if another read is running
+ */
+bool DriverInBase::beginRead()
+{
+  std::lock_guard<std::mutex> lock(m_read_status_lock);
+  if(m_read_status.code == OPERATION_RUNNING) { return false;}
+  m_read_status = STATUS_DRV_RUNNING;
+  m_read_status.success = false;
+  return true;
+}
+
+/**
+ * @brief Set the read operation status, the workers of asynchronous
+ *        requests set it as well
+ *
+ * @param status The status
+ */
+void DriverInBase::setReadStatus(Status_t status)
+{
+  std::lock_guard<std::mutex> lock(m_read_status_lock);
+  m_read_status = status;
+}
+
+/**
+ * @brief Account for a new read request
+ *
+ * @return uint32_t Identifier given to the request
+ */
+uint32_t DriverInBase::submitRead()
+{
+  std::lock_guard<std::mutex> lock(m_read_status_lock);
+  m_reads_pending++;
+  m_read_status = STATUS_DRV_RUNNING;
+  m_read_status.success = false;
+  return ++m_read_id;
+}
+
+/**
+ * @brief Withdraw a read request that could not be queued
+ *
+ * @param count_busy false if the rejection is already counted, e.g. with the
+ *        other half of a transfer
+ */
+void DriverInBase::cancelRead(bool count_busy)
+{
+  std::lock_guard<std::mutex> lock(m_read_status_lock);
+  if(count_busy) { m_stats.countBusy();}
+  if(m_reads_pending.fetch_sub(1) == 1)
+  {
+    m_read_status = STATUS_DRV_IDLE;
+  }
+}
+
+/**
+ * @brief Account for the end of a read request, the driver's status only
+ *        leaves the running state once no other request is pending
+ *
+ * @param status Status of the request
+ */
+void DriverInBase::completeRead(Status_t status)
+{
+  std::lock_guard<std::mutex> lock(m_read_status_lock);
+  if(m_reads_pending.fetch_sub(1) == 1)
+  {
+    m_read_status = status;
+  }
+}
+
+/**
+ * @brief Hand a read request to the driver's worker, drivers that support
+ *        asynchronous mode complete the token and release the pooled buffer
+ *        once the request is done, and take neither when they fail
+ *
+ * @param data Buffer to store the data
+ * @param byte_count Number of bytes to read
+ * @param timeout Time to wait in milliseconds before returning an error
+ * @param completion Pointer to give to DriverToken::complete(), may be nullptr
+ * @param pool_buffer Pointer to give to PoolBuffer::release(), may be nullptr
+ * @return Status_t
+ */
+Status_t DriverInBase::queueRead(uint8_t *data, Size_t byte_count, uint32_t timeout, void *completion, void *pool_buffer)
+{
+  (void) pool_buffer;
+  (void) data;
+  (void) byte_count;
+  (void) timeout;
+  (void) completion;
+  return STATUS_DRV_NOT_IMPLEMENTED;
+}
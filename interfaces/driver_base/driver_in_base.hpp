@@ -12,8 +12,12 @@
 #ifndef DRIVER_IN_BASE_HPP
 #define DRIVER_IN_BASE_HPP
 
+#include <atomic>
+#include <mutex>
+
 #include "commons.hpp"
 #include "driver_base.hpp"
+#include "driver_token.hpp"
 
 class DriverInBase : virtual public DriverBase
 {
@@ -21,9 +25,12 @@ public:
 
   Size_t m_bytes_read;
   Size_t m_bytes_available;
-  Status_t m_read_status;
+  Status_t m_read_status;                 /*!< Accessed under m_read_status_lock */
   DriverCallback_t m_func_rx;
   void *m_arg_rx;
+  std::atomic<uint32_t> m_reads_pending;
+  std::atomic<uint32_t> m_read_id;
+  std::mutex m_read_status_lock;
 
   DriverInBase();
   virtual ~DriverInBase();
@@ -33,6 +40,7 @@ public:
   virtual Status_t read(float &data);
   virtual Status_t read(uint8_t *data, Size_t byte_count, uint32_t timeout = UINT32_MAX);
   virtual Status_t read(Buffer_t data, uint32_t timeout = UINT32_MAX);
+  virtual Status_t read(PoolBuffer buffer, uint32_t timeout = UINT32_MAX);
 
   // Bytes exchanged
   virtual Size_t getBytesAvailable();
@@ -40,6 +48,25 @@ public:
 
   // Error handling
   virtual Status_t getReadStatus();
+
+  // Asynchronous requests
+  virtual uint32_t getReadsPending();
+  virtual uint32_t getLastReadId();
+  virtual Status_t getReadResult(DriverRequest_t &request, uint32_t timeout = UINT32_MAX);
+  DriverToken readAsync(uint8_t *data, Size_t byte_count, uint32_t timeout = UINT32_MAX);
+  DriverToken readAsync(Buffer_t data, uint32_t timeout = UINT32_MAX);
+  DriverToken readAsync(PoolBuffer buffer, uint32_t timeout = UINT32_MAX);
+
+protected:
+  bool beginRead();
+  void setReadStatus(Status_t status);
+  uint32_t submitRead();
+  void cancelRead(bool count_busy = true);
+  void completeRead(Status_t status);
+  virtual Status_t queueRead(uint8_t *data, Size_t byte_count, uint32_t timeout, void *completion, void *pool_buffer);
+
+private:
+  DriverToken readAsync(uint8_t *data, Size_t byte_count, uint32_t timeout, const PoolBuffer *buffer);
 };
 
 #endif /* DRIVER_IN_BASE_HPP */
\ No newline at end of file
@@ -21,6 +21,8 @@ DriverOutBase::DriverOutBase()
   m_func_tx = nullptr;
   m_arg_tx = nullptr;
   m_write_status = STATUS_DRV_NOT_CONFIGURED;
+  m_writes_pending = 0;
+  m_write_id = 0;
 }
 
 /**
@@ -80,6 +82,38 @@ Status_t DriverOutBase::write(Buffer_t data, uint32_t timeout)
   return write(data.data(), data.size(), timeout);
 }
 
+/**
+ * @brief Write through a pooled buffer, in asynchronous mode the driver keeps
+ *        the buffer alive until the request is done
+ *
+ * @param buffer Buffer taken from a BufferPool, its size is the byte count
+ * @param timeout Time to wait in milliseconds before returning an error
+ * @return Status_t
+ */
+Status_t DriverOutBase::write(PoolBuffer buffer, uint32_t timeout)
+{
+  Status_t status;
+  void *pool_buffer;
+
+  if(!buffer.valid()) { return STATUS_DRV_NULL_POINTER;}
+  if(!m_is_async_mode) { return write(buffer.data(), buffer.size(), timeout);}
+
+  pool_buffer = buffer.retain();
+  status = queueWrite(buffer.data(), buffer.size(), timeout, nullptr, pool_buffer);
+  if(!status.success) { PoolBuffer::release(pool_buffer);}
+  return status;
+}
+
+/**
+ * @brief Block until all data written has been sent
+ *
+ * @return Status_t
+ */
+Status_t DriverOutBase::flush()
+{
+  return STATUS_DRV_NOT_IMPLEMENTED;
+}
+
 /**
  * @brief Get the number of bytes on the driver's internal write buffer
  *
@@ -107,5 +141,214 @@ Size_t DriverOutBase::getBytesWritten()
  */
 Status_t DriverOutBase::getWriteStatus()
 {
+  std::lock_guard<std::mutex> lock(m_write_status_lock);
   return m_write_status;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Get the number of write requests queued or running
+ *
+ * @return uint32_t
+ */
+uint32_t DriverOutBase::getWritesPending()
+{
+  return m_writes_pending;
+}
+
+/**
+ * @brief Get the identifier given to the last write request submitted
+ *
+ * @return uint32_t
+ */
+uint32_t DriverOutBase::getLastWriteId()
+{
+  return m_write_id;
+}
+
+/**
+ * @brief Wait for the outcome of the oldest write request not yet collected
+ *
+ * @param request Storage for the outcome of the request
+ * @param timeout Time to wait in milliseconds before returning an error
+ * @return Status_t
+ */
+Status_t DriverOutBase::getWriteResult(DriverRequest_t &request, uint32_t timeout)
+{
+  (void) request;
+  (void) timeout;
+  return STATUS_DRV_NOT_IMPLEMENTED;
+}
+
+/**
+ * @brief Submit a write request and get a token to track its completion
+ *
+ * @note In synchronous mode the request is processed right away and the
+ *       token returned is already ready.
+ *
+ * @param data Buffer where data is stored
+ * @param byte_count Number of bytes to write
+ * @param timeout Time to wait in milliseconds before returning an error
+ * @return DriverToken
+ */
+DriverToken DriverOutBase::writeAsync(uint8_t *data, Size_t byte_count, uint32_t timeout)
+{
+  return writeAsync(data, byte_count, timeout, nullptr);
+}
+
+/**
+ * @brief Submit a write request and get a token to track its completion
+ *
+ * @param data Buffer and size
+ * @param timeout Time to wait in milliseconds before returning an error
+ * @return DriverToken
+ */
+DriverToken DriverOutBase::writeAsync(Buffer_t data, uint32_t timeout)
+{
+  return writeAsync(data.data(), data.size(), timeout);
+}
+
+/**
+ * @brief Submit a write request on a pooled buffer and get a token to track
+ *        its completion, the driver keeps the buffer alive until it is done
+ *
+ * @param buffer Buffer taken from a BufferPool, its size is the byte count
+ * @param timeout Time to wait in milliseconds before returning an error
+ * @return DriverToken
+ */
+DriverToken DriverOutBase::writeAsync(PoolBuffer buffer, uint32_t timeout)
+{
+  if(!buffer.valid()) { return DriverToken(STATUS_DRV_NULL_POINTER);}
+  return writeAsync(buffer.data(), buffer.size(), timeout, &buffer);
+}
+
+/**
+ * @brief Submit a write request and get a token to track its completion
+ *
+ * @param data Buffer where data is stored
+ * @param byte_count Number of bytes to write
+ * @param timeout Time to wait in milliseconds before returning an error
+ * @param buffer Pooled buffer kept alive while the request is in flight, may be nullptr
+ * @return DriverToken
+ */
+DriverToken DriverOutBase::writeAsync(uint8_t *data, Size_t byte_count, uint32_t timeout, const PoolBuffer *buffer)
+{
+  Status_t status;
+  DriverToken token;
+  void *completion;
+  void *pool_buffer;
+
+  if(data == nullptr) { return DriverToken(STATUS_DRV_NULL_POINTER);}
+
+  if(!m_is_async_mode)
+  {
+    status = write(data, byte_count, timeout);
+    return DriverToken(status, status.success ? getBytesWritten() : 0);
+  }
+
+  token = DriverToken::create(EVENT_WRITE, Buffer_t(data, byte_count));
+  if(!token.valid()) { return token;}
+
+  completion = token.attach();
+  pool_buffer = buffer != nullptr ? buffer->retain() : nullptr;
+  status = queueWrite(data, byte_count, timeout, completion, pool_buffer);
+  if(!status.success)
+  {
+    // The request never reached the driver, complete it here
+    DriverToken::complete(completion, {0, status, 0, EVENT_WRITE});
+    PoolBuffer::release(pool_buffer);
+  }
+  return token;
+}
+
+/**
+ * @brief Mark a synchronous write as running
+ *
+ * @return false if another write is running
+ */
+bool DriverOutBase::beginWrite()
+{
+  std::lock_guard<std::mutex> lock(m_write_status_lock);
+  if(m_write_status.code == OPERATION_RUNNING) { return false;}
+  m_write_status = STATUS_DRV_RUNNING;
+  m_write_status.success = false;
+  return true;
+}
+
+/**
+ * @brief Set the write operation status, the workers of asynchronous
+ *        requests set it as well
+ *
+ * @param status The status
+ */
+void DriverOutBase::setWriteStatus(Status_t status)
+{
+  std::lock_guard<std::mutex> lock(m_write_status_lock);
+  m_write_status = status;
+}
+
+/**
+ * @brief Account for a new write request
+ *
+ * @return uint32_t Identifier given to the request
+ */
+uint32_t DriverOutBase::submitWrite()
+{
+  std::lock_guard<std::mutex> lock(m_write_status_lock);
+  m_writes_pending++;
+  m_write_status = STATUS_DRV_RUNNING;
+  m_write_status.success = false;
+  return ++m_write_id;
+}
+
+/**
+ * @brief Withdraw a write request that could not be queued
+ *
+ * @param count_busy false if the rejection is already counted, e.g. with the
+ *        other half of a transfer
+ */
+void DriverOutBase::cancelWrite(bool count_busy)
+{
+  std::lock_guard<std::mutex> lock(m_write_status_lock);
+  if(count_busy) { m_stats.countBusy();}
+  if(m_writes_pending.fetch_sub(1) == 1)
+  {
+    m_write_status = STATUS_DRV_IDLE;
+  }
+}
+
+/**
+ * @brief Account for the end of a write request, the driver's status only
+ *        leaves the running state once no other request is pending
+ *
+ * @param status Status of the request
+ */
+void DriverOutBase::completeWrite(Status_t status)
+{
+  std::lock_guard<std::mutex> lock(m_write_status_lock);
+  if(m_writes_pending.fetch_sub(1) == 1)
+  {
+    m_write_status = status;
+  }
+}
+
+/**
+ * @brief Hand a write request to the driver's worker, drivers that support
+ *        asynchronous mode complete the token and release the pooled buffer
+ *        once the request is done, and take neither when they fail
+ *
+ * @param data Buffer where data is stored
+ * @param byte_count Number of bytes to write
+ * @param timeout Time to wait in milliseconds before returning an error
+ * @param completion Pointer to give to DriverToken::complete(), may be nullptr
+ * @param pool_buffer Pointer to give to PoolBuffer::release(), may be nullptr
+ * @return Status_t
+ */
+Status_t DriverOutBase::queueWrite(uint8_t *data, Size_t byte_count, uint32_t timeout, void *completion, void *pool_buffer)
+{
+  (void) pool_buffer;
+  (void) data;
+  (void) byte_count;
+  (void) timeout;
+  (void) completion;
+  return STATUS_DRV_NOT_IMPLEMENTED;
+}
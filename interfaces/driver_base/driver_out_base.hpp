@@ -12,8 +12,12 @@
 #ifndef DRIVER_OUT_BASE_HPP
 #define DRIVER_OUT_BASE_HPP
 
+#include <atomic>
+#include <mutex>
+
 #include "commons.hpp"
 #include "driver_base.hpp"
+#include "driver_token.hpp"
 
 class DriverOutBase : virtual public DriverBase
 {
@@ -21,9 +25,12 @@ public:
 
   Size_t m_bytes_written;
   Size_t m_bytes_pending;
-  Status_t m_write_status;
+  Status_t m_write_status;                 /*!< Accessed under m_write_status_lock */
   DriverCallback_t m_func_tx;
   void *m_arg_tx;
+  std::atomic<uint32_t> m_writes_pending;
+  std::atomic<uint32_t> m_write_id;
+  std::mutex m_write_status_lock;
 
   DriverOutBase();
   virtual ~DriverOutBase();
@@ -33,6 +40,10 @@ public:
   virtual Status_t write(float data);
   virtual Status_t write(uint8_t *data, Size_t byte_count, uint32_t timeout = UINT32_MAX);
   virtual Status_t write(Buffer_t data, uint32_t timeout = UINT32_MAX);
+  virtual Status_t write(PoolBuffer buffer, uint32_t timeout = UINT32_MAX);
+
+  // Block until all data written has been sent
+  virtual Status_t flush();
 
   // Bytes exchanged
   virtual Size_t getBytesPending();
@@ -40,6 +51,25 @@ public:
 
   // Error handling
   virtual Status_t getWriteStatus();
+
+  // Asynchronous requests
+  virtual uint32_t getWritesPending();
+  virtual uint32_t getLastWriteId();
+  virtual Status_t getWriteResult(DriverRequest_t &request, uint32_t timeout = UINT32_MAX);
+  DriverToken writeAsync(uint8_t *data, Size_t byte_count, uint32_t timeout = UINT32_MAX);
+  DriverToken writeAsync(Buffer_t data, uint32_t timeout = UINT32_MAX);
+  DriverToken writeAsync(PoolBuffer buffer, uint32_t timeout = UINT32_MAX);
+
+protected:
+  bool beginWrite();
+  void setWriteStatus(Status_t status);
+  uint32_t submitWrite();
+  void cancelWrite(bool count_busy = true);
+  void completeWrite(Status_t status);
+  virtual Status_t queueWrite(uint8_t *data, Size_t byte_count, uint32_t timeout, void *completion, void *pool_buffer);
+
+private:
+  DriverToken writeAsync(uint8_t *data, Size_t byte_count, uint32_t timeout, const PoolBuffer *buffer);
 };
 
 #endif /* DRIVER_OUT_BASE_HPP*/
\ No newline at end of file
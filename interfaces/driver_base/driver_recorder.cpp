@@ -0,0 +1,217 @@
+/**
+ * @file driver_recorder.cpp
+ * @author your name (you@domain.com)
+ * @brief Capture of driver traffic into a binary log, and its reader
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "driver_recorder.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <chrono>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+
+std::atomic<bool> DriverRecorder::s_is_recording(false);
+
+static std::mutex s_mutex;
+static std::condition_variable s_condition;
+static std::vector<uint8_t> s_staging;
+static std::thread *s_thread = nullptr;
+static FILE *s_file = nullptr;
+static bool s_terminate = false;
+static bool s_write_failed = false;
+static std::atomic<uint64_t> s_dropped(0);
+static std::atomic<uint16_t> s_next_id(1);
+
+/**
+ * @brief Start capturing into a file, it is overwritten
+ * @param path Path of the log
+ * @return Status_t
+ */
+Status_t DriverRecorder::start(const char *path)
+{
+  std::lock_guard<std::mutex> lock(s_mutex);
+  Status_t status;
+
+  if(path == nullptr) { return STATUS_DRV_NULL_POINTER;}
+  if(s_thread != nullptr) { return STATUS_DRV_ERR_BUSY;}
+
+  s_file = fopen(path, "wb");
+  if(s_file == nullptr)
+  {
+    SET_STATUS(status, false, SRC_DRIVER, ERR_FAILED, (char *)"Failed to open the record file.\r\n");
+    return status;
+  }
+  if(fwrite(DRIVER_RECORD_MAGIC, sizeof(DRIVER_RECORD_MAGIC), 1, s_file) != 1)
+  {
+    fclose(s_file);
+    s_file = nullptr;
+    SET_STATUS(status, false, SRC_DRIVER, ERR_FAILED, (char *)"Failed to write the record file.\r\n");
+    return status;
+  }
+
+  s_staging.clear();
+  s_staging.reserve(DRIVER_RECORD_BUFFER_SIZE);
+  s_terminate = false;
+  s_write_failed = false;
+  s_dropped.store(0, std::memory_order_relaxed);
+  s_thread = new std::thread(&DriverRecorder::writerThread);
+  s_is_recording.store(true, std::memory_order_relaxed);
+  return STATUS_DRV_SUCCESS;
+}
+
+/**
+ * @brief Stop capturing, buffered records are written before returning
+ * @return Status_t
+ */
+Status_t DriverRecorder::stop()
+{
+  std::unique_lock<std::mutex> locker(s_mutex);
+  Status_t status = STATUS_DRV_SUCCESS;
+
+  if(s_thread == nullptr) { return STATUS_DRV_NOT_CONFIGURED;}
+  s_is_recording.store(false, std::memory_order_relaxed);
+  s_terminate = true;
+  locker.unlock();
+  s_condition.notify_one();
+  s_thread->join();
+  delete s_thread;
+
+  locker.lock();
+  s_thread = nullptr;
+  if(fclose(s_file) != 0) { s_write_failed = true;}
+  s_file = nullptr;
+  if(s_write_failed)
+  {
+    SET_STATUS(status, false, SRC_DRIVER, ERR_FAILED, (char *)"Failed to write the record file.\r\n");
+  }
+  return status;
+}
+
+/**
+ * @brief Append a record to the staging buffer, empty payloads are skipped
+ * @param driver_id Id of the driver
+ * @param direction What the payload is
+ * @param data The payload
+ * @param size Payload size
+ */
+void DriverRecorder::record(uint16_t driver_id, DriverRecordDirection_t direction, const uint8_t *data, Size_t size)
+{
+  DriverRecordHeader_t header;
+
+  // Nothing was transferred, a failed or empty request
+  if(data == nullptr || size == 0) { return;}
+  header.driver_id = driver_id;
+  header.direction = (uint8_t) direction;
+  header.reserved = 0;
+  header.size = (uint32_t) size;
+
+  std::lock_guard<std::mutex> lock(s_mutex);
+  if(!s_is_recording.load(std::memory_order_relaxed)) { return;}
+  // Taken under the lock so that timestamps never go back in the log
+  header.timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+  if(sizeof(header) + size > DRIVER_RECORD_BUFFER_SIZE - s_staging.size())
+  {
+    s_dropped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  s_staging.insert(s_staging.end(), (const uint8_t *) &header, (const uint8_t *) &header + sizeof(header));
+  s_staging.insert(s_staging.end(), data, data + size);
+}
+
+/**
+ * @brief Get the number of records lost because the writer fell behind
+ * @return uint64_t
+ */
+uint64_t DriverRecorder::getDropped()
+{
+  return s_dropped.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Get an id for a new driver, ids follow the construction order
+ * @return uint16_t
+ */
+uint16_t DriverRecorder::assignId()
+{
+  return s_next_id.fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Thread that moves the staging buffer to the file
+ */
+void DriverRecorder::writerThread(void)
+{
+  std::unique_lock<std::mutex> locker(s_mutex);
+  std::vector<uint8_t> buffer;
+  bool is_last;
+
+  buffer.reserve(DRIVER_RECORD_BUFFER_SIZE);
+  do
+  {
+    s_condition.wait_for(locker, std::chrono::milliseconds(DRIVER_RECORD_FLUSH_MS), [] { return s_terminate;});
+    is_last = s_terminate;
+    s_staging.swap(buffer);
+    locker.unlock();
+
+    if(!buffer.empty() && fwrite(buffer.data(), buffer.size(), 1, s_file) != 1)
+    {
+      s_write_failed = true;
+    }
+    buffer.clear();
+    locker.lock();
+  } while(!is_last);
+}
+
+/**
+ * @brief Read a whole log
+ * @param path Path of the log
+ * @return Status_t
+ */
+Status_t DriverRecording::load(const char *path)
+{
+  DriverRecordHeader_t header;
+  DriverRecord_t record;
+  char magic[sizeof(DRIVER_RECORD_MAGIC)];
+  Status_t status = STATUS_DRV_SUCCESS;
+  FILE *file;
+
+  if(path == nullptr) { return STATUS_DRV_NULL_POINTER;}
+  m_records.clear();
+  file = fopen(path, "rb");
+  if(file == nullptr)
+  {
+    SET_STATUS(status, false, SRC_DRIVER, ERR_FAILED, (char *)"Failed to open the record file.\r\n");
+    return status;
+  }
+  if(fread(magic, sizeof(magic), 1, file) != 1 || memcmp(magic, DRIVER_RECORD_MAGIC, sizeof(magic)) != 0)
+  {
+    fclose(file);
+    SET_STATUS(status, false, SRC_DRIVER, ERR_FAILED, (char *)"Not a record file.\r\n");
+    return status;
+  }
+
+  while(fread(&header, sizeof(header), 1, file) == 1)
+  {
+    record.timestamp = header.timestamp;
+    record.driver_id = header.driver_id;
+    record.direction = (DriverRecordDirection_t) header.direction;
+    record.data.resize(header.size);
+    if(header.size > 0 && fread(record.data.data(), header.size, 1, file) != 1)
+    {
+      // A capture cut short leaves a partial record at the end
+      break;
+    }
+    m_records.push_back(record);
+  }
+  fclose(file);
+  return status;
+}
@@ -0,0 +1,131 @@
+/**
+ * @file driver_recorder.hpp
+ * @author your name (you@domain.com)
+ * @brief Capture of driver traffic into a binary log, and its reader
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef DRIVER_RECORDER_HPP
+#define DRIVER_RECORDER_HPP
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <atomic>
+#include <vector>
+
+#include "commons.hpp"
+#if __has_include("setup.hpp")
+#include "setup.hpp"
+#endif
+
+#ifndef DRIVER_ENABLE_RECORD
+#define DRIVER_ENABLE_RECORD                                                   1
+#endif
+
+// Bytes buffered between two flushes of the writer, records that do not fit
+// are dropped
+#ifndef DRIVER_RECORD_BUFFER_SIZE
+#define DRIVER_RECORD_BUFFER_SIZE                                      (1 << 20)
+#endif
+
+// Time between two flushes of the writer in milliseconds
+#ifndef DRIVER_RECORD_FLUSH_MS
+#define DRIVER_RECORD_FLUSH_MS                                                50
+#endif
+
+/**
+ * @brief What a record holds
+ */
+typedef enum
+{
+  DRIVER_RECORD_READ = 0,   /*!< Data received by the driver */
+  DRIVER_RECORD_WRITE,      /*!< Data sent by the driver */
+  DRIVER_RECORD_EDGE,       /*!< Edge on a line, the payload is the new level */
+}DriverRecordDirection_t;
+
+/**
+ * @brief Header written before each payload, in host byte order
+ */
+typedef struct
+{
+  uint64_t timestamp;   /*!< Completion time in nanoseconds, monotonic clock */
+  uint16_t driver_id;   /*!< DriverBase::m_record_id of the driver */
+  uint8_t direction;    /*!< DriverRecordDirection_t */
+  uint8_t reserved;
+  uint32_t size;        /*!< Payload size in bytes */
+}DriverRecordHeader_t;
+
+/**
+ * @brief A record read back from a log
+ */
+typedef struct
+{
+  uint64_t timestamp;
+  uint16_t driver_id;
+  DriverRecordDirection_t direction;
+  std::vector<uint8_t> data;
+}DriverRecord_t;
+
+/**
+ * @brief Records every completed driver operation while a capture runs
+ *
+ * @note Drivers copy their payload into a staging buffer under a lock, a
+ *       background thread writes the buffer to the file, so no file IO
+ *       happens on the drivers' threads. The log starts with
+ *       DRIVER_RECORD_MAGIC followed by DriverRecordHeader_t and payload
+ *       pairs.
+ */
+class DriverRecorder
+{
+public:
+  static Status_t start(const char *path);
+  static Status_t stop();
+
+  static bool isRecording() { return s_is_recording.load(std::memory_order_relaxed);}
+
+  static void record(uint16_t driver_id, DriverRecordDirection_t direction, const uint8_t *data, Size_t size);
+
+  static uint64_t getDropped();
+
+  static uint16_t assignId();
+
+private:
+  static std::atomic<bool> s_is_recording;
+
+  static void writerThread(void);
+};
+
+/**
+ * @brief A log loaded in memory
+ */
+class DriverRecording
+{
+public:
+  Status_t load(const char *path);
+
+  const std::vector<DriverRecord_t>& getRecords() const { return m_records;}
+
+private:
+  std::vector<DriverRecord_t> m_records;
+};
+
+constexpr char DRIVER_RECORD_MAGIC[8] = {'D', 'R', 'V', 'R', 'E', 'C', '0', '1'};
+
+#if DRIVER_ENABLE_RECORD
+#define DRIVER_RECORD(id, direction, data, size)     \
+  do                                                 \
+  {                                                  \
+    if(DriverRecorder::isRecording())                \
+    {                                                \
+      DriverRecorder::record(id, direction, (const uint8_t *) (data), size); \
+    }                                                \
+  } while(0)
+#else
+#define DRIVER_RECORD(id, direction, data, size)     ((void) 0)
+#endif /* DRIVER_ENABLE_RECORD */
+
+#endif /* DRIVER_RECORDER_HPP */
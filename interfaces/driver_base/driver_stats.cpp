@@ -0,0 +1,243 @@
+/**
+ * @file driver_stats.cpp
+ * @author your name (you@domain.com)
+ * @brief Lock-free performance counters and latency histograms for drivers
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "driver_stats.hpp"
+
+#if DRIVER_ENABLE_STATS
+
+#include <chrono>
+#include <cstring>
+
+// Number of attempts at getting a snapshot no update overlapped
+constexpr uint32_t DRIVER_STATS_SNAPSHOT_RETRIES = 16;
+
+/**
+ * @brief Constructor
+ */
+DriverStats::DriverStats()
+{
+  reset();
+}
+
+/**
+ * @brief Account for the end of a read request
+ * @param status Status of the request
+ * @param bytes Number of bytes read
+ */
+void DriverStats::countRead(Status_t status, Size_t bytes)
+{
+  m_update_begin.fetch_add(1, std::memory_order_seq_cst);
+  m_read_ops.fetch_add(1, std::memory_order_relaxed);
+  if(bytes > 0) { m_bytes_read.fetch_add(bytes, std::memory_order_relaxed);}
+  countStatus(status);
+  m_update_end.fetch_add(1, std::memory_order_seq_cst);
+}
+
+/**
+ * @brief Account for the end of a write request
+ * @param status Status of the request
+ * @param bytes Number of bytes written
+ */
+void DriverStats::countWrite(Status_t status, Size_t bytes)
+{
+  m_update_begin.fetch_add(1, std::memory_order_seq_cst);
+  m_write_ops.fetch_add(1, std::memory_order_relaxed);
+  if(bytes > 0) { m_bytes_written.fetch_add(bytes, std::memory_order_relaxed);}
+  countStatus(status);
+  m_update_end.fetch_add(1, std::memory_order_seq_cst);
+}
+
+/**
+ * @brief Account for a request rejected because the driver was busy
+ */
+void DriverStats::countBusy()
+{
+  m_update_begin.fetch_add(1, std::memory_order_seq_cst);
+  m_busy.fetch_add(1, std::memory_order_relaxed);
+  m_update_end.fetch_add(1, std::memory_order_seq_cst);
+}
+
+/**
+ * @brief Add a sample to a latency histogram
+ * @param latency Histogram to update
+ * @param duration_ns Sample in nanoseconds
+ */
+void DriverStats::recordLatency(DriverLatencyList_t latency, uint64_t duration_ns)
+{
+  if(latency >= DRIVER_LATENCY_COUNT) { return;}
+  m_update_begin.fetch_add(1, std::memory_order_seq_cst);
+  m_latency[latency][getBucket(duration_ns)].fetch_add(1, std::memory_order_relaxed);
+  m_update_end.fetch_add(1, std::memory_order_seq_cst);
+}
+
+/**
+ * @brief Add the time elapsed since a timestamp to a latency histogram
+ * @param latency Histogram to update
+ * @param start_ns Timestamp taken with getTimeNs()
+ */
+void DriverStats::recordSince(DriverLatencyList_t latency, uint64_t start_ns)
+{
+  uint64_t now = getTimeNs();
+  recordLatency(latency, now > start_ns ? now - start_ns : 0);
+}
+
+/**
+ * @brief Copy every counter at a single point in time
+ *
+ * @note A copy is accepted only if no update started after the last one
+ *       that had completed when the copy began.
+ *
+ * @param snapshot Storage for the copy
+ * @return bool false if updates kept overlapping the copy
+ */
+bool DriverStats::getSnapshot(DriverStatsSnapshot_t &snapshot)
+{
+  uint64_t updates_done;
+
+  for(uint32_t attempt = 0; attempt < DRIVER_STATS_SNAPSHOT_RETRIES; attempt++)
+  {
+    updates_done = m_update_end.load(std::memory_order_seq_cst);
+    if(m_update_begin.load(std::memory_order_seq_cst) != updates_done) { continue;}
+
+    snapshot.read_ops = m_read_ops.load(std::memory_order_relaxed);
+    snapshot.write_ops = m_write_ops.load(std::memory_order_relaxed);
+    snapshot.bytes_read = m_bytes_read.load(std::memory_order_relaxed);
+    snapshot.bytes_written = m_bytes_written.load(std::memory_order_relaxed);
+    snapshot.errors = m_errors.load(std::memory_order_relaxed);
+    snapshot.timeouts = m_timeouts.load(std::memory_order_relaxed);
+    snapshot.busy = m_busy.load(std::memory_order_relaxed);
+    for(uint32_t i = 0; i < DRIVER_LATENCY_COUNT; i++)
+    {
+      for(uint32_t j = 0; j < DRIVER_STATS_BUCKETS; j++)
+      {
+        snapshot.latency[i][j] = m_latency[i][j].load(std::memory_order_relaxed);
+      }
+    }
+
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if(m_update_begin.load(std::memory_order_seq_cst) == updates_done) { return true;}
+  }
+  return false;
+}
+
+/**
+ * @brief Zero every counter
+ */
+void DriverStats::reset()
+{
+  m_update_begin.fetch_add(1, std::memory_order_seq_cst);
+  m_read_ops = 0;
+  m_write_ops = 0;
+  m_bytes_read = 0;
+  m_bytes_written = 0;
+  m_errors = 0;
+  m_timeouts = 0;
+  m_busy = 0;
+  for(uint32_t i = 0; i < DRIVER_LATENCY_COUNT; i++)
+  {
+    for(uint32_t j = 0; j < DRIVER_STATS_BUCKETS; j++)
+    {
+      m_latency[i][j].store(0, std::memory_order_relaxed);
+    }
+  }
+  m_update_end.fetch_add(1, std::memory_order_seq_cst);
+}
+
+/**
+ * @brief Get a monotonic timestamp
+ * @return uint64_t Time in nanoseconds
+ */
+uint64_t DriverStats::getTimeNs()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief Get the histogram bucket of a sample, buckets are linear up to
+ *        DRIVER_STATS_SUB_BUCKETS and then split each power of two evenly
+ * @param duration_ns Sample in nanoseconds
+ * @return uint32_t
+ */
+uint32_t DriverStats::getBucket(uint64_t duration_ns)
+{
+  uint32_t msb, shift, bucket;
+
+  if(duration_ns < DRIVER_STATS_SUB_BUCKETS) { return (uint32_t) duration_ns;}
+
+  msb = 63 - __builtin_clzll(duration_ns);
+  shift = msb - DRIVER_STATS_SUB_BUCKET_BITS;
+  bucket = (shift + 1) * DRIVER_STATS_SUB_BUCKETS + ((duration_ns >> shift) & (DRIVER_STATS_SUB_BUCKETS - 1));
+  return bucket < DRIVER_STATS_BUCKETS ? bucket : DRIVER_STATS_BUCKETS - 1;
+}
+
+/**
+ * @brief Get the smallest sample that falls in a bucket
+ * @param bucket Bucket index
+ * @return uint64_t Time in nanoseconds
+ */
+uint64_t DriverStats::getBucketLowerBound(uint32_t bucket)
+{
+  uint32_t shift;
+
+  if(bucket < DRIVER_STATS_SUB_BUCKETS) { return bucket;}
+  shift = bucket / DRIVER_STATS_SUB_BUCKETS - 1;
+  return (uint64_t)(DRIVER_STATS_SUB_BUCKETS + bucket % DRIVER_STATS_SUB_BUCKETS) << shift;
+}
+
+/**
+ * @brief Estimate a percentile from a histogram
+ * @param snapshot Snapshot holding the histogram
+ * @param latency Histogram to use
+ * @param percentile Value between 0 and 100
+ * @return uint64_t Lower bound of the bucket holding the percentile, in ns
+ */
+uint64_t DriverStats::getPercentile(const DriverStatsSnapshot_t &snapshot, DriverLatencyList_t latency, double percentile)
+{
+  uint64_t total = 0, target, count = 0;
+
+  if(latency >= DRIVER_LATENCY_COUNT) { return 0;}
+  for(uint32_t i = 0; i < DRIVER_STATS_BUCKETS; i++) { total += snapshot.latency[latency][i];}
+  if(total == 0) { return 0;}
+
+  target = (uint64_t)(percentile / 100.0 * total + 0.5);
+  if(target == 0) { target = 1;}
+  for(uint32_t i = 0; i < DRIVER_STATS_BUCKETS; i++)
+  {
+    count += snapshot.latency[latency][i];
+    if(count >= target) { return getBucketLowerBound(i);}
+  }
+  return getBucketLowerBound(DRIVER_STATS_BUCKETS - 1);
+}
+
+/**
+ * @brief Update the error counters from the status of a request
+ * @param status Status of the request
+ */
+void DriverStats::countStatus(Status_t status)
+{
+  // Reads that time out without error still succeed, e.g. STATUS_DRV_TIMED_OUT
+  if(status.code == OPERATION_TIMED_OUT || status.code == ERR_TIMEOUT)
+  {
+    m_timeouts.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  if(status.success) { return;}
+  if(status.code == ERR_BUSY)
+  {
+    m_busy.fetch_add(1, std::memory_order_relaxed);
+  }else
+  {
+    m_errors.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+#endif /* DRIVER_ENABLE_STATS */
@@ -0,0 +1,138 @@
+/**
+ * @file driver_stats.hpp
+ * @author your name (you@domain.com)
+ * @brief Lock-free performance counters and latency histograms for drivers
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef DRIVER_STATS_HPP
+#define DRIVER_STATS_HPP
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <atomic>
+
+#include "commons.hpp"
+#if __has_include("setup.hpp")
+#include "setup.hpp"
+#endif
+
+#ifndef DRIVER_ENABLE_STATS
+#define DRIVER_ENABLE_STATS                                                    1
+#endif
+
+// Each power of two is split in 2^DRIVER_STATS_SUB_BUCKET_BITS buckets
+#ifndef DRIVER_STATS_SUB_BUCKET_BITS
+#define DRIVER_STATS_SUB_BUCKET_BITS                                           2
+#endif
+
+// Latencies of 2^DRIVER_STATS_MAX_BITS ns (about 18 minutes) or more share the last bucket
+#ifndef DRIVER_STATS_MAX_BITS
+#define DRIVER_STATS_MAX_BITS                                                 40
+#endif
+
+constexpr uint32_t DRIVER_STATS_SUB_BUCKETS = 1u << DRIVER_STATS_SUB_BUCKET_BITS;
+constexpr uint32_t DRIVER_STATS_BUCKETS = (DRIVER_STATS_MAX_BITS - DRIVER_STATS_SUB_BUCKET_BITS + 1) * DRIVER_STATS_SUB_BUCKETS;
+
+/**
+ * @brief List of latencies measured by drivers
+ */
+typedef enum
+{
+  DRIVER_LATENCY_QUEUE_WAIT,  /*!< From submission until a worker picks the request */
+  DRIVER_LATENCY_SYSCALL,     /*!< Time spent on the peripheral itself */
+  DRIVER_LATENCY_CALLBACK,    /*!< Time spent in the user's callback */
+  DRIVER_LATENCY_COUNT,
+}DriverLatencyList_t;
+
+/**
+ * @brief Copy of a driver's counters taken at a single point in time
+ */
+typedef struct
+{
+  uint64_t read_ops;
+  uint64_t write_ops;
+  uint64_t bytes_read;
+  uint64_t bytes_written;
+  uint64_t errors;            /*!< Failed requests, timeouts excluded */
+  uint64_t timeouts;          /*!< Requests that timed out, with or without error */
+  uint64_t busy;              /*!< Requests rejected because the driver was busy */
+  uint32_t latency[DRIVER_LATENCY_COUNT][DRIVER_STATS_BUCKETS];  /*!< Histograms in ns */
+}DriverStatsSnapshot_t;
+
+#if DRIVER_ENABLE_STATS
+
+/**
+ * @brief Per-driver counters, updated from any thread without locks
+ *
+ * @note Readers get a consistent snapshot: updates are bracketed by two
+ *       counters and a copy is only accepted when no update overlapped it.
+ */
+class DriverStats
+{
+public:
+  DriverStats();
+
+  void countRead(Status_t status, Size_t bytes);
+  void countWrite(Status_t status, Size_t bytes);
+  void countBusy();
+  void recordLatency(DriverLatencyList_t latency, uint64_t duration_ns);
+  void recordSince(DriverLatencyList_t latency, uint64_t start_ns);
+
+  bool getSnapshot(DriverStatsSnapshot_t &snapshot);
+  void reset();
+
+  static uint64_t getTimeNs();
+  static uint32_t getBucket(uint64_t duration_ns);
+  static uint64_t getBucketLowerBound(uint32_t bucket);
+  static uint64_t getPercentile(const DriverStatsSnapshot_t &snapshot, DriverLatencyList_t latency, double percentile);
+
+private:
+  std::atomic<uint64_t> m_update_begin;
+  std::atomic<uint64_t> m_update_end;
+  std::atomic<uint64_t> m_read_ops;
+  std::atomic<uint64_t> m_write_ops;
+  std::atomic<uint64_t> m_bytes_read;
+  std::atomic<uint64_t> m_bytes_written;
+  std::atomic<uint64_t> m_errors;
+  std::atomic<uint64_t> m_timeouts;
+  std::atomic<uint64_t> m_busy;
+  std::atomic<uint32_t> m_latency[DRIVER_LATENCY_COUNT][DRIVER_STATS_BUCKETS];
+
+  void countStatus(Status_t status);
+};
+
+#else
+
+/**
+ * @brief Empty stand-in used when statistics are disabled, every call
+ *        compiles to nothing
+ */
+class DriverStats
+{
+public:
+  void countRead(Status_t status, Size_t bytes) { (void) status; (void) bytes;}
+  void countWrite(Status_t status, Size_t bytes) { (void) status; (void) bytes;}
+  void countBusy() {}
+  void recordLatency(DriverLatencyList_t latency, uint64_t duration_ns) { (void) latency; (void) duration_ns;}
+  void recordSince(DriverLatencyList_t latency, uint64_t start_ns) { (void) latency; (void) start_ns;}
+
+  bool getSnapshot(DriverStatsSnapshot_t &snapshot) { (void) snapshot; return false;}
+  void reset() {}
+
+  static uint64_t getTimeNs() { return 0;}
+  static uint32_t getBucket(uint64_t duration_ns) { (void) duration_ns; return 0;}
+  static uint64_t getBucketLowerBound(uint32_t bucket) { (void) bucket; return 0;}
+  static uint64_t getPercentile(const DriverStatsSnapshot_t &snapshot, DriverLatencyList_t latency, double percentile)
+  {
+    (void) snapshot; (void) latency; (void) percentile; return 0;
+  }
+};
+
+#endif /* DRIVER_ENABLE_STATS */
+
+#endif /* DRIVER_STATS_HPP */
@@ -0,0 +1,432 @@
+/**
+ * @file driver_token.cpp
+ * @author your name (you@domain.com)
+ * @brief Completion tokens for asynchronous driver requests
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "driver_token.hpp"
+#include "task_interface/scheduler_interface.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <thread>
+#include <climits>
+
+#if defined(USE_LINUX)
+#include <unistd.h>
+#include <time.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#endif
+
+constexpr uint32_t DRIVER_TOKEN_PENDING = 0;
+constexpr uint32_t DRIVER_TOKEN_DONE = 1;
+
+/**
+ * @brief Shared state behind a token
+ */
+struct DriverTokenSlot
+{
+  std::atomic<uint32_t> state;    /*!< Futex word, pending or done */
+  std::atomic<uint32_t> refs;     /*!< Zero while the slot is free */
+  std::atomic<uint32_t> waiters;  /*!< Threads blocked on the futex word */
+  std::mutex lock;                /*!< Guards the fields below */
+  DriverRequest_t result;
+  Buffer_t data;
+  DriverCallback_t func;          /*!< Continuation, run once on completion */
+  void *arg;
+  DriverTokenSlot_t *next;        /*!< Token returned by then() */
+};
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "Futex word must be 32 bits wide");
+
+static DriverTokenSlot_t g_token_pool[DRIVER_TOKEN_POOL_SIZE];
+static std::atomic<uint32_t> g_token_cursor(0);
+
+/**
+ * @brief Take a free slot from the pool
+ * @return DriverTokenSlot_t* nullptr if the pool is exhausted
+ */
+static DriverTokenSlot_t *acquireSlot()
+{
+  uint32_t start = g_token_cursor.fetch_add(1, std::memory_order_relaxed);
+  uint32_t expected;
+
+  for(uint32_t i = 0; i < DRIVER_TOKEN_POOL_SIZE; i++)
+  {
+    DriverTokenSlot_t *slot = &g_token_pool[(start + i) % DRIVER_TOKEN_POOL_SIZE];
+    expected = 0;
+    if(slot->refs.load(std::memory_order_relaxed) == 0 &&
+       slot->refs.compare_exchange_strong(expected, 1, std::memory_order_acquire))
+    {
+      slot->state.store(DRIVER_TOKEN_PENDING, std::memory_order_relaxed);
+      slot->func = nullptr;
+      slot->arg = nullptr;
+      slot->next = nullptr;
+      return slot;
+    }
+  }
+  return nullptr;
+}
+
+/**
+ * @brief Drop a reference to a slot, giving it back to the pool on the last one
+ * @param slot Slot to release
+ */
+static void releaseSlot(DriverTokenSlot_t *slot)
+{
+  if(slot == nullptr) { return;}
+  // Continuations are moved out by complete(), which every driver calls
+  // before dropping its reference, so there is nothing left to clean up
+  slot->refs.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+/**
+ * @brief Block until the slot is done or the timeout expires
+ * @param slot Slot to wait on
+ * @param timeout Time to wait in milliseconds
+ * @return true if the slot is done
+ */
+static bool waitSlot(DriverTokenSlot_t *slot, uint32_t timeout)
+{
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+
+  if(slot->state.load(std::memory_order_acquire) == DRIVER_TOKEN_DONE) { return true;}
+  if(timeout == 0) { return false;}
+
+  slot->waiters.fetch_add(1, std::memory_order_seq_cst);
+  while(slot->state.load(std::memory_order_seq_cst) != DRIVER_TOKEN_DONE)
+  {
+#if defined(USE_LINUX)
+    struct timespec ts;
+    struct timespec *ts_ptr = nullptr;
+    if(timeout != UINT32_MAX)
+    {
+      auto remaining = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - std::chrono::steady_clock::now());
+      if(remaining.count() <= 0) { break;}
+      ts.tv_sec = remaining.count() / 1000000000;
+      ts.tv_nsec = remaining.count() % 1000000000;
+      ts_ptr = &ts;
+    }
+    (void) syscall(SYS_futex, reinterpret_cast<uint32_t *>(&slot->state), FUTEX_WAIT_PRIVATE,
+                   DRIVER_TOKEN_PENDING, ts_ptr, nullptr, 0);
+#else
+    if(timeout != UINT32_MAX && std::chrono::steady_clock::now() >= deadline) { break;}
+    std::this_thread::yield();
+#endif
+  }
+  slot->waiters.fetch_sub(1, std::memory_order_relaxed);
+
+  return slot->state.load(std::memory_order_acquire) == DRIVER_TOKEN_DONE;
+}
+
+/**
+ * @brief Constructor, the token is ready and reports a not configured status
+ */
+DriverToken::DriverToken()
+{
+  m_slot = nullptr;
+  m_result = {0, STATUS_DRV_NOT_CONFIGURED, 0, EVENT_NONE};
+}
+
+/**
+ * @brief Constructor, the token is ready and reports the given outcome
+ * @param status Status of the request
+ * @param bytes Number of bytes transferred
+ */
+DriverToken::DriverToken(Status_t status, Size_t bytes)
+{
+  m_slot = nullptr;
+  m_result = {0, status, bytes, EVENT_NONE};
+}
+
+/**
+ * @brief Copy constructor
+ */
+DriverToken::DriverToken(const DriverToken &other)
+{
+  m_slot = other.m_slot;
+  m_result = other.m_result;
+  if(m_slot != nullptr) { m_slot->refs.fetch_add(1, std::memory_order_relaxed);}
+}
+
+/**
+ * @brief Move constructor
+ */
+DriverToken::DriverToken(DriverToken &&other) noexcept
+{
+  m_slot = other.m_slot;
+  m_result = other.m_result;
+  other.m_slot = nullptr;
+}
+
+/**
+ * @brief Destructor
+ */
+DriverToken::~DriverToken()
+{
+  releaseSlot(m_slot);
+}
+
+/**
+ * @brief Copy assignment
+ */
+DriverToken &DriverToken::operator=(const DriverToken &other)
+{
+  if(this != &other)
+  {
+    if(other.m_slot != nullptr) { other.m_slot->refs.fetch_add(1, std::memory_order_relaxed);}
+    releaseSlot(m_slot);
+    m_slot = other.m_slot;
+    m_result = other.m_result;
+  }
+  return *this;
+}
+
+/**
+ * @brief Move assignment
+ */
+DriverToken &DriverToken::operator=(DriverToken &&other) noexcept
+{
+  if(this != &other)
+  {
+    releaseSlot(m_slot);
+    m_slot = other.m_slot;
+    m_result = other.m_result;
+    other.m_slot = nullptr;
+  }
+  return *this;
+}
+
+/**
+ * @brief Create a pending token
+ * @param event Event reported to continuations
+ * @param data Buffer used by the request
+ * @return DriverToken Not valid if the pool is exhausted
+ */
+DriverToken DriverToken::create(DriverEventsList_t event, Buffer_t data)
+{
+  DriverToken token(STATUS_DRV_ERR_BUSY);
+
+  token.m_slot = acquireSlot();
+  if(token.m_slot != nullptr)
+  {
+    token.m_slot->data = data;
+    token.m_slot->result = {0, STATUS_DRV_RUNNING, 0, event};
+    token.m_slot->result.status.success = false;
+  }
+  return token;
+}
+
+/**
+ * @brief Check if the token is backed by a pool slot
+ * @return bool
+ */
+bool DriverToken::valid()
+{
+  return m_slot != nullptr;
+}
+
+/**
+ * @brief Check if the request is done, never blocks
+ * @return bool
+ */
+bool DriverToken::ready()
+{
+  if(m_slot == nullptr) { return true;}
+  return m_slot->state.load(std::memory_order_acquire) == DRIVER_TOKEN_DONE;
+}
+
+/**
+ * @brief Block until the request is done
+ * @param timeout Time to wait in milliseconds before returning an error
+ * @return Status_t Status of the request or STATUS_DRV_ERR_TIMEOUT
+ */
+Status_t DriverToken::wait(uint32_t timeout)
+{
+  if(m_slot == nullptr) { return m_result.status;}
+  if(!waitSlot(m_slot, timeout)) { return STATUS_DRV_ERR_TIMEOUT;}
+  return m_slot->result.status;
+}
+
+/**
+ * @brief Get the outcome of the request, only meaningful once ready
+ * @return DriverRequest_t
+ */
+DriverRequest_t DriverToken::getResult()
+{
+  if(m_slot == nullptr) { return m_result;}
+  std::lock_guard<std::mutex> lock(m_slot->lock);
+  return m_slot->result;
+}
+
+/**
+ * @brief Chain a function to run once the request is done
+ *
+ * @note The function runs on the driver's worker thread, or immediately on
+ *       the calling thread if the request is already done. Only one
+ *       continuation can be chained to a token.
+ *
+ * @param function Function to run, its return value completes the new token
+ * @param user_arg Argument passed to the function
+ * @return DriverToken Token completed with the status returned by function
+ */
+DriverToken DriverToken::then(DriverCallback_t function, void *user_arg)
+{
+  DriverToken next;
+  DriverRequest_t result;
+  Status_t status;
+
+  if(function == nullptr) { return DriverToken(STATUS_DRV_NULL_POINTER);}
+
+  if(m_slot != nullptr)
+  {
+    next = create(m_slot->result.event, m_slot->data);
+    if(!next.valid()) { return next;}
+
+    std::unique_lock<std::mutex> lock(m_slot->lock);
+    if(m_slot->state.load(std::memory_order_acquire) != DRIVER_TOKEN_DONE)
+    {
+      if(m_slot->func != nullptr) { return DriverToken(STATUS_DRV_ERR_BUSY);}
+      m_slot->func = function;
+      m_slot->arg = user_arg;
+      m_slot->next = static_cast<DriverTokenSlot_t *>(next.attach());
+      return next;
+    }
+    lock.unlock();
+    next = DriverToken();
+  }
+
+  result = getResult();
+  Buffer_t data = m_slot != nullptr ? Buffer_t(m_slot->data.data(), result.bytes) : Buffer_t();
+  status = function(result.status, result.event, data, user_arg);
+  return DriverToken(status, result.bytes);
+}
+
+/**
+ * @brief Check if a coroutine awaiting the token can go on without suspending
+ * @return bool
+ */
+bool DriverToken::await_ready()
+{
+  return ready();
+}
+
+/**
+ * @brief Resume a coroutine once the request is done
+ *
+ * @note The coroutine is posted to the scheduler running on the calling
+ *       thread, or resumed on the driver's worker if there is none. A
+ *       continuation given to then() runs first, the coroutine is resumed
+ *       after it.
+ *
+ * @param handle Coroutine to resume
+ * @return bool false if the coroutine must not suspend
+ */
+bool DriverToken::await_suspend(std::coroutine_handle<> handle)
+{
+  SchedulerInterface *scheduler = SchedulerInterface::current();
+  DriverCallback_t continuation;
+  void *continuation_arg;
+
+  if(m_slot == nullptr) { return false;}
+
+  std::lock_guard<std::mutex> lock(m_slot->lock);
+  if(m_slot->state.load(std::memory_order_acquire) == DRIVER_TOKEN_DONE) { return false;}
+
+  // The token of the continuation still gets its status through m_slot->next
+  continuation = std::move(m_slot->func);
+  continuation_arg = m_slot->arg;
+  m_slot->func = [handle, scheduler, continuation, continuation_arg](Status_t status, DriverEventsList_t event,
+                                                                     const Buffer_t data, void *user_arg)
+  {
+    (void) user_arg;
+    if(continuation != nullptr)
+    {
+      status = continuation(status, event, data, continuation_arg);
+    }
+    if(scheduler != nullptr)
+    {
+      scheduler->post(handle);
+    }else
+    {
+      handle.resume();
+    }
+    return status;
+  };
+  m_slot->arg = nullptr;
+  return true;
+}
+
+/**
+ * @brief Get the status of the request once a coroutine is resumed
+ * @return Status_t
+ */
+Status_t DriverToken::await_resume()
+{
+  return wait();
+}
+
+/**
+ * @brief Take a reference for the driver completing the request
+ * @return void* Opaque pointer to give back to complete(), nullptr if not valid
+ */
+void *DriverToken::attach()
+{
+  if(m_slot == nullptr) { return nullptr;}
+  m_slot->refs.fetch_add(1, std::memory_order_relaxed);
+  return m_slot;
+}
+
+/**
+ * @brief Report the outcome of a request, wake its waiters, run its
+ *        continuation and drop the driver's reference
+ * @param completion Pointer returned by attach(), nullptr is ignored
+ * @param request Outcome of the request
+ */
+void DriverToken::complete(void *completion, const DriverRequest_t &request)
+{
+  DriverTokenSlot_t *slot = static_cast<DriverTokenSlot_t *>(completion);
+  DriverTokenSlot_t *next;
+  DriverCallback_t func;
+  DriverRequest_t next_result;
+  void *arg;
+
+  if(slot == nullptr) { return;}
+
+  {
+    std::lock_guard<std::mutex> lock(slot->lock);
+    slot->result.id = request.id;
+    slot->result.status = request.status;
+    slot->result.bytes = request.bytes;
+    func = std::move(slot->func);
+    slot->func = nullptr;
+    arg = slot->arg;
+    next = slot->next;
+    slot->next = nullptr;
+    slot->state.store(DRIVER_TOKEN_DONE, std::memory_order_seq_cst);
+  }
+
+#if defined(USE_LINUX)
+  if(slot->waiters.load(std::memory_order_seq_cst) > 0)
+  {
+    (void) syscall(SYS_futex, reinterpret_cast<uint32_t *>(&slot->state), FUTEX_WAKE_PRIVATE,
+                   INT_MAX, nullptr, nullptr, 0);
+  }
+#endif
+
+  if(func != nullptr)
+  {
+    Buffer_t data(slot->data.data(), request.bytes);
+    next_result = {request.id, func(request.status, slot->result.event, data, arg), request.bytes, slot->result.event};
+    complete(next, next_result);
+  }
+
+  releaseSlot(slot);
+}
@@ -0,0 +1,74 @@
+/**
+ * @file driver_token.hpp
+ * @author your name (you@domain.com)
+ * @brief Completion tokens for asynchronous driver requests
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef DRIVER_TOKEN_HPP
+#define DRIVER_TOKEN_HPP
+
+#include <coroutine>
+
+#include "commons.hpp"
+#include "driver_base_types.hpp"
+#if __has_include("setup.hpp")
+#include "setup.hpp"
+#endif
+
+#ifndef DRIVER_TOKEN_POOL_SIZE
+#define DRIVER_TOKEN_POOL_SIZE                                                64
+#endif
+
+typedef struct DriverTokenSlot DriverTokenSlot_t;
+
+/**
+ * @brief Handle to the outcome of one asynchronous request
+ *
+ * @note Tokens are reference counted handles to slots taken from a fixed
+ *       pool, copying one is cheap and no memory is allocated per request.
+ *       A token that could not get a slot, or that was created from a
+ *       status, is ready from the start. Tokens can be awaited from a
+ *       coroutine, the coroutine is resumed on the scheduler it runs on.
+ */
+class DriverToken
+{
+public:
+  DriverToken();
+  DriverToken(Status_t status, Size_t bytes = 0);
+  DriverToken(const DriverToken &other);
+  DriverToken(DriverToken &&other) noexcept;
+  ~DriverToken();
+
+  DriverToken &operator=(const DriverToken &other);
+  DriverToken &operator=(DriverToken &&other) noexcept;
+
+  static DriverToken create(DriverEventsList_t event, Buffer_t data);
+
+  bool valid();
+  bool ready();
+
+  Status_t wait(uint32_t timeout = UINT32_MAX);
+  DriverRequest_t getResult();
+
+  DriverToken then(DriverCallback_t function, void *user_arg = nullptr);
+
+  // Awaitable interface
+  bool await_ready();
+  bool await_suspend(std::coroutine_handle<> handle);
+  Status_t await_resume();
+
+  // Used by drivers to carry the token through their request queues
+  void *attach();
+  static void complete(void *completion, const DriverRequest_t &request);
+
+private:
+  DriverTokenSlot_t *m_slot;
+  DriverRequest_t m_result;
+};
+
+#endif /* DRIVER_TOKEN_HPP */
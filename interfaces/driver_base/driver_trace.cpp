@@ -0,0 +1,323 @@
+/**
+ * @file driver_trace.cpp
+ * @author your name (you@domain.com)
+ * @brief Per-thread event rings exported as Chrome trace JSON
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "driver_trace.hpp"
+
+#if DRIVER_ENABLE_TRACE
+
+#include <cstdio>
+#include <chrono>
+
+/**
+ * @brief A recorded event, fields are atomic because dump() may read a slot
+ *        while its thread overwrites it
+ */
+typedef struct
+{
+  std::atomic<uint64_t> timestamp;
+  std::atomic<uint64_t> id;
+  std::atomic<const char *> category;
+  std::atomic<const char *> name;
+  std::atomic<char> phase;
+}DriverTraceEvent_t;
+
+/**
+ * @brief Events of a single thread, written only by that thread
+ */
+typedef struct
+{
+  std::atomic<uint64_t> head;     /*!< Number of slots ever claimed */
+  std::atomic<uint64_t> committed;  /*!< Number of events fully written */
+  std::atomic<uint64_t> tail;     /*!< Events before this one were cleared */
+  std::atomic<const char *> thread_name;
+  DriverTraceEvent_t events[DRIVER_TRACE_RING_SIZE];
+}DriverTraceRing_t;
+
+static std::atomic<DriverTraceRing_t *> s_rings[DRIVER_TRACE_MAX_THREADS];
+static std::atomic<uint32_t> s_ring_count(0);
+static std::atomic<uint64_t> s_dropped(0);
+static const uint64_t s_start_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+  std::chrono::steady_clock::now().time_since_epoch()).count();
+
+/**
+ * @brief Get the calling thread's ring, claiming one on first use
+ * @return DriverTraceRing_t* or nullptr when every ring is taken
+ */
+static DriverTraceRing_t *getRing()
+{
+  thread_local DriverTraceRing_t *ring = nullptr;
+  thread_local bool claimed = false;
+  uint32_t index;
+
+  if(claimed) { return ring;}
+  claimed = true;
+
+  index = s_ring_count.fetch_add(1, std::memory_order_relaxed);
+  if(index >= DRIVER_TRACE_MAX_THREADS) { return nullptr;}
+
+  // Rings are never freed so that events of finished threads can be dumped
+  ring = new DriverTraceRing_t();
+  ring->head.store(0, std::memory_order_relaxed);
+  ring->committed.store(0, std::memory_order_relaxed);
+  ring->tail.store(0, std::memory_order_relaxed);
+  ring->thread_name.store(nullptr, std::memory_order_relaxed);
+  s_rings[index].store(ring, std::memory_order_release);
+  return ring;
+}
+
+/**
+ * @brief Write a string as a JSON string literal
+ * @param file Output file
+ * @param text The string, nullptr is written as an empty string
+ */
+static void writeJsonString(FILE *file, const char *text)
+{
+  fputc('"', file);
+  for(; text != nullptr && *text != '\0'; text++)
+  {
+    if(*text == '"' || *text == '\\')
+    {
+      fputc('\\', file);
+      fputc(*text, file);
+    }else if((unsigned char) *text < 0x20)
+    {
+      fprintf(file, "\\u%04x", (unsigned char) *text);
+    }else
+    {
+      fputc(*text, file);
+    }
+  }
+  fputc('"', file);
+}
+
+/**
+ * @brief Record the beginning of a duration event
+ * @param category Group the event belongs to, e.g. the driver
+ * @param name Name of the event
+ */
+void DriverTrace::begin(const char *category, const char *name)
+{
+  record(DRIVER_TRACE_BEGIN, category, name, 0);
+}
+
+/**
+ * @brief Record the end of a duration event
+ * @param category Group the event belongs to, e.g. the driver
+ * @param name Name of the event
+ */
+void DriverTrace::end(const char *category, const char *name)
+{
+  record(DRIVER_TRACE_END, category, name, 0);
+}
+
+/**
+ * @brief Record an event without duration
+ * @param category Group the event belongs to, e.g. the driver
+ * @param name Name of the event
+ */
+void DriverTrace::instant(const char *category, const char *name)
+{
+  record(DRIVER_TRACE_INSTANT, category, name, 0);
+}
+
+/**
+ * @brief Record the start of an arrow going to another thread, bound to the
+ *        duration event currently open on this thread
+ * @param category Group the event belongs to, e.g. the driver
+ * @param name Name of the event
+ * @param id Identifier shared with the matching flowEnd()
+ */
+void DriverTrace::flowBegin(const char *category, const char *name, uint64_t id)
+{
+  record(DRIVER_TRACE_FLOW_BEGIN, category, name, id);
+}
+
+/**
+ * @brief Record the end of an arrow coming from another thread, bound to the
+ *        duration event currently open on this thread
+ * @param category Group the event belongs to, e.g. the driver
+ * @param name Name of the event
+ * @param id Identifier given to the matching flowBegin()
+ */
+void DriverTrace::flowEnd(const char *category, const char *name, uint64_t id)
+{
+  record(DRIVER_TRACE_FLOW_END, category, name, id);
+}
+
+/**
+ * @brief Name the calling thread on the timeline
+ * @param name Name of the thread
+ */
+void DriverTrace::setThreadName(const char *name)
+{
+  DriverTraceRing_t *ring = getRing();
+  if(ring == nullptr) { return;}
+  ring->thread_name.store(name, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Write every recorded event to a Chrome trace JSON file, which can be
+ *        opened on chrome://tracing or ui.perfetto.dev
+ *
+ * @note Threads keep recording while the file is written, events overwritten
+ *       meanwhile are left out.
+ * @param path Path of the file
+ * @return Status_t
+ */
+Status_t DriverTrace::dump(const char *path)
+{
+  DriverTraceRing_t *ring;
+  DriverTraceEvent_t *event;
+  uint64_t head, first, index, timestamp;
+  uint32_t ring_count, tid;
+  bool first_event = true;
+  char phase;
+  FILE *file;
+
+  if(path == nullptr) { return STATUS_DRV_NULL_POINTER;}
+  file = fopen(path, "w");
+  if(file == nullptr) { return STATUS_DRV_ERR_PARAM;}
+
+  fprintf(file, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+  ring_count = s_ring_count.load(std::memory_order_relaxed);
+  if(ring_count > DRIVER_TRACE_MAX_THREADS) { ring_count = DRIVER_TRACE_MAX_THREADS;}
+  for(tid = 0; tid < ring_count; tid++)
+  {
+    ring = s_rings[tid].load(std::memory_order_acquire);
+    if(ring == nullptr) { continue;}
+
+    fprintf(file, "%s\n{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":", first_event ? "" : ",", tid + 1);
+    if(ring->thread_name.load(std::memory_order_relaxed) != nullptr)
+    {
+      writeJsonString(file, ring->thread_name.load(std::memory_order_relaxed));
+    }else
+    {
+      fprintf(file, "\"thread %u\"", tid + 1);
+    }
+    fprintf(file, "}}");
+    first_event = false;
+
+    head = ring->committed.load(std::memory_order_acquire);
+    first = head > DRIVER_TRACE_RING_SIZE ? head - DRIVER_TRACE_RING_SIZE : 0;
+    if(ring->tail.load(std::memory_order_relaxed) > first) { first = ring->tail.load(std::memory_order_relaxed);}
+    for(index = first; index < head; index++)
+    {
+      event = &ring->events[index & (DRIVER_TRACE_RING_SIZE - 1)];
+      timestamp = event->timestamp.load(std::memory_order_relaxed);
+      phase = event->phase.load(std::memory_order_relaxed);
+      const char *category = event->category.load(std::memory_order_relaxed);
+      const char *name = event->name.load(std::memory_order_relaxed);
+      uint64_t id = event->id.load(std::memory_order_relaxed);
+
+      // The slot is valid only if its thread has not wrapped around since
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if(ring->head.load(std::memory_order_relaxed) >= index + DRIVER_TRACE_RING_SIZE) { continue;}
+
+      timestamp = timestamp > s_start_ns ? timestamp - s_start_ns : 0;
+      fprintf(file, ",\n{\"ph\":\"%c\",\"pid\":1,\"tid\":%u,\"ts\":%llu.%03llu,\"cat\":", phase, tid + 1,
+        (unsigned long long) (timestamp / 1000), (unsigned long long) (timestamp % 1000));
+      writeJsonString(file, category);
+      fprintf(file, ",\"name\":");
+      writeJsonString(file, name);
+      if(phase == DRIVER_TRACE_FLOW_BEGIN || phase == DRIVER_TRACE_FLOW_END)
+      {
+        fprintf(file, ",\"id\":\"0x%llx\",\"bp\":\"e\"", (unsigned long long) id);
+      }else if(phase == DRIVER_TRACE_INSTANT)
+      {
+        fprintf(file, ",\"s\":\"t\"");
+      }
+      fputc('}', file);
+    }
+  }
+  fprintf(file, "\n]}\n");
+
+  if(fclose(file) != 0) { return STATUS_DRV_UNKNOWN_ERROR;}
+  return STATUS_DRV_SUCCESS;
+}
+
+/**
+ * @brief Forget every recorded event
+ */
+void DriverTrace::clear()
+{
+  DriverTraceRing_t *ring;
+  uint32_t ring_count = s_ring_count.load(std::memory_order_relaxed);
+
+  if(ring_count > DRIVER_TRACE_MAX_THREADS) { ring_count = DRIVER_TRACE_MAX_THREADS;}
+  for(uint32_t tid = 0; tid < ring_count; tid++)
+  {
+    ring = s_rings[tid].load(std::memory_order_acquire);
+    if(ring == nullptr) { continue;}
+    ring->tail.store(ring->committed.load(std::memory_order_acquire), std::memory_order_relaxed);
+  }
+  s_dropped.store(0, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Get the number of events lost because every ring was taken
+ * @return uint64_t
+ */
+uint64_t DriverTrace::getDropped()
+{
+  return s_dropped.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Append an event to the calling thread's ring
+ * @param phase Kind of event
+ * @param category Group the event belongs to
+ * @param name Name of the event
+ * @param id Flow identifier, unused by other kinds of event
+ */
+void DriverTrace::record(DriverTracePhase_t phase, const char *category, const char *name, uint64_t id)
+{
+  DriverTraceRing_t *ring = getRing();
+  DriverTraceEvent_t *event;
+  uint64_t head;
+
+  if(ring == nullptr)
+  {
+    s_dropped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  head = ring->head.load(std::memory_order_relaxed);
+  // Publish the new head first so that dump() drops the slot being rewritten
+  ring->head.store(head + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  event = &ring->events[head & (DRIVER_TRACE_RING_SIZE - 1)];
+  event->timestamp.store(std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count(), std::memory_order_relaxed);
+  event->id.store(id, std::memory_order_relaxed);
+  event->category.store(category, std::memory_order_relaxed);
+  event->name.store(name, std::memory_order_relaxed);
+  event->phase.store((char) phase, std::memory_order_relaxed);
+  ring->committed.store(head + 1, std::memory_order_release);
+}
+
+#else
+
+void DriverTrace::begin(const char *category, const char *name) { (void) category; (void) name;}
+void DriverTrace::end(const char *category, const char *name) { (void) category; (void) name;}
+void DriverTrace::instant(const char *category, const char *name) { (void) category; (void) name;}
+void DriverTrace::flowBegin(const char *category, const char *name, uint64_t id) { (void) category; (void) name; (void) id;}
+void DriverTrace::flowEnd(const char *category, const char *name, uint64_t id) { (void) category; (void) name; (void) id;}
+void DriverTrace::setThreadName(const char *name) { (void) name;}
+Status_t DriverTrace::dump(const char *path) { (void) path; return STATUS_DRV_NOT_IMPLEMENTED;}
+void DriverTrace::clear() {}
+uint64_t DriverTrace::getDropped() { return 0;}
+void DriverTrace::record(DriverTracePhase_t phase, const char *category, const char *name, uint64_t id)
+{
+  (void) phase; (void) category; (void) name; (void) id;
+}
+
+#endif /* DRIVER_ENABLE_TRACE */
@@ -0,0 +1,122 @@
+/**
+ * @file driver_trace.hpp
+ * @author your name (you@domain.com)
+ * @brief Per-thread event rings exported as Chrome trace JSON
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef DRIVER_TRACE_HPP
+#define DRIVER_TRACE_HPP
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <atomic>
+
+#include "commons.hpp"
+#if __has_include("setup.hpp")
+#include "setup.hpp"
+#endif
+
+#ifndef DRIVER_ENABLE_TRACE
+#define DRIVER_ENABLE_TRACE                                                    0
+#endif
+
+// Number of events kept per thread, older events are overwritten
+#ifndef DRIVER_TRACE_RING_SIZE
+#define DRIVER_TRACE_RING_SIZE                                              4096
+#endif
+
+// Number of threads that can record events, later threads are ignored
+#ifndef DRIVER_TRACE_MAX_THREADS
+#define DRIVER_TRACE_MAX_THREADS                                              32
+#endif
+
+static_assert((DRIVER_TRACE_RING_SIZE & (DRIVER_TRACE_RING_SIZE - 1)) == 0, "DRIVER_TRACE_RING_SIZE must be a power of two");
+
+/**
+ * @brief Kind of trace event, values are the Chrome trace phases
+ */
+typedef enum
+{
+  DRIVER_TRACE_BEGIN = 'B',
+  DRIVER_TRACE_END = 'E',
+  DRIVER_TRACE_INSTANT = 'i',
+  DRIVER_TRACE_FLOW_BEGIN = 's',
+  DRIVER_TRACE_FLOW_END = 'f',
+}DriverTracePhase_t;
+
+/**
+ * @brief Records driver events in lock-free per-thread rings and exports them
+ *        in the Chrome trace format, which Perfetto opens as well
+ *
+ * @note Categories and names, thread names included, are stored as
+ *       pointers: pass string literals or strings that outlive the trace.
+ *       Each ring has a single writer, its own thread, so recording an
+ *       event costs a clock read and a few relaxed stores.
+ */
+class DriverTrace
+{
+public:
+  static void begin(const char *category, const char *name);
+  static void end(const char *category, const char *name);
+  static void instant(const char *category, const char *name);
+  static void flowBegin(const char *category, const char *name, uint64_t id);
+  static void flowEnd(const char *category, const char *name, uint64_t id);
+
+  static void setThreadName(const char *name);
+
+  static Status_t dump(const char *path);
+  static void clear();
+  static uint64_t getDropped();
+
+private:
+  static void record(DriverTracePhase_t phase, const char *category, const char *name, uint64_t id);
+};
+
+/**
+ * @brief Records a begin event now and the matching end event when leaving
+ *        the scope
+ */
+class DriverTraceScope
+{
+public:
+  DriverTraceScope(const char *category, const char *name) : m_category(category), m_name(name)
+  {
+    DriverTrace::begin(m_category, m_name);
+  }
+
+  ~DriverTraceScope()
+  {
+    DriverTrace::end(m_category, m_name);
+  }
+
+  DriverTraceScope(const DriverTraceScope &) = delete;
+  DriverTraceScope &operator=(const DriverTraceScope &) = delete;
+
+private:
+  const char *m_category;
+  const char *m_name;
+};
+
+#define DRIVER_TRACE_CONCAT_(a, b) a##b
+#define DRIVER_TRACE_CONCAT(a, b) DRIVER_TRACE_CONCAT_(a, b)
+
+#if DRIVER_ENABLE_TRACE
+#define DRIVER_TRACE_SCOPE(category, name)           DriverTraceScope DRIVER_TRACE_CONCAT(trace_scope_, __LINE__)(category, name)
+#define DRIVER_TRACE_EVENT(category, name)           DriverTrace::instant(category, name)
+#define DRIVER_TRACE_HOP_BEGIN(category, name, id)   DriverTrace::flowBegin(category, name, id)
+#define DRIVER_TRACE_HOP_END(category, name, id)     DriverTrace::flowEnd(category, name, id)
+#define DRIVER_TRACE_THREAD_NAME(name)               DriverTrace::setThreadName(name)
+#else
+#define DRIVER_TRACE_SCOPE(category, name)           ((void) 0)
+#define DRIVER_TRACE_EVENT(category, name)           ((void) 0)
+#define DRIVER_TRACE_HOP_BEGIN(category, name, id)   ((void) 0)
+#define DRIVER_TRACE_HOP_END(category, name, id)     ((void) 0)
+#define DRIVER_TRACE_THREAD_NAME(name)               ((void) 0)
+#endif /* DRIVER_ENABLE_TRACE */
+
+#endif /* DRIVER_TRACE_HPP */
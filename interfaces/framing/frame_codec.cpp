@@ -0,0 +1,547 @@
+/**
+ * @file frame_codec.cpp
+ * @author your name (you@domain.com)
+ * @brief SLIP, COBS and HDLC-like framing of byte streams
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "frame_codec.hpp"
+
+#include <string.h>
+
+constexpr uint8_t SLIP_END = 0xC0;
+constexpr uint8_t SLIP_ESC = 0xDB;
+constexpr uint8_t SLIP_ESC_END = 0xDC;
+constexpr uint8_t SLIP_ESC_ESC = 0xDD;
+constexpr uint8_t HDLC_FLAG = 0x7E;
+constexpr uint8_t HDLC_ESC = 0x7D;
+constexpr uint8_t HDLC_XOR = 0x20;
+constexpr uint8_t COBS_DELIMITER = 0x00;
+constexpr uint8_t COBS_MAX_CODE = 0xFF;
+
+/**
+ * @brief Bytes that must be escaped on transmission, one entry per value
+ */
+typedef struct
+{
+  bool special[256];
+}EscapeTable_t;
+
+static constexpr EscapeTable_t makeEscapeTable(uint8_t delimiter, uint8_t escape)
+{
+  EscapeTable_t table = {};
+  table.special[delimiter] = true;
+  table.special[escape] = true;
+  return table;
+}
+
+static constexpr EscapeTable_t SLIP_TABLE = makeEscapeTable(SLIP_END, SLIP_ESC);
+static constexpr EscapeTable_t HDLC_TABLE = makeEscapeTable(HDLC_FLAG, HDLC_ESC);
+
+/**
+ * @brief Escape the special bytes of a SLIP or HDLC payload, runs without
+ *        special bytes are copied at once
+ * @param data Bytes to escape
+ * @param size Number of bytes
+ * @param output Where the escaped bytes go
+ * @param is_slip True for SLIP, false for HDLC
+ * @return Size_t Number of bytes written
+ */
+static Size_t escape(const uint8_t *data, Size_t size, uint8_t *output, bool is_slip)
+{
+  const EscapeTable_t &table = is_slip ? SLIP_TABLE : HDLC_TABLE;
+  Size_t read = 0, written = 0, run;
+
+  while(read < size)
+  {
+    for(run = 0; read + run < size && !table.special[data[read + run]]; run++) {}
+    memcpy(output + written, data + read, run);
+    written += run;
+    read += run;
+    if(read == size) { break;}
+    if(is_slip)
+    {
+      output[written++] = SLIP_ESC;
+      output[written++] = data[read] == SLIP_END ? SLIP_ESC_END : SLIP_ESC_ESC;
+    }else
+    {
+      output[written++] = HDLC_ESC;
+      output[written++] = data[read] ^ HDLC_XOR;
+    }
+    read++;
+  }
+  return written;
+}
+
+/**
+ * @brief Encode a SLIP or HDLC frame
+ * @param data Payload
+ * @param size Number of bytes of the payload
+ * @param trailer Bytes sent after the payload, e.g. its checksum, may be nullptr
+ * @param trailer_size Number of bytes of the trailer
+ * @param output Buffer large enough for the worst case
+ * @param is_slip True for SLIP, false for HDLC
+ * @return Size_t Number of bytes written
+ */
+static Size_t encodeEscaped(const uint8_t *data, Size_t size, const uint8_t *trailer, Size_t trailer_size,
+                            uint8_t *output, bool is_slip)
+{
+  uint8_t delimiter = is_slip ? SLIP_END : HDLC_FLAG;
+  Size_t written = 0;
+
+  // A leading delimiter ends whatever noise the receiver got before
+  output[written++] = delimiter;
+  written += escape(data, size, output + written, is_slip);
+  written += escape(trailer, trailer_size, output + written, is_slip);
+  output[written++] = delimiter;
+  return written;
+}
+
+/**
+ * @brief Add bytes to a COBS frame being encoded
+ * @param data Bytes to add
+ * @param size Number of bytes
+ * @param output The frame
+ * @param code Index of the code of the open block, -1 after a full block
+ * @param written Number of bytes of the frame
+ */
+static void encodeCobsPart(const uint8_t *data, Size_t size, uint8_t *output, Size_t &code, Size_t &written)
+{
+  const uint8_t *zero;
+  Size_t read = 0, run;
+
+  while(read < size)
+  {
+    // A full block has no zero after it, the next one opens on its first byte
+    if(code < 0) { code = written++;}
+    zero = (const uint8_t *) memchr(data + read, COBS_DELIMITER, size - read);
+    run = (zero != nullptr ? (Size_t) (zero - data) : size) - read;
+    if(run > COBS_MAX_CODE - (written - code)) { run = COBS_MAX_CODE - (written - code);}
+    memcpy(output + written, data + read, run);
+    written += run;
+    read += run;
+    if(written - code == COBS_MAX_CODE)
+    {
+      output[code] = COBS_MAX_CODE;
+      code = -1;
+    }else if(read < size)
+    {
+      // The zero ends the block
+      output[code] = (uint8_t) (written - code);
+      code = written++;
+      read++;
+    }
+  }
+}
+
+/**
+ * @brief Encode a COBS frame, followed by its delimiter
+ * @param data Payload
+ * @param size Number of bytes of the payload
+ * @param trailer Bytes sent after the payload, e.g. its checksum, may be nullptr
+ * @param trailer_size Number of bytes of the trailer
+ * @param output Buffer large enough for the worst case
+ * @return Size_t Number of bytes written
+ */
+static Size_t encodeCobs(const uint8_t *data, Size_t size, const uint8_t *trailer, Size_t trailer_size, uint8_t *output)
+{
+  Size_t code = 0, written = 1;
+
+  encodeCobsPart(data, size, output, code, written);
+  encodeCobsPart(trailer, trailer_size, output, code, written);
+  if(code >= 0) { output[code] = (uint8_t) (written - code);}
+  output[written++] = COBS_DELIMITER;
+  return written;
+}
+
+/**
+ * @brief Constructor
+ * @param mode The framing
+ * @param buffer_size Bytes buffered on reception, the longest encoded frame
+ *        must fit
+ */
+FrameCodec::FrameCodec(FramingMode_t mode, Size_t buffer_size)
+{
+  m_mode = mode;
+  switch(mode)
+  {
+    case FRAMING_SLIP:
+      m_delimiter = SLIP_END;
+      break;
+    case FRAMING_HDLC:
+      m_delimiter = HDLC_FLAG;
+      break;
+    default:
+      m_delimiter = COBS_DELIMITER;
+      break;
+  }
+  m_buffer.resize(buffer_size > 0 ? buffer_size : FRAMING_BUFFER_SIZE);
+  m_func = nullptr;
+  m_arg = nullptr;
+  memset(&m_stats, 0, sizeof(m_stats));
+  reset();
+}
+
+/**
+ * @brief Install the function called with each frame received
+ *
+ * @note The frame is a view into the codec's buffer, valid until the
+ *       function returns.
+ * @param function Called with EVENT_READ and the payload
+ * @param user_arg Argument passed to the function
+ */
+void FrameCodec::setCallback(DriverCallback_t function, void *user_arg)
+{
+  m_func = function;
+  m_arg = user_arg;
+}
+
+/**
+ * @brief Get where the next bytes received go
+ *
+ * @note The partial frame at the end of the buffer is moved to its start
+ *       once less than a quarter of the buffer is left.
+ * @param free_size Storage for the number of bytes that may be written
+ * @return uint8_t* Free space of the buffer
+ */
+uint8_t *FrameCodec::getWriteBuffer(Size_t &free_size)
+{
+  Size_t buffer_size = (Size_t) m_buffer.size();
+
+  if(m_start > 0 && buffer_size - m_end < buffer_size / 4)
+  {
+    memmove(m_buffer.data(), m_buffer.data() + m_start, m_end - m_start);
+    m_stats.moved_bytes += m_end - m_start;
+    m_scanned -= m_start;
+    m_end -= m_start;
+    m_start = 0;
+  }
+  free_size = buffer_size - m_end;
+  return m_buffer.data() + m_end;
+}
+
+/**
+ * @brief Decode bytes written at getWriteBuffer(), the callback runs for
+ *        each frame they complete
+ * @param byte_count Number of bytes written
+ * @return Status_t
+ */
+Status_t FrameCodec::commit(Size_t byte_count)
+{
+  uint8_t *data = m_buffer.data();
+  uint8_t *delimiter;
+  Size_t position;
+
+  if(byte_count < 0 || byte_count > (Size_t) m_buffer.size() - m_end) { return STATUS_DRV_ERR_PARAM_SIZE;}
+  m_end += byte_count;
+
+  while(m_scanned < m_end)
+  {
+    delimiter = (uint8_t *) memchr(data + m_scanned, m_delimiter, m_end - m_scanned);
+    if(delimiter == nullptr)
+    {
+      m_scanned = m_end;
+      break;
+    }
+    position = (Size_t) (delimiter - data);
+    if(m_discarding)
+    {
+      m_discarding = false;
+    }else
+    {
+      emitFrame(data + m_start, position - m_start);
+    }
+    m_start = position + 1;
+    m_scanned = m_start;
+  }
+
+  if(m_start == m_end)
+  {
+    m_start = 0;
+    m_scanned = 0;
+    m_end = 0;
+  }else if(m_start == 0 && m_end == (Size_t) m_buffer.size())
+  {
+    // No delimiter in a full buffer, drop up to the next one
+    if(!m_discarding) { m_stats.overflows++;}
+    m_discarding = true;
+    m_scanned = 0;
+    m_end = 0;
+  }
+  return STATUS_DRV_SUCCESS;
+}
+
+/**
+ * @brief Decode bytes from a buffer of the caller, they are copied into the
+ *        codec
+ * @param data Bytes received
+ * @param byte_count Number of bytes
+ * @return Status_t
+ */
+Status_t FrameCodec::decode(const uint8_t *data, Size_t byte_count)
+{
+  uint8_t *free_space;
+  Size_t free_size, size;
+  Status_t status;
+
+  if(data == nullptr && byte_count != 0) { return STATUS_DRV_NULL_POINTER;}
+  while(byte_count > 0)
+  {
+    free_space = getWriteBuffer(free_size);
+    size = byte_count < free_size ? byte_count : free_size;
+    memcpy(free_space, data, size);
+    status = commit(size);
+    if(!status.success) { return status;}
+    data += size;
+    byte_count -= size;
+  }
+  return STATUS_DRV_SUCCESS;
+}
+
+/**
+ * @brief Drop the bytes of the frame being received
+ */
+void FrameCodec::reset()
+{
+  m_start = 0;
+  m_scanned = 0;
+  m_end = 0;
+  m_discarding = false;
+}
+
+/**
+ * @brief Encode a frame, delimiters included
+ * @param data Payload
+ * @param byte_count Number of bytes of the payload
+ * @param output Buffer to store the frame, at least getEncodedSizeMax() of
+ *        the payload and its checksum
+ * @param output_size Number of bytes of the buffer
+ * @param encoded_size Storage for the number of bytes of the frame
+ * @return Status_t
+ */
+Status_t FrameCodec::encode(const uint8_t *data, Size_t byte_count, uint8_t *output, Size_t output_size, Size_t &encoded_size)
+{
+  uint8_t trailer[CHECKSUM_SIZE_MAX];
+  Size_t trailer_size;
+
+  if((data == nullptr && byte_count != 0) || output == nullptr) { return STATUS_DRV_NULL_POINTER;}
+  if(byte_count < 0 || output_size < getEncodedSizeMax(m_mode, byte_count + m_checksum.getSize())) { return STATUS_DRV_ERR_PARAM_SIZE;}
+
+  // The checksum is encoded after the payload, which is read where it is
+  trailer_size = Checksum::getTrailer(m_checksum.getType(), data, byte_count, trailer);
+
+  if(m_mode == FRAMING_COBS)
+  {
+    encoded_size = encodeCobs(data, byte_count, trailer, trailer_size, output);
+  }else
+  {
+    encoded_size = encodeEscaped(data, byte_count, trailer, trailer_size, output, m_mode == FRAMING_SLIP);
+  }
+  return STATUS_DRV_SUCCESS;
+}
+
+/**
+ * @brief Get the size of the longest frame a payload may be encoded into
+ * @param mode The framing
+ * @param byte_count Number of bytes of the payload
+ * @return Size_t
+ */
+Size_t FrameCodec::getEncodedSizeMax(FramingMode_t mode, Size_t byte_count)
+{
+  if(mode == FRAMING_COBS)
+  {
+    // One code per block of 254 bytes and the delimiter
+    return byte_count + byte_count / (COBS_MAX_CODE - 1) + 2;
+  }
+  // Every byte escaped and two delimiters
+  return 2 * byte_count + 2;
+}
+
+/**
+ * @brief Decode a frame in place and pass it to the callback
+ * @param frame Bytes between two delimiters
+ * @param size Number of bytes
+ */
+void FrameCodec::emitFrame(uint8_t *frame, Size_t size)
+{
+  uint8_t *decoded = frame;
+  Size_t decoded_size = size;
+
+  if(size == 0) { return;}
+  if(m_mode == FRAMING_COBS)
+  {
+    decoded = decodeCobs(frame, size, decoded_size);
+  }else
+  {
+    decoded_size = unescape(frame, size);
+  }
+  if(decoded == nullptr || decoded_size < 0)
+  {
+    m_stats.malformed++;
+    return;
+  }
+  if(decoded_size == 0) { return;}
+  if(m_checksum.isEnabled())
+  {
+    if(!m_checksum.verify(decoded, decoded_size).success)
+    {
+      m_stats.bad_checksums++;
+      return;
+    }
+    decoded_size -= m_checksum.getSize();
+  }
+
+  m_stats.frames++;
+  m_stats.bytes += decoded_size;
+  if(m_func != nullptr)
+  {
+    (void) m_func(STATUS_DRV_SUCCESS, EVENT_READ, Buffer_t(decoded, decoded_size), m_arg);
+  }
+}
+
+/**
+ * @brief Remove the escapes of a SLIP or HDLC frame in place, frames
+ *        without escapes are left untouched
+ * @param frame Bytes between two delimiters
+ * @param size Number of bytes
+ * @return Size_t Number of bytes decoded, -1 if an escape is invalid
+ */
+Size_t FrameCodec::unescape(uint8_t *frame, Size_t size)
+{
+  uint8_t escape = m_mode == FRAMING_SLIP ? SLIP_ESC : HDLC_ESC;
+  uint8_t *escaped = (uint8_t *) memchr(frame, escape, size);
+  Size_t read, written, run;
+  uint8_t value;
+
+  if(escaped == nullptr) { return size;}
+
+  read = (Size_t) (escaped - frame);
+  written = read;
+  while(read < size)
+  {
+    // frame[read] is an escape
+    if(read + 1 >= size) { return -1;}
+    value = frame[read + 1];
+    if(m_mode == FRAMING_SLIP)
+    {
+      if(value == SLIP_ESC_END)
+      {
+        value = SLIP_END;
+      }else if(value == SLIP_ESC_ESC)
+      {
+        value = SLIP_ESC;
+      }else
+      {
+        return -1;
+      }
+    }else
+    {
+      value ^= HDLC_XOR;
+    }
+    frame[written++] = value;
+    read += 2;
+
+    escaped = (uint8_t *) memchr(frame + read, escape, size - read);
+    run = (escaped != nullptr ? (Size_t) (escaped - frame) : size) - read;
+    memmove(frame + written, frame + read, run);
+    written += run;
+    read += run;
+  }
+  return written;
+}
+
+/**
+ * @brief Decode a COBS frame in place
+ *
+ * @note The payload starts one byte after the frame, each code but the
+ *       first becomes the zero it stands for. Bytes only move after a
+ *       block of 254 bytes, which has no zero after it.
+ * @param frame Bytes between two delimiters
+ * @param size Number of bytes
+ * @param decoded_size Storage for the number of bytes decoded
+ * @return uint8_t* The payload, nullptr if a code points past the frame
+ */
+uint8_t *FrameCodec::decodeCobs(uint8_t *frame, Size_t size, Size_t &decoded_size)
+{
+  uint8_t *output = frame + 1;
+  Size_t read = 0, written = 0, run;
+  uint8_t code = frame[0], next;
+
+  while(true)
+  {
+    // Codes are never zero, zeros end frames
+    if(read + code > size) { return nullptr;}
+    run = code - 1;
+    if(written != read) { memmove(output + written, frame + read + 1, run);}
+    written += run;
+    read += code;
+    if(read == size) { break;}
+    // Taken before the zero below overwrites it
+    next = frame[read];
+    if(code != COBS_MAX_CODE) { output[written++] = 0;}
+    code = next;
+  }
+  decoded_size = written;
+  return output;
+}
+
+/**
+ * @brief Constructor
+ * @param uart The driver, configured in blocking mode
+ * @param mode The framing
+ * @param buffer_size Bytes buffered on reception and for the frame sent
+ */
+FrameLink::FrameLink(UartBase &uart, FramingMode_t mode, Size_t buffer_size) :
+m_uart(uart),
+m_codec(mode, buffer_size)
+{
+  m_tx_buffer.resize(buffer_size > 0 ? buffer_size : FRAMING_BUFFER_SIZE);
+}
+
+/**
+ * @brief Wait for bytes and decode all of them, the callback runs for each
+ *        frame they complete
+ *
+ * @note The first byte is waited for, everything received by then is taken
+ *       in a second request that does not wait.
+ * @param timeout Time to wait in milliseconds for the first byte
+ * @return Status_t STATUS_DRV_TIMED_OUT if nothing came
+ */
+Status_t FrameLink::receive(uint32_t timeout)
+{
+  Status_t status;
+  uint8_t *free_space;
+  Size_t free_size, received;
+
+  free_space = m_codec.getWriteBuffer(free_size);
+  status = m_uart.read(free_space, 1, timeout);
+  if(!status.success || m_uart.getBytesRead() <= 0) { return status;}
+
+  received = 1;
+  if(free_size > 1 && m_uart.read(free_space + 1, free_size - 1, 0).success)
+  {
+    received += m_uart.getBytesRead();
+  }
+  return m_codec.commit(received);
+}
+
+/**
+ * @brief Encode a frame and write it
+ * @param data Payload
+ * @param byte_count Number of bytes of the payload
+ * @param timeout Time to wait in milliseconds before returning an error
+ * @return Status_t
+ */
+Status_t FrameLink::send(const uint8_t *data, Size_t byte_count, uint32_t timeout)
+{
+  Status_t status;
+  Size_t encoded_size;
+
+  status = m_codec.encode(data, byte_count, m_tx_buffer.data(), (Size_t) m_tx_buffer.size(), encoded_size);
+  if(!status.success) { return status;}
+  return m_uart.write(m_tx_buffer.data(), encoded_size, timeout);
+}
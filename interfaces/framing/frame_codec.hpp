@@ -0,0 +1,162 @@
+/**
+ * @file frame_codec.hpp
+ * @author your name (you@domain.com)
+ * @brief SLIP, COBS and HDLC-like framing of byte streams
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef FRAME_CODEC_HPP
+#define FRAME_CODEC_HPP
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <vector>
+
+#include "peripherals_base/uart_base.hpp"
+#include "checksum/checksum.hpp"
+#if __has_include("setup.hpp")
+#include "setup.hpp"
+#endif
+
+// Bytes buffered on reception, the longest encoded frame must fit
+#ifndef FRAMING_BUFFER_SIZE
+#define FRAMING_BUFFER_SIZE                                                 4096
+#endif
+
+/**
+ * @brief Supported framings
+ */
+typedef enum
+{
+  FRAMING_SLIP,           /*!< RFC 1055, 0xC0 ends frames, 0xDB escapes */
+  FRAMING_COBS,           /*!< Consistent overhead byte stuffing, 0x00 ends frames */
+  FRAMING_HDLC,           /*!< 0x7E around frames, 0x7D escapes the next byte XOR 0x20, FCS from setChecksum() */
+}FramingMode_t;
+
+/**
+ * @brief Counters of a codec
+ */
+typedef struct
+{
+  uint64_t frames;        /*!< Frames decoded */
+  uint64_t bytes;         /*!< Bytes of the frames decoded */
+  uint64_t malformed;     /*!< Frames dropped for a bad escape or COBS code */
+  uint64_t overflows;     /*!< Frames dropped for not fitting the buffer */
+  uint64_t bad_checksums; /*!< Frames dropped for a checksum that does not match */
+  uint64_t moved_bytes;   /*!< Bytes of partial frames moved to the start of the buffer */
+}FrameCodecStats_t;
+
+/**
+ * @brief Splits a byte stream into frames and encodes frames into it
+ *
+ * @note Received bytes are written straight into the codec's buffer, see
+ *       getWriteBuffer() and commit(). Delimiters are found with memchr(),
+ *       vectorised by the C library, and frames are decoded in place since
+ *       they only shrink, so the callback gets a view into the buffer and
+ *       no byte is copied. SLIP and HDLC frames without escaped bytes and
+ *       COBS frames shorter than 254 bytes are not even moved. Only the
+ *       partial frame left at the end of the buffer is moved to its start
+ *       when the buffer runs out of space. Empty frames are skipped, so
+ *       repeated delimiters may be used to resynchronise the receiver.
+ *       With setChecksum() every frame carries a checksum after its
+ *       payload, encode() appends it and frames that fail it are dropped,
+ *       the callback only gets the payload. CHECKSUM_CRC16_X25 gives the
+ *       FCS-16 of HDLC.
+ *
+ * @code
+ * FrameCodec codec(FRAMING_COBS);
+ * codec.setCallback(onFrame, nullptr);
+ * Size_t free_size;
+ * uint8_t *free_space = codec.getWriteBuffer(free_size);
+ * uart.read(free_space, free_size, 5);
+ * codec.commit(uart.getBytesRead());   // onFrame() runs for each frame
+ * @endcode
+ */
+class FrameCodec
+{
+public:
+  FrameCodec(FramingMode_t mode, Size_t buffer_size = FRAMING_BUFFER_SIZE);
+
+  FramingMode_t getMode() { return m_mode;}
+
+  void setCallback(DriverCallback_t function, void *user_arg = nullptr);
+
+  Status_t setChecksum(ChecksumType_t type) { return m_checksum.setType(type);}
+
+  ChecksumType_t getChecksum() { return m_checksum.getType();}
+
+  uint8_t *getWriteBuffer(Size_t &free_size);
+
+  Status_t commit(Size_t byte_count);
+
+  Status_t decode(const uint8_t *data, Size_t byte_count);
+
+  void reset();
+
+  Status_t encode(const uint8_t *data, Size_t byte_count, uint8_t *output, Size_t output_size, Size_t &encoded_size);
+
+  static Size_t getEncodedSizeMax(FramingMode_t mode, Size_t byte_count);
+
+  FrameCodecStats_t getStats() { return m_stats;}
+
+private:
+  FramingMode_t m_mode;
+  uint8_t m_delimiter;
+  std::vector<uint8_t> m_buffer;
+  Size_t m_start;         /*!< First byte of the frame being received */
+  Size_t m_scanned;       /*!< Bytes already searched for a delimiter */
+  Size_t m_end;           /*!< Bytes in the buffer */
+  bool m_discarding;      /*!< Dropping bytes up to the next delimiter */
+  DriverCallback_t m_func;
+  void *m_arg;
+  FrameCodecStats_t m_stats;
+  FrameChecksum m_checksum;
+
+  void emitFrame(uint8_t *frame, Size_t size);
+
+  Size_t unescape(uint8_t *frame, Size_t size);
+
+  uint8_t *decodeCobs(uint8_t *frame, Size_t size, Size_t &decoded_size);
+};
+
+/**
+ * @brief Frames sent and received over a UART
+ *
+ * @note receive() reads everything available in one request, straight into
+ *       the codec, and calls back once per complete frame. The driver must
+ *       work in blocking mode, which is the default. send() encodes into a
+ *       buffer of the link and writes it in one request.
+ *
+ * @code
+ * UART uart("/dev/ttyUSB0");
+ * uart.configure(settings, 1);
+ * FrameLink link(uart, FRAMING_SLIP);
+ * link.setCallback(onFrame, nullptr);
+ * link.send(command, sizeof(command));
+ * while(running) { link.receive(5);}
+ * @endcode
+ */
+class FrameLink
+{
+public:
+  FrameLink(UartBase &uart, FramingMode_t mode, Size_t buffer_size = FRAMING_BUFFER_SIZE);
+
+  void setCallback(DriverCallback_t function, void *user_arg = nullptr) { m_codec.setCallback(function, user_arg);}
+
+  Status_t receive(uint32_t timeout = UINT32_MAX);
+
+  Status_t send(const uint8_t *data, Size_t byte_count, uint32_t timeout = UINT32_MAX);
+
+  FrameCodec &getCodec() { return m_codec;}
+
+private:
+  UartBase &m_uart;
+  FrameCodec m_codec;
+  std::vector<uint8_t> m_tx_buffer;
+};
+
+#endif /* FRAME_CODEC_HPP */
@@ -22,7 +22,7 @@
 #endif
 
 #ifndef IIC_QUEUE_SIZE
-#define IIC_QUEUE_SIZE                                                         1
+#define IIC_QUEUE_SIZE                                                         8
 #endif
 
 /**
@@ -42,6 +42,9 @@ public:
   using DriverInOutBase::write;
   virtual Status_t write(uint8_t *data, Size_t byte_count, uint32_t timeout = UINT32_MAX) = 0;
 
+  // Write then read with a repeated start, no stop in between
+  virtual Status_t writeRead(uint8_t *tx_data, Size_t tx_size, uint8_t *rx_data, Size_t rx_size, uint32_t timeout = UINT32_MAX) = 0;
+
   virtual Status_t setCallback(DriverEventsList_t event = EVENT_NONE, DriverCallback_t function = nullptr, void *user_arg = nullptr) = 0;
 };
 
@@ -22,7 +22,7 @@
 #endif
 
 #ifndef SPI_QUEUE_SIZE
-#define SPI_QUEUE_SIZE                                                         1
+#define SPI_QUEUE_SIZE                                                         8
 #endif
 
 /**
@@ -43,6 +43,9 @@ public:
   virtual Status_t transfer(uint8_t *rx_data, uint8_t *tx_data, Size_t byte_count, uint32_t timeout = UINT32_MAX) = 0;
   virtual Status_t transfer(Buffer_t rx_data, Buffer_t tx_data, uint32_t timeout = UINT32_MAX) = 0;
 
+  virtual DriverToken transferAsync(uint8_t *rx_data, uint8_t *tx_data, Size_t byte_count, uint32_t timeout = UINT32_MAX) = 0;
+  virtual DriverToken transferAsync(PoolBuffer buffer, uint32_t timeout = UINT32_MAX) = 0;
+
   virtual Status_t setCallback(DriverEventsList_t event = EVENT_NONE, DriverCallback_t function = nullptr, void *user_arg = nullptr) = 0;
 };
 
@@ -22,7 +22,7 @@
 #endif
 
 #ifndef UART_QUEUE_SIZE
-#define UART_QUEUE_SIZE                                                        1
+#define UART_QUEUE_SIZE                                                        8
 #endif
 
 /**
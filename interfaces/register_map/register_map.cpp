@@ -0,0 +1,427 @@
+/**
+ * @file register_map.cpp
+ * @author your name (you@domain.com)
+ * @brief Cached register map of a device behind SPI or IIC
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "register_map.hpp"
+
+#include <string.h>
+
+// Flags kept for each register
+constexpr uint8_t REGISTER_VALID = 0x01;     // The copy in memory matches the device
+constexpr uint8_t REGISTER_DIRTY = 0x02;     // The copy in memory was not sent yet
+constexpr uint8_t REGISTER_VOLATILE = 0x04;  // The device changes the register on its own
+
+/**
+ * @brief Constructor
+ * @param config How registers are addressed, an address size other than 2
+ *        is taken as 1
+ */
+RegisterMap::RegisterMap(const RegisterMapConfig_t &config)
+{
+  m_config = config;
+  if(m_config.address_size != 2) { m_config.address_size = 1;}
+  m_values.assign(m_config.register_count, 0);
+  m_flags.assign(m_config.register_count, 0);
+  m_frame.resize(m_config.address_size + getMaxBurst());
+  memset(&m_stats, 0, sizeof(m_stats));
+}
+
+/**
+ * @brief Mark registers as changed by the device, they are never cached
+ * @param first First register
+ * @param count Number of registers
+ * @param is_volatile False to allow caching again
+ * @return Status_t
+ */
+Status_t RegisterMap::setVolatile(uint16_t first, uint16_t count, bool is_volatile)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  if(!checkRange(first, count)) { return STATUS_DRV_ERR_PARAM_SIZE;}
+  for(uint16_t i = first; i < first + count; i++)
+  {
+    if(is_volatile)
+    {
+      m_flags[i] = (m_flags[i] | REGISTER_VOLATILE) & ~REGISTER_VALID;
+    }else
+    {
+      m_flags[i] &= ~REGISTER_VOLATILE;
+    }
+  }
+  return STATUS_DRV_SUCCESS;
+}
+
+/**
+ * @brief Read a register
+ * @param address The register
+ * @param value Variable to store the value
+ * @return Status_t
+ */
+Status_t RegisterMap::read(uint16_t address, uint8_t &value)
+{
+  return read(address, &value, 1);
+}
+
+/**
+ * @brief Read consecutive registers, the bus is only used when one of them
+ *        is volatile or was never read
+ * @param address First register
+ * @param data Buffer to store the values
+ * @param count Number of registers
+ * @return Status_t
+ */
+Status_t RegisterMap::read(uint16_t address, uint8_t *data, uint16_t count)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  Status_t status;
+
+  if(data == nullptr) { return STATUS_DRV_NULL_POINTER;}
+  if(!checkRange(address, count)) { return STATUS_DRV_ERR_PARAM_SIZE;}
+
+  if(isCached(address, count))
+  {
+    m_stats.cache_hits += count;
+  }else
+  {
+    status = fetch(address, count);
+    if(!status.success) { return status;}
+  }
+  memcpy(data, &m_values[address], count);
+  return STATUS_DRV_SUCCESS;
+}
+
+/**
+ * @brief Write a register
+ * @param address The register
+ * @param value The value
+ * @return Status_t
+ */
+Status_t RegisterMap::write(uint16_t address, uint8_t value)
+{
+  return write(address, &value, 1);
+}
+
+/**
+ * @brief Write consecutive registers, non-volatile ones are sent by sync()
+ *        and a range holding a volatile register is sent right away
+ * @param address First register
+ * @param data The values
+ * @param count Number of registers
+ * @return Status_t
+ */
+Status_t RegisterMap::write(uint16_t address, const uint8_t *data, uint16_t count)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  if(data == nullptr) { return STATUS_DRV_NULL_POINTER;}
+  if(!checkRange(address, count)) { return STATUS_DRV_ERR_PARAM_SIZE;}
+
+  for(uint16_t i = address; i < address + count; i++)
+  {
+    if(m_flags[i] & REGISTER_VOLATILE) { return writeVolatile(address, data, count);}
+  }
+  for(uint16_t i = 0; i < count; i++)
+  {
+    // Writing the value the device already holds costs nothing
+    if((m_flags[address + i] & REGISTER_VALID) && m_values[address + i] == data[i]) { continue;}
+    m_values[address + i] = data[i];
+    m_flags[address + i] |= REGISTER_VALID | REGISTER_DIRTY;
+  }
+  return STATUS_DRV_SUCCESS;
+}
+
+/**
+ * @brief Change some bits of a register, the other bits are kept
+ * @param address The register
+ * @param mask Bits to change
+ * @param value New value of the bits
+ * @return Status_t
+ */
+Status_t RegisterMap::update(uint16_t address, uint8_t mask, uint8_t value)
+{
+  uint8_t current;
+  Status_t status;
+
+  status = read(address, current);
+  if(!status.success) { return status;}
+  return write(address, (uint8_t) ((current & ~mask) | (value & mask)));
+}
+
+/**
+ * @brief Send the dirty registers, each run of adjacent dirty registers goes
+ *        in one transfer
+ * @return Status_t
+ */
+Status_t RegisterMap::sync()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  uint16_t max_burst = getMaxBurst();
+  uint16_t first, count;
+  Status_t status;
+
+  for(first = 0; first < m_config.register_count; first += count)
+  {
+    count = 1;
+    if(!(m_flags[first] & REGISTER_DIRTY)) { continue;}
+    while(count < max_burst && first + count < m_config.register_count &&
+          (m_flags[first + count] & REGISTER_DIRTY))
+    {
+      count++;
+    }
+
+    status = busWrite(first, &m_values[first], count);
+    m_stats.bus_writes++;
+    if(!status.success) { return status;}
+    m_stats.registers_written += count;
+    for(uint16_t i = first; i < first + count; i++) { m_flags[i] &= ~REGISTER_DIRTY;}
+  }
+  return STATUS_DRV_SUCCESS;
+}
+
+/**
+ * @brief Forget the cached values, for example after the device was reset,
+ *        writes not sent yet are lost
+ */
+void RegisterMap::invalidate()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  for(uint8_t &flags : m_flags) { flags &= REGISTER_VOLATILE;}
+}
+
+/**
+ * @brief Check for writes not sent yet
+ * @return true if sync() has something to send
+ */
+bool RegisterMap::isDirty()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  for(uint8_t flags : m_flags)
+  {
+    if(flags & REGISTER_DIRTY) { return true;}
+  }
+  return false;
+}
+
+/**
+ * @brief Get the bus traffic caused by the map
+ * @return RegisterMapStats_t
+ */
+RegisterMapStats_t RegisterMap::getStats()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_stats;
+}
+
+/**
+ * @brief Write the address of a transfer at the start of a frame
+ * @param address The register
+ * @param flags Read, write or burst flags
+ * @param frame The frame, at least address_size bytes
+ */
+void RegisterMap::buildAddress(uint16_t address, uint16_t flags, uint8_t *frame)
+{
+  address |= flags;
+  if(m_config.address_size == 2)
+  {
+    frame[0] = (uint8_t) (address >> 8);
+    frame[1] = (uint8_t) address;
+  }else
+  {
+    frame[0] = (uint8_t) address;
+  }
+}
+
+/**
+ * @brief Check that registers are in the map
+ * @param address First register
+ * @param count Number of registers
+ * @return true if they are
+ */
+bool RegisterMap::checkRange(uint16_t address, uint16_t count)
+{
+  return count > 0 && (uint32_t) address + count <= m_config.register_count;
+}
+
+/**
+ * @brief Check if registers can be served from memory
+ * @param address First register
+ * @param count Number of registers
+ * @return true if all of them are valid and none is volatile
+ */
+bool RegisterMap::isCached(uint16_t address, uint16_t count)
+{
+  for(uint16_t i = address; i < address + count; i++)
+  {
+    if((m_flags[i] & (REGISTER_VALID | REGISTER_VOLATILE)) != REGISTER_VALID) { return false;}
+  }
+  return true;
+}
+
+/**
+ * @brief Read registers from the device into memory, dirty registers keep
+ *        the value waiting to be sent
+ * @param address First register
+ * @param count Number of registers
+ * @return Status_t
+ */
+Status_t RegisterMap::fetch(uint16_t address, uint16_t count)
+{
+  uint16_t max_burst = getMaxBurst();
+  uint16_t chunk;
+  uint8_t value;
+  Status_t status;
+
+  for(; count > 0; address += chunk, count -= chunk)
+  {
+    chunk = count < max_burst ? count : max_burst;
+    // Reuse the tail of the frame, busRead() only needs it for the address
+    status = busRead(address, &m_frame[m_config.address_size], chunk);
+    m_stats.bus_reads++;
+    if(!status.success) { return status;}
+    for(uint16_t i = 0; i < chunk; i++)
+    {
+      value = m_frame[m_config.address_size + i];
+      if(m_flags[address + i] & REGISTER_DIRTY) { continue;}
+      m_values[address + i] = value;
+      if(!(m_flags[address + i] & REGISTER_VOLATILE)) { m_flags[address + i] |= REGISTER_VALID;}
+    }
+  }
+  return STATUS_DRV_SUCCESS;
+}
+
+/**
+ * @brief Send a range holding a volatile register right away, the cached
+ *        registers in it are updated
+ * @param address First register
+ * @param data The values
+ * @param count Number of registers
+ * @return Status_t
+ */
+Status_t RegisterMap::writeVolatile(uint16_t address, const uint8_t *data, uint16_t count)
+{
+  uint16_t max_burst = getMaxBurst();
+  uint16_t chunk;
+  Status_t status;
+
+  for(; count > 0; address += chunk, data += chunk, count -= chunk)
+  {
+    chunk = count < max_burst ? count : max_burst;
+    status = busWrite(address, data, chunk);
+    m_stats.bus_writes++;
+    if(!status.success) { return status;}
+    m_stats.registers_written += chunk;
+    for(uint16_t i = 0; i < chunk; i++)
+    {
+      m_values[address + i] = data[i];
+      if(m_flags[address + i] & REGISTER_VOLATILE) { continue;}
+      m_flags[address + i] = (m_flags[address + i] | REGISTER_VALID) & ~REGISTER_DIRTY;
+    }
+  }
+  return STATUS_DRV_SUCCESS;
+}
+
+/**
+ * @brief Get the longest transfer in registers
+ * @return uint16_t
+ */
+uint16_t RegisterMap::getMaxBurst()
+{
+  if(m_config.max_burst == 0 || m_config.max_burst > m_config.register_count) { return m_config.register_count;}
+  return m_config.max_burst;
+}
+
+/**
+ * @brief Constructor
+ * @param spi The driver, configured by the caller
+ * @param config How registers are addressed
+ */
+SpiRegisterMap::SpiRegisterMap(SpiBase &spi, const RegisterMapConfig_t &config) : RegisterMap(config), m_spi(spi)
+{
+  m_rx_frame.resize(m_frame.size());
+}
+
+/**
+ * @brief Read registers in one transfer, data is clocked in after the address
+ * @param address First register
+ * @param data Buffer to store the values
+ * @param count Number of registers
+ * @return Status_t
+ */
+Status_t SpiRegisterMap::busRead(uint16_t address, uint8_t *data, uint16_t count)
+{
+  uint8_t address_size = m_config.address_size;
+  Status_t status;
+
+  buildAddress(address, m_config.read_flag | (count > 1 ? m_config.burst_flag : 0), m_frame.data());
+  memset(&m_frame[address_size], 0, count);
+  status = m_spi.transfer(m_rx_frame.data(), m_frame.data(), address_size + count);
+  if(!status.success) { return status;}
+  memcpy(data, &m_rx_frame[address_size], count);
+  return status;
+}
+
+/**
+ * @brief Write registers in one transfer
+ * @param address First register
+ * @param data The values
+ * @param count Number of registers
+ * @return Status_t
+ */
+Status_t SpiRegisterMap::busWrite(uint16_t address, const uint8_t *data, uint16_t count)
+{
+  uint8_t address_size = m_config.address_size;
+
+  buildAddress(address, m_config.write_flag | (count > 1 ? m_config.burst_flag : 0), m_frame.data());
+  memcpy(&m_frame[address_size], data, count);
+  return m_spi.write(m_frame.data(), address_size + count);
+}
+
+/**
+ * @brief Constructor
+ * @param iic The driver, configured and addressed by the caller
+ * @param config How registers are addressed
+ */
+IicRegisterMap::IicRegisterMap(IicBase &iic, const RegisterMapConfig_t &config) : RegisterMap(config), m_iic(iic)
+{
+}
+
+/**
+ * @brief Write the register address, then read the registers after a
+ *        repeated start
+ * @param address First register
+ * @param data Buffer to store the values
+ * @param count Number of registers
+ * @return Status_t
+ */
+Status_t IicRegisterMap::busRead(uint16_t address, uint8_t *data, uint16_t count)
+{
+  uint8_t frame[2];
+
+  buildAddress(address, m_config.read_flag | (count > 1 ? m_config.burst_flag : 0), frame);
+  return m_iic.writeRead(frame, m_config.address_size, data, count);
+}
+
+/**
+ * @brief Write the register address followed by the values in one message
+ * @param address First register
+ * @param data The values
+ * @param count Number of registers
+ * @return Status_t
+ */
+Status_t IicRegisterMap::busWrite(uint16_t address, const uint8_t *data, uint16_t count)
+{
+  uint8_t address_size = m_config.address_size;
+
+  buildAddress(address, m_config.write_flag | (count > 1 ? m_config.burst_flag : 0), m_frame.data());
+  memcpy(&m_frame[address_size], data, count);
+  return m_iic.write(m_frame.data(), address_size + count);
+}
@@ -0,0 +1,136 @@
+/**
+ * @file register_map.hpp
+ * @author your name (you@domain.com)
+ * @brief Cached register map of a device behind SPI or IIC
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef REGISTER_MAP_HPP
+#define REGISTER_MAP_HPP
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <mutex>
+#include <vector>
+
+#include "peripherals_base/spi_base.hpp"
+#include "peripherals_base/iic_base.hpp"
+
+/**
+ * @brief How registers are addressed on the bus
+ */
+typedef struct
+{
+  uint16_t register_count;  /*!< Registers in the map, addresses go from 0 to register_count - 1 */
+  uint8_t address_size;     /*!< Bytes of address sent before the data, 1 or 2, most significant first */
+  uint16_t read_flag;       /*!< OR'ed into the address of reads, e.g. 0x80 on most SPI devices */
+  uint16_t write_flag;      /*!< OR'ed into the address of writes */
+  uint16_t burst_flag;      /*!< OR'ed into the address of transfers longer than a register, 0 if the device auto-increments */
+  uint16_t max_burst;       /*!< Longest transfer in registers, 0 for no limit */
+}RegisterMapConfig_t;
+
+/**
+ * @brief Bus traffic caused by a map
+ */
+typedef struct
+{
+  uint64_t cache_hits;      /*!< Registers read served from memory */
+  uint64_t bus_reads;       /*!< Read transactions on the bus */
+  uint64_t bus_writes;      /*!< Write transactions on the bus */
+  uint64_t registers_written; /*!< Registers sent by the write transactions */
+}RegisterMapStats_t;
+
+/**
+ * @brief Copy of the 8 bit registers of a device
+ *
+ * @note Reads of non-volatile registers are served from memory once the
+ *       register was read or written. Writes to non-volatile registers only
+ *       update memory and mark the register dirty, sync() sends them and
+ *       merges adjacent dirty registers into one burst. Volatile registers,
+ *       status or data registers the device changes on its own, always go
+ *       to the bus.
+ */
+class RegisterMap
+{
+public:
+  RegisterMap(const RegisterMapConfig_t &config);
+  virtual ~RegisterMap() = default;
+
+  Status_t setVolatile(uint16_t first, uint16_t count, bool is_volatile = true);
+
+  Status_t read(uint16_t address, uint8_t &value);
+  Status_t read(uint16_t address, uint8_t *data, uint16_t count);
+
+  Status_t write(uint16_t address, uint8_t value);
+  Status_t write(uint16_t address, const uint8_t *data, uint16_t count);
+
+  Status_t update(uint16_t address, uint8_t mask, uint8_t value);
+
+  Status_t sync();
+
+  void invalidate();
+
+  bool isDirty();
+
+  RegisterMapStats_t getStats();
+
+protected:
+  RegisterMapConfig_t m_config;
+  std::vector<uint8_t> m_frame;
+
+  void buildAddress(uint16_t address, uint16_t flags, uint8_t *frame);
+
+  virtual Status_t busRead(uint16_t address, uint8_t *data, uint16_t count) = 0;
+  virtual Status_t busWrite(uint16_t address, const uint8_t *data, uint16_t count) = 0;
+
+private:
+  std::mutex m_mutex;
+  std::vector<uint8_t> m_values;
+  std::vector<uint8_t> m_flags;
+  RegisterMapStats_t m_stats;
+
+  bool checkRange(uint16_t address, uint16_t count);
+  bool isCached(uint16_t address, uint16_t count);
+  Status_t fetch(uint16_t address, uint16_t count);
+  Status_t writeVolatile(uint16_t address, const uint8_t *data, uint16_t count);
+  uint16_t getMaxBurst();
+};
+
+/**
+ * @brief Register map of a SPI device, the address goes out first and the
+ *        data follows in the same transfer
+ */
+class SpiRegisterMap final : public RegisterMap
+{
+public:
+  SpiRegisterMap(SpiBase &spi, const RegisterMapConfig_t &config);
+
+private:
+  SpiBase &m_spi;
+  std::vector<uint8_t> m_rx_frame;
+
+  Status_t busRead(uint16_t address, uint8_t *data, uint16_t count) override;
+  Status_t busWrite(uint16_t address, const uint8_t *data, uint16_t count) override;
+};
+
+/**
+ * @brief Register map of an IIC device, reads write the address and then read
+ *        the data, writes send the address followed by the data
+ */
+class IicRegisterMap final : public RegisterMap
+{
+public:
+  IicRegisterMap(IicBase &iic, const RegisterMapConfig_t &config);
+
+private:
+  IicBase &m_iic;
+
+  Status_t busRead(uint16_t address, uint8_t *data, uint16_t count) override;
+  Status_t busWrite(uint16_t address, const uint8_t *data, uint16_t count) override;
+};
+
+#endif /* REGISTER_MAP_HPP */
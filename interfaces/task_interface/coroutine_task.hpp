@@ -0,0 +1,127 @@
+/**
+ * @file coroutine_task.hpp
+ * @author your name (you@domain.com)
+ * @brief Coroutine type for driver state machines
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef COROUTINE_TASK_HPP
+#define COROUTINE_TASK_HPP
+
+#include <coroutine>
+#include <exception>
+#include <utility>
+
+#include "scheduler_interface.hpp"
+
+/**
+ * @brief Lazily started coroutine, either spawned on a scheduler or awaited
+ *        by another coroutine
+ *
+ * @code
+ * CoroutineTask blink(DIO &led, SPT &timer)
+ * {
+ *   while(true)
+ *   {
+ *     led.toggle();
+ *     co_await timer.sleep(500);
+ *   }
+ * }
+ * @endcode
+ */
+class CoroutineTask
+{
+public:
+  struct promise_type
+  {
+    std::coroutine_handle<> continuation;
+    SchedulerInterface *owner = nullptr;
+
+    CoroutineTask get_return_object()
+    {
+      return CoroutineTask(std::coroutine_handle<promise_type>::from_promise(*this));
+    }
+
+    std::suspend_always initial_suspend() noexcept { return {};}
+
+    /**
+     * @brief Resume the awaiting coroutine, or free a spawned task
+     */
+    struct FinalAwaiter
+    {
+      bool await_ready() noexcept { return false;}
+
+      std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> handle) noexcept
+      {
+        std::coroutine_handle<> continuation = handle.promise().continuation;
+        SchedulerInterface *owner = handle.promise().owner;
+
+        if(continuation) { return continuation;}
+        handle.destroy();
+        if(owner != nullptr) { owner->onTaskEnd();}
+        return std::noop_coroutine();
+      }
+
+      void await_resume() noexcept {}
+    };
+
+    FinalAwaiter final_suspend() noexcept { return {};}
+
+    void return_void() {}
+
+    void unhandled_exception() { std::terminate();}
+  };
+
+  CoroutineTask() : m_handle(nullptr) {}
+  explicit CoroutineTask(std::coroutine_handle<promise_type> handle) : m_handle(handle) {}
+  CoroutineTask(CoroutineTask &&other) noexcept : m_handle(std::exchange(other.m_handle, nullptr)) {}
+  CoroutineTask(const CoroutineTask &) = delete;
+  CoroutineTask &operator=(const CoroutineTask &) = delete;
+
+  CoroutineTask &operator=(CoroutineTask &&other) noexcept
+  {
+    if(this != &other)
+    {
+      if(m_handle) { m_handle.destroy();}
+      m_handle = std::exchange(other.m_handle, nullptr);
+    }
+    return *this;
+  }
+
+  ~CoroutineTask()
+  {
+    if(m_handle) { m_handle.destroy();}
+  }
+
+  /**
+   * @brief Give up ownership, the task frees itself once it ends
+   * @param owner Scheduler told when the task ends
+   * @return std::coroutine_handle<> Handle to resume to start the task
+   */
+  std::coroutine_handle<> detach(SchedulerInterface *owner)
+  {
+    std::coroutine_handle<promise_type> handle = std::exchange(m_handle, nullptr);
+    if(handle) { handle.promise().owner = owner;}
+    return handle;
+  }
+
+  // Awaiting a task runs it to completion before resuming the caller
+  bool await_ready() noexcept { return !m_handle || m_handle.done();}
+
+  std::coroutine_handle<> await_suspend(std::coroutine_handle<> caller) noexcept
+  {
+    m_handle.promise().continuation = caller;
+    return m_handle;
+  }
+
+  void await_resume() noexcept {}
+
+private:
+  std::coroutine_handle<promise_type> m_handle;
+};
+
+#endif /* COROUTINE_TASK_HPP */
@@ -0,0 +1,46 @@
+/**
+ * @file scheduler_interface.hpp
+ * @author your name (you@domain.com)
+ * @brief Abstraction layer for coroutine schedulers
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef SCHEDULER_INTERFACE_HPP
+#define SCHEDULER_INTERFACE_HPP
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <coroutine>
+
+/**
+ * @brief Interface class for single-threaded coroutine schedulers
+ *
+ * @note Awaitables use current() to find the scheduler running on the calling
+ *       thread, if there is none they fall back to blocking calls.
+ */
+class SchedulerInterface
+{
+public:
+  virtual ~SchedulerInterface(){;}
+
+  // Resume a coroutine on the scheduler's thread, callable from any thread
+  virtual void post(std::coroutine_handle<> handle) = 0;
+
+  // Called once by every spawned task when it ends
+  virtual void onTaskEnd() = 0;
+
+  // Scheduler running on the calling thread, nullptr if none
+  static SchedulerInterface *current() { return s_current;}
+
+protected:
+  static void setCurrent(SchedulerInterface *scheduler) { s_current = scheduler;}
+
+private:
+  static inline thread_local SchedulerInterface *s_current = nullptr;
+};
+
+#endif /* SCHEDULER_INTERFACE_HPP */
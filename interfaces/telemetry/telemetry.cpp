@@ -0,0 +1,84 @@
+/**
+ * @file telemetry.cpp
+ * @author your name (you@domain.com)
+ * @brief Compact binary frames of telemetry structs
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "telemetry.hpp"
+
+// Longest varint, 64 bits at 7 bits per byte
+constexpr Size_t VARINT_SIZE_MAX = 10;
+
+/**
+ * @brief Write the header of a frame
+ * @param header The header
+ * @param frame Storage of TELEMETRY_HEADER_SIZE bytes
+ */
+void writeTelemetryHeader(const TelemetryHeader_t &header, uint8_t *frame)
+{
+  frame[0] = header.schema_id;
+  frame[1] = header.flags;
+  frame[2] = (uint8_t) header.sequence;
+  frame[3] = (uint8_t) (header.sequence >> 8);
+}
+
+/**
+ * @brief Read the header of a frame, e.g. to pick the decoder of its schema
+ * @param frame The frame
+ * @param size Number of bytes of the frame
+ * @param header Storage for the header
+ * @return Status_t
+ */
+Status_t readTelemetryHeader(const uint8_t *frame, Size_t size, TelemetryHeader_t &header)
+{
+  if(frame == nullptr) { return STATUS_DRV_NULL_POINTER;}
+  if(size < TELEMETRY_HEADER_SIZE) { return STATUS_DRV_ERR_PARAM_SIZE;}
+
+  header.schema_id = frame[0];
+  header.flags = frame[1];
+  header.sequence = (uint16_t) (frame[2] | frame[3] << 8);
+  return STATUS_DRV_SUCCESS;
+}
+
+/**
+ * @brief Write a number 7 bits per byte, least significant first, the top
+ *        bit of a byte tells another one follows
+ * @param value The number
+ * @param output Storage of up to 10 bytes
+ * @return Size_t Number of bytes written
+ */
+Size_t encodeVarint(uint64_t value, uint8_t *output)
+{
+  Size_t size = 0;
+
+  while(value >= 0x80)
+  {
+    output[size++] = (uint8_t) value | 0x80;
+    value >>= 7;
+  }
+  output[size++] = (uint8_t) value;
+  return size;
+}
+
+/**
+ * @brief Read a number written by encodeVarint()
+ * @param input The bytes
+ * @param size Number of bytes available
+ * @param value Storage for the number
+ * @return Size_t Number of bytes read, 0 if the number is cut or too long
+ */
+Size_t decodeVarint(const uint8_t *input, Size_t size, uint64_t &value)
+{
+  value = 0;
+  for(Size_t i = 0; i < size && i < VARINT_SIZE_MAX; i++)
+  {
+    value |= (uint64_t) (input[i] & 0x7F) << (7 * i);
+    if((input[i] & 0x80) == 0) { return i + 1;}
+  }
+  return 0;
+}
@@ -0,0 +1,222 @@
+/**
+ * @file telemetry.hpp
+ * @author your name (you@domain.com)
+ * @brief Compact binary frames of telemetry structs
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifndef TELEMETRY_HPP
+#define TELEMETRY_HPP
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <tuple>
+#include <type_traits>
+
+#include "commons.hpp"
+#include "com_buffer_pool.hpp"
+#include "driver_base/driver_out_base.hpp"
+#if __has_include("setup.hpp")
+#include "setup.hpp"
+#endif
+
+// Bytes before the payload: schema id, flags and sequence number
+constexpr Size_t TELEMETRY_HEADER_SIZE = 4;
+// Set in the flags of frames holding changes since the previous frame
+constexpr uint8_t TELEMETRY_FLAG_DELTA = 0x01;
+
+/**
+ * @brief Header of a frame, little-endian on the wire
+ */
+typedef struct
+{
+  uint8_t schema_id;          /*!< Tells the structs of a stream apart */
+  uint8_t flags;
+  uint16_t sequence;          /*!< Incremented on every frame of a schema */
+}TelemetryHeader_t;
+
+/**
+ * @brief Activity of an encoder
+ */
+typedef struct
+{
+  uint64_t frames;            /*!< Frames encoded */
+  uint64_t keyframes;         /*!< Frames holding every field */
+  uint64_t bytes;             /*!< Bytes of the frames */
+  uint64_t full_bytes;        /*!< Bytes the frames would take without delta encoding */
+}TelemetryStats_t;
+
+void writeTelemetryHeader(const TelemetryHeader_t &header, uint8_t *frame);
+
+Status_t readTelemetryHeader(const uint8_t *frame, Size_t size, TelemetryHeader_t &header);
+
+Size_t encodeVarint(uint64_t value, uint8_t *output);
+
+Size_t decodeVarint(const uint8_t *input, Size_t size, uint64_t &value);
+
+/**
+ * @brief Types behind a pointer to a struct member
+ * @tparam MEMBER Type of the member pointer
+ */
+template <typename MEMBER>
+struct TelemetryMember;
+
+template <typename CLASS, typename FIELD>
+struct TelemetryMember<FIELD CLASS::*>
+{
+  using Class_t = CLASS;
+  using Element_t = std::remove_cv_t<std::remove_all_extents_t<FIELD>>;
+  static constexpr Size_t COUNT = sizeof(FIELD) / sizeof(Element_t);
+  static constexpr bool IS_INTEGER = std::is_integral_v<Element_t>;
+
+  static_assert(std::is_arithmetic_v<Element_t> && !std::is_same_v<Element_t, bool>,
+                "Telemetry fields are integers, floats or arrays of them");
+
+  // Longest encoding of an element in a delta frame
+  static constexpr Size_t DELTA_SIZE_MAX = IS_INTEGER ? (sizeof(Element_t) * 8 + 6) / 7 : sizeof(Element_t);
+};
+
+/**
+ * @brief Wire format of a struct, given as pointers to the members sent
+ *
+ * @note Everything is resolved at compile time: the fields are packed back
+ *       to back in the order given, at their own width and little-endian,
+ *       without the padding of the struct. Delta payloads start with a
+ *       mask of the fields that changed. Only those follow, integers as the
+ *       zigzag varint of their difference to the previous value, floats as
+ *       they are.
+ *
+ * @code
+ * typedef struct { uint32_t tick; int16_t accel[3]; float temperature;} ImuSample_t;
+ * using ImuSchema = TelemetrySchema<&ImuSample_t::tick, &ImuSample_t::accel, &ImuSample_t::temperature>;
+ * static_assert(ImuSchema::PAYLOAD_SIZE == 14);
+ * @endcode
+ *
+ * @tparam MEMBERS Pointers to members of the same struct
+ */
+template <auto... MEMBERS>
+class TelemetrySchema
+{
+public:
+  static_assert(sizeof...(MEMBERS) > 0, "A schema needs at least one field");
+
+  using Sample_t = typename TelemetryMember<std::tuple_element_t<0, std::tuple<decltype(MEMBERS)...>>>::Class_t;
+
+  static_assert((std::is_same_v<typename TelemetryMember<decltype(MEMBERS)>::Class_t, Sample_t> && ...),
+                "Every field must belong to the same struct");
+
+  static constexpr Size_t FIELD_COUNT = sizeof...(MEMBERS);
+  static constexpr Size_t MASK_SIZE = (FIELD_COUNT + 7) / 8;
+  static constexpr Size_t PAYLOAD_SIZE = ((TelemetryMember<decltype(MEMBERS)>::COUNT *
+                                           sizeof(typename TelemetryMember<decltype(MEMBERS)>::Element_t)) + ...);
+  static constexpr Size_t DELTA_SIZE_MAX = MASK_SIZE + ((TelemetryMember<decltype(MEMBERS)>::COUNT *
+                                                         TelemetryMember<decltype(MEMBERS)>::DELTA_SIZE_MAX) + ...);
+  static constexpr Size_t FRAME_SIZE_MAX = TELEMETRY_HEADER_SIZE + (PAYLOAD_SIZE > DELTA_SIZE_MAX ? PAYLOAD_SIZE : DELTA_SIZE_MAX);
+
+  static Size_t pack(const Sample_t &sample, uint8_t *output);
+
+  static Size_t unpack(const uint8_t *input, Sample_t &sample);
+
+  static Size_t packDelta(const Sample_t &sample, const Sample_t &reference, uint8_t *output);
+
+  static Size_t unpackDelta(const uint8_t *input, Size_t size, Sample_t &sample);
+
+  static void copy(const Sample_t &from, Sample_t &to);
+
+private:
+  template <auto MEMBER>
+  static void packField(const Sample_t &sample, uint8_t *&output);
+
+  template <auto MEMBER>
+  static void unpackField(const uint8_t *&input, Sample_t &sample);
+
+  template <auto MEMBER>
+  static void packFieldDelta(const Sample_t &sample, const Sample_t &reference, uint8_t *mask, Size_t index, uint8_t *&output);
+
+  template <auto MEMBER>
+  static bool unpackFieldDelta(const uint8_t *mask, Size_t index, const uint8_t *&input, const uint8_t *end, Sample_t &sample);
+};
+
+/**
+ * @brief Turns samples of a schema into frames
+ *
+ * @note Frames are written where the caller says: a buffer of its own, or a
+ *       buffer of a BufferPool that send() hands to the driver, so no byte
+ *       is staged or copied after the packing. With delta encoding on, a
+ *       keyframe holding every field goes out every keyframe_interval
+ *       frames and the others only carry the fields that changed. Frames
+ *       have no delimiter or checksum of their own, the link adds them,
+ *       e.g. COMM_USE_HW_CRC or a FrameLink.
+ *
+ * @code
+ * BufferPool<ImuSchema::FRAME_SIZE_MAX, 8> pool;
+ * TelemetryEncoder<ImuSchema> encoder(1);
+ * encoder.setDelta(50);
+ * encoder.send(uart, pool, sample);
+ * @endcode
+ *
+ * @tparam SCHEMA A TelemetrySchema
+ */
+template <typename SCHEMA>
+class TelemetryEncoder
+{
+public:
+  using Sample_t = typename SCHEMA::Sample_t;
+
+  TelemetryEncoder(uint8_t schema_id);
+
+  void setDelta(uint16_t keyframe_interval);
+
+  void forceKeyframe() { m_since_keyframe = 0;}
+
+  Status_t encode(const Sample_t &sample, Buffer_t output, Size_t &frame_size);
+
+  template <uint32_t BUFFER_SIZE, uint32_t BUFFER_COUNT>
+  DriverToken send(DriverOutBase &driver, BufferPool<BUFFER_SIZE, BUFFER_COUNT> &pool, const Sample_t &sample,
+                   uint32_t timeout = UINT32_MAX);
+
+  TelemetryStats_t getStats() { return m_stats;}
+
+private:
+  uint8_t m_schema_id;
+  uint16_t m_sequence;
+  uint16_t m_keyframe_interval;   /*!< 0 when delta encoding is off */
+  uint16_t m_since_keyframe;      /*!< Frames since the last keyframe, 0 to send one */
+  Sample_t m_reference;           /*!< Sample of the previous frame */
+  TelemetryStats_t m_stats;
+};
+
+/**
+ * @brief Turns frames of a schema back into samples
+ *
+ * @note Delta frames apply to the sample of the previous frame. After a
+ *       frame is lost they are refused until the next keyframe.
+ *
+ * @tparam SCHEMA A TelemetrySchema
+ */
+template <typename SCHEMA>
+class TelemetryDecoder
+{
+public:
+  using Sample_t = typename SCHEMA::Sample_t;
+
+  TelemetryDecoder(uint8_t schema_id);
+
+  Status_t decode(const uint8_t *frame, Size_t size, Sample_t &sample);
+
+  void reset() { m_has_reference = false;}
+
+private:
+  uint8_t m_schema_id;
+  uint16_t m_sequence;            /*!< Sequence number of the previous frame */
+  bool m_has_reference;
+  Sample_t m_reference;
+};
+
+#include "telemetry.tpp"
+
+#endif /* TELEMETRY_HPP */
@@ -0,0 +1,462 @@
+/**
+ * @file telemetry.tpp
+ * @author your name (you@domain.com)
+ * @brief Compact binary frames of telemetry structs
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <string.h>
+#include <bit>
+
+/**
+ * @brief Unsigned integer of the same size as a field element
+ * @tparam T Type of the element
+ */
+template <typename T>
+using TelemetryBits_t = std::conditional_t<sizeof(T) == 1, uint8_t,
+                        std::conditional_t<sizeof(T) == 2, uint16_t,
+                        std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>>>;
+
+/**
+ * @brief Get the bits of an element in the order they go on the wire
+ * @tparam T Type of the element
+ * @param value The element
+ * @return TelemetryBits_t<T> Bits to store least significant byte first
+ */
+template <typename T>
+static inline TelemetryBits_t<T> toTelemetryBits(T value)
+{
+  TelemetryBits_t<T> bits;
+
+  memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+/**
+ * @brief Store an element, least significant byte first
+ * @tparam T Type of the element
+ * @param value The element
+ * @param output Storage of sizeof(T) bytes
+ */
+template <typename T>
+static inline void storeLittleEndian(T value, uint8_t *output)
+{
+  TelemetryBits_t<T> bits = toTelemetryBits(value);
+
+  if constexpr(std::endian::native == std::endian::big)
+  {
+    for(Size_t i = 0; i < sizeof(bits); i++) { output[i] = (uint8_t) (bits >> (8 * i));}
+  }else
+  {
+    memcpy(output, &bits, sizeof(bits));
+  }
+}
+
+/**
+ * @brief Load an element stored least significant byte first
+ * @tparam T Type of the element
+ * @param input Bytes of the element
+ * @return T The element
+ */
+template <typename T>
+static inline T loadLittleEndian(const uint8_t *input)
+{
+  TelemetryBits_t<T> bits = 0;
+  T value;
+
+  if constexpr(std::endian::native == std::endian::big)
+  {
+    for(Size_t i = 0; i < sizeof(bits); i++) { bits |= (TelemetryBits_t<T>) input[i] << (8 * i);}
+  }else
+  {
+    memcpy(&bits, input, sizeof(bits));
+  }
+  memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+/**
+ * @brief Pack every field of a sample
+ * @param sample The sample
+ * @param output Storage of PAYLOAD_SIZE bytes
+ * @return Size_t PAYLOAD_SIZE
+ */
+template <auto... MEMBERS>
+Size_t TelemetrySchema<MEMBERS...>::pack(const Sample_t &sample, uint8_t *output)
+{
+  uint8_t *cursor = output;
+
+  (packField<MEMBERS>(sample, cursor), ...);
+  return cursor - output;
+}
+
+/**
+ * @brief Unpack every field of a sample
+ * @param input PAYLOAD_SIZE bytes
+ * @param sample Storage for the sample, members out of the schema are left as they are
+ * @return Size_t PAYLOAD_SIZE
+ */
+template <auto... MEMBERS>
+Size_t TelemetrySchema<MEMBERS...>::unpack(const uint8_t *input, Sample_t &sample)
+{
+  const uint8_t *cursor = input;
+
+  (unpackField<MEMBERS>(cursor, sample), ...);
+  return cursor - input;
+}
+
+/**
+ * @brief Pack the fields of a sample that differ from a reference
+ * @param sample The sample
+ * @param reference Sample the receiver already has
+ * @param output Storage of DELTA_SIZE_MAX bytes
+ * @return Size_t Number of bytes written
+ */
+template <auto... MEMBERS>
+Size_t TelemetrySchema<MEMBERS...>::packDelta(const Sample_t &sample, const Sample_t &reference, uint8_t *output)
+{
+  uint8_t *cursor = output + MASK_SIZE;
+  Size_t index = 0;
+
+  memset(output, 0, MASK_SIZE);
+  (packFieldDelta<MEMBERS>(sample, reference, output, index++, cursor), ...);
+  return cursor - output;
+}
+
+/**
+ * @brief Apply a delta payload to a sample
+ * @param input The payload
+ * @param size Number of bytes of the payload
+ * @param sample The reference, turned into the new sample
+ * @return Size_t Number of bytes read, 0 if the payload is malformed
+ */
+template <auto... MEMBERS>
+Size_t TelemetrySchema<MEMBERS...>::unpackDelta(const uint8_t *input, Size_t size, Sample_t &sample)
+{
+  const uint8_t *cursor = input + MASK_SIZE;
+  Size_t index = 0;
+  bool is_valid;
+
+  if(size < MASK_SIZE) { return 0;}
+  is_valid = (unpackFieldDelta<MEMBERS>(input, index++, cursor, input + size, sample) && ...);
+  return is_valid ? cursor - input : 0;
+}
+
+/**
+ * @brief Copy the fields of the schema from a sample to another
+ * @param from Sample to copy from
+ * @param to Sample to copy to, members out of the schema are left as they are
+ */
+template <auto... MEMBERS>
+void TelemetrySchema<MEMBERS...>::copy(const Sample_t &from, Sample_t &to)
+{
+  (memcpy(&(to.*MEMBERS), &(from.*MEMBERS), sizeof(from.*MEMBERS)), ...);
+}
+
+/**
+ * @brief Pack the elements of a field
+ * @tparam MEMBER Pointer to the member
+ * @param sample The sample
+ * @param output Storage, advanced past the field
+ */
+template <auto... MEMBERS>
+template <auto MEMBER>
+void TelemetrySchema<MEMBERS...>::packField(const Sample_t &sample, uint8_t *&output)
+{
+  using Field = TelemetryMember<decltype(MEMBER)>;
+  using Element_t = typename Field::Element_t;
+  const Element_t *elements = reinterpret_cast<const Element_t *>(&(sample.*MEMBER));
+
+  if constexpr(std::endian::native == std::endian::little)
+  {
+    memcpy(output, elements, sizeof(Element_t) * Field::COUNT);
+  }else
+  {
+    for(Size_t i = 0; i < Field::COUNT; i++) { storeLittleEndian(elements[i], output + i * sizeof(Element_t));}
+  }
+  output += sizeof(Element_t) * Field::COUNT;
+}
+
+/**
+ * @brief Unpack the elements of a field
+ * @tparam MEMBER Pointer to the member
+ * @param input Bytes of the field, advanced past it
+ * @param sample Storage for the sample
+ */
+template <auto... MEMBERS>
+template <auto MEMBER>
+void TelemetrySchema<MEMBERS...>::unpackField(const uint8_t *&input, Sample_t &sample)
+{
+  using Field = TelemetryMember<decltype(MEMBER)>;
+  using Element_t = typename Field::Element_t;
+  Element_t *elements = reinterpret_cast<Element_t *>(&(sample.*MEMBER));
+
+  if constexpr(std::endian::native == std::endian::little)
+  {
+    memcpy(elements, input, sizeof(Element_t) * Field::COUNT);
+  }else
+  {
+    for(Size_t i = 0; i < Field::COUNT; i++) { elements[i] = loadLittleEndian<Element_t>(input + i * sizeof(Element_t));}
+  }
+  input += sizeof(Element_t) * Field::COUNT;
+}
+
+/**
+ * @brief Pack a field if it differs from the reference and mark it in the mask
+ *
+ * @note Differences are taken modulo the width of the field, so a counter
+ *       that wraps around still takes a single byte.
+ * @tparam MEMBER Pointer to the member
+ * @param sample The sample
+ * @param reference Sample the receiver already has
+ * @param mask Mask of the changed fields
+ * @param index Position of the field in the schema
+ * @param output Storage, advanced past the field if it is sent
+ */
+template <auto... MEMBERS>
+template <auto MEMBER>
+void TelemetrySchema<MEMBERS...>::packFieldDelta(const Sample_t &sample, const Sample_t &reference, uint8_t *mask, Size_t index,
+                                                 uint8_t *&output)
+{
+  using Field = TelemetryMember<decltype(MEMBER)>;
+  using Element_t = typename Field::Element_t;
+  using Bits_t = TelemetryBits_t<Element_t>;
+  const Element_t *elements = reinterpret_cast<const Element_t *>(&(sample.*MEMBER));
+  const Element_t *references = reinterpret_cast<const Element_t *>(&(reference.*MEMBER));
+  int64_t difference;
+
+  // Bitwise, a NaN that did not change is not sent again
+  if(memcmp(elements, references, sizeof(Element_t) * Field::COUNT) == 0) { return;}
+  mask[index / 8] |= 1 << (index % 8);
+
+  for(Size_t i = 0; i < Field::COUNT; i++)
+  {
+    if constexpr(Field::IS_INTEGER)
+    {
+      difference = (std::make_signed_t<Bits_t>) (Bits_t) ((Bits_t) elements[i] - (Bits_t) references[i]);
+      output += encodeVarint(((uint64_t) difference << 1) ^ (uint64_t) (difference >> 63), output);
+    }else
+    {
+      storeLittleEndian(elements[i], output);
+      output += sizeof(Element_t);
+    }
+  }
+}
+
+/**
+ * @brief Apply a field of a delta payload if the mask holds it
+ * @tparam MEMBER Pointer to the member
+ * @param mask Mask of the changed fields
+ * @param index Position of the field in the schema
+ * @param input Bytes of the field, advanced past it
+ * @param end End of the payload
+ * @param sample The reference, turned into the new sample
+ * @return true unless the payload ends before the field
+ */
+template <auto... MEMBERS>
+template <auto MEMBER>
+bool TelemetrySchema<MEMBERS...>::unpackFieldDelta(const uint8_t *mask, Size_t index, const uint8_t *&input, const uint8_t *end,
+                                                   Sample_t &sample)
+{
+  using Field = TelemetryMember<decltype(MEMBER)>;
+  using Element_t = typename Field::Element_t;
+  using Bits_t = TelemetryBits_t<Element_t>;
+  Element_t *elements = reinterpret_cast<Element_t *>(&(sample.*MEMBER));
+  uint64_t zigzag;
+  Size_t size;
+
+  if((mask[index / 8] & (1 << (index % 8))) == 0) { return true;}
+
+  for(Size_t i = 0; i < Field::COUNT; i++)
+  {
+    if constexpr(Field::IS_INTEGER)
+    {
+      size = decodeVarint(input, end - input, zigzag);
+      if(size == 0) { return false;}
+      elements[i] = (Element_t) (Bits_t) ((Bits_t) elements[i] + (Bits_t) ((zigzag >> 1) ^ (0 - (zigzag & 1))));
+      input += size;
+    }else
+    {
+      if(end - input < (long) sizeof(Element_t)) { return false;}
+      elements[i] = loadLittleEndian<Element_t>(input);
+      input += sizeof(Element_t);
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Constructor, delta encoding is off
+ * @param schema_id Identifier written in the frames
+ */
+template <typename SCHEMA>
+TelemetryEncoder<SCHEMA>::TelemetryEncoder(uint8_t schema_id)
+{
+  m_schema_id = schema_id;
+  m_sequence = 0;
+  m_keyframe_interval = 0;
+  m_since_keyframe = 0;
+  m_reference = {};
+  m_stats = {0, 0, 0, 0};
+}
+
+/**
+ * @brief Turn delta encoding on or off, the next frame is a keyframe
+ * @param keyframe_interval Frames from a keyframe to the next, 0 or 1 to
+ *        send every field in every frame
+ */
+template <typename SCHEMA>
+void TelemetryEncoder<SCHEMA>::setDelta(uint16_t keyframe_interval)
+{
+  m_keyframe_interval = keyframe_interval > 1 ? keyframe_interval : 0;
+  m_since_keyframe = 0;
+}
+
+/**
+ * @brief Encode a sample as the next frame of the stream
+ * @param sample The sample
+ * @param output Storage for the frame, SCHEMA::FRAME_SIZE_MAX bytes always fit
+ * @param frame_size Storage for the size of the frame
+ * @return Status_t
+ */
+template <typename SCHEMA>
+Status_t TelemetryEncoder<SCHEMA>::encode(const Sample_t &sample, Buffer_t output, Size_t &frame_size)
+{
+  TelemetryHeader_t header = {m_schema_id, 0, m_sequence};
+  bool is_keyframe = m_keyframe_interval == 0 || m_since_keyframe == 0;
+  Status_t status;
+
+  frame_size = 0;
+  if(output.data() == nullptr) { return STATUS_DRV_NULL_POINTER;}
+  if(output.size() < (is_keyframe ? TELEMETRY_HEADER_SIZE + SCHEMA::PAYLOAD_SIZE : SCHEMA::FRAME_SIZE_MAX))
+  {
+    SET_STATUS(status, false, SRC_DRIVER, ERR_BUFFER_SIZE, (char *)"Buffer too small for the frame.\r\n");
+    return status;
+  }
+
+  if(is_keyframe)
+  {
+    frame_size = TELEMETRY_HEADER_SIZE + SCHEMA::pack(sample, output.data() + TELEMETRY_HEADER_SIZE);
+    m_stats.keyframes++;
+  }else
+  {
+    header.flags |= TELEMETRY_FLAG_DELTA;
+    frame_size = TELEMETRY_HEADER_SIZE + SCHEMA::packDelta(sample, m_reference, output.data() + TELEMETRY_HEADER_SIZE);
+  }
+  writeTelemetryHeader(header, output.data());
+
+  if(m_keyframe_interval != 0)
+  {
+    m_reference = sample;
+    m_since_keyframe = (m_since_keyframe + 1) % m_keyframe_interval;
+  }
+  m_sequence++;
+  m_stats.frames++;
+  m_stats.bytes += frame_size;
+  m_stats.full_bytes += TELEMETRY_HEADER_SIZE + SCHEMA::PAYLOAD_SIZE;
+  return STATUS_DRV_SUCCESS;
+}
+
+/**
+ * @brief Encode a sample straight into a buffer of a pool and queue it on a
+ *        driver
+ *
+ * @note The buffer goes back to the pool once the driver is done with it.
+ *       A write refused on the spot makes the next frame a keyframe.
+ * @param driver Output driver, e.g. a UART
+ * @param pool Pool the frame is written in
+ * @param sample The sample
+ * @param timeout Time given to the write in milliseconds
+ * @return DriverToken Completes with the write
+ */
+template <typename SCHEMA>
+template <uint32_t BUFFER_SIZE, uint32_t BUFFER_COUNT>
+DriverToken TelemetryEncoder<SCHEMA>::send(DriverOutBase &driver, BufferPool<BUFFER_SIZE, BUFFER_COUNT> &pool,
+                                           const Sample_t &sample, uint32_t timeout)
+{
+  static_assert(BUFFER_SIZE >= SCHEMA::FRAME_SIZE_MAX, "Pool buffers are smaller than the frames of the schema");
+  PoolBuffer buffer = pool.acquire();
+  DriverToken token;
+  Size_t frame_size;
+  Status_t status;
+
+  if(!buffer.valid()) { return DriverToken(STATUS_DRV_ERR_BUSY);}
+  status = encode(sample, buffer.span(), frame_size);
+  if(!status.success) { return DriverToken(status);}
+  buffer.resize(frame_size);
+
+  token = driver.writeAsync(buffer, timeout);
+  if(token.ready() && !token.wait(0).success) { forceKeyframe();}
+  return token;
+}
+
+/**
+ * @brief Constructor
+ * @param schema_id Identifier of the frames to accept
+ */
+template <typename SCHEMA>
+TelemetryDecoder<SCHEMA>::TelemetryDecoder(uint8_t schema_id)
+{
+  m_schema_id = schema_id;
+  m_sequence = 0;
+  m_has_reference = false;
+  m_reference = {};
+}
+
+/**
+ * @brief Decode a frame
+ * @param frame The frame, as written by a TelemetryEncoder
+ * @param size Number of bytes of the frame
+ * @param sample Storage for the sample, members out of the schema are left as they are
+ * @return Status_t ERR_PARAM_ID for a frame of another schema, ERR_NOT_AVAILABLE
+ *         for a delta frame whose reference was lost
+ */
+template <typename SCHEMA>
+Status_t TelemetryDecoder<SCHEMA>::decode(const uint8_t *frame, Size_t size, Sample_t &sample)
+{
+  TelemetryHeader_t header;
+  Sample_t decoded;
+  Size_t payload_size;
+  Status_t status;
+
+  status = readTelemetryHeader(frame, size, header);
+  if(!status.success) { return status;}
+  if(header.schema_id != m_schema_id)
+  {
+    SET_STATUS(status, false, SRC_DRIVER, ERR_PARAM_ID, (char *)"Frame of another schema.\r\n");
+    return status;
+  }
+
+  if((header.flags & TELEMETRY_FLAG_DELTA) == 0)
+  {
+    if(size != TELEMETRY_HEADER_SIZE + SCHEMA::PAYLOAD_SIZE) { return STATUS_DRV_ERR_PARAM_SIZE;}
+    (void) SCHEMA::unpack(frame + TELEMETRY_HEADER_SIZE, m_reference);
+  }else
+  {
+    if(!m_has_reference || header.sequence != (uint16_t) (m_sequence + 1))
+    {
+      m_has_reference = false;
+      SET_STATUS(status, false, SRC_DRIVER, ERR_NOT_AVAILABLE, (char *)"Delta frame without its reference.\r\n");
+      return status;
+    }
+    // Applied to a copy, a malformed frame leaves the reference as it was
+    decoded = m_reference;
+    payload_size = SCHEMA::unpackDelta(frame + TELEMETRY_HEADER_SIZE, size - TELEMETRY_HEADER_SIZE, decoded);
+    if(payload_size == 0 || payload_size != size - TELEMETRY_HEADER_SIZE)
+    {
+      m_has_reference = false;
+      SET_STATUS(status, false, SRC_DRIVER, ERR_RECEPTION, (char *)"Malformed telemetry frame.\r\n");
+      return status;
+    }
+    m_reference = decoded;
+  }
+
+  m_sequence = header.sequence;
+  m_has_reference = true;
+  SCHEMA::copy(m_reference, sample);
+  return STATUS_DRV_SUCCESS;
+}